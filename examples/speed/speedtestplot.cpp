@@ -201,6 +201,10 @@ void SpeedTestPlot::plotNewData()
         Y2[NDATA-1]=cos(X[NDATA-1])+static_cast<double>(std::rand())/static_cast<double>(RAND_MAX + 1u)-0.5+addOutlier(1.0/static_cast<double>(NDATA/7), 2.0);
 
     }
+    // the arrays are referenced by the datastore, but were changed directly, so tell it, which columns have to be re-read
+    getDatastore()->markColumnModified(graph->getXColumn());
+    getDatastore()->markColumnModified(graph->getYColumn());
+    getDatastore()->markColumnModified(graph2->getYColumn());
 
 
     // set new x-range and replot
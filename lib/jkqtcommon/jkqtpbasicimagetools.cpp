@@ -23,6 +23,9 @@
 #include <QDir>
 #include <QFileInfo>
 #include <algorithm>
+#include <thread>
+#include <atomic>
+#include <QThread>
 #ifdef QT_XML_LIB
 #  include <QtXml/QtXml>
 #endif
@@ -44,6 +47,45 @@ QReadWriteLock JKQTPImageTools::lutMutex;
 QStringList JKQTPImageTools::getPredefinedPalettesGlobalList = QStringList();
 QStringList JKQTPImageTools::getPredefinedPalettesMachineReadableGlobalList = QStringList();
 
+namespace {
+    /** \brief number of threads used by JKQTPImageTools::runRowsInParallel() (0: QThread::idealThreadCount() ) */
+    std::atomic<int> JKQTPImageTools_parallelColorizationThreads(0);
+    /** \brief images with less pixels are colorized in the calling thread, as starting threads costs more than it saves */
+    const qint64 JKQTPImageTools_minParallelPixels=256*1024;
+    /** \brief minimum number of pixels per thread */
+    const qint64 JKQTPImageTools_minPixelsPerThread=64*1024;
+}
+
+void JKQTPImageTools::runRowsInParallel(int height, qint64 pixels, const std::function<void (int, int)> &rows)
+{
+    if (height<=0) return;
+    int threads=JKQTPImageTools_parallelColorizationThreads;
+    if (threads<=0) threads=QThread::idealThreadCount();
+    threads=static_cast<int>(std::min<qint64>(std::min<qint64>(threads, height), pixels/JKQTPImageTools_minPixelsPerThread));
+    if (pixels<JKQTPImageTools_minParallelPixels || threads<=1) {
+        rows(0, height);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(threads));
+    for (int t=0; t<threads; t++) {
+        const int rowStart=static_cast<int>(static_cast<qint64>(height)*t/threads);
+        const int rowEnd=static_cast<int>(static_cast<qint64>(height)*(t+1)/threads);
+        workers.emplace_back(rows, rowStart, rowEnd);
+    }
+    for (auto& w: workers) w.join();
+}
+
+void JKQTPImageTools::setParallelColorizationThreads(int threads)
+{
+    JKQTPImageTools_parallelColorizationThreads=threads;
+}
+
+int JKQTPImageTools::getParallelColorizationThreads()
+{
+    return JKQTPImageTools_parallelColorizationThreads;
+}
+
 
 
 
@@ -2476,6 +2518,25 @@ QString ModifierModeToString(const JKQTPMathImageModifierMode &mode) {
     return "none";
 }
 
+bool JKQTPImagePlot_getImageMinMax(const void *data, JKQTPMathImageDataType datatype, int width, int height, double &imin, double &imax)
+{
+    imin=imax=0;
+    if (!data) return false;
+    switch(datatype) {
+        case JKQTPMathImageDataType::DoubleArray: return JKQTPImagePlot_getImageMinMax<double>(static_cast<const double*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::FloatArray: return JKQTPImagePlot_getImageMinMax<float>(static_cast<const float*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::UInt8Array: return JKQTPImagePlot_getImageMinMax<uint8_t>(static_cast<const uint8_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::UInt16Array: return JKQTPImagePlot_getImageMinMax<uint16_t>(static_cast<const uint16_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::UInt32Array: return JKQTPImagePlot_getImageMinMax<uint32_t>(static_cast<const uint32_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::UInt64Array: return JKQTPImagePlot_getImageMinMax<uint64_t>(static_cast<const uint64_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::Int8Array: return JKQTPImagePlot_getImageMinMax<int8_t>(static_cast<const int8_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::Int16Array: return JKQTPImagePlot_getImageMinMax<int16_t>(static_cast<const int16_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::Int32Array: return JKQTPImagePlot_getImageMinMax<int32_t>(static_cast<const int32_t*>(data), width, height, imin, imax);
+        case JKQTPMathImageDataType::Int64Array: return JKQTPImagePlot_getImageMinMax<int64_t>(static_cast<const int64_t*>(data), width, height, imin, imax);
+    }
+    return false;
+}
+
 void JKQTPModifyImage(QImage &img, JKQTPMathImageModifierMode modifierMode, const void *dataModifier, JKQTPMathImageDataType datatypeModifier, int Nx, int Ny, double internalModifierMin, double internalModifierMax)
 {
     if (!dataModifier) return;
@@ -2587,3 +2648,300 @@ QImage jkqtp_mirrored(const QImage &image, bool mirrx, bool mirry)
     return image.mirrored(mirrx, mirry);
 #endif
 }
+
+
+
+JKQTPImageTilePyramid::Statistics &JKQTPImageTilePyramid::Statistics::operator+=(const Statistics &other)
+{
+    requestedTiles+=other.requestedTiles;
+    hitTiles+=other.hitTiles;
+    builtTiles+=other.builtTiles;
+    evictedTiles+=other.evictedTiles;
+    invalidations+=other.invalidations;
+    cachedTiles+=other.cachedTiles;
+    memoryBytes+=other.memoryBytes;
+    return *this;
+}
+
+JKQTPImageTilePyramid::JKQTPImageTilePyramid():
+    m_data(nullptr),
+    m_datatype(JKQTPMathImageDataType::DoubleArray),
+    m_Nx(0),
+    m_Ny(0),
+    m_key(0),
+    m_useCounter(0),
+    m_maxMemory(256*1024*1024),
+    m_parallelBuilding(true)
+{
+}
+
+void JKQTPImageTilePyramid::setSource(const void *data, JKQTPMathImageDataType datatype, int Nx, int Ny, quint64 key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (data!=m_data || datatype!=m_datatype || Nx!=m_Nx || Ny!=m_Ny || key!=m_key) {
+        if (m_tiles.size()>0) m_statistics.invalidations++;
+        m_tiles.clear();
+        m_data=data;
+        m_datatype=datatype;
+        m_Nx=Nx;
+        m_Ny=Ny;
+        m_key=key;
+    }
+}
+
+void JKQTPImageTilePyramid::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tiles.clear();
+}
+
+int JKQTPImageTilePyramid::getLevelCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_data || m_Nx<=0 || m_Ny<=0) return 0;
+    int levels=1;
+    while ((std::max(m_Nx, m_Ny)-1)>>(levels-1) > 0) levels++;
+    return levels;
+}
+
+int JKQTPImageTilePyramid::getLevelWidth(int level) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_Nx+(1<<level)-1)>>level;
+}
+
+int JKQTPImageTilePyramid::getLevelHeight(int level) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_Ny+(1<<level)-1)>>level;
+}
+
+int JKQTPImageTilePyramid::levelForDownsampling(double sourcePixelsPerOutputPixel) const
+{
+    if (!(sourcePixelsPerOutputPixel>=2.0)) return 0;
+    const int level=static_cast<int>(floor(log2(sourcePixelsPerOutputPixel)));
+    return qBound(0, level, std::max(0, getLevelCount()-1));
+}
+
+namespace {
+    /** \brief calculates the pixels of a level-1 tile directly from the source image \a data (row-major, \a Nx * \a Ny ) */
+    template <class T>
+    void JKQTPImageTilePyramidBuildFromSource(const T* data, int Nx, int Ny, int tx, int ty, double* out) {
+        const int TS=JKQTPImageTilePyramid::TileSize;
+        for (int j=0; j<TS; j++) {
+            const int y=2*(ty*TS+j);
+            for (int i=0; i<TS; i++) {
+                const int x=2*(tx*TS+i);
+                double sum=0;
+                int cnt=0;
+                for (int yy=y; yy<std::min(y+2, Ny); yy++) {
+                    for (int xx=x; xx<std::min(x+2, Nx); xx++) {
+                        const double v=static_cast<double>(data[static_cast<size_t>(yy)*static_cast<size_t>(Nx)+static_cast<size_t>(xx)]);
+                        if (std::isfinite(v)) {
+                            sum+=v;
+                            cnt++;
+                        }
+                    }
+                }
+                out[j*TS+i]=(cnt>0)?(sum/static_cast<double>(cnt)):JKQTP_NAN;
+            }
+        }
+    }
+}
+
+std::vector<double> JKQTPImageTilePyramid::buildTile(int level, int tx, int ty) const
+{
+    const int TS=TileSize;
+    std::vector<double> values(static_cast<size_t>(TS)*static_cast<size_t>(TS), JKQTP_NAN);
+    if (level==1) {
+        switch(m_datatype) {
+            case JKQTPMathImageDataType::DoubleArray: JKQTPImageTilePyramidBuildFromSource<double>(static_cast<const double*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::FloatArray: JKQTPImageTilePyramidBuildFromSource<float>(static_cast<const float*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::UInt8Array: JKQTPImageTilePyramidBuildFromSource<uint8_t>(static_cast<const uint8_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::UInt16Array: JKQTPImageTilePyramidBuildFromSource<uint16_t>(static_cast<const uint16_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::UInt32Array: JKQTPImageTilePyramidBuildFromSource<uint32_t>(static_cast<const uint32_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::UInt64Array: JKQTPImageTilePyramidBuildFromSource<uint64_t>(static_cast<const uint64_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::Int8Array: JKQTPImageTilePyramidBuildFromSource<int8_t>(static_cast<const int8_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::Int16Array: JKQTPImageTilePyramidBuildFromSource<int16_t>(static_cast<const int16_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::Int32Array: JKQTPImageTilePyramidBuildFromSource<int32_t>(static_cast<const int32_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+            case JKQTPMathImageDataType::Int64Array: JKQTPImageTilePyramidBuildFromSource<int64_t>(static_cast<const int64_t*>(m_data), m_Nx, m_Ny, tx, ty, values.data()); break;
+        }
+    } else {
+        // each quadrant of the tile is calculated from one tile of the level below
+        const int HTS=TS/2;
+        for (int q=0; q<4; q++) {
+            const int qx=q%2;
+            const int qy=q/2;
+            const auto child=m_tiles.find(tileKey(level-1, 2*tx+qx, 2*ty+qy));
+            if (child==m_tiles.end()) continue; // outside of the image
+            const double* cv=child->second.values.data();
+            for (int j=0; j<HTS; j++) {
+                const double* l0=cv+(2*j)*TS;
+                const double* l1=l0+TS;
+                double* o=values.data()+(qy*HTS+j)*TS+qx*HTS;
+                for (int i=0; i<HTS; i++) {
+                    double sum=0;
+                    int cnt=0;
+                    const double v[4]={l0[2*i], l0[2*i+1], l1[2*i], l1[2*i+1]};
+                    for (const double vv: v) {
+                        if (std::isfinite(vv)) {
+                            sum+=vv;
+                            cnt++;
+                        }
+                    }
+                    o[i]=(cnt>0)?(sum/static_cast<double>(cnt)):JKQTP_NAN;
+                }
+            }
+        }
+    }
+    return values;
+}
+
+quint64 JKQTPImageTilePyramid::ensureTiles(int level, int tx0, int ty0, int tx1, int ty1)
+{
+    // collect the missing tiles, level by level down to level 1
+    std::vector<std::vector<std::pair<int,int> > > missing(static_cast<size_t>(level)+1);
+    quint64 hits=0;
+    for (int ty=ty0; ty<=ty1; ty++) {
+        for (int tx=tx0; tx<=tx1; tx++) {
+            auto it=m_tiles.find(tileKey(level, tx, ty));
+            if (it!=m_tiles.end()) {
+                it->second.lastUse=m_useCounter;
+                hits++;
+            } else {
+                missing[level].emplace_back(tx, ty);
+            }
+        }
+    }
+    for (int l=level; l>1; l--) {
+        const int ntx=(((m_Nx+(1<<(l-1))-1)>>(l-1))+TileSize-1)/TileSize;
+        const int nty=(((m_Ny+(1<<(l-1))-1)>>(l-1))+TileSize-1)/TileSize;
+        for (const auto& t: missing[l]) {
+            for (int q=0; q<4; q++) {
+                const int cx=2*t.first+q%2;
+                const int cy=2*t.second+q/2;
+                if (cx>=ntx || cy>=nty) continue;
+                auto it=m_tiles.find(tileKey(l-1, cx, cy));
+                if (it!=m_tiles.end()) {
+                    it->second.lastUse=m_useCounter;
+                } else {
+                    missing[l-1].emplace_back(cx, cy);
+                }
+            }
+        }
+    }
+
+    // build the missing tiles, starting at level 1, each level (optionally) in parallel
+    for (int l=1; l<=level; l++) {
+        const auto& todo=missing[l];
+        if (todo.size()==0) continue;
+        std::vector<std::vector<double> > built(todo.size());
+        const size_t workerCount=m_parallelBuilding?std::min<size_t>(static_cast<size_t>(std::max(1, QThread::idealThreadCount())), todo.size()):1;
+        if (workerCount<=1) {
+            for (size_t i=0; i<todo.size(); i++) built[i]=buildTile(l, todo[i].first, todo[i].second);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(workerCount);
+            for (size_t w=0; w<workerCount; w++) {
+                workers.emplace_back([&, w, l]() {
+                    for (size_t i=w; i<todo.size(); i+=workerCount) built[i]=buildTile(l, todo[i].first, todo[i].second);
+                });
+            }
+            for (auto& t: workers) t.join();
+        }
+        for (size_t i=0; i<todo.size(); i++) {
+            Tile& tile=m_tiles[tileKey(l, todo[i].first, todo[i].second)];
+            tile.values=std::move(built[i]);
+            tile.lastUse=m_useCounter;
+        }
+        m_statistics.builtTiles+=todo.size();
+    }
+    return hits;
+}
+
+void JKQTPImageTilePyramid::evictTiles(bool keepCurrentRequest)
+{
+    const size_t tileBytes=static_cast<size_t>(TileSize)*static_cast<size_t>(TileSize)*sizeof(double);
+    if (m_tiles.size()*tileBytes<=m_maxMemory) return;
+    std::vector<std::pair<quint64,quint64> > candidates; // (lastUse, key)
+    candidates.reserve(m_tiles.size());
+    for (const auto& t: m_tiles) {
+        if (!keepCurrentRequest || t.second.lastUse!=m_useCounter) candidates.emplace_back(t.second.lastUse, t.first);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& c: candidates) {
+        if (m_tiles.size()*tileBytes<=m_maxMemory) break;
+        m_tiles.erase(c.second);
+        m_statistics.evictedTiles++;
+    }
+}
+
+bool JKQTPImageTilePyramid::getRegion(int level, int x0, int y0, int x1, int y1, std::vector<double> &out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_data || m_Nx<=0 || m_Ny<=0 || level<1 || level>=30) return false;
+    const int levelW=(m_Nx+(1<<level)-1)>>level;
+    const int levelH=(m_Ny+(1<<level)-1)>>level;
+    if (x0<0 || y0<0 || x1>levelW || y1>levelH || x1<=x0 || y1<=y0) return false;
+
+    m_useCounter++;
+    const int tx0=x0/TileSize, tx1=(x1-1)/TileSize;
+    const int ty0=y0/TileSize, ty1=(y1-1)/TileSize;
+    m_statistics.requestedTiles+=static_cast<quint64>(tx1-tx0+1)*static_cast<quint64>(ty1-ty0+1);
+    m_statistics.hitTiles+=ensureTiles(level, tx0, ty0, tx1, ty1);
+
+    const int W=x1-x0;
+    out.resize(static_cast<size_t>(W)*static_cast<size_t>(y1-y0));
+    for (int ty=ty0; ty<=ty1; ty++) {
+        for (int tx=tx0; tx<=tx1; tx++) {
+            const double* tv=m_tiles.at(tileKey(level, tx, ty)).values.data();
+            const int xs=std::max(x0, tx*TileSize), xe=std::min(x1, (tx+1)*TileSize);
+            const int ys=std::max(y0, ty*TileSize), ye=std::min(y1, (ty+1)*TileSize);
+            for (int y=ys; y<ye; y++) {
+                std::copy(tv+(y-ty*TileSize)*TileSize+(xs-tx*TileSize), tv+(y-ty*TileSize)*TileSize+(xe-tx*TileSize), out.data()+static_cast<size_t>(y-y0)*static_cast<size_t>(W)+static_cast<size_t>(xs-x0));
+            }
+        }
+    }
+    evictTiles();
+    return true;
+}
+
+void JKQTPImageTilePyramid::setMaxMemory(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxMemory=bytes;
+    evictTiles(false);
+}
+
+size_t JKQTPImageTilePyramid::getMaxMemory() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxMemory;
+}
+
+void JKQTPImageTilePyramid::setParallelBuilding(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_parallelBuilding=enabled;
+}
+
+bool JKQTPImageTilePyramid::getParallelBuilding() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parallelBuilding;
+}
+
+JKQTPImageTilePyramid::Statistics JKQTPImageTilePyramid::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Statistics s=m_statistics;
+    s.cachedTiles=m_tiles.size();
+    s.memoryBytes=m_tiles.size()*static_cast<size_t>(TileSize)*static_cast<size_t>(TileSize)*sizeof(double);
+    return s;
+}
+
+void JKQTPImageTilePyramid::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics=Statistics();
+}
@@ -31,6 +31,11 @@
 #include <QReadWriteLock>
 #include <vector>
 #include <limits>
+#include <type_traits>
+#include <mutex>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
 #include "jkqtcommon/jkqtcommon_imexport.h"
 #include "jkqtcommon/jkqtpmathtools.h"
 #include "jkqtcommon/jkqttools.h"
@@ -51,6 +56,91 @@ enum class JKQTPMathImageDataType {
     Int64Array /*!< Data is of type \c int64_t */
 };
 
+/** \brief returns the size (in bytes) of one element of the given \a datatype
+    \ingroup jkqtplotter_imagelots_tools
+ */
+inline size_t JKQTPMathImageDataTypeSize(JKQTPMathImageDataType datatype) {
+    switch(datatype) {
+        case JKQTPMathImageDataType::FloatArray: return sizeof(float);
+        case JKQTPMathImageDataType::DoubleArray: return sizeof(double);
+        case JKQTPMathImageDataType::UInt8Array: return sizeof(uint8_t);
+        case JKQTPMathImageDataType::UInt16Array: return sizeof(uint16_t);
+        case JKQTPMathImageDataType::UInt32Array: return sizeof(uint32_t);
+        case JKQTPMathImageDataType::UInt64Array: return sizeof(uint64_t);
+        case JKQTPMathImageDataType::Int8Array: return sizeof(int8_t);
+        case JKQTPMathImageDataType::Int16Array: return sizeof(int16_t);
+        case JKQTPMathImageDataType::Int32Array: return sizeof(int32_t);
+        case JKQTPMathImageDataType::Int64Array: return sizeof(int64_t);
+    }
+    return sizeof(double);
+}
+
+/** \brief returns the JKQTPMathImageDataType that corresponds to the C++ type \a T
+    \ingroup jkqtplotter_imagelots_tools
+
+    \code
+        JKQTPMathImageDataTypeOf<uint16_t>() // == JKQTPMathImageDataType::UInt16Array
+    \endcode
+ */
+template<typename T>
+constexpr JKQTPMathImageDataType JKQTPMathImageDataTypeOf() {
+    static_assert(std::is_arithmetic<T>::value, "JKQTPMathImageDataTypeOf<T>() only works for arithmetic types");
+    return std::is_floating_point<T>::value ? ((sizeof(T)==sizeof(float)) ? JKQTPMathImageDataType::FloatArray : JKQTPMathImageDataType::DoubleArray)
+         : std::is_signed<T>::value ? ((sizeof(T)==1) ? JKQTPMathImageDataType::Int8Array : (sizeof(T)==2) ? JKQTPMathImageDataType::Int16Array : (sizeof(T)==4) ? JKQTPMathImageDataType::Int32Array : JKQTPMathImageDataType::Int64Array)
+         : ((sizeof(T)==1) ? JKQTPMathImageDataType::UInt8Array : (sizeof(T)==2) ? JKQTPMathImageDataType::UInt16Array : (sizeof(T)==4) ? JKQTPMathImageDataType::UInt32Array : JKQTPMathImageDataType::UInt64Array);
+}
+
+/** \brief converts a \c double \a v into the numeric type \a T.
+    \ingroup jkqtplotter_imagelots_tools
+
+    For integer types \a v is rounded and limited to the range of \a T, non-finite values (NaN, inf) are converted to 0.
+ */
+template<typename T>
+inline T JKQTPMathImageConvertFromDouble(double v) {
+    if (std::is_floating_point<T>::value) return static_cast<T>(v);
+    if (!std::isfinite(v)) return T(0);
+    if (v<=static_cast<double>(std::numeric_limits<T>::min())) return std::numeric_limits<T>::min();
+    if (v>=static_cast<double>(std::numeric_limits<T>::max())) return std::numeric_limits<T>::max();
+    return static_cast<T>(std::round(v));
+}
+
+/** \brief returns the \a idx -th element of the array \a data (of type \a datatype ), converted to \c double
+    \ingroup jkqtplotter_imagelots_tools
+ */
+inline double JKQTPMathImageGetValue(const void* data, JKQTPMathImageDataType datatype, size_t idx) {
+    switch(datatype) {
+        case JKQTPMathImageDataType::FloatArray: return static_cast<double>(static_cast<const float*>(data)[idx]);
+        case JKQTPMathImageDataType::DoubleArray: return static_cast<const double*>(data)[idx];
+        case JKQTPMathImageDataType::UInt8Array: return static_cast<double>(static_cast<const uint8_t*>(data)[idx]);
+        case JKQTPMathImageDataType::UInt16Array: return static_cast<double>(static_cast<const uint16_t*>(data)[idx]);
+        case JKQTPMathImageDataType::UInt32Array: return static_cast<double>(static_cast<const uint32_t*>(data)[idx]);
+        case JKQTPMathImageDataType::UInt64Array: return static_cast<double>(static_cast<const uint64_t*>(data)[idx]);
+        case JKQTPMathImageDataType::Int8Array: return static_cast<double>(static_cast<const int8_t*>(data)[idx]);
+        case JKQTPMathImageDataType::Int16Array: return static_cast<double>(static_cast<const int16_t*>(data)[idx]);
+        case JKQTPMathImageDataType::Int32Array: return static_cast<double>(static_cast<const int32_t*>(data)[idx]);
+        case JKQTPMathImageDataType::Int64Array: return static_cast<double>(static_cast<const int64_t*>(data)[idx]);
+    }
+    return JKQTP_NAN;
+}
+
+/** \brief sets the \a idx -th element of the array \a data (of type \a datatype ) to \a value (converted with JKQTPMathImageConvertFromDouble() )
+    \ingroup jkqtplotter_imagelots_tools
+ */
+inline void JKQTPMathImageSetValue(void* data, JKQTPMathImageDataType datatype, size_t idx, double value) {
+    switch(datatype) {
+        case JKQTPMathImageDataType::FloatArray: static_cast<float*>(data)[idx]=JKQTPMathImageConvertFromDouble<float>(value); break;
+        case JKQTPMathImageDataType::DoubleArray: static_cast<double*>(data)[idx]=value; break;
+        case JKQTPMathImageDataType::UInt8Array: static_cast<uint8_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<uint8_t>(value); break;
+        case JKQTPMathImageDataType::UInt16Array: static_cast<uint16_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<uint16_t>(value); break;
+        case JKQTPMathImageDataType::UInt32Array: static_cast<uint32_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<uint32_t>(value); break;
+        case JKQTPMathImageDataType::UInt64Array: static_cast<uint64_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<uint64_t>(value); break;
+        case JKQTPMathImageDataType::Int8Array: static_cast<int8_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<int8_t>(value); break;
+        case JKQTPMathImageDataType::Int16Array: static_cast<int16_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<int16_t>(value); break;
+        case JKQTPMathImageDataType::Int32Array: static_cast<int32_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<int32_t>(value); break;
+        case JKQTPMathImageDataType::Int64Array: static_cast<int64_t*>(data)[idx]=JKQTPMathImageConvertFromDouble<int64_t>(value); break;
+    }
+}
+
 /*! \brief retrieve an R/G/B/Alpha (\a ch == 0/1/2/3) value from the \c QRgb value \a rgb
     \ingroup jkqtplotter_imagelots_tools
  */
@@ -366,6 +456,9 @@ enum JKQTPMathImageColorRangeFailAction {
     JKQTPMathImageTransparent=2 /*!< set transparent */
 };
 
+template <class T>
+inline bool JKQTPImagePlot_getImageMinMax(const T* dbl, int width, int height, double& imin, double& imax);
+
 /*! \brief tool structure that summarizes several static properties of JKQTPlotters palette system,
            also provides functions to work with palettes and register user-defined palettes.
     \ingroup jkqtplotter_imagelots_tools
@@ -458,12 +551,52 @@ struct JKQTPImageTools {
 
 
 
+        /*! \brief maps single (non-log-scaled) values onto the colors of a LUT, using the same rules as array2image()
+            \internal
+         */
+        struct LUTMapper {
+            inline LUTMapper(const LUTType& lut_, double min_, double delta_, JKQTPMathImageColorRangeFailAction paletteMinFail, JKQTPMathImageColorRangeFailAction paletteMaxFail, QColor minFailColor, QColor maxFailColor, QColor nanColor, QColor infColor):
+                lut(lut_.constData()), lutSize(lut_.size()), min(min_), delta(delta_),
+                belowRgb((paletteMinFail==JKQTPMathImageGivenColor)?minFailColor.rgba():((paletteMinFail==JKQTPMathImageTransparent)?QColor(Qt::transparent).rgba():lut_[0])),
+                aboveRgb((paletteMaxFail==JKQTPMathImageGivenColor)?maxFailColor.rgba():((paletteMaxFail==JKQTPMathImageTransparent)?QColor(Qt::transparent).rgba():lut_[lut_.size()-1])),
+                nanRgb(nanColor.rgba()), infRgb(infColor.rgba())
+            {}
+            /** \brief returns the color for \a val */
+            inline QRgb map(double val) const {
+                if (std::isnan(val)) return nanRgb;
+                if (std::isinf(val)) return infRgb;
+                const int v = static_cast<int>((val-min)/delta*static_cast<double>(lutSize));
+                if (v<0) return belowRgb;
+                if (v>=lutSize) return aboveRgb;
+                return lut[v];
+            }
+            const QRgb* lut;
+            int lutSize;
+            double min;
+            double delta;
+            QRgb belowRgb;
+            QRgb aboveRgb;
+            QRgb nanRgb;
+            QRgb infRgb;
+        };
+
+        /*! \brief calls \a rows for ranges <code>[rowStart..rowEnd)</code> covering the rows <code>0..height-1</code> of an image with \a pixels pixels.
+                   For large images the ranges are processed in parallel threads (see setParallelColorizationThreads() ), otherwise
+                   \a rows is called once for all rows in the calling thread.
+            \internal
+         */
+        static JKQTCOMMON_LIB_EXPORT void runRowsInParallel(int height, qint64 pixels, const std::function<void(int,int)>& rows);
+        /*! \brief sets the maximum number of threads used by array2image() for large images (\c 0 [default]: QThread::idealThreadCount(), \c 1: no threads) */
+        static JKQTCOMMON_LIB_EXPORT void setParallelColorizationThreads(int threads);
+        /*! \brief returns the maximum number of threads used by array2image() for large images, see setParallelColorizationThreads() */
+        static JKQTCOMMON_LIB_EXPORT int getParallelColorizationThreads();
+
         /*! \brief convert a 2D image (as 1D array) into a QImage with given palette (see JKQTFPColorPalette)
 
             \param dbl_in pointer to a 1D array of template type \c T representing the image to plot. This array has to be of size \a width * \a height
             \param width width of the array in \a dbl
             \param height height of the array in \a dbl
-            \param[out] img the QImage object to draw to (should be initialized as \c QImage::Format_ARGB32 )
+            \param[out] img the QImage object to draw to. It is only reallocated, if it does not already have the size \a width * \a height and the format \c QImage::Format_ARGB32 , so a buffer can be reused between calls.
             \param palette the color palette to use for the display
             \param minColor lower boundary of color range in \a dbl pixels, if \a minColor == \a maxColor then this function will extract the image min and image max.
             \param maxColor upper boundary of color range in \a dbl pixels, if \a minColor == \a maxColor then this function will extract the image min and image max.
@@ -488,23 +621,9 @@ struct JKQTPImageTools {
             double min = *dbl_in;
             double max = *dbl_in;
             if (jkqtp_approximatelyEqual(minColor, maxColor, JKQTP_DOUBLE_EPSILON)) {
-                bool first=true;
-                for (int i=1; i<NPixels; ++i)
-                {
-                    T v=dbl_in[i];
-                    if (!(std::isnan(static_cast<long double>(v)) || std::isinf(static_cast<long double>(v)))) {
-                        if (first) {
-                            min=max=v;
-                            first=false;
-                        } else {
-                            if (v < min)
-                                min = v;
-                            else if (v > max)
-                                max = v;
-                        }
-                    }
+                if (!JKQTPImagePlot_getImageMinMax<T>(dbl_in, width, height, min, max)) {
+                    min=max=*dbl_in;
                 }
-
             } else {
                 min = minColor;
                 max = maxColor;
@@ -528,37 +647,50 @@ struct JKQTPImageTools {
             // either use lutUser (if palette==JKQTPMathImageUSER_PALETTE) or else read the LUT from the internal storage
             const LUTType& lut_used=(palette==JKQTPMathImageUSER_PALETTE)?lutUser:getLUTforPalette(JKQTPImageTools::global_jkqtpimagetools_lutstore, palette);
 
-            img = QImage(width, height, QImage::Format_ARGB32);
+            if (img.width()!=width || img.height()!=height || img.format()!=QImage::Format_ARGB32) {
+                img = QImage(width, height, QImage::Format_ARGB32);
+            }
             if (jkqtp_approximatelyEqual(min, max, JKQTP_DOUBLE_EPSILON)) {
                     img.fill(lut_used[0]);
             } else {
                 const int lutSize=lut_used.size();
                 if (lutSize>0) {
                     // LUT found: collor the image accordingly
-                    for (int j=0; j<height; ++j) {
-                        QRgb* line=reinterpret_cast<QRgb*>(img.scanLine(height-1-j));
-                        for (int i=0; i<width; ++i) {
-                            double val=dbl[j*width+i];
-                            if (std::isnan(val)) {
-                                line[i]=nanColor.rgba();
-                            } else if (std::isinf(val)) {
-                                line[i]=infColor.rgba();
-                            } else {
-                                const int v = static_cast<int>((val-min)/delta*static_cast<double>(lutSize));
-                                const int vv = qBound<int>(0, v, lutSize-1);
-                                line[i]=lut_used[vv];
-                                if ((v<0)&&(paletteMinFail==JKQTPMathImageGivenColor)) {
-                                    line[i]=minFailColor.rgba();
-                                } else if ((v>=lutSize)&&(paletteMaxFail==JKQTPMathImageGivenColor)) {
-                                    line[i]=maxFailColor.rgba();
-                                } else if ((v<0)&&(paletteMinFail==JKQTPMathImageTransparent)) {
-                                    line[i]=QColor(Qt::transparent).rgba();
-                                } else if ((v>=lutSize)&&(paletteMaxFail==JKQTPMathImageTransparent)) {
-                                    line[i]=QColor(Qt::transparent).rgba();
-                                }
+                    const LUTMapper mapper(lut_used, min, delta, paletteMinFail, paletteMaxFail, minFailColor, maxFailColor, nanColor, infColor);
+                    uchar* const bits=img.bits(); // detach once, before the rows are (possibly) written in parallel
+                    const qsizetype bytesPerLine=img.bytesPerLine();
+                    bool done=false;
+                    if constexpr (std::is_integral<T>::value && sizeof(T)<=2) {
+                        // 8/16-bit integers: map every possible value once, then each pixel is a single table lookup
+                        if (!logScale && (sizeof(T)==1 || NPixels>=(2<<(8*sizeof(T))))) {
+                            typedef typename std::make_unsigned<T>::type UT;
+                            std::vector<QRgb> table(size_t(1)<<(8*sizeof(T)));
+                            for (size_t k=0; k<table.size(); k++) {
+                                table[k]=mapper.map(static_cast<double>(static_cast<T>(static_cast<UT>(k))));
                             }
+                            runRowsInParallel(height, NPixels, [&](int rowStart, int rowEnd) {
+                                for (int j=rowStart; j<rowEnd; ++j) {
+                                    QRgb* line=reinterpret_cast<QRgb*>(bits+(height-1-j)*bytesPerLine);
+                                    const T* src=dbl+static_cast<size_t>(j)*static_cast<size_t>(width);
+                                    for (int i=0; i<width; ++i) {
+                                        line[i]=table[static_cast<UT>(src[i])];
+                                    }
+                                }
+                            });
+                            done=true;
                         }
                     }
+                    if (!done) {
+                        runRowsInParallel(height, NPixels, [&](int rowStart, int rowEnd) {
+                            for (int j=rowStart; j<rowEnd; ++j) {
+                                QRgb* line=reinterpret_cast<QRgb*>(bits+(height-1-j)*bytesPerLine);
+                                const T* src=dbl+static_cast<size_t>(j)*static_cast<size_t>(width);
+                                for (int i=0; i<width; ++i) {
+                                    line[i]=mapper.map(static_cast<double>(src[i]));
+                                }
+                            }
+                        });
+                    }
                 } else {
                     // no LUT found: paint a black image!
                     img.fill(0);
@@ -799,6 +931,82 @@ inline double JKQTPImagePlot_getImageMax(const T* dbl, int width, int height)
     return max;
 };
 
+/*! \brief find the minimum \a imin and the maximum \a imax of the pixel values in the given image \a dbl with width \a width and height \a height
+           in a single pass over the data, i.e. this returns the results of JKQTPImagePlot_getImageMin() and JKQTPImagePlot_getImageMax() ,
+           but reads the image only once
+    \ingroup jkqtplotter_imagelots_tools
+
+    NaN and inf values are ignored. Large images are scanned in parallel (see JKQTPImageTools::runRowsInParallel() ).
+
+    \return \c false, if the image contains no finite values (\a imin and \a imax are set to 0 in this case)
+ */
+template <class T>
+inline bool JKQTPImagePlot_getImageMinMax(const T* dbl, int width, int height, double& imin, double& imax)
+{
+    imin=imax=0;
+    if (!dbl || width<=0 || height<=0)
+            return false;
+
+    std::mutex mergeMutex;
+    bool found=false;
+    T min = 0;
+    T max = 0;
+    JKQTPImageTools::runRowsInParallel(height, static_cast<qint64>(width)*static_cast<qint64>(height), [&](int rowStart, int rowEnd) {
+        // as in JKQTPImagePlot_getImageMin(), the first pixel is not taken into account
+        const qint64 start=std::max<qint64>(1, static_cast<qint64>(rowStart)*width);
+        const qint64 end=static_cast<qint64>(rowEnd)*width;
+        T lmin = 0;
+        T lmax = 0;
+        bool lfound=false;
+        if constexpr (std::is_floating_point<T>::value) {
+            for (qint64 i=start; i<end; ++i) {
+                const T v=dbl[i];
+                if (std::isfinite(v)) {
+                    if (!lfound) {
+                        lmin=lmax=v;
+                        lfound=true;
+                    } else {
+                        if (v < lmin) lmin = v;
+                        else if (v > lmax) lmax = v;
+                    }
+                }
+            }
+        } else if (start<end) {
+            // all integer values are valid, so the loop needs no special cases
+            lmin=lmax=dbl[start];
+            for (qint64 i=start+1; i<end; ++i) {
+                lmin=std::min(lmin, dbl[i]);
+                lmax=std::max(lmax, dbl[i]);
+            }
+            lfound=true;
+        }
+        if (lfound) {
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            if (!found) {
+                min=lmin;
+                max=lmax;
+                found=true;
+            } else {
+                min=std::min(min, lmin);
+                max=std::max(max, lmax);
+            }
+        }
+    });
+    if (found) {
+        imin=static_cast<double>(min);
+        imax=static_cast<double>(max);
+    }
+    return found;
+};
+
+/*! \brief find the minimum \a imin and the maximum \a imax of the pixel values in the given image \a data of type \a datatype with width \a width and height \a height
+           in a single pass over the data (see JKQTPImagePlot_getImageMinMax(const T*,int,int,double&,double&) )
+    \ingroup jkqtplotter_imagelots_tools
+
+    \return \c false, if the image contains no finite values (\a imin and \a imax are set to 0 in this case)
+ */
+JKQTCOMMON_LIB_EXPORT bool JKQTPImagePlot_getImageMinMax(const void* data, JKQTPMathImageDataType datatype, int width, int height, double& imin, double& imax);
+
 
 
 
@@ -1471,4 +1679,134 @@ void JKQTCOMMON_LIB_EXPORT JKQTPModifyImage(QImage& img, JKQTPMathImageModifierM
 QImage JKQTCOMMON_LIB_EXPORT jkqtp_mirrored(const QImage& image, bool mirrx, bool mirry);
 
 
+/** \brief lazily built, tiled mip-map pyramid of a 2D image (of any JKQTPMathImageDataType ), used to draw zoomed-out views of large images
+    \ingroup jkqtplotter_imagelots_tools
+
+    Level 0 of the pyramid is the source image itself (it is not copied). Each pixel of level \c L>0 is the average of
+    the (finite) values of the 2x2 pixels of level \c L-1 it covers, so level \c L has a size of about
+    <code>Nx/2^L * Ny/2^L</code> pixels. The levels are stored as \c double in tiles of TileSize x TileSize pixels. A tile
+    is only built, when it is requested by getRegion() (which also builds the tiles of the lower levels it is calculated from).
+    Therefore a request only touches the tiles that intersect the requested region.
+
+    The tiles are kept in a cache of limited size (see setMaxMemory() ). When the cache exceeds this size after a request,
+    the least-recently used tiles are evicted (the tiles used by the current request are never evicted, so a single large request
+    may exceed the limit temporarily). All tiles are dropped, when setSource() is called with a different image or a different
+    \a key (e.g. the generation of a JKQTPDatastore column, see JKQTPDatastore::getColumnGeneration() ).
+
+    Missing tiles of one level can be built in parallel threads (see setParallelBuilding() ). All public methods are thread-safe.
+
+    \see JKQTPMathImageBase::setUseTileCache()
+ */
+class JKQTCOMMON_LIB_EXPORT JKQTPImageTilePyramid {
+    public:
+        /** \brief width and height of a tile in pixels */
+        static constexpr int TileSize=256;
+
+        /** \brief cache statistics, see getStatistics() */
+        struct Statistics {
+            /** \brief number of tiles, requested by getRegion() */
+            quint64 requestedTiles=0;
+            /** \brief number of requested tiles that were already in the cache */
+            quint64 hitTiles=0;
+            /** \brief number of tiles that were built (requested tiles and tiles of lower levels, needed to build them) */
+            quint64 builtTiles=0;
+            /** \brief number of tiles that were evicted from the cache, due to the memory limit */
+            quint64 evictedTiles=0;
+            /** \brief number of times, the cache was dropped, because the source image changed */
+            quint64 invalidations=0;
+            /** \brief number of tiles currently in the cache */
+            size_t cachedTiles=0;
+            /** \brief memory currently used by the cached tiles in bytes */
+            size_t memoryBytes=0;
+            /** \brief fraction of the requested tiles that were found in the cache */
+            inline double hitRate() const { return (requestedTiles>0)?(static_cast<double>(hitTiles)/static_cast<double>(requestedTiles)):0.0; }
+            /** \brief adds the counters of \a other to this object */
+            Statistics& operator+=(const Statistics& other);
+        };
+
+        JKQTPImageTilePyramid();
+        JKQTPImageTilePyramid(const JKQTPImageTilePyramid&)=delete;
+        JKQTPImageTilePyramid& operator=(const JKQTPImageTilePyramid&)=delete;
+
+        /** \brief sets the source image (\a Nx * \a Ny pixels of type \a datatype at \a data , row-major). If any of the parameters,
+         *         including \a key , differs from the previous call, all cached tiles are dropped.
+         *
+         *  \note The pyramid does not copy \a data , so it has to stay valid until the next call of setSource() or getRegion().
+         */
+        void setSource(const void* data, JKQTPMathImageDataType datatype, int Nx, int Ny, quint64 key);
+        /** \brief drops all cached tiles */
+        void clear();
+
+        /** \brief number of levels in the pyramid, i.e. the last level has a size of 1x1 pixels (0 if there is no source image) */
+        int getLevelCount() const;
+        /** \brief width of level \a level in pixels */
+        int getLevelWidth(int level) const;
+        /** \brief height of level \a level in pixels */
+        int getLevelHeight(int level) const;
+        /** \brief returns the level to use, if \a sourcePixelsPerOutputPixel pixels of the source image are mapped onto one output pixel
+         *         i.e. the coarsest level, whose pixels are still at most as large as one output pixel */
+        int levelForDownsampling(double sourcePixelsPerOutputPixel) const;
+
+        /** \brief copies the pixels <code>[x0..x1)x[y0..y1)</code> of level \a level (\c >=1 ) into \a out (row-major, width \c x1-x0 ),
+         *         building the missing tiles first
+         *
+         *  \return \c false, if the region is invalid
+         */
+        bool getRegion(int level, int x0, int y0, int x1, int y1, std::vector<double>& out);
+
+        /** \brief sets the maximum memory (in bytes) used by the cached tiles (default: 256 MiB) */
+        void setMaxMemory(size_t bytes);
+        /** \brief returns the maximum memory (in bytes) used by the cached tiles */
+        size_t getMaxMemory() const;
+        /** \brief if \c true (default), missing tiles of one level are built in parallel threads (see QThread::idealThreadCount() ) */
+        void setParallelBuilding(bool enabled);
+        /** \brief returns whether missing tiles are built in parallel threads */
+        bool getParallelBuilding() const;
+
+        /** \brief returns the cache statistics */
+        Statistics getStatistics() const;
+        /** \brief resets the counters in the cache statistics */
+        void resetStatistics();
+    protected:
+        /** \brief one tile of the pyramid */
+        struct Tile {
+            /** \brief TileSize*TileSize pixels (row-major), pixels outside the level are NaN */
+            std::vector<double> values;
+            /** \brief value of useCounter, when this tile was last used */
+            quint64 lastUse=0;
+        };
+        /** \brief key of the tile \a tx / \a ty in level \a level in tiles */
+        static inline quint64 tileKey(int level, int tx, int ty) { return (static_cast<quint64>(level)<<56)|(static_cast<quint64>(ty)<<28)|static_cast<quint64>(tx); }
+        /** \brief builds the tile \a tx / \a ty of level \a level (>=1), the tiles of level \c level-1 it is calculated from have to be in tiles */
+        std::vector<double> buildTile(int level, int tx, int ty) const;
+        /** \brief builds all missing tiles <code>[tx0..tx1]x[ty0..ty1]</code> of level \a level and the lower levels, returns the number of requested tiles found in the cache */
+        quint64 ensureTiles(int level, int tx0, int ty0, int tx1, int ty1);
+        /** \brief evicts least-recently used tiles, until at most m_maxMemory bytes are used (if \a keepCurrentRequest , tiles used in the current request are kept) */
+        void evictTiles(bool keepCurrentRequest=true);
+
+        /** \brief protects all members */
+        mutable std::mutex m_mutex;
+        /** \brief source image, i.e. level 0 */
+        const void* m_data;
+        /** \brief datatype of m_data */
+        JKQTPMathImageDataType m_datatype;
+        /** \brief width of m_data */
+        int m_Nx;
+        /** \brief height of m_data */
+        int m_Ny;
+        /** \brief key of the source, set by setSource() */
+        quint64 m_key;
+        /** \brief cached tiles, see tileKey() */
+        std::unordered_map<quint64, Tile> m_tiles;
+        /** \brief incremented for each getRegion(), used to determine the least-recently used tiles */
+        quint64 m_useCounter;
+        /** \brief maximum memory (in bytes) used by the cached tiles, see setMaxMemory() */
+        size_t m_maxMemory;
+        /** \brief build tiles in parallel threads, see setParallelBuilding() */
+        bool m_parallelBuilding;
+        /** \brief cache statistics */
+        Statistics m_statistics;
+};
+
+
 #endif // JKQTPBASICIMAGETOOLS_H
@@ -29,6 +29,10 @@
 #include <QReadLocker>
 #include <QWriteLocker>
 #include <mutex>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <limits>
 
 /** \brief template class that wraps any datatype and combines it with a mutex, exposes the lock()/unlock()
  *         interface, so access to the contained data can be synchronized
@@ -187,4 +191,100 @@ private:
 
 };
 
+/** \brief lock-free, wait-free queue (ring-buffer of fixed capacity) for exactly one producer thread and exactly one consumer thread
+ *  \ingroup jkqtptools_concurrency
+ *
+ *  The producer calls push(), the consumer calls pop() or consume(). Neither call ever blocks: if the queue is full,
+ *  push() accepts only as many items as fit (back pressure is handled by the caller), if it is empty,
+ *  pop() and consume() return 0. Items are always transferred in blocks, so the atomic indices are only
+ *  updated once per call and not once per item.
+ *
+ *  consume() gives the consumer direct access to the (at most two) contiguous segments of queued items, so
+ *  they can be processed without copying them into an intermediate buffer first.
+ *
+ *  \note All other functions (size(), empty(), capacity(), ...) may be called from any thread,
+ *        but size() and empty() only return a snapshot.
+ */
+template <class T>
+class JKQTPSPSCQueue {
+public:
+    /** \brief contained data type T */
+    typedef T value_type;
+    /** \brief constructs a queue that can store up to \a capacity items (at least 1) */
+    inline explicit JKQTPSPSCQueue(size_t capacity=1024):
+        m_data(std::max<size_t>(capacity, 1)), m_head(0), m_tail(0)
+    { }
+    Q_DISABLE_COPY(JKQTPSPSCQueue)
+
+    /** \brief maximum number of items in the queue */
+    inline size_t capacity() const { return m_data.size(); }
+    /** \brief number of items currently in the queue (snapshot) */
+    inline size_t size() const {
+        const size_t head=m_head.load(std::memory_order_acquire);
+        const size_t tail=m_tail.load(std::memory_order_acquire);
+        return tail-head;
+    }
+    /** \brief \c true, if the queue is currently empty (snapshot) */
+    inline bool empty() const { return size()==0; }
+
+    /** \brief <b>producer thread:</b> appends up to \a count items from \a data and returns the number of items that were appended.
+     *
+     *  Only multiples of \a chunk items are appended, i.e. a chunk (e.g. a multi-column frame) is either queued completely or not at all.
+     *  The call never blocks: if the queue is (nearly) full, less than \a count items are appended.
+     */
+    inline size_t push(const T* data, size_t count, size_t chunk=1) {
+        const size_t tail=m_tail.load(std::memory_order_relaxed);
+        const size_t head=m_head.load(std::memory_order_acquire);
+        size_t n=std::min(count, capacity()-(tail-head));
+        if (chunk>1) n=(n/chunk)*chunk;
+        if (n==0) return 0;
+        const size_t start=tail%capacity();
+        const size_t n1=std::min(n, capacity()-start);
+        std::copy(data, data+n1, m_data.begin()+start);
+        std::copy(data+n1, data+n, m_data.begin());
+        m_tail.store(tail+n, std::memory_order_release);
+        return n;
+    }
+    /** \brief <b>producer thread:</b> appends a single item, returns \c false if the queue is full */
+    inline bool push(const T& value) {
+        return push(&value, 1)==1;
+    }
+
+    /** \brief <b>consumer thread:</b> calls \c func(const T* data, size_t count) for the queued items (at most \a maxCount) and removes them from the queue.
+     *         Returns the number of removed items.
+     *
+     *  The items are handed to \a func in at most two contiguous segments (the ring-buffer may wrap around), without copying them.
+     *  The length of each segment is a multiple of \a chunk, if the producer only pushes multiples of \a chunk and capacity() is a multiple of \a chunk.
+     */
+    template <class F>
+    inline size_t consume(F func, size_t maxCount=std::numeric_limits<size_t>::max()) {
+        const size_t head=m_head.load(std::memory_order_relaxed);
+        const size_t tail=m_tail.load(std::memory_order_acquire);
+        const size_t n=std::min(tail-head, maxCount);
+        if (n==0) return 0;
+        const size_t start=head%capacity();
+        const size_t n1=std::min(n, capacity()-start);
+        func(m_data.data()+start, n1);
+        if (n>n1) func(m_data.data(), n-n1);
+        m_head.store(head+n, std::memory_order_release);
+        return n;
+    }
+    /** \brief <b>consumer thread:</b> copies up to \a maxCount items to \a out, removes them from the queue and returns their number */
+    inline size_t pop(T* out, size_t maxCount) {
+        return consume([&out](const T* data, size_t count) { out=std::copy(data, data+count, out); }, maxCount);
+    }
+    /** \brief <b>consumer thread:</b> removes all items from the queue and returns their number */
+    inline size_t clear() {
+        return consume([](const T*, size_t) {});
+    }
+
+private:
+    /** \brief storage of the ring-buffer */
+    std::vector<T> m_data;
+    /** \brief total number of items removed by the consumer (only written by the consumer), the next item is read from <tt>m_head%capacity()</tt> */
+    alignas(64) std::atomic<size_t> m_head;
+    /** \brief total number of items appended by the producer (only written by the producer), the next item is written to <tt>m_tail%capacity()</tt> */
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
 #endif // JKQTPCONCURRENCYTOOLS_H
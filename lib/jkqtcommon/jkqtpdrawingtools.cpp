@@ -18,7 +18,10 @@
 
 #include "jkqtcommon/jkqtpdrawingtools.h"
 #include "jkqtcommon/jkqtpenhancedpainter.h"
+#include "jkqtcommon/jkqtpcachingtools.h"
 #include <QDebug>
+#include <QPaintEngine>
+#include <atomic>
 
 const double JKQTPlotterDrawingTools::ABS_MIN_LINEWIDTH= 0.02;
 const QColor JKQTPlotterDrawingTools::CurrentColorPlaceholder = QColor::fromRgbF(0.1234,0.5678,0.9123,1.0);
@@ -309,6 +312,175 @@ void JKQTPPlotSymbol(QPaintDevice &paintDevice, double x, double y, JKQTPGraphSy
     JKQTPPlotSymbol(p, x, y, symbol, size, symbolLineWidth, color, fillColor, symbolFont);
 }
 
+namespace {
+    /** \brief number of sub-pixel positions (per axis) for which a symbol sprite is rendered */
+    constexpr int JKQTPSymbolSpriteSubPixelSteps=4;
+    /** \brief symbols larger than this (in device pixels) are always drawn as vector graphics */
+    constexpr double JKQTPSymbolSpriteMaxSize=256.0;
+
+    /** \brief everything that determines the looks of a pre-rendered symbol */
+    struct JKQTPSymbolSpriteKey {
+        JKQTPGraphSymbols symbol;
+        double size;
+        double lineWidth;
+        QRgb color;
+        QRgb fillColor;
+        bool antialiasing;
+        bool cosmetic;
+        Qt::PenJoinStyle joinStyle;
+        /** \brief scaling from painter coordinates to device pixels */
+        double scale;
+        int phaseX;
+        int phaseY;
+
+        inline bool operator==(const JKQTPSymbolSpriteKey& other) const {
+            return symbol==other.symbol && size==other.size && lineWidth==other.lineWidth && color==other.color && fillColor==other.fillColor
+                    && antialiasing==other.antialiasing && cosmetic==other.cosmetic && joinStyle==other.joinStyle && scale==other.scale
+                    && phaseX==other.phaseX && phaseY==other.phaseY;
+        }
+    };
+
+    /** \brief a pre-rendered symbol, the symbol center is at pixel (center,center) + the sub-pixel phase of the key */
+    struct JKQTPSymbolSprite {
+        QImage image;
+        int center;
+    };
+
+    std::atomic<bool> JKQTPSymbolSpriteCacheEnabled(true);
+}
+
+namespace std {
+    template <>
+    struct hash<JKQTPSymbolSpriteKey> {
+        inline std::size_t operator()(const JKQTPSymbolSpriteKey& k) const {
+            std::size_t seed=0;
+            jkqtp_hash_combine(seed, static_cast<int>(k.symbol));
+            jkqtp_hash_combine(seed, k.size);
+            jkqtp_hash_combine(seed, k.lineWidth);
+            jkqtp_hash_combine(seed, k.color);
+            jkqtp_hash_combine(seed, k.fillColor);
+            jkqtp_hash_combine(seed, static_cast<int>(k.antialiasing)+2*static_cast<int>(k.cosmetic)+4*static_cast<int>(k.joinStyle));
+            jkqtp_hash_combine(seed, k.scale);
+            jkqtp_hash_combine(seed, k.phaseX*JKQTPSymbolSpriteSubPixelSteps+k.phaseY);
+            return seed;
+        }
+    };
+}
+
+void JKQTPSetSymbolSpriteCacheEnabled(bool enabled)
+{
+    JKQTPSymbolSpriteCacheEnabled=enabled;
+}
+
+bool JKQTPIsSymbolSpriteCacheEnabled()
+{
+    return JKQTPSymbolSpriteCacheEnabled;
+}
+
+namespace {
+    /** \brief the state of a QPainter that is relevant for stamping symbol sprites */
+    struct JKQTPSymbolSpriteContext {
+        QTransform transform;
+        double devicePixelRatio;
+        /** \brief template for the sprite keys, only phaseX and phaseY have to be set per symbol */
+        JKQTPSymbolSpriteKey key;
+    };
+
+    /** \brief checks whether symbols may be drawn with sprites onto \a painter and initializes \a ctx */
+    bool JKQTPSymbolSpriteInitContext(QPainter &painter, JKQTPGraphSymbols symbol, double symbolSize, double symbolLineWidth, QColor color, QColor fillColor, JKQTPSymbolSpriteContext& ctx) {
+        if (!JKQTPSymbolSpriteCacheEnabled) return false;
+        if (symbol<=JKQTPNoSymbol || symbol>=JKQTPSymbolCount || symbol==JKQTPDot) return false;
+        const QPaintEngine* engine=painter.paintEngine();
+        if (!engine || engine->type()!=QPaintEngine::Raster || !painter.device()) return false;
+        ctx.transform=painter.combinedTransform();
+        if (ctx.transform.type()>QTransform::TxScale || ctx.transform.m11()<=0.0 || ctx.transform.m11()!=ctx.transform.m22()) return false;
+        ctx.devicePixelRatio=painter.device()->devicePixelRatioF();
+        const double scale=ctx.transform.m11()*ctx.devicePixelRatio;
+        if (symbolSize*scale>JKQTPSymbolSpriteMaxSize) return false;
+        const QPen pen=painter.pen();
+        ctx.key=JKQTPSymbolSpriteKey{symbol, symbolSize, symbolLineWidth, color.rgba(), fillColor.rgba(),
+                                     painter.testRenderHint(QPainter::Antialiasing), pen.isCosmetic(), pen.joinStyle(),
+                                     scale, 0, 0};
+        return true;
+    }
+
+    /** \brief returns the sprite for \a key from a global cache, renders it if necessary */
+    JKQTPSymbolSprite JKQTPSymbolSpriteGet(const JKQTPSymbolSpriteKey& key) {
+        static JKQTPDataCache<JKQTPSymbolSprite,JKQTPSymbolSpriteKey,JKQTPDataCacheThreadSafe> cache(
+            [](const JKQTPSymbolSpriteKey& key) {
+                const double lw=qMax(JKQTPlotterDrawingTools::ABS_MIN_LINEWIDTH, key.lineWidth);
+                const double halfExtent=(0.75*key.size+2.0*lw)*key.scale+2.0*lw+2.0;
+                JKQTPSymbolSprite sprite;
+                sprite.center=static_cast<int>(std::ceil(halfExtent));
+                sprite.image=QImage(2*sprite.center+2, 2*sprite.center+2, QImage::Format_ARGB32_Premultiplied);
+                sprite.image.fill(Qt::transparent);
+                {
+                    QPainter p(&sprite.image);
+                    p.setRenderHint(QPainter::Antialiasing, key.antialiasing);
+                    QPen pen=p.pen();
+                    pen.setCosmetic(key.cosmetic);
+                    pen.setJoinStyle(key.joinStyle);
+                    p.setPen(pen);
+                    p.scale(key.scale, key.scale);
+                    JKQTPPlotSymbolUncached(p, (sprite.center+static_cast<double>(key.phaseX)/JKQTPSymbolSpriteSubPixelSteps)/key.scale,
+                                               (sprite.center+static_cast<double>(key.phaseY)/JKQTPSymbolSpriteSubPixelSteps)/key.scale,
+                                               key.symbol, key.size, key.lineWidth, QColor::fromRgba(key.color), QColor::fromRgba(key.fillColor), QFont());
+                }
+                // one image pixel corresponds to one device pixel
+                sprite.image.setDevicePixelRatio(key.scale);
+                return sprite;
+            }, 2000);
+        return cache.get(key);
+    }
+
+    /** \brief draws the sprite for a symbol at (\a x , \a y ) onto \a painter , \a sprites caches the sprites for all sub-pixel phases */
+    inline void JKQTPSymbolSpriteStamp(QPainter &painter, const JKQTPSymbolSpriteContext& ctx, double x, double y, JKQTPSymbolSprite* sprites) {
+        const QTransform& t=ctx.transform;
+        // symbol center in device pixels, rounded to the sub-pixel grid
+        const double devX=(x*t.m11()+t.dx())*ctx.devicePixelRatio*JKQTPSymbolSpriteSubPixelSteps;
+        const double devY=(y*t.m22()+t.dy())*ctx.devicePixelRatio*JKQTPSymbolSpriteSubPixelSteps;
+        if (!JKQTPIsOKFloat(devX) || !JKQTPIsOKFloat(devY) || fabs(devX)>1e9 || fabs(devY)>1e9) return;
+        const int qX=static_cast<int>(std::floor(devX+0.5));
+        const int qY=static_cast<int>(std::floor(devY+0.5));
+        const int iX=static_cast<int>(std::floor(static_cast<double>(qX)/JKQTPSymbolSpriteSubPixelSteps));
+        const int iY=static_cast<int>(std::floor(static_cast<double>(qY)/JKQTPSymbolSpriteSubPixelSteps));
+        const int phaseX=qX-iX*JKQTPSymbolSpriteSubPixelSteps;
+        const int phaseY=qY-iY*JKQTPSymbolSpriteSubPixelSteps;
+
+        JKQTPSymbolSprite& sprite=sprites[phaseY*JKQTPSymbolSpriteSubPixelSteps+phaseX];
+        if (sprite.image.isNull()) {
+            JKQTPSymbolSpriteKey key=ctx.key;
+            key.phaseX=phaseX;
+            key.phaseY=phaseY;
+            sprite=JKQTPSymbolSpriteGet(key);
+        }
+        // map the top-left corner of the sprite back from device pixels to painter coordinates
+        const double topLeftX=(static_cast<double>(iX-sprite.center)/ctx.devicePixelRatio-t.dx())/t.m11();
+        const double topLeftY=(static_cast<double>(iY-sprite.center)/ctx.devicePixelRatio-t.dy())/t.m22();
+        painter.drawImage(QPointF(topLeftX, topLeftY), sprite.image);
+    }
+}
+
+bool JKQTPPlotSymbolSprite(QPainter &painter, double x, double y, JKQTPGraphSymbols symbol, double symbolSize, double symbolLineWidth, QColor color, QColor fillColor)
+{
+    JKQTPSymbolSpriteContext ctx;
+    if (!JKQTPSymbolSpriteInitContext(painter, symbol, symbolSize, symbolLineWidth, color, fillColor, ctx)) return false;
+    JKQTPSymbolSprite sprites[JKQTPSymbolSpriteSubPixelSteps*JKQTPSymbolSpriteSubPixelSteps];
+    JKQTPSymbolSpriteStamp(painter, ctx, x, y, sprites);
+    return true;
+}
+
+bool JKQTPPlotSymbolSprites(QPainter &painter, const QVector<QPointF> &points, JKQTPGraphSymbols symbol, double symbolSize, double symbolLineWidth, QColor color, QColor fillColor)
+{
+    JKQTPSymbolSpriteContext ctx;
+    if (!JKQTPSymbolSpriteInitContext(painter, symbol, symbolSize, symbolLineWidth, color, fillColor, ctx)) return false;
+    JKQTPSymbolSprite sprites[JKQTPSymbolSpriteSubPixelSteps*JKQTPSymbolSpriteSubPixelSteps];
+    for (const QPointF& p: points) {
+        JKQTPSymbolSpriteStamp(painter, ctx, p.x(), p.y(), sprites);
+    }
+    return true;
+}
+
 QString JKQTPLineDecoratorStyle2String(JKQTPLineDecoratorStyle pos)
 {
     switch(pos) {
@@ -557,6 +729,69 @@ QList<QPolygonF> JKQTPSimplifyPolyLines(const QList<QPolygonF> &lines_in, double
     return l;
 }
 
+JKQTPMinMaxPolyLineDecimator::JKQTPMinMaxPolyLineDecimator(QPolygonF *output, double binWidth, double binOffset):
+    m_output(output), m_binWidth((binWidth>0.0)?binWidth:1.0), m_binOffset(binOffset), m_bin(0), m_count(0),
+    m_iMin(0), m_iMax(0), m_lastX(0), m_direction(0), m_started(false)
+{
+
+}
+
+bool JKQTPMinMaxPolyLineDecimator::add(const QPointF &p)
+{
+    const double x=p.x();
+    if (m_started) {
+        const double dx=x-m_lastX;
+        if (dx>0.0) {
+            if (m_direction<0) return false;
+            m_direction=1;
+        } else if (dx<0.0) {
+            if (m_direction>0) return false;
+            m_direction=-1;
+        }
+    }
+    m_started=true;
+    m_lastX=x;
+    const double bin=floor((x-m_binOffset)/m_binWidth);
+    if (m_count>0 && bin!=m_bin) flush();
+    if (m_count==0) {
+        m_bin=bin;
+        m_first=m_last=m_min=m_max=p;
+        m_iMin=m_iMax=0;
+    } else {
+        m_last=p;
+        if (p.y()<m_min.y()) { m_min=p; m_iMin=m_count; }
+        if (p.y()>m_max.y()) { m_max=p; m_iMax=m_count; }
+    }
+    m_count++;
+    return true;
+}
+
+void JKQTPMinMaxPolyLineDecimator::flush()
+{
+    if (m_count<=0 || !m_output) {
+        m_count=0;
+        return;
+    }
+    QPolygonF& out=*m_output;
+    const int iLast=m_count-1;
+    out<<m_first;
+    // min and max in the order they were added, skipping points that equal first or last
+    const int i1=qMin(m_iMin, m_iMax);
+    const int i2=qMax(m_iMin, m_iMax);
+    const QPointF& p1=(m_iMin<=m_iMax)?m_min:m_max;
+    const QPointF& p2=(m_iMin<=m_iMax)?m_max:m_min;
+    if (i1>0 && i1<iLast) out<<p1;
+    if (i2>0 && i2<iLast && i2!=i1) out<<p2;
+    if (iLast>0) out<<m_last;
+    m_count=0;
+}
+
+void JKQTPMinMaxPolyLineDecimator::setOutput(QPolygonF *output)
+{
+    flush();
+    m_output=output;
+}
+
 
 JKQTPSynchronized<QVector<JKQTPCustomGraphSymbolFunctor> > JKQTPlotterDrawingTools::JKQTPCustomGraphSymbolStore=QVector<JKQTPCustomGraphSymbolFunctor>();
 
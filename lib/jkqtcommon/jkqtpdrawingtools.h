@@ -324,10 +324,85 @@ inline QDataStream& operator>>(QDataStream& str, JKQTPGraphSymbols& s) {
     \param fillColor color of the symbol filling
     \param symbolFont font used to draw symbols like \c JKQTPCharacterSymbol+QChar('@').unicode()
 
+    On pixel devices (QImage, QPixmap, QWidget), the standard symbols are not drawn as vector paths, but copied
+    from pre-rendered images, see JKQTPPlotSymbolSprite().
+
  */
 template <class TPainter>
 inline void JKQTPPlotSymbol(TPainter& painter, double x, double y, JKQTPGraphSymbols symbol, double size, double symbolLineWidth, QColor color, QColor fillColor, QFont symbolFont);
 
+/*! \brief plot the specified symbol at pixel position x,y as vector graphics (i.e. without using the pre-rendered images of JKQTPPlotSymbolSprite() ), <b>thread-safe</b>
+   \ingroup jkqtptools_drawing
+
+    The parameters are the same as for JKQTPPlotSymbol().
+ */
+template <class TPainter>
+inline void JKQTPPlotSymbolUncached(TPainter& painter, double x, double y, JKQTPGraphSymbols symbol, double size, double symbolLineWidth, QColor color, QColor fillColor, QFont symbolFont);
+
+/*! \brief plot the specified symbol at pixel position x,y by copying a pre-rendered image of the symbol ("sprite") onto \a painter , <b>thread-safe</b>
+   \ingroup jkqtptools_drawing
+
+    Drawing a symbol with JKQTPPlotSymbolUncached() requires building pens and paths and stroking them, which is expensive for
+    graphs with many symbols. This function keeps a (global, LRU) cache of images of the symbols, keyed on the symbol type, size, line width, colors,
+    antialiasing and the scaling of the output. Each symbol is rendered in 4x4 sub-pixel positions, so the position error is at most 1/8 pixel.
+
+    This is only possible for the standard symbols (i.e. not for character or custom symbols), on pixel devices (raster paint engine)
+    and if \a painter only scales and translates. Otherwise (e.g. for PDF or SVG output) nothing is drawn and \c false is returned.
+
+    The parameters are the same as for JKQTPPlotSymbol().
+
+    \see JKQTPSetSymbolSpriteCacheEnabled()
+ */
+JKQTCOMMON_LIB_EXPORT bool JKQTPPlotSymbolSprite(QPainter& painter, double x, double y, JKQTPGraphSymbols symbol, double size, double symbolLineWidth, QColor color, QColor fillColor);
+
+/*! \brief plot the specified symbol at all pixel positions in \a points by copying pre-rendered images of the symbol, <b>thread-safe</b>
+   \ingroup jkqtptools_drawing
+
+    This is the same as calling JKQTPPlotSymbolSprite() for every point, but the sprites are looked up in the cache only once.
+    Returns \c false and draws nothing, if sprites cannot be used for \a painter or \a symbol .
+
+    \see JKQTPPlotSymbols()
+ */
+JKQTCOMMON_LIB_EXPORT bool JKQTPPlotSymbolSprites(QPainter& painter, const QVector<QPointF>& points, JKQTPGraphSymbols symbol, double size, double symbolLineWidth, QColor color, QColor fillColor);
+
+/*! \brief plot the specified symbol at all pixel positions in \a points , <b>thread-safe</b>
+   \ingroup jkqtptools_drawing
+
+    This draws the same as calling JKQTPPlotSymbol() for every point, but is faster for many symbols with the same looks,
+    as the setup is done only once (see JKQTPPlotSymbolSprites()).
+
+    \param painter the <a href="http://doc.qt.io/qt-5/qpainter.html">QPainter</a> to draw to
+    \param points center positions of the symbols
+    \param symbol type of the symbol to plot, see JKQTPGraphSymbols
+    \param size size (width/height) of the symbol around (\a x , \a y)
+    \param symbolLineWidth width of the lines used to draw the symbol
+    \param color color of the symbol lines
+    \param fillColor color of the symbol filling
+    \param symbolFont font used to draw symbols like \c JKQTPCharacterSymbol+QChar('@').unicode()
+ */
+template <class TPainter>
+inline void JKQTPPlotSymbols(TPainter& painter, const QVector<QPointF>& points, JKQTPGraphSymbols symbol, double size, double symbolLineWidth, QColor color, QColor fillColor, QFont symbolFont) {
+    if (symbol==JKQTPNoSymbol || points.isEmpty()) return;
+    if (JKQTPPlotSymbolSprites(painter, points, symbol, size, symbolLineWidth, color, fillColor)) return;
+    for (const QPointF& p: points) {
+        JKQTPPlotSymbolUncached(painter, p.x(), p.y(), symbol, size, symbolLineWidth, color, fillColor, symbolFont);
+    }
+}
+
+/*! \brief activates/deactivates the use of pre-rendered symbol images by JKQTPPlotSymbol() (default: activated)
+   \ingroup jkqtptools_drawing
+
+    \see JKQTPPlotSymbolSprite()
+ */
+JKQTCOMMON_LIB_EXPORT void JKQTPSetSymbolSpriteCacheEnabled(bool enabled);
+
+/*! \brief returns whether JKQTPPlotSymbol() uses pre-rendered symbol images
+   \ingroup jkqtptools_drawing
+
+    \see JKQTPSetSymbolSpriteCacheEnabled(), JKQTPPlotSymbolSprite()
+ */
+JKQTCOMMON_LIB_EXPORT bool JKQTPIsSymbolSpriteCacheEnabled();
+
 /*! \brief plot the specified symbol at pixel position x,y, <b>thread-safe</b>
    \ingroup jkqtptools_drawing
 
@@ -608,6 +683,63 @@ JKQTCOMMON_LIB_EXPORT QList<QPolygonF> JKQTPSimplifyPolyLines(const QList<QPolyg
 */
 JKQTCOMMON_LIB_EXPORT QPolygonF JKQTPSimplifyPolyLines(const QPolygonF& lines_in, double maxDeltaXY=1.0);
 
+/*! \brief builds a min/max-decimated poly-line from a stream of points with monotonic x-coordinates (e.g. time-series)
+    \ingroup jkqtptools_drawing
+
+    The points are grouped into bins of width \a binWidth , starting at \a binOffset , along the x-axis (typically one pixel column of the
+    output device, i.e. for a painter with a device transform \c T : \c binWidth=1/T.m11() and \c binOffset=-T.dx()/T.m11() ). For each bin at most
+    four points are written to the output: the first point, the points with the minimum and the maximum y-coordinate (in the order of their
+    occurence) and the last point. Drawing the resulting poly-line gives the same image as drawing all points, as the vertical extent
+    of the line in every bin and the connections between neighboring bins are retained. So the cost of drawing scales with the plot width,
+    not with the number of data points.
+
+    Usage:
+    \code
+        QPolygonF line;
+        JKQTPMinMaxPolyLineDecimator decimator(&line);
+        for (const QPointF& p: points) {
+            if (!decimator.add(p)) {
+                // x is not monotonic, use a different strategy
+            }
+        }
+        decimator.flush();
+    \endcode
+
+    \note the x-coordinates may either increase or decrease monotonically (e.g. for inverted axes). If add() detects a change
+          of direction, it returns \c false and the output is not valid anymore.
+*/
+class JKQTCOMMON_LIB_EXPORT JKQTPMinMaxPolyLineDecimator {
+    public:
+        /** \brief constructs a decimator that writes into \a output, using bins of width \a binWidth , the bin boundaries are at \c binOffset+k*binWidth */
+        explicit JKQTPMinMaxPolyLineDecimator(QPolygonF* output, double binWidth=1.0, double binOffset=0.0);
+        /** \brief adds a point, returns \c false if the x-coordinates are not monotonic */
+        bool add(const QPointF& p);
+        /** \brief writes the points of the current bin to the output */
+        void flush();
+        /** \brief flushes the current bin and writes all following points to \a output, e.g. to start a new poly-line */
+        void setOutput(QPolygonF* output);
+    private:
+        QPolygonF* m_output;
+        double m_binWidth;
+        double m_binOffset;
+        /** \brief index of the current bin, only valid if m_count>0 */
+        double m_bin;
+        /** \brief number of points in the current bin */
+        int m_count;
+        QPointF m_first;
+        QPointF m_last;
+        QPointF m_min;
+        QPointF m_max;
+        int m_iMin;
+        int m_iMax;
+        /** \brief x-coordinate of the last point added */
+        double m_lastX;
+        /** \brief direction of the x-coordinates (+1: increasing, -1: decreasing, 0: unknown yet) */
+        int m_direction;
+        /** \brief \c true, if at least one point has been added */
+        bool m_started;
+};
+
 /*! \brief draw a tooltip, using the current brush and pen of the provided painter
     \ingroup jkqtptools_drawing
 
@@ -659,6 +791,13 @@ struct JKQTPSymbolPathsInternnal {
 
 template <class TPainter>
 inline void JKQTPPlotSymbol(TPainter& painter, double x, double y, JKQTPGraphSymbols symbol, double symbolSize, double symbolLineWidth, QColor color, QColor fillColor, QFont symbolFont) {
+    if (symbol==JKQTPNoSymbol) return;
+    if (JKQTPPlotSymbolSprite(painter, x, y, symbol, symbolSize, symbolLineWidth, color, fillColor)) return;
+    JKQTPPlotSymbolUncached(painter, x, y, symbol, symbolSize, symbolLineWidth, color, fillColor, symbolFont);
+}
+
+template <class TPainter>
+inline void JKQTPPlotSymbolUncached(TPainter& painter, double x, double y, JKQTPGraphSymbols symbol, double symbolSize, double symbolLineWidth, QColor color, QColor fillColor, QFont symbolFont) {
     if (symbol==JKQTPNoSymbol) return;
     painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
     QPen p=painter.pen();
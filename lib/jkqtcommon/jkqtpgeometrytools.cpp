@@ -20,6 +20,10 @@
 #include <QDebug>
 #include <algorithm>
 #include <QTransform>
+#include <QThread>
+#include <thread>
+#include <unordered_map>
+#include <array>
 
 
 
@@ -151,6 +155,112 @@ QVector<QPolygonF> JKQTPUnifyLinesToPolygons(const QVector<QLineF> &lines, doubl
     return res.toVector();
 }
 
+QVector<QPolygonF> JKQTPMarchingSquaresContour(const double *data, int Nx, int Ny, double level)
+{
+    QVector<QPolygonF> res;
+    if (!data || Nx<2 || Ny<2) return res;
+
+    // edge indices: the horizontal edge (x,y)-(x+1,y) has index y*(Nx-1)+x, the vertical edge (x,y)-(x,y+1) has index nHEdges+y*Nx+x
+    const qint64 nHEdges=static_cast<qint64>(Nx-1)*static_cast<qint64>(Ny);
+    auto value=[&](int x, int y) { return data[static_cast<size_t>(y)*static_cast<size_t>(Nx)+static_cast<size_t>(x)]; };
+    auto hEdge=[&](int x, int y) { return static_cast<qint64>(y)*static_cast<qint64>(Nx-1)+x; };
+    auto vEdge=[&](int x, int y) { return nHEdges+static_cast<qint64>(y)*static_cast<qint64>(Nx)+x; };
+    auto edgePoint=[&](qint64 e) {
+        int x0, y0, x1, y1;
+        if (e<nHEdges) {
+            y0=y1=static_cast<int>(e/(Nx-1));
+            x0=static_cast<int>(e%(Nx-1));
+            x1=x0+1;
+        } else {
+            e-=nHEdges;
+            y0=static_cast<int>(e/Nx);
+            x0=x1=static_cast<int>(e%Nx);
+            y1=y0+1;
+        }
+        const double v0=value(x0, y0);
+        const double t=(level-v0)/(value(x1, y1)-v0);
+        return QPointF(x0+t*(x1-x0), y0+t*(y1-y0));
+    };
+
+    // 1. find the line segments in all cells. Each edge is shared by at most two cells and is crossed by
+    //    at most one segment per cell, so each crossing point connects at most two segments.
+    std::vector<std::array<qint64,2> > segments;
+    std::unordered_map<qint64, std::array<int,2> > edgeSegments;
+    auto addSegment=[&](qint64 e0, qint64 e1) {
+        const int s=static_cast<int>(segments.size());
+        segments.push_back({e0, e1});
+        for (const qint64 e: {e0, e1}) {
+            auto it=edgeSegments.find(e);
+            if (it==edgeSegments.end()) edgeSegments.emplace(e, std::array<int,2>{s, -1});
+            else it->second[1]=s;
+        }
+    };
+    for (int y=0; y<Ny-1; y++) {
+        for (int x=0; x<Nx-1; x++) {
+            const double v00=value(x, y);
+            const double v10=value(x+1, y);
+            const double v11=value(x+1, y+1);
+            const double v01=value(x, y+1);
+            const int c=((v00>=level)?1:0) | ((v10>=level)?2:0) | ((v11>=level)?4:0) | ((v01>=level)?8:0);
+            if (c==0 || c==15) continue;
+            if (!std::isfinite(v00) || !std::isfinite(v10) || !std::isfinite(v11) || !std::isfinite(v01)) continue;
+            const qint64 bottom=hEdge(x, y);
+            const qint64 right=vEdge(x+1, y);
+            const qint64 top=hEdge(x, y+1);
+            const qint64 left=vEdge(x, y);
+            switch(c) {
+                case 1: case 14: addSegment(left, bottom); break;
+                case 2: case 13: addSegment(bottom, right); break;
+                case 4: case 11: addSegment(right, top); break;
+                case 8: case 7: addSegment(top, left); break;
+                case 3: case 12: addSegment(left, right); break;
+                case 6: case 9: addSegment(bottom, top); break;
+                case 5: case 10: {
+                        // saddle point: the center decides, which pair of opposite corners is connected
+                        const bool centerAbove=(v00+v10+v11+v01)/4.0>=level;
+                        if (centerAbove==(c==5)) {
+                            addSegment(bottom, right);
+                            addSegment(top, left);
+                        } else {
+                            addSegment(left, bottom);
+                            addSegment(right, top);
+                        }
+                    } break;
+            }
+        }
+    }
+
+    // 2. join the segments to polylines
+    std::vector<bool> used(segments.size(), false);
+    auto walk=[&](int s, qint64 e) {
+        QPolygonF poly;
+        poly<<edgePoint(e);
+        while (s>=0 && !used[s]) {
+            used[s]=true;
+            e=(segments[s][0]==e)?segments[s][1]:segments[s][0];
+            poly<<edgePoint(e);
+            const std::array<int,2>& es=edgeSegments.at(e);
+            s=(es[0]==s)?es[1]:es[0];
+        }
+        res<<poly;
+    };
+    // open lines start and end at edges with only one segment (at the border of the grid or next to non-finite values)
+    for (size_t s=0; s<segments.size(); s++) {
+        if (used[s]) continue;
+        for (const qint64 e: segments[s]) {
+            if (edgeSegments.at(e)[1]<0) {
+                walk(static_cast<int>(s), e);
+                break;
+            }
+        }
+    }
+    // all remaining segments belong to closed lines
+    for (size_t s=0; s<segments.size(); s++) {
+        if (!used[s]) walk(static_cast<int>(s), segments[s][0]);
+    }
+    return res;
+}
+
 QPolygonF JKQTPCleanPolygon(const QPolygonF &poly, double distanceThreshold)
 {
     if (poly.size()<=2) return poly;
@@ -236,9 +346,9 @@ JKQTPAdaptiveFunctionGraphEvaluator::JKQTPAdaptiveFunctionGraphEvaluator(const s
     maxRefinementDegree(maxRefinementDegree_),
     slopeTolerance(slopeTolerance_),
     minPixelPerSample(minPixelPerSample_),
-    rd(), gen{rd()}, dist(0,1)
+    threads(1),
+    alignedGrid(false)
 {
-    gen.seed(12345);
 }
 
 JKQTPAdaptiveFunctionGraphEvaluator::JKQTPAdaptiveFunctionGraphEvaluator(const std::function<QPointF (double)> &fxy_, unsigned int minSamples_, unsigned int maxRefinementDegree_, double slopeTolerance_, double minPixelPerSample_):
@@ -247,60 +357,171 @@ JKQTPAdaptiveFunctionGraphEvaluator::JKQTPAdaptiveFunctionGraphEvaluator(const s
     maxRefinementDegree(maxRefinementDegree_),
     slopeTolerance(slopeTolerance_),
     minPixelPerSample(minPixelPerSample_),
-    rd(), gen{rd()}, dist(0,1)
+    threads(1),
+    alignedGrid(false)
 {
-    gen.seed(12345);
 }
 
 QVector<QPointF> JKQTPAdaptiveFunctionGraphEvaluator::evaluate(double tmin, double tmax) const
 {
-    InternalList intData;
-
-    double delta_t0=(tmax-tmin)/static_cast<double>(minSamples);
-
-    intData.push_front(std::pair<double, QPointF>(tmin, fxy(tmin)));
-    InternalList::iterator a=intData.begin();
-    //qDebug()<<"**************************************************";
-    for (double t=tmin+delta_t0; t<tmax; t=t+delta_t0) {
-        const double treal=t;
-        intData.insert_after(a, std::pair<double, QPointF>(treal, fxy(treal)));
-        InternalList::iterator b=a; ++b;
-        //qDebug()<<"t="<<t<<", dist(a,b)="<<std::distance(a,b);
-        refine(intData, a, b, 0);
-        //qDebug()<<"       after refine: dist(a,b)="<<std::distance(a,b);
-        a=b;
+    // a sample of the function, sorted by the index of the interval of the initial grid it belongs to (segment)
+    // and its relative position within that interval (position)
+    struct Sample {
+        double t;
+        QPointF p;
+        size_t segment;
+        double position;
+    };
+    // an interval [a,b] that might be bisected, node is its index in the (binary) refinement tree of segment,
+    // where the root (i.e. the interval of the initial grid) has index 1 and the children of node n have indices 2n and 2n+1.
+    // seed identifies the interval of the initial grid for jitter()
+    struct Interval {
+        size_t a;
+        size_t b;
+        size_t segment;
+        uint64_t node;
+        uint64_t seed;
+    };
+
+    // evaluate the initial grid
+    std::vector<double> t;
+    std::vector<uint64_t> seeds;
+    std::vector<QPointF> p;
+    const double delta_t0=(tmax-tmin)/static_cast<double>(minSamples);
+    const double gridStep=(alignedGrid && delta_t0>0.0 && JKQTPIsOKFloat(delta_t0))?pow(2.0, floor(log2(delta_t0))):0.0;
+    if (gridStep>0.0 && fabs(tmin)/gridStep<4.0e15 && fabs(tmax)/gridStep<4.0e15) {
+        // grid points at integer multiples of gridStep, the seeds are the (global) indices of the grid intervals,
+        // so overlapping ranges share their grid and refinement points
+        const int64_t kmin=static_cast<int64_t>(ceil(tmin/gridStep));
+        t.push_back(tmin);
+        seeds.push_back(static_cast<uint64_t>(static_cast<int64_t>(floor(tmin/gridStep))));
+        for (int64_t k=kmin; static_cast<double>(k)*gridStep<tmax; k++) {
+            const double tt=static_cast<double>(k)*gridStep;
+            if (tt>tmin) {
+                t.push_back(tt);
+                seeds.push_back(static_cast<uint64_t>(k));
+            }
+        }
+    } else {
+        t.push_back(tmin);
+        for (double tt=tmin+delta_t0; tt<tmax; tt=tt+delta_t0) {
+            t.push_back(tt);
+        }
+        for (size_t i=0; i<t.size(); i++) seeds.push_back(i);
     }
-    intData.insert_after(a, std::pair<double, QPointF>(tmax, fxy(tmax)));
-    auto b=a; b++;
-    refine(intData, a, b, 0);
-    // copy data to output data structure
+    t.push_back(tmax);
+    evaluateBatch(t, p);
+
+    std::vector<Sample> samples;
+    std::vector<Interval> intervals, nextIntervals;
+    samples.reserve(t.size()*2);
+    intervals.reserve(t.size());
+    for (size_t i=0; i<t.size(); i++) {
+        samples.push_back(Sample{t[i], p[i], i, 0.0});
+        if (i+1<t.size()) intervals.push_back(Interval{i, i+1, i, 1, seeds[i]});
+    }
+
+    // bisect the intervals level by level, each level is evaluated as one batch
+    double nodePosition=0.5;
+    for (unsigned int degree=0; degree<maxRefinementDegree && intervals.size()>0; degree++) {
+        t.resize(intervals.size());
+        for (size_t i=0; i<intervals.size(); i++) {
+            const double ta=samples[intervals[i].a].t;
+            const double tb=samples[intervals[i].b].t;
+            t[i]=ta+(tb-ta)*(0.5 +(jitter(intervals[i].seed, intervals[i].node)-0.5)/5.0);
+        }
+        evaluateBatch(t, p);
+
+        nextIntervals.clear();
+        const uint64_t firstNodeOfLevel=uint64_t(1)<<degree;
+        for (size_t i=0; i<intervals.size(); i++) {
+            const Interval& iv=intervals[i];
+            const QPointF pa=samples[iv.a].p;
+            const QPointF pb=samples[iv.b].p;
+            const QPointF pmid=p[i];
+            const double delta=QLineF(pa, pb).length();
+
+            const double slope_a_mid=(pmid.y()-pa.y())/(pmid.x()-pa.x());
+            const double slope_mid_b=(pb.y()-pmid.y())/(pb.x()-pmid.x());
+            if (fabs(slope_mid_b-slope_a_mid)>slopeTolerance || delta>minPixelPerSample) {
+                // in-order position of the midpoint within its segment: (2k+1)/2^(degree+1) for the k-th node of this level
+                const double position=static_cast<double>(2*(iv.node-firstNodeOfLevel)+1)*nodePosition;
+                samples.push_back(Sample{t[i], pmid, iv.segment, position});
+                const size_t mid=samples.size()-1;
+                nextIntervals.push_back(Interval{iv.a, mid, iv.segment, 2*iv.node, iv.seed});
+                nextIntervals.push_back(Interval{mid, iv.b, iv.segment, 2*iv.node+1, iv.seed});
+            }
+        }
+        intervals.swap(nextIntervals);
+        nodePosition=nodePosition/2.0;
+    }
+
+    // sort samples into the order along the curve
+    std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+        return (a.segment<b.segment) || (a.segment==b.segment && a.position<b.position);
+    });
     QVector<QPointF> result;
-    result.reserve(std::distance(intData.begin(), intData.end()));
-    for (const auto& d: intData) {
-        result.push_back(d.second);
+    result.reserve(static_cast<int>(samples.size()));
+    for (const auto& d: samples) {
+        result.push_back(d.p);
     }
     return result;
 }
 
-void JKQTPAdaptiveFunctionGraphEvaluator::refine(JKQTPAdaptiveFunctionGraphEvaluator::InternalList &intData, JKQTPAdaptiveFunctionGraphEvaluator::InternalList::iterator a, JKQTPAdaptiveFunctionGraphEvaluator::InternalList::iterator b, unsigned int degree) const
+void JKQTPAdaptiveFunctionGraphEvaluator::setThreads(int threads_)
+{
+    threads=threads_;
+}
+
+int JKQTPAdaptiveFunctionGraphEvaluator::getThreads() const
+{
+    return threads;
+}
+
+void JKQTPAdaptiveFunctionGraphEvaluator::setAlignedGrid(bool aligned)
 {
-    if (degree>=maxRefinementDegree) return;
-    const double ta=a->first;
-    const double tb=b->first;
-    const double tmid=ta+(tb-ta)*(0.5 +(dist(gen)-0.5)/5.0);
-    const QPointF pa=a->second;
-    const QPointF pb=b->second;
-    const QPointF pmid(fxy(tmid));
-    const double delta=QLineF(pa, pb).length();
-
-    const double slope_a_mid=(pmid.y()-pa.y())/(pmid.x()-pa.x());
-    const double slope_mid_b=(pb.y()-pmid.y())/(pb.x()-pmid.x());
-    if (fabs(slope_mid_b-slope_a_mid)>slopeTolerance || delta>minPixelPerSample) {
-        intData.insert_after(a, std::pair<double, QPointF>(tmid, pmid));
-        InternalList::iterator abmid=a; ++abmid;
-        refine(intData, a, abmid, degree+1);
-        refine(intData, abmid, b, degree+1);
+    alignedGrid=aligned;
+}
+
+bool JKQTPAdaptiveFunctionGraphEvaluator::isAlignedGrid() const
+{
+    return alignedGrid;
+}
+
+void JKQTPAdaptiveFunctionGraphEvaluator::evaluateBatch(const std::vector<double> &t, std::vector<QPointF> &p) const
+{
+    p.resize(t.size());
+    const size_t workerCount=std::min<size_t>(static_cast<size_t>(std::max(1, (threads<=0)?QThread::idealThreadCount():threads)), t.size());
+    if (workerCount<=1) {
+        for (size_t i=0; i<t.size(); i++) {
+            p[i]=fxy(t[i]);
+        }
+        return;
     }
+    auto evalRange=[&](size_t w) {
+        const size_t first=t.size()*w/workerCount;
+        const size_t last=t.size()*(w+1)/workerCount;
+        for (size_t i=first; i<last; i++) {
+            p[i]=fxy(t[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount-1);
+    for (size_t w=1; w<workerCount; w++) {
+        workers.emplace_back(evalRange, w);
+    }
+    evalRange(0);
+    for (auto& w: workers) w.join();
+}
+
+double JKQTPAdaptiveFunctionGraphEvaluator::jitter(uint64_t segment, uint64_t node)
+{
+    // splitmix64 hash of (segment, node)
+    uint64_t z=(segment*0x9E3779B97F4A7C15ULL)^(node+12345);
+    z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z=(z^(z>>27))*0x94D049BB133111EBULL;
+    z=z^(z>>31);
+    return static_cast<double>(z>>11)*(1.0/9007199254740992.0);
 }
 
 QVector<QPointF> JKQTPSplitLineIntoPoints(const QLineF &line, std::function<QPointF (QPointF)> fTransform)
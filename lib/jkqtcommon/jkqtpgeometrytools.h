@@ -31,6 +31,7 @@
 #include <QVector>
 #include <vector>
 #include <forward_list>
+#include <cstdint>
 #include <cmath>
 #include <utility>
 #include <random>
@@ -45,7 +46,18 @@
 JKQTCOMMON_LIB_EXPORT QPolygonF jkqtpRotateRect(QRectF r, double angle);
 
 
-/** \brief adaptive drawing of a function graph, specified by two function \f$ f_x(t) \f$ and \f$ f_y(t) \f$ evaluated over a parameter range \f$ t\in\left[t_\text{min}..t_\text{max}\right] \f$ */
+/** \brief adaptive drawing of a function graph, specified by two function \f$ f_x(t) \f$ and \f$ f_y(t) \f$ evaluated over a parameter range \f$ t\in\left[t_\text{min}..t_\text{max}\right] \f$
+ *
+ *  The function is first sampled on a grid of \c minSamples intervals. Then every interval is bisected recursively
+ *  (up to \c maxRefinementDegree times), as long as the slopes left and right of the midpoint differ by more than
+ *  \c slopeTolerance or the interval is longer than \c minPixelPerSample. The midpoints are slightly jittered,
+ *  to avoid aliasing with periodic functions. The jitter only depends on the position of an interval in the
+ *  refinement tree, so evaluating the same function twice yields the same points.
+ *
+ *  The algorithm proceeds level by level, i.e. the initial grid and all midpoints of one refinement level are
+ *  evaluated as one batch. Using setThreads() these batches can be distributed over several threads,
+ *  which speeds up plotting expensive functions. The result does not depend on the number of threads.
+ */
 class JKQTCOMMON_LIB_EXPORT JKQTPAdaptiveFunctionGraphEvaluator {
 public:
 
@@ -82,10 +94,31 @@ public:
      *  \param tmax upper parameter range limit \f$ t_\text{max} \f$
      */
     QVector<QPointF> evaluate(double tmin=0.0, double tmax=1.0) const;
+
+    /** \brief sets the number of threads that evaluate the function (default: \c 1, i.e. evaluate in the calling thread,
+     *         \c 0 : use QThread::idealThreadCount() threads)
+     *
+     *  \warning If more than one thread is used, the function(s) given in the constructor have to be thread-safe!
+     */
+    void setThreads(int threads);
+    /** \brief returns the number of threads that evaluate the function \see setThreads() */
+    int getThreads() const;
+    /** \brief if set \c true (default: \c false ), the points of the initial grid are placed at integer multiples
+     *         of a power-of-two step (plus the range limits \a tmin and \a tmax ), instead of equidistantly between \a tmin and \a tmax
+     *
+     *  The step is the largest power of two that is not larger than \f$ (t_\text{max}-t_\text{min})/\text{minSamples} \f$ ,
+     *  so the initial grid contains between minSamples and 2*minSamples points. As the jitter of the refinement
+     *  points is derived from the (global) index of the grid interval, evaluating overlapping ranges (e.g. when panning a plot)
+     *  samples the function at identical positions in the overlap. This allows to cache function values between evaluations.
+     */
+    void setAlignedGrid(bool aligned);
+    /** \brief returns whether the initial grid is aligned to multiples of a power-of-two step \see setAlignedGrid() */
+    bool isAlignedGrid() const;
 protected:
-    typedef std::forward_list<std::pair<double, QPointF>> InternalList;
-    /** \brief refine (if necessary) the function graph between the two points \a a and \a b, working on the given list of data \a data */
-    void refine(InternalList& data, InternalList::iterator a, InternalList::iterator b, unsigned int degree) const;
+    /** \brief evaluates fxy for all parameters in \a t and stores the results in \a p, using up to \c threads threads */
+    void evaluateBatch(const std::vector<double>& t, std::vector<QPointF>& p) const;
+    /** \brief returns a pseudo-random number in the range [0..1) for the node \a node of the refinement tree of the \a segment -th interval of the initial grid */
+    static double jitter(uint64_t segment, uint64_t node);
 
     /** \brief function \f$ f_x(t) \f$ */
     std::function<double(double)> fx;
@@ -106,12 +139,10 @@ protected:
     double slopeTolerance;
     /** \brief create one sample at least every \a minPixelPerSample pixels */
     double minPixelPerSample;
-    /** \brief random number generation: device */
-    mutable std::random_device rd; // random number generators:
-    /** \brief random number generation: egenrator */
-    mutable std::mt19937 gen;
-    /** \brief random number generation: distribution */
-    mutable std::uniform_real_distribution<double> dist;
+    /** \brief number of threads that evaluate the function \see setThreads() */
+    int threads;
+    /** \brief align the initial grid to multiples of a power-of-two step \see setAlignedGrid() */
+    bool alignedGrid;
 
 };
 
@@ -225,6 +256,23 @@ JKQTCOMMON_LIB_EXPORT QPolygonF JKQTPCleanPolygon(const QPolygonF& poly, double
  */
 JKQTCOMMON_LIB_EXPORT QVector<QPolygonF> JKQTPUnifyLinesToPolygons(const QVector<QLineF>& lines, double distanceThreshold=0.3, int searchMaxSurroundingElements=10);
 
+/** \brief extracts the contour lines (iso-lines) at the value \a level from the 2D grid \a data (row-major, \a Nx columns and \a Ny rows),
+ *         using the marching squares algorithm
+ *  \ingroup jkqtptools_drawing
+ *
+ *  Each cell of the grid contributes up to two line segments, which connect the (linearly interpolated) crossing points of the
+ *  contour line with the edges of the cell. Neighbouring cells share their edges, so the segments are joined to polylines via the index
+ *  of these edges, i.e. in linear time and without the distance-based search of JKQTPUnifyLinesToPolygons().
+ *  Ambiguous cells (saddle points) are resolved using the average of their four corners. Cells with non-finite corners are skipped.
+ *
+ *  \param data the grid values
+ *  \param Nx number of columns in \a data
+ *  \param Ny number of rows in \a data
+ *  \param level the value of the contour line
+ *  \return the contour lines as polylines in grid coordinates (i.e. x in 0..Nx-1, y in 0..Ny-1). Closed contour lines end with their first point.
+ */
+JKQTCOMMON_LIB_EXPORT QVector<QPolygonF> JKQTPMarchingSquaresContour(const double* data, int Nx, int Ny, double level);
+
 /** \brief clip a QLineF \a line to the rectangle defines by \a clippingRect
  *  \ingroup jkqtptools_drawing
  *
@@ -21,6 +21,7 @@
 
 #include "jkqttools.h"
 
+#include <cstring>
 #include <QList>
 #include <QApplication>
 #include <QLocale>
@@ -91,3 +92,83 @@ quint16 jkqtp_checksum(const void *data, size_t len)
     return qChecksum(static_cast<const char*>(data), len);
 #endif
 }
+
+namespace {
+    const quint64 JKQTPHash64Prime1=0x9E3779B185EBCA87ULL;
+    const quint64 JKQTPHash64Prime2=0xC2B2AE3D27D4EB4FULL;
+    const quint64 JKQTPHash64Prime3=0x165667B19E3779F9ULL;
+    const quint64 JKQTPHash64Prime4=0x85EBCA77C2B2AE63ULL;
+    const quint64 JKQTPHash64Prime5=0x27D4EB2F165667C5ULL;
+
+    inline quint64 jkqtp_hash64_rotl(quint64 x, int r) {
+        return (x<<r) | (x>>(64-r));
+    }
+    inline quint64 jkqtp_hash64_read64(const uint8_t* p) {
+        quint64 v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    inline quint32 jkqtp_hash64_read32(const uint8_t* p) {
+        quint32 v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    inline quint64 jkqtp_hash64_round(quint64 acc, quint64 input) {
+        acc+=input*JKQTPHash64Prime2;
+        acc=jkqtp_hash64_rotl(acc, 31);
+        return acc*JKQTPHash64Prime1;
+    }
+    inline quint64 jkqtp_hash64_merge(quint64 acc, quint64 val) {
+        acc^=jkqtp_hash64_round(0, val);
+        return acc*JKQTPHash64Prime1+JKQTPHash64Prime4;
+    }
+}
+
+quint64 jkqtp_hash64(const void *data, size_t len, quint64 seed)
+{
+    const uint8_t* p=static_cast<const uint8_t*>(data);
+    const uint8_t* const end=p+len;
+    quint64 h;
+    if (len>=32) {
+        quint64 v1=seed+JKQTPHash64Prime1+JKQTPHash64Prime2;
+        quint64 v2=seed+JKQTPHash64Prime2;
+        quint64 v3=seed;
+        quint64 v4=seed-JKQTPHash64Prime1;
+        const uint8_t* const limit=end-32;
+        do {
+            v1=jkqtp_hash64_round(v1, jkqtp_hash64_read64(p)); p+=8;
+            v2=jkqtp_hash64_round(v2, jkqtp_hash64_read64(p)); p+=8;
+            v3=jkqtp_hash64_round(v3, jkqtp_hash64_read64(p)); p+=8;
+            v4=jkqtp_hash64_round(v4, jkqtp_hash64_read64(p)); p+=8;
+        } while (p<=limit);
+        h=jkqtp_hash64_rotl(v1, 1)+jkqtp_hash64_rotl(v2, 7)+jkqtp_hash64_rotl(v3, 12)+jkqtp_hash64_rotl(v4, 18);
+        h=jkqtp_hash64_merge(h, v1);
+        h=jkqtp_hash64_merge(h, v2);
+        h=jkqtp_hash64_merge(h, v3);
+        h=jkqtp_hash64_merge(h, v4);
+    } else {
+        h=seed+JKQTPHash64Prime5;
+    }
+    h+=static_cast<quint64>(len);
+    while (p+8<=end) {
+        h^=jkqtp_hash64_round(0, jkqtp_hash64_read64(p));
+        h=jkqtp_hash64_rotl(h, 27)*JKQTPHash64Prime1+JKQTPHash64Prime4;
+        p+=8;
+    }
+    if (p+4<=end) {
+        h^=static_cast<quint64>(jkqtp_hash64_read32(p))*JKQTPHash64Prime1;
+        h=jkqtp_hash64_rotl(h, 23)*JKQTPHash64Prime2+JKQTPHash64Prime3;
+        p+=4;
+    }
+    while (p<end) {
+        h^=static_cast<quint64>(*p)*JKQTPHash64Prime5;
+        h=jkqtp_hash64_rotl(h, 11)*JKQTPHash64Prime1;
+        p++;
+    }
+    h^=h>>33;
+    h*=JKQTPHash64Prime2;
+    h^=h>>29;
+    h*=JKQTPHash64Prime3;
+    h^=h>>32;
+    return h;
+}
@@ -95,6 +95,20 @@ JKQTCOMMON_LIB_EXPORT void jkloadSplitter(QSettings& settings, QSplitter* splitt
  */
 JKQTCOMMON_LIB_EXPORT quint16 jkqtp_checksum(const void* data, size_t len);
 
+/** \brief calculates a fast 64-bit hash of the \a len bytes at \a data (the algorithm follows xxHash64)
+ *  \ingroup jkqtptools_general
+ *
+ *  In contrast to jkqtp_checksum() this processes 32 bytes per step (instead of single bytes) and
+ *  has a negligible collision probability, so it can be used as a cache key for large datasets.
+ *
+ *  \param data the memory to hash
+ *  \param len number of bytes in \a data
+ *  \param seed a seed value, which can be used to chain several calls
+ *
+ *  \see jkqtp_checksum()
+ */
+JKQTCOMMON_LIB_EXPORT quint64 jkqtp_hash64(const void* data, size_t len, quint64 seed=0);
+
 /** \brief Checks whether a given iterator is an input iterator (std::input_iterator_tag)
  *  \ingroup jkqtptools_general
  *
@@ -30,6 +30,7 @@
 #include <float.h>
 #include <ctime>
 #include <array>
+#include <algorithm>
 #include "jkqtcommon/jkqtpstringtools.h"
 
 
@@ -518,6 +519,99 @@ namespace { // anonymous namespace to limit availability to this module (CPP-fil
     }
 
 
+    /** \brief signature of a pure function with one argument, that can be called directly from a JKQTPMathParser::jkmpByteCode */
+    typedef double (*jkmpByteCodeFunction1)(double);
+    /** \brief signature of a pure function with two arguments, that can be called directly from a JKQTPMathParser::jkmpByteCode */
+    typedef double (*jkmpByteCodeFunction2)(double, double);
+
+    /** \brief returns a plain C-function that is equivalent to the standard function \a f with one argument, or \c nullptr if there is none */
+    jkmpByteCodeFunction1 findByteCodeFunction1(JKQTPMathParser::jkmpEvaluateFunc f) {
+        static const std::vector<std::pair<JKQTPMathParser::jkmpEvaluateFunc, jkmpByteCodeFunction1> > functions {
+            {fSin, [](double x) { return sin(x); }},
+            {fCos, [](double x) { return cos(x); }},
+            {fTan, [](double x) { return tan(x); }},
+            {fASin, [](double x) { return asin(x); }},
+            {fACos, [](double x) { return acos(x); }},
+            {fATan, [](double x) { return atan(x); }},
+            {fSinh, [](double x) { return sinh(x); }},
+            {fCosh, [](double x) { return cosh(x); }},
+            {fTanh, [](double x) { return tanh(x); }},
+            {fExp, [](double x) { return exp(x); }},
+            {fLog, [](double x) { return log(x); }},
+            {fLog2, [](double x) { return log2(x); }},
+            {fLog10, [](double x) { return log10(x); }},
+            {fSqrt, [](double x) { return sqrt(x); }},
+            {fCbrt, [](double x) { return cbrt(x); }},
+            {fAbs, [](double x) { return fabs(x); }},
+            {fErf, [](double x) { return erf(x); }},
+            {fErfc, [](double x) { return erfc(x); }},
+            {flGamma, [](double x) { return lgamma(x); }},
+            {ftGamma, [](double x) { return tgamma(x); }},
+            {fCeil, [](double x) { return ceil(x); }},
+            {fFloor, [](double x) { return floor(x); }},
+            {fTrunc, [](double x) { return trunc(x); }},
+            {fRound, [](double x) { return round(x); }}
+        };
+        for (const auto& fi: functions) {
+            if (fi.first==f) return fi.second;
+        }
+        return nullptr;
+    }
+
+    /** \brief returns a plain C-function that is equivalent to the standard function \a f with two arguments, or \c nullptr if there is none */
+    jkmpByteCodeFunction2 findByteCodeFunction2(JKQTPMathParser::jkmpEvaluateFunc f) {
+        if (f==fATan2) return [](double y, double x) { return atan2(y, x); };
+        return nullptr;
+    }
+
+    /** \brief returns the first register that is not occupied by the compiled operand \a op, if \a reg was the first free register before compiling \a op */
+    inline int nextFreeByteCodeRegister(int reg, const JKQTPMathParser::jkmpByteCodeOperand& op) {
+        return (!op.isConstant && op.reg>=reg)?(op.reg+1):reg;
+    }
+
+    /** \brief evaluate the arithmetic operation \a op on constant operands (used for constant folding) */
+    double foldByteCodeOperation(JKQTPMathParser::jkmpByteCode::jkmpOpCode op, double a, double b) {
+        switch(op) {
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Neg: return -a;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Sqr: return a*a;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Add: return a+b;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Sub: return a-b;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Mul: return a*b;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Div: return a/b;
+            case JKQTPMathParser::jkmpByteCode::jkmpOpCode::Pow: return pow(a, b);
+            default: break;
+        }
+        return NAN;
+    }
+
+    /** \brief executes \c d[i]=f(a[i]) for \a n samples */
+    template <class TFunc>
+    inline void runByteCodeUnary(double* d, const double* a, size_t n, TFunc f) {
+        for (size_t i=0; i<n; i++) {
+            d[i]=f(a[i]);
+        }
+    }
+
+    /** \brief executes \c d[i]=f(a[i],b[i]) for \a n samples, if \a a or \a b is \c nullptr, the constant \a c is used instead */
+    template <class TFunc>
+    inline void runByteCodeBinary(double* d, const double* a, const double* b, double c, size_t n, TFunc f) {
+        if (a && b) {
+            for (size_t i=0; i<n; i++) {
+                d[i]=f(a[i], b[i]);
+            }
+        } else if (a) {
+            for (size_t i=0; i<n; i++) {
+                d[i]=f(a[i], c);
+            }
+        } else if (b) {
+            for (size_t i=0; i<n; i++) {
+                d[i]=f(c, b[i]);
+            }
+        } else {
+            std::fill(d, d+n, f(c, c));
+        }
+    }
+
 
     inline std::string strip(const std::string& s) {
       std::string r;
@@ -1151,6 +1245,22 @@ JKQTPMathParser::jkmpNode* JKQTPMathParser::parse(const std::string& prog){
     }
 }
 
+bool JKQTPMathParser::compileByteCode(jkmpNode *node, const std::string &argumentName, jkmpByteCode &byteCode)
+{
+    byteCode.clear();
+    if (!node) return false;
+    byteCode.parser=this;
+    byteCode.argumentName=strip(argumentName);
+    jkmpByteCodeOperand res;
+    if (!node->compileByteCode(byteCode, 1, res)) {
+        byteCode.clear();
+        return false;
+    }
+    byteCode.result=res;
+    byteCode.valid=true;
+    return true;
+}
+
 JKQTPMathParser::jkmpResult JKQTPMathParser::evaluate(const std::string& prog) {
     JKQTPMathParser::jkmpNode* res=parse(prog);
     JKQTPMathParser::jkmpResult r=res->evaluate();
@@ -1912,3 +2022,349 @@ JKQTPMathParser::jkmpTempVariable::jkmpTempVariable()
     boolean=nullptr;
 
 }
+
+
+JKQTPMathParser::jkmpByteCodeOperand::jkmpByteCodeOperand():
+    isConstant(false), value(0), reg(-1)
+{
+
+}
+
+bool JKQTPMathParser::jkmpNode::compileByteCode(jkmpByteCode &/*bc*/, int /*reg*/, jkmpByteCodeOperand &/*result*/)
+{
+    return false;
+}
+
+bool JKQTPMathParser::jkmpBinaryArithmeticNode::compileByteCode(jkmpByteCode &bc, int reg, jkmpByteCodeOperand &result)
+{
+    jkmpByteCode::jkmpOpCode op;
+    switch(operation) {
+        case '+': op=jkmpByteCode::jkmpOpCode::Add; break;
+        case '-': op=jkmpByteCode::jkmpOpCode::Sub; break;
+        case '*': op=jkmpByteCode::jkmpOpCode::Mul; break;
+        case '/': op=jkmpByteCode::jkmpOpCode::Div; break;
+        case '^': op=jkmpByteCode::jkmpOpCode::Pow; break;
+        default: return false; // '%' checks its arguments at runtime and is left to evaluate()
+    }
+    jkmpByteCodeOperand l, r;
+    if (!left->compileByteCode(bc, reg, l)) return false;
+    if (!right->compileByteCode(bc, nextFreeByteCodeRegister(reg, l), r)) return false;
+    result=bc.emitBinary(op, reg, l, r);
+    return true;
+}
+
+bool JKQTPMathParser::jkmpUnaryNode::compileByteCode(jkmpByteCode &bc, int reg, jkmpByteCodeOperand &result)
+{
+    if (operation!='-') return false;
+    jkmpByteCodeOperand c;
+    if (!child->compileByteCode(bc, reg, c)) return false;
+    result=bc.emitUnary(jkmpByteCode::jkmpOpCode::Neg, reg, c);
+    return true;
+}
+
+bool JKQTPMathParser::jkmpConstantNode::compileByteCode(jkmpByteCode &/*bc*/, int /*reg*/, jkmpByteCodeOperand &result)
+{
+    if (data.type!=JKQTPMathParser::jkmpDouble) return false;
+    result.isConstant=true;
+    result.value=data.num;
+    return true;
+}
+
+bool JKQTPMathParser::jkmpVariableNode::compileByteCode(jkmpByteCode &bc, int reg, jkmpByteCodeOperand &result)
+{
+    if (var==bc.getArgumentName()) {
+        result=bc.argument();
+        return true;
+    }
+    if (!getParser() || !getParser()->variableExists(var)) return false;
+    const jkmpVariable v=getParser()->getVariableDef(var);
+    if (v.type!=JKQTPMathParser::jkmpDouble || v.num==nullptr) return false;
+    if (v.internal) {
+        // internal variables can only be changed by the parser itself, so they are treated as constants
+        result.isConstant=true;
+        result.value=*(v.num);
+    } else {
+        result=bc.emitLoadVariable(v.num, reg);
+    }
+    return true;
+}
+
+bool JKQTPMathParser::jkmpFunctionNode::compileByteCode(jkmpByteCode &bc, int reg, jkmpByteCodeOperand &result)
+{
+    // srand() changes global state, so the order of calls matters, which is not preserved by block-wise evaluation
+    if (!function || function==fSRand) return false;
+    std::vector<jkmpByteCodeOperand> args(n);
+    int next=reg;
+    for (int i=0; i<n; i++) {
+        if (!child[i]->compileByteCode(bc, next, args[i])) return false;
+        next=nextFreeByteCodeRegister(next, args[i]);
+    }
+    if (n==1) {
+        if (function==fSqr) {
+            result=bc.emitUnary(jkmpByteCode::jkmpOpCode::Sqr, reg, args[0]);
+            return true;
+        }
+        const jkmpByteCodeFunction1 f=findByteCodeFunction1(function);
+        if (f) {
+            result=bc.emitFunction(f, reg, args[0]);
+            return true;
+        }
+    } else if (n==2) {
+        const jkmpByteCodeFunction2 f=findByteCodeFunction2(function);
+        if (f) {
+            result=bc.emitFunction(f, reg, args[0], args[1]);
+            return true;
+        }
+    }
+    result=bc.emitCall(function, reg, args);
+    return true;
+}
+
+JKQTPMathParser::jkmpByteCode::jkmpByteCode():
+    registerCount(1), valid(false), parser(nullptr)
+{
+
+}
+
+bool JKQTPMathParser::jkmpByteCode::isValid() const
+{
+    return valid;
+}
+
+void JKQTPMathParser::jkmpByteCode::clear()
+{
+    program.clear();
+    callArguments.clear();
+    result=jkmpByteCodeOperand();
+    registerCount=1;
+    valid=false;
+    argumentName.clear();
+    parser=nullptr;
+}
+
+size_t JKQTPMathParser::jkmpByteCode::getInstructionCount() const
+{
+    return program.size();
+}
+
+size_t JKQTPMathParser::jkmpByteCode::getRegisterCount() const
+{
+    return static_cast<size_t>(registerCount);
+}
+
+const std::string &JKQTPMathParser::jkmpByteCode::getArgumentName() const
+{
+    return argumentName;
+}
+
+double JKQTPMathParser::jkmpByteCode::evaluate(double x) const
+{
+    if (!valid) return NAN;
+    if (result.isConstant) return result.value;
+    std::array<double, 16> localRegisters;
+    std::vector<double> heapRegisters;
+    double* registers=localRegisters.data();
+    if (static_cast<size_t>(registerCount)>localRegisters.size()) {
+        heapRegisters.resize(static_cast<size_t>(registerCount));
+        registers=heapRegisters.data();
+    }
+    registers[0]=x;
+    run(registers, 1, 1);
+    return registers[result.reg];
+}
+
+void JKQTPMathParser::jkmpByteCode::evaluate(const double *x, double *out, size_t n) const
+{
+    if (!valid) {
+        std::fill(out, out+n, NAN);
+        return;
+    }
+    if (result.isConstant) {
+        std::fill(out, out+n, result.value);
+        return;
+    }
+    std::vector<double> registers(static_cast<size_t>(registerCount)*BlockSize);
+    const double* res=registers.data()+static_cast<size_t>(result.reg)*BlockSize;
+    for (size_t start=0; start<n; start+=BlockSize) {
+        const size_t cnt=std::min<size_t>(BlockSize, n-start);
+        std::copy(x+start, x+start+cnt, registers.data());
+        run(registers.data(), BlockSize, cnt);
+        std::copy(res, res+cnt, out+start);
+    }
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitUnary(jkmpOpCode op, int dst, const jkmpByteCodeOperand &a)
+{
+    if (a.isConstant) {
+        jkmpByteCodeOperand res;
+        res.isConstant=true;
+        res.value=foldByteCodeOperation(op, a.value, 0);
+        return res;
+    }
+    Instruction ins=makeInstruction(op, dst);
+    ins.a=a.reg;
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitBinary(jkmpOpCode op, int dst, const jkmpByteCodeOperand &a, const jkmpByteCodeOperand &b)
+{
+    if (a.isConstant && b.isConstant) {
+        jkmpByteCodeOperand res;
+        res.isConstant=true;
+        res.value=foldByteCodeOperation(op, a.value, b.value);
+        return res;
+    }
+    // x^2 is very common and pow() is comparatively slow
+    if (op==jkmpOpCode::Pow && b.isConstant && b.value==2.0) return emitUnary(jkmpOpCode::Sqr, dst, a);
+    Instruction ins=makeInstruction(op, dst);
+    if (a.isConstant) ins.value=a.value; else ins.a=a.reg;
+    if (b.isConstant) ins.value=b.value; else ins.b=b.reg;
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitFunction(double (*f)(double), int dst, const jkmpByteCodeOperand &a)
+{
+    if (a.isConstant) {
+        jkmpByteCodeOperand res;
+        res.isConstant=true;
+        res.value=f(a.value);
+        return res;
+    }
+    Instruction ins=makeInstruction(jkmpOpCode::Function1, dst);
+    ins.a=a.reg;
+    ins.function1=f;
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitFunction(double (*f)(double, double), int dst, const jkmpByteCodeOperand &a, const jkmpByteCodeOperand &b)
+{
+    if (a.isConstant && b.isConstant) {
+        jkmpByteCodeOperand res;
+        res.isConstant=true;
+        res.value=f(a.value, b.value);
+        return res;
+    }
+    Instruction ins=makeInstruction(jkmpOpCode::Function2, dst);
+    if (a.isConstant) ins.value=a.value; else ins.a=a.reg;
+    if (b.isConstant) ins.value=b.value; else ins.b=b.reg;
+    ins.function2=f;
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitCall(jkmpEvaluateFunc f, int dst, const std::vector<jkmpByteCodeOperand> &args)
+{
+    Instruction ins=makeInstruction(jkmpOpCode::Call, dst);
+    ins.function=f;
+    ins.firstArgument=callArguments.size();
+    ins.argumentCount=static_cast<unsigned char>(args.size());
+    for (const auto& arg: args) {
+        callArguments.push_back(arg);
+        if (!arg.isConstant) registerCount=std::max(registerCount, arg.reg+1);
+    }
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::emitLoadVariable(const double *variable, int dst)
+{
+    Instruction ins=makeInstruction(jkmpOpCode::LoadVariable, dst);
+    ins.variable=variable;
+    return append(ins);
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::argument() const
+{
+    jkmpByteCodeOperand res;
+    res.isConstant=false;
+    res.reg=0;
+    return res;
+}
+
+JKQTPMathParser *JKQTPMathParser::jkmpByteCode::getParser() const
+{
+    return parser;
+}
+
+JKQTPMathParser::jkmpByteCode::Instruction JKQTPMathParser::jkmpByteCode::makeInstruction(jkmpOpCode op, int dst)
+{
+    Instruction ins;
+    ins.op=op;
+    ins.dst=dst;
+    ins.a=-1;
+    ins.b=-1;
+    ins.value=0;
+    ins.variable=nullptr;
+    ins.function1=nullptr;
+    ins.function2=nullptr;
+    ins.function=nullptr;
+    ins.firstArgument=0;
+    ins.argumentCount=0;
+    return ins;
+}
+
+JKQTPMathParser::jkmpByteCodeOperand JKQTPMathParser::jkmpByteCode::append(const Instruction &ins)
+{
+    program.push_back(ins);
+    registerCount=std::max(registerCount, ins.dst+1);
+    if (ins.a>=0) registerCount=std::max(registerCount, ins.a+1);
+    if (ins.b>=0) registerCount=std::max(registerCount, ins.b+1);
+    jkmpByteCodeOperand res;
+    res.isConstant=false;
+    res.reg=ins.dst;
+    return res;
+}
+
+void JKQTPMathParser::jkmpByteCode::run(double *registers, size_t stride, size_t n) const
+{
+    // parameter array for jkmpOpCode::Call, sized like in jkmpFunctionNode::evaluate()
+    std::vector<JKQTPMathParser::jkmpResult> params;
+    for (const Instruction& ins: program) {
+        double* d=registers+static_cast<size_t>(ins.dst)*stride;
+        const double* a=(ins.a>=0)?(registers+static_cast<size_t>(ins.a)*stride):nullptr;
+        const double* b=(ins.b>=0)?(registers+static_cast<size_t>(ins.b)*stride):nullptr;
+        switch(ins.op) {
+            case jkmpOpCode::LoadVariable:
+                std::fill(d, d+n, *(ins.variable));
+                break;
+            case jkmpOpCode::Neg:
+                runByteCodeUnary(d, a, n, [](double x) { return -x; });
+                break;
+            case jkmpOpCode::Sqr:
+                runByteCodeUnary(d, a, n, [](double x) { return x*x; });
+                break;
+            case jkmpOpCode::Add:
+                runByteCodeBinary(d, a, b, ins.value, n, [](double l, double r) { return l+r; });
+                break;
+            case jkmpOpCode::Sub:
+                runByteCodeBinary(d, a, b, ins.value, n, [](double l, double r) { return l-r; });
+                break;
+            case jkmpOpCode::Mul:
+                runByteCodeBinary(d, a, b, ins.value, n, [](double l, double r) { return l*r; });
+                break;
+            case jkmpOpCode::Div:
+                runByteCodeBinary(d, a, b, ins.value, n, [](double l, double r) { return l/r; });
+                break;
+            case jkmpOpCode::Pow:
+                runByteCodeBinary(d, a, b, ins.value, n, [](double l, double r) { return pow(l, r); });
+                break;
+            case jkmpOpCode::Function1:
+                runByteCodeUnary(d, a, n, ins.function1);
+                break;
+            case jkmpOpCode::Function2:
+                runByteCodeBinary(d, a, b, ins.value, n, ins.function2);
+                break;
+            case jkmpOpCode::Call:
+                if (params.empty()) params.resize(257);
+                for (size_t i=0; i<n; i++) {
+                    for (unsigned char k=0; k<ins.argumentCount; k++) {
+                        const jkmpByteCodeOperand& arg=callArguments[ins.firstArgument+k];
+                        params[k].isValid=true;
+                        params[k].type=JKQTPMathParser::jkmpDouble;
+                        params[k].num=arg.isConstant?arg.value:registers[static_cast<size_t>(arg.reg)*stride+i];
+                    }
+                    const JKQTPMathParser::jkmpResult r=ins.function(params.data(), ins.argumentCount, parser);
+                    d[i]=(r.isValid && r.type==JKQTPMathParser::jkmpDouble)?r.num:NAN;
+                }
+                break;
+        }
+    }
+}
@@ -122,6 +122,24 @@
  external variable x as the argument and then evaluate the function for
  each x.
 
+ \section jkmp_bytecode compiling expressions to bytecode
+ If an expression only works with numbers (no strings, booleans or assignments), it can
+ additionally be compiled into a flat register bytecode (see jkmpByteCode) by calling
+ JKQTPMathParser::compileByteCode(). Constant sub-expressions (including internal variables
+ other than the argument) are folded during compilation. The resulting program evaluates
+ much faster than the node tree and provides a batch-interface jkmpByteCode::evaluate(const double*, double*, size_t)
+ that processes arrays of arguments block-wise:
+ \code
+     JKQTPMathParser mp;
+     std::unique_ptr<JKQTPMathParser::jkmpNode> n(mp.parse("p1*sin(x)^2+exp(-x/10)"));
+     JKQTPMathParser::jkmpByteCode bc;
+     if (mp.compileByteCode(n.get(), "x", bc)) {
+        bc.evaluate(x.data(), y.data(), x.size());
+     } else {
+        // fall back to n->evaluate()
+     }
+ \endcode
+
  \section jkmp_ebnf EBNF definition of the parsed expressions
 
 <pre> logical_expression ->  logical_term
@@ -309,6 +327,22 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
 
 
+        class jkmpByteCode;
+
+        /** \brief describes where the value of a compiled sub-expression is stored in a jkmpByteCode program
+         *
+         * \see jkmpNode::compileByteCode()
+         */
+        struct jkqtmath_LIB_EXPORT jkmpByteCodeOperand {
+            jkmpByteCodeOperand();
+            /** \brief \c true, if the sub-expression was folded into the constant value */
+            bool isConstant;
+            /** \brief value of the sub-expression, if \c isConstant==true */
+            double value;
+            /** \brief register that contains the value of the sub-expression, if \c isConstant==false */
+            int reg;
+        };
+
         /**
          * \brief This class is the abstract base class for nodes.
          *        All allowed node types must inherit from jkmpNode
@@ -325,6 +359,17 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
             /** \brief evaluate this node */
             virtual jkmpResult evaluate()=0;
 
+            /** \brief compile this node into the bytecode program \a bc
+             *
+             * \param bc the program to append instructions to
+             * \param reg first free register, the value of this node is stored in this register (if it is not constant),
+             *            registers above \a reg may be used as scratch space
+             * \param[out] result where the value of this node can be found after executing the emitted instructions
+             * \return \c true on success, \c false if this node cannot be represented as bytecode
+             *         (i.e. it does not evaluate to a number). The default implementation returns \c false.
+             */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result);
+
             /** \brief return a pointer to the JKQTPMathParser  */
             JKQTPMathParser *getParser();
 
@@ -362,6 +407,9 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
             /** \brief evaluate this node */
             virtual jkmpResult evaluate() override;
+
+            /** \copydoc jkmpNode::compileByteCode() */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result) override;
         };
 
         /** \brief internal names for logic operations */
@@ -448,6 +496,9 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
             /** \brief evaluate this node */
             virtual jkmpResult evaluate() override;
+
+            /** \copydoc jkmpNode::compileByteCode() */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result) override;
         };
 
         /**
@@ -487,6 +538,9 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
             /** \brief evaluate this node */
             virtual jkmpResult evaluate() override;
+
+            /** \copydoc jkmpNode::compileByteCode() */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result) override;
         };
 
         /** \brief This class represents a variable. */
@@ -503,6 +557,9 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
             /** \brief evaluate this node */
             virtual jkmpResult evaluate() override;
+
+            /** \copydoc jkmpNode::compileByteCode() */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result) override;
         };
 
         /** \brief This class represents an arbitrary function.
@@ -534,6 +591,9 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
 
             /** \brief evaluate this node */
             virtual jkmpResult evaluate() override;
+
+            /** \copydoc jkmpNode::compileByteCode() */
+            virtual bool compileByteCode(jkmpByteCode& bc, int reg, jkmpByteCodeOperand& result) override;
         };
 
         /**
@@ -563,6 +623,149 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
             int getCount();
         };
 
+        /** \brief a double-valued expression, compiled into a flat register bytecode by JKQTPMathParser::compileByteCode()
+         *
+         * The program operates on an array of registers. Register 0 holds the argument of the function
+         * (e.g. \c x ), all other registers hold intermediate results. Each instruction reads up to
+         * two registers (or an inlined constant) and writes one register. Constant sub-expressions
+         * are folded during compilation, so e.g. <code>2*pi*x</code> results in a single multiplication.
+         *
+         * evaluate(const double*, double*, size_t) processes the arguments in blocks of BlockSize samples,
+         * i.e. each instruction is executed for a whole block, before the next instruction is executed.
+         * This keeps the inner loops tight and allows the compiler to vectorize them.
+         *
+         * External variables (registered with JKQTPMathParser::addVariableDouble(const std::string&, double*) )
+         * are read when the program is executed, whereas internal variables are replaced by their value at
+         * the time of compilation. Functions that are not built into the bytecode are called via their
+         * jkmpEvaluateFunc, if such a function does not return a number, the program evaluates to \c NaN.
+         *
+         * Both evaluate() functions are \c const and do not modify the JKQTPMathParser, so a
+         * jkmpByteCode may be evaluated from several threads in parallel.
+         *
+         * \see JKQTPMathParser::compileByteCode(), \ref jkmp_bytecode
+         */
+        class jkqtmath_LIB_EXPORT jkmpByteCode {
+          public:
+            /** \brief number of samples processed per instruction by evaluate(const double*, double*, size_t) */
+            static constexpr size_t BlockSize=256;
+
+            /** \brief class constructor, constructs an invalid (empty) program */
+            jkmpByteCode();
+
+            /** \brief returns \c true, if this object contains a successfully compiled program */
+            bool isValid() const;
+            /** \brief remove the program, afterwards isValid() returns \c false */
+            void clear();
+            /** \brief number of instructions in the program (after constant folding) */
+            size_t getInstructionCount() const;
+            /** \brief number of registers, used by the program (including the argument register 0) */
+            size_t getRegisterCount() const;
+            /** \brief name of the variable, that is used as argument of the program */
+            const std::string& getArgumentName() const;
+
+            /** \brief evaluate the program for a single argument \a x
+             *
+             * \note returns \c NaN, if the program is invalid
+             */
+            double evaluate(double x) const;
+            /** \brief evaluate the program for the \a n arguments in \a x and write the results to \a out
+             *
+             * \note \a x and \a out may point to the same memory
+             * \note writes \c NaN to \a out, if the program is invalid
+             */
+            void evaluate(const double* x, double* out, size_t n) const;
+
+            /** \brief operation codes of the bytecode */
+            enum class jkmpOpCode {
+                LoadVariable,   /*!< \brief dst = *variable */
+                Neg,            /*!< \brief dst = -a */
+                Sqr,            /*!< \brief dst = a*a */
+                Add,            /*!< \brief dst = a+b */
+                Sub,            /*!< \brief dst = a-b */
+                Mul,            /*!< \brief dst = a*b */
+                Div,            /*!< \brief dst = a/b */
+                Pow,            /*!< \brief dst = a^b */
+                Function1,      /*!< \brief dst = function1(a) */
+                Function2,      /*!< \brief dst = function2(a,b) */
+                Call            /*!< \brief dst = function(args...) for an arbitrary jkmpEvaluateFunc */
+            };
+
+            /** \brief append an operation with one operand to the program, folds constant operands
+             *
+             * \param op one of jkmpOpCode::Neg, jkmpOpCode::Sqr
+             * \param dst destination register
+             * \param a operand
+             */
+            jkmpByteCodeOperand emitUnary(jkmpOpCode op, int dst, const jkmpByteCodeOperand& a);
+            /** \brief append an operation with two operands to the program, folds constant operands
+             *
+             * \param op one of jkmpOpCode::Add, jkmpOpCode::Sub, jkmpOpCode::Mul, jkmpOpCode::Div, jkmpOpCode::Pow
+             * \param dst destination register
+             * \param a left operand
+             * \param b right operand
+             */
+            jkmpByteCodeOperand emitBinary(jkmpOpCode op, int dst, const jkmpByteCodeOperand& a, const jkmpByteCodeOperand& b);
+            /** \brief append a call to the pure function \a f with one argument, folds constant operands */
+            jkmpByteCodeOperand emitFunction(double (*f)(double), int dst, const jkmpByteCodeOperand& a);
+            /** \brief append a call to the pure function \a f with two arguments, folds constant operands */
+            jkmpByteCodeOperand emitFunction(double (*f)(double, double), int dst, const jkmpByteCodeOperand& a, const jkmpByteCodeOperand& b);
+            /** \brief append a call to the jkmpEvaluateFunc \a f (never folded, as \a f might have side effects) */
+            jkmpByteCodeOperand emitCall(jkmpEvaluateFunc f, int dst, const std::vector<jkmpByteCodeOperand>& args);
+            /** \brief append an instruction that loads the external variable \a variable into register \a dst */
+            jkmpByteCodeOperand emitLoadVariable(const double* variable, int dst);
+            /** \brief returns the operand that represents the argument of the program */
+            jkmpByteCodeOperand argument() const;
+            /** \brief the JKQTPMathParser that compiles this program */
+            JKQTPMathParser* getParser() const;
+          private:
+            friend class JKQTPMathParser;
+            /** \brief a single instruction */
+            struct Instruction {
+                jkmpOpCode op;
+                /** \brief destination register */
+                int dst;
+                /** \brief first operand register, or -1 if the operand is the constant \c value */
+                int a;
+                /** \brief second operand register, or -1 if the operand is the constant \c value */
+                int b;
+                /** \brief inlined constant operand */
+                double value;
+                /** \brief variable for jkmpOpCode::LoadVariable */
+                const double* variable;
+                /** \brief function for jkmpOpCode::Function1 */
+                double (*function1)(double);
+                /** \brief function for jkmpOpCode::Function2 */
+                double (*function2)(double, double);
+                /** \brief function for jkmpOpCode::Call */
+                jkmpEvaluateFunc function;
+                /** \brief first argument of jkmpOpCode::Call in callArguments */
+                size_t firstArgument;
+                /** \brief number of arguments of jkmpOpCode::Call */
+                unsigned char argumentCount;
+            };
+            /** \brief creates an empty Instruction */
+            static Instruction makeInstruction(jkmpOpCode op, int dst);
+            /** \brief add \a ins to the program and return the operand for its destination register */
+            jkmpByteCodeOperand append(const Instruction& ins);
+            /** \brief execute the program on \a n samples, register \c r is stored at <code>registers+r*stride</code>, register 0 has to be initialized by the caller */
+            void run(double* registers, size_t stride, size_t n) const;
+
+            /** \brief the instructions */
+            std::vector<Instruction> program;
+            /** \brief operands of all jkmpOpCode::Call instructions */
+            std::vector<jkmpByteCodeOperand> callArguments;
+            /** \brief where to find the result after executing program */
+            jkmpByteCodeOperand result;
+            /** \brief number of registers used by program */
+            int registerCount;
+            /** \brief indicates whether the program is valid */
+            bool valid;
+            /** \brief name of the argument variable */
+            std::string argumentName;
+            /** \brief parser that is used for jkmpOpCode::Call */
+            JKQTPMathParser* parser;
+        };
+
         /**@}*/
 
 
@@ -859,6 +1062,19 @@ class jkqtmath_LIB_EXPORT JKQTPMathParser
         /** \brief evaluate the given expression */
         jkmpResult evaluate(const std::string& prog);
 
+        /** \brief compiles the expression tree \a node (as returned by parse() ) into the bytecode program \a byteCode
+         *
+         * \param node the expression to compile
+         * \param argumentName name of the variable that is used as argument of the compiled function
+         * \param[out] byteCode the compiled program
+         * \return \c true on success. If the expression contains non-numeric parts (strings, booleans,
+         *         comparisons, variable assignments, lists of expressions, ...) it cannot be compiled
+         *         and \c false is returned, in this case jkmpNode::evaluate() has to be used instead.
+         *
+         * \see jkmpByteCode, \ref jkmp_bytecode
+         */
+        bool compileByteCode(jkmpNode* node, const std::string& argumentName, jkmpByteCode& byteCode);
+
         /** \brief  prints a list of all registered variables */
         void printVariables();
 
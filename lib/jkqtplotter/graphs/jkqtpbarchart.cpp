@@ -80,6 +80,7 @@ void JKQTPBarVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
         intSortData();
         const bool hasStackPar=hasStackParent();
         for (int iii=imin; iii<imax; iii++) {
+            if (isDrawingAborted()) return;
             int i=qBound(imin, getDataIndex(iii), imax);
             const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
             const int sr=datastore->getNextLowerIndex(xColumn, i);
@@ -158,6 +159,7 @@ void JKQTPBarVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
                 }
             }
         }
+        if (isDrawingAborted()) return;
 
         if (getDrawBaseline() && left!=right && !hasStackParent()) {
             painter.setPen(baselineStyle().getLinePen(painter, parent));
@@ -265,6 +267,7 @@ void JKQTPBarHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
             double deltap=0;
             double deltam=0;
             for (int iii=imin; iii<imax; iii++) {
+                if (isDrawingAborted()) return;
                 int i=qBound(imin, getDataIndex(iii), imax);
                 const double xvdirect=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
                 double xv=xvdirect;
@@ -342,6 +345,7 @@ void JKQTPBarHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
                     }
                 }
             }
+            if (isDrawingAborted()) return;
         }
         if (getDrawBaseline() && top!=bottom && !hasStackParent()) {
             painter.setPen(baselineStyle().getLinePen(painter, parent));
@@ -33,13 +33,18 @@
 #include <QApplication>
 #include <QClipboard>
 # include <QVector3D>
+#include <QThread>
+#include <thread>
+#include <atomic>
 
 JKQTPContourPlot::JKQTPContourPlot(JKQTBasePlotter *parent) :
     JKQTPMathImage(parent),
     ignoreOnPlane(false),
+    contourAlgorithm(MarchingSquaresContours),
     contourColoringMode(ColorContoursFromPaletteByValue),
     relativeLevels(false),
-    contourLinesCachedForChecksum(0)
+    contourLinesCachedForKey(0),
+    contourLinesCacheValid(false)
 {
 
     initLineStyle(parent, parentPlotStyle, JKQTPPlotStyleType::Default);
@@ -63,27 +68,14 @@ void JKQTPContourPlot::draw(JKQTPEnhancedPainter &painter)
 
     if (numberOfLevels<=0) return;
 
-    int64_t colChecksum=-1;
-    if (data && Nx*Ny>0) {
-        colChecksum=static_cast<int64_t>(jkqtp_checksum(reinterpret_cast<const char*>(data), static_cast<int64_t>(Nx)*static_cast<int64_t>(Ny)* static_cast<int64_t>(getSampleSize()/sizeof(char))));
-    }
-    /*if (parent && parent->getDatastore() && imageColumn>=0) {
-        colChecksum=static_cast<int64_t>(parent->getDatastore()->getColumnChecksum(imageColumn));
-    }*/
+    const quint64 dataKey=getImageDataKey();
 
-    if(contourLinesCache.isEmpty() || (contourLinesCachedForChecksum!=colChecksum) || (contourLinesCachedForChecksum<0)) { // contour lines are only calculated once
-        QList<QVector<QLineF> > lines;
-        lines.reserve(contourLevels.size());
-        for(int i =0; i<contourLevels.size();++i) {
-            lines.append(QVector<QLineF> (0));
-        }
-        this->calcContourLines(lines);
+    if(!contourLinesCacheValid || (contourLinesCachedForKey!=dataKey)) { // contour lines are only calculated once
         contourLinesCache.clear();
-        contourLinesCachedForChecksum=colChecksum;
-        for (const QVector<QLineF>& l: lines) {
-            contourLinesCache.push_back(JKQTPUnifyLinesToPolygons(l, qMin(getWidth()/static_cast<double>(getNx()),getHeight()/static_cast<double>(getNy()))/4.0));
-        }
+        contourLinesCachedForKey=dataKey;
+        contourLinesCacheValid=true;
     }
+    updateContourLinesCache();
 
 
 
@@ -119,7 +111,8 @@ void JKQTPContourPlot::draw(JKQTPEnhancedPainter &painter)
             p.setColor(QColor(colorLevels.pixel(i,0)));
             painter.setPen(p);
             // transform into plot coordinates
-            for(auto polygon =contourLinesCache.at(i).begin(); polygon!=contourLinesCache.at(i).end();++polygon ) {
+            const QVector<QPolygonF> contourLinesSingleLevel=contourLinesCache.value(contourLevels[i]);
+            for(auto polygon =contourLinesSingleLevel.begin(); polygon!=contourLinesSingleLevel.end();++polygon ) {
                 contourLinesTransformedSingleLevel.push_back(QPolygonF());
                 for (auto& poly: *polygon) {
                     contourLinesTransformedSingleLevel.last().append(transform(x+poly.x()/double(Nx-1)*width, y+poly.y()/double(Ny-1)*height));
@@ -148,10 +141,9 @@ void JKQTPContourPlot::createContourLevels(int nLevels)
     for(int i=1; i<=nLevels; ++i) {
         contourLevels.append(min + i*delta);
     }
+    if (relativeLevels) clearCachedContours();
     relativeLevels=false;
 
-    clearCachedContours();
-
 }
 
 void JKQTPContourPlot::createContourLevelsLog(int nLevels, int m)
@@ -185,9 +177,8 @@ void JKQTPContourPlot::createContourLevelsLog(int nLevels, int m)
         //qDebug()<<"adapt m";
     }
 
+    if (relativeLevels) clearCachedContours();
     relativeLevels=false;
-
-    clearCachedContours();
 }
 
 void JKQTPContourPlot::setIgnoreOnPlane(bool __value)
@@ -201,6 +192,17 @@ bool JKQTPContourPlot::getIgnoreOnPlane() const
     return this->ignoreOnPlane;
 }
 
+void JKQTPContourPlot::setContourAlgorithm(ContourAlgorithm __value)
+{
+    this->contourAlgorithm = __value;
+    clearCachedContours();
+}
+
+JKQTPContourPlot::ContourAlgorithm JKQTPContourPlot::getContourAlgorithm() const
+{
+    return this->contourAlgorithm;
+}
+
 int JKQTPContourPlot::getNumberOfLevels() const
 {
     return this->contourLevels.size();
@@ -224,6 +226,7 @@ QVector<double> JKQTPContourPlot::getContourLevels() const
 void JKQTPContourPlot::setRelativeLevels(bool __value)
 {
     this->relativeLevels = __value;
+    clearCachedContours();
 }
 
 bool JKQTPContourPlot::getRelativeLevels() const
@@ -235,7 +238,6 @@ void JKQTPContourPlot::addContourLevel(double level)
 {
     contourLevels.append(level);
     std::sort(contourLevels.begin(), contourLevels.end());
-    clearCachedContours();
 }
 
 void JKQTPContourPlot::addContourLevel(double level, QColor overrideColor)
@@ -282,20 +284,77 @@ void JKQTPContourPlot::clearContourLevel()
 {
     contourLevels.clear();
     contourOverrideColor.clear();
-    clearCachedContours();
 }
 
 void JKQTPContourPlot::clearCachedContours()
 {
     contourLinesCache.clear();
-    contourLinesCachedForChecksum=-1;
+    contourLinesCacheValid=false;
 }
 
 
 
 
 
-void JKQTPContourPlot::calcContourLines(QList<QVector<QLineF> > &ContourLines)
+void JKQTPContourPlot::updateContourLinesCache()
+{
+    // drop levels that are no longer used
+    for (auto it=contourLinesCache.begin(); it!=contourLinesCache.end();) {
+        if (contourLevels.contains(it.key())) ++it;
+        else it=contourLinesCache.erase(it);
+    }
+    QVector<double> missingLevels;
+    for (const double level: contourLevels) {
+        if (!contourLinesCache.contains(level) && (missingLevels.isEmpty() || missingLevels.last()!=level)) missingLevels<<level;
+    }
+    if (missingLevels.isEmpty()) return;
+
+#ifdef JKQTBP_AUTOTIMER
+    JKQTPAutoOutputTimer jkaat(QString("JKQTPContourPlot::updateContourLinesCache(%1 levels)").arg(missingLevels.size()));
+#endif
+    if (contourAlgorithm==CONRECContours) {
+        QList<QVector<QLineF> > lines;
+        lines.reserve(missingLevels.size());
+        for(int i =0; i<missingLevels.size();++i) {
+            lines.append(QVector<QLineF> (0));
+        }
+        this->calcContourLines(missingLevels, lines);
+        for (int i=0; i<missingLevels.size(); i++) {
+            contourLinesCache[missingLevels[i]]=JKQTPUnifyLinesToPolygons(lines[i], qMin(getWidth()/static_cast<double>(getNx()),getHeight()/static_cast<double>(getNy()))/4.0);
+        }
+        return;
+    }
+
+    // marching squares: convert the image to double once, then calculate the levels in parallel
+    QVector<double> grid=getDataAsDoubleVector();
+    if (grid.size()<getNx()*getNy()) return;
+    if (relativeLevels) {
+        double min;
+        double max;
+        getDataMinMax(min,max);
+        const double scale=1/(max-min);
+        for (double& v: grid) v*=scale;
+    }
+    std::vector<QVector<QPolygonF> > lines(static_cast<size_t>(missingLevels.size()));
+    std::atomic<int> nextLevel(0);
+    auto worker=[&]() {
+        for (int i=nextLevel++; i<missingLevels.size(); i=nextLevel++) {
+            lines[static_cast<size_t>(i)]=JKQTPMarchingSquaresContour(grid.constData(), getNx(), getNy(), missingLevels[i]);
+        }
+    };
+    const int threads=qBound(1, QThread::idealThreadCount(), static_cast<int>(missingLevels.size()));
+    std::vector<std::thread> workers;
+    for (int t=1; t<threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& w: workers) w.join();
+    for (int i=0; i<missingLevels.size(); i++) {
+        contourLinesCache[missingLevels[i]]=lines[static_cast<size_t>(i)];
+    }
+}
+
+void JKQTPContourPlot::calcContourLines(const QVector<double>& levels, QList<QVector<QLineF> > &ContourLines)
 {
 #ifdef JKQTBP_AUTOTIMER
     JKQTPAutoOutputTimer jkaat(QString("JKQTPContourPlot::calcContourLines()"));
@@ -387,13 +446,13 @@ void JKQTPContourPlot::calcContourLines(QList<QVector<QLineF> > &ContourLines)
             }
 
 
-            if ( zMax >= contourLevels.first() && zMin <= contourLevels.last() ) {
+            if ( zMax >= levels.first() && zMin <= levels.last() ) {
 
                 vertices[Center].setX(xp + 0.5); // pseudo pixel coordinates
                 vertices[Center].setY(yp + 0.5);
                 vertices[Center].setZ(0.25 * zSum);
-                for (int levelIdx=0; levelIdx<contourLevels.size(); ++levelIdx) {
-                    if ( contourLevels.at(levelIdx) >= zMin && contourLevels.at(levelIdx) <= zMax ) {
+                for (int levelIdx=0; levelIdx<levels.size(); ++levelIdx) {
+                    if ( levels.at(levelIdx) >= zMin && levels.at(levelIdx) <= zMax ) {
 
                         QLineF line;
                         QVector<QVector3D> triangle(3);
@@ -413,7 +472,7 @@ void JKQTPContourPlot::calcContourLines(QList<QVector<QLineF> > &ContourLines)
                             triangle[2] = vertices[(m!=BottomLeft)?(m + 1):TopLeft];
 
                             const bool intersects =intersect(line, triangle.at(0),triangle.at(1),triangle.at(2),
-                                                             contourLevels.at(levelIdx));
+                                                             levels.at(levelIdx));
                             if ( intersects ) {
                                 ContourLines[levelIdx]<<line;
                             }
@@ -466,13 +525,28 @@ bool JKQTPColumnContourPlot::usesColumn(int c) const
 
 void JKQTPColumnContourPlot::ensureImageData()
 {
-    if (this->Nx==0 || imageColumn<0 || !parent->getDatastore()->getColumnPointer(imageColumn,0)) {
+    const JKQTPDatastore* ds=parent->getDatastore();
+    if (this->Nx==0 || imageColumn<0 || !ds->getColumnRawPointer(imageColumn,0)) {
         this->Ny=0;
         this->data=nullptr;
         this->datatype=JKQTPMathImageDataType::DoubleArray;
     } else {
-        this->datatype=JKQTPMathImageDataType::DoubleArray;
-        this->data=parent->getDatastore()->getColumnPointer(imageColumn,0);
-        this->Ny=static_cast<int>(parent->getDatastore()->getRows(imageColumn)/this->Nx);
+        this->datatype=ds->getColumnDataType(imageColumn);
+        this->data=ds->getColumnRawPointer(imageColumn,0);
+        this->Ny=static_cast<int>(ds->getRows(imageColumn)/this->Nx);
     }
 }
+
+quint64 JKQTPColumnContourPlot::getImageDataKey() const
+{
+    return calcImageDataKey(parent->getDatastore()->getColumnDataKey(imageColumn), data, datatype);
+}
+
+bool JKQTPColumnContourPlot::getCachedDataRange(TileCacheChannel channel, double &imin, double &imax) const
+{
+    if (channel!=TileCacheImage || detectImageDataChanges) return false;
+    const JKQTPColumnView col=parent->getDatastore()->getColumnView(imageColumn);
+    if (!col.isValid()) return false;
+    col.getMinMax(0, static_cast<size_t>(Nx)*static_cast<size_t>(Ny), imin, imax);
+    return true;
+}
@@ -44,8 +44,10 @@
  *  finds the iso lines/polygons, connecting all neighboring points \f$ \{(x,y)|f(x,y)\equiv L_i\} \f$
  *  that equal a given set of contour levels \f$ \{L_i\} \f$ .
  *
- *  For its calculations, this class implements the CONREC algorithm
- *  (see <a href="http://paulbourke.net/papers/conrec/">http://paulbourke.net/papers/conrec/</a>).
+ *  By default the contour lines are calculated with the marching squares algorithm (see JKQTPMarchingSquaresContour() ),
+ *  which directly yields connected polylines. The levels are processed in parallel threads. Alternatively the CONREC algorithm
+ *  (see <a href="http://paulbourke.net/papers/conrec/">http://paulbourke.net/papers/conrec/</a>) can be selected with
+ *  setContourAlgorithm().
  *
  *  In order to use this class, you first have to set an image column with the data for this plot and then
  *  define several contour levels for which to plot the contour lines. See \ref JKQTPlotterContourPlot for a
@@ -67,11 +69,12 @@
  * \image html contourplot.png
  *
  * \note This class uses a caching strategy to determine whether contour lines need to be recalculated (which is time-consuming):
- *       Whenever contours have been calculated, these contours are stored in the member contourLinesCache and can then be used for
- *       redrawing. In addition the checksum of the data column is stored in contourLinesCachedForChecksum. On every redraw,
- *       the checksum is recalculated and compared to the value in contourLinesCachedForChecksum. If it matches, no recalculation
- *       is necessary. If it doesn't match, the contours are recalculated. In addition several methods that change certain
- *       properties of the plot will force a recalculation. Finally you can call clearCachedContours() to force a recalculation!
+ *       Whenever contours have been calculated, these contours are stored for each level in the member contourLinesCache and can then be used for
+ *       redrawing. In addition a key of the image data (see getImageDataKey() ) is stored in contourLinesCachedForKey. On every redraw,
+ *       the key is recalculated and compared to the value in contourLinesCachedForKey. If it matches, only levels that are not yet
+ *       in the cache (e.g. after addContourLevel() ) are calculated. If it doesn't match, the contours of all levels are recalculated.
+ *       In addition several methods that change certain properties of the plot will force a recalculation.
+ *       Finally you can call clearCachedContours() to force a recalculation!
  */
 class JKQTPLOTTER_LIB_EXPORT JKQTPContourPlot: public JKQTPMathImage, public JKQTPGraphLineStyleMixin  {
         Q_OBJECT
@@ -83,6 +86,12 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPContourPlot: public JKQTPMathImage, public JKQ
             ColorContoursFromPalette, /*!< \brief the color for each contour line is chosen from the current color palette, distributing the contour lines evenly over the palette, wirhout any connection to the value associated with each contour line \image html contourplot_ColorContoursFromPalette.png */
         };
 
+        /** \brief algorithms available for calculating the contour lines */
+        enum ContourAlgorithm {
+            MarchingSquaresContours, /*!< \brief marching squares (see JKQTPMarchingSquaresContour() ), yields connected polylines, levels are calculated in parallel (default) */
+            CONRECContours, /*!< \brief the CONREC algorithm, yields single line segments that are joined with JKQTPUnifyLinesToPolygons() , respects ignoreOnPlane */
+        };
+
         /** \brief class constructor */
         JKQTPContourPlot(JKQTBasePlotter* parent=nullptr);
         /** \brief class constructor */
@@ -99,6 +108,10 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPContourPlot: public JKQTPMathImage, public JKQ
         void setIgnoreOnPlane(bool __value);
         /** \copydoc ignoreOnPlane */
         bool getIgnoreOnPlane() const;
+        /** \copydoc contourAlgorithm */
+        void setContourAlgorithm(ContourAlgorithm __value);
+        /** \copydoc contourAlgorithm */
+        ContourAlgorithm getContourAlgorithm() const;
         /** \copydoc contourLevels */
         int getNumberOfLevels() const;
         /** \copydoc contourColoringMode */
@@ -164,8 +177,10 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPContourPlot: public JKQTPMathImage, public JKQ
         void clearCachedContours();
 
     protected:
-        /** \brief if true, vertices that all lie on the contour plane will be ignored*/
+        /** \brief if true, vertices that all lie on the contour plane will be ignored (only used by CONRECContours )*/
         bool ignoreOnPlane;
+        /** \brief the algorithm used to calculate the contour lines (default: MarchingSquaresContours ) */
+        ContourAlgorithm contourAlgorithm;
         /** \brief defines how the colors for the contours are chosen */
         ContourColoringMode contourColoringMode;
 
@@ -218,24 +233,32 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPContourPlot: public JKQTPMathImage, public JKQ
          * @return above (1), on the plane (0), below (-1);
          */
         inline int compare2level(const QVector3D &vertex, float level) const ;
-        /** \brief calcContourLines calculates the contour lines using the CONREC algorithm */
-        void calcContourLines(QList<QVector<QLineF > > &ContourLines);
-        /** \brief For Caching: the contour lines as vector of single lines (one for each triangle). the list index refers to the contour level.
+        /** \brief calcContourLines calculates the contour lines for the given (sorted) \a levels using the CONREC algorithm. \a ContourLines receives one vector of line segments for each entry in \a levels */
+        void calcContourLines(const QVector<double>& levels, QList<QVector<QLineF > > &ContourLines);
+        /** \brief calculates the contour lines of all levels in contourLevels that are not yet in contourLinesCache and removes unused levels from the cache */
+        void updateContourLinesCache();
+        /** \brief For Caching: the contour lines (as polylines in pixel coordinates) for each contour level.
          *  \internal
          *
          *  This property is used to store the last result of the contour line calculation. This is done, because
          *  calculating contour lines is rather expensive. In order to determine the need for a recalculation,
-         *  the data in the column is converted to a checksum, which can be compared to the sum value stored in
-         *  contourLinesCachedForChecksum.
+         *  the key of the image data (see getImageDataKey() ) is compared to the value stored in
+         *  contourLinesCachedForKey. As the cache is indexed by the level, changing a single level only
+         *  calculates the contour lines of that level.
          *
-         *  \see contourLinesCachedForChecksum
+         *  \see contourLinesCachedForKey
+         */
+        QMap<double, QVector<QPolygonF > > contourLinesCache;
+        /** \brief key of the image data (see getImageDataKey() ) for which contours were cached in contourLinesCache
+         *  \internal
+         *  \see contourLinesCache, contourLinesCacheValid
          */
-        QList<QVector<QPolygonF > > contourLinesCache; // contour levels, squares on grid, line
-        /** \brief if (>=0) checksum of the column for which contours were cached in contourLinesCache
+        quint64 contourLinesCachedForKey;
+        /** \brief indicates whether contourLinesCache and contourLinesCachedForKey are valid
          *  \internal
-         *  \see contourLinesCache
+         *  \see contourLinesCache, clearCachedContours()
          */
-        int64_t contourLinesCachedForChecksum;
+        bool contourLinesCacheValid;
 
 };
 
@@ -278,6 +301,19 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumnContourPlot: public JKQTPContourPlot  {
         int imageColumn;
 
         virtual void ensureImageData() override;
+    public:
+        /** \copydoc JKQTPMathImageBase::getImageDataKey()
+         *
+         *  This implementation uses the data key of the imageColumn in the datastore (see JKQTPDatastore::getColumnDataKey() ),
+         *  i.e. it is an O(1) operation, unless detectImageDataChanges is switched on.
+         */
+        virtual quint64 getImageDataKey() const override;
+    protected:
+        /** \copydoc JKQTPMathImageBase::getCachedDataRange()
+         *
+         *  This implementation returns the (cached) range of the imageColumn in the datastore.
+         */
+        virtual bool getCachedDataRange(TileCacheChannel channel, double& imin, double& imax) const override;
 
 };
 
@@ -305,8 +341,6 @@ void JKQTPContourPlot::setContourLevels(const TContainer &levels, const TColorCo
         ++itc;
     }
     std::sort(contourLevels.begin(), contourLevels.end());
-    clearCachedContours();
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -319,8 +353,6 @@ void JKQTPContourPlot::setContourLevels(const TContainer &levels)
         contourLevels<<jkqtp_todouble(*it);
     }
     std::sort(contourLevels.begin(), contourLevels.end());
-    clearCachedContours();
-
 }
 
 
@@ -603,6 +603,7 @@ void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(const jkqtpPlotFunctionTy
     simplePlotFunction=jkqtpSimplePlotFunctionType();
     plotFunction = __value;
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(const jkqtpSimplePlotFunctionType &__value)
@@ -610,6 +611,7 @@ void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(const jkqtpSimplePlotFunc
     plotFunction=jkqtpPlotFunctionType();
     simplePlotFunction=__value;
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(jkqtpPlotFunctionType &&__value)
@@ -617,6 +619,7 @@ void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(jkqtpPlotFunctionType &&_
     simplePlotFunction=jkqtpSimplePlotFunctionType();
     plotFunction = std::move(__value);
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(jkqtpSimplePlotFunctionType &&__value)
@@ -624,6 +627,7 @@ void JKQTPFunctorLineGraphBase::setPlotFunctionFunctor(jkqtpSimplePlotFunctionTy
     plotFunction=jkqtpPlotFunctionType();
     simplePlotFunction=std::move(__value);
     data.clear();
+    clearSampleCache();
 }
 
 jkqtpPlotFunctionType JKQTPFunctorLineGraphBase::getPlotFunctionFunctor() const
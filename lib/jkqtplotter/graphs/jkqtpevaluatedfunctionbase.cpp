@@ -42,7 +42,11 @@ JKQTPEvaluatedFunctionGraphBase::JKQTPEvaluatedFunctionGraphBase(JKQTBasePlotter
     slopeTolerance(0.005),
     minPixelPerSample(32),
     dataCleanupMaxAllowedAngleDegree(0.2),
-    displaySamplePoints(false)
+    displaySamplePoints(false),
+    parallelEvaluation(false),
+    parallelEvaluationThreads(0),
+    sampleCaching(false),
+    sampleCacheMaxSize(100000)
 {
     data.clear();
     iparams.clear();
@@ -60,6 +64,11 @@ JKQTPEvaluatedFunctionGraphBase::~JKQTPEvaluatedFunctionGraphBase()
 }
 
 
+bool JKQTPEvaluatedFunctionGraphBase::canDrawInParallel() const
+{
+    return true;
+}
+
 void JKQTPEvaluatedFunctionGraphBase::drawSamplePoints(JKQTPEnhancedPainter& painter, QColor graphColor) {
     QColor c=graphColor;
     c.setHsv(fmod(c.hue()+90, 360), c.saturation(), c.value());
@@ -128,6 +137,59 @@ void JKQTPEvaluatedFunctionGraphBase::setDisplaySamplePoints(bool __value)
     this->displaySamplePoints = __value;
 }
 
+void JKQTPEvaluatedFunctionGraphBase::setParallelEvaluation(bool __value)
+{
+    this->parallelEvaluation = __value;
+}
+
+bool JKQTPEvaluatedFunctionGraphBase::isParallelEvaluation() const
+{
+    return this->parallelEvaluation;
+}
+
+void JKQTPEvaluatedFunctionGraphBase::setParallelEvaluationThreads(int __value)
+{
+    this->parallelEvaluationThreads = __value;
+}
+
+int JKQTPEvaluatedFunctionGraphBase::getParallelEvaluationThreads() const
+{
+    return this->parallelEvaluationThreads;
+}
+
+void JKQTPEvaluatedFunctionGraphBase::setSampleCaching(bool __value)
+{
+    this->sampleCaching = __value;
+    if (!sampleCaching) clearSampleCache();
+}
+
+bool JKQTPEvaluatedFunctionGraphBase::isSampleCaching() const
+{
+    return this->sampleCaching;
+}
+
+void JKQTPEvaluatedFunctionGraphBase::setSampleCacheMaxSize(int __value)
+{
+    this->sampleCacheMaxSize = __value;
+}
+
+int JKQTPEvaluatedFunctionGraphBase::getSampleCacheMaxSize() const
+{
+    return this->sampleCacheMaxSize;
+}
+
+int JKQTPEvaluatedFunctionGraphBase::getSampleCacheSize() const
+{
+    return static_cast<int>(sampleCache.size());
+}
+
+void JKQTPEvaluatedFunctionGraphBase::clearSampleCache()
+{
+    std::lock_guard<std::mutex> lock(sampleCacheMutex);
+    sampleCache.clear();
+    sampleCacheParams.clear();
+}
+
 void JKQTPEvaluatedFunctionGraphBase::createPlotData(bool collectParams)
 {
 #ifdef JKQTBP_AUTOTIMER
@@ -138,11 +200,45 @@ void JKQTPEvaluatedFunctionGraphBase::createPlotData(bool collectParams)
     PlotFunctorSpec plotfunc= buildPlotFunctorSpec();
 
     if (plotfunc.isValid()) {
-        std::function<QPointF(double)> fTransformedFunc= std::bind([plotfunc](const JKQTPPlotElement* plot, double t) -> QPointF { return plot->transform(plotfunc.func(t)); }, this, std::placeholders::_1);
+        std::function<QPointF(double)> fTransformedFunc;
+        if (sampleCaching) {
+            if (sampleCacheParams!=iparams) {
+                clearSampleCache();
+                sampleCacheParams=iparams;
+            }
+            fTransformedFunc=[this, plotfunc](double t) -> QPointF {
+                {
+                    std::lock_guard<std::mutex> lock(sampleCacheMutex);
+                    const auto it=sampleCache.constFind(t);
+                    if (it!=sampleCache.constEnd()) return transform(it.value());
+                }
+                const QPointF v=plotfunc.func(t);
+                {
+                    std::lock_guard<std::mutex> lock(sampleCacheMutex);
+                    sampleCache.insert(t, v);
+                }
+                return transform(v);
+            };
+        } else {
+            fTransformedFunc= std::bind([plotfunc](const JKQTPPlotElement* plot, double t) -> QPointF { return plot->transform(plotfunc.func(t)); }, this, std::placeholders::_1);
+        }
 
         JKQTPAdaptiveFunctionGraphEvaluator evaluator(fTransformedFunc, minSamples, maxRefinementDegree, slopeTolerance, minPixelPerSample);
+        evaluator.setThreads(parallelEvaluation?parallelEvaluationThreads:1);
+        evaluator.setAlignedGrid(sampleCaching);
         data=evaluator.evaluate(plotfunc.range_start, plotfunc.range_end);
         data=JKQTPSimplyfyLineSegemnts(data, dataCleanupMaxAllowedAngleDegree);
+
+        if (sampleCaching && sampleCache.size()>sampleCacheMaxSize) {
+            // drop the values outside the current range first, then everything
+            const double tmin=qMin(plotfunc.range_start, plotfunc.range_end);
+            const double tmax=qMax(plotfunc.range_start, plotfunc.range_end);
+            for (auto it=sampleCache.begin(); it!=sampleCache.end();) {
+                if (it.key()<tmin || it.key()>tmax) it=sampleCache.erase(it);
+                else ++it;
+            }
+            if (sampleCache.size()>sampleCacheMaxSize) sampleCache.clear();
+        }
     }
 }
 
@@ -30,6 +30,8 @@
 #include "jkqtplotter/jkqtplotter_imexport.h"
 #include "jkqtcommon/jkqtpgeometrytools.h"
 #include <functional>
+#include <mutex>
+#include <QHash>
 
 
 
@@ -84,6 +86,13 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPEvaluatedFunctionGraphBase: public JKQTPGraph
         /** \brief class destructor */
         virtual ~JKQTPEvaluatedFunctionGraphBase() ;
 
+        /** \copydoc JKQTPPlotElement::canDrawInParallel()
+         *
+         *  \note If parallel drawing is activated, the plot functions of several graphs may be evaluated concurrently, so they must not
+         *        modify state that is shared with other graphs.
+         */
+        virtual bool canDrawInParallel() const override;
+
         /** \copydoc JKQTPPlotElement::getXMinMax() */
         virtual bool getXMinMax(double& minx, double& maxx, double& smallestGreaterZero) override;
         /** \copydoc JKQTPPlotElement::getYMinMax() */
@@ -117,6 +126,16 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPEvaluatedFunctionGraphBase: public JKQTPGraph
         double getDataCleanupMaxAllowedAngleDegree() const;
         /** \copydoc displaySamplePoints */
         bool getDisplaySamplePoints() const;
+        /** \copydoc parallelEvaluation */
+        bool isParallelEvaluation() const;
+        /** \copydoc parallelEvaluationThreads */
+        int getParallelEvaluationThreads() const;
+        /** \copydoc sampleCaching */
+        bool isSampleCaching() const;
+        /** \copydoc sampleCacheMaxSize */
+        int getSampleCacheMaxSize() const;
+        /** \brief returns the number of function values currently stored in the sample cache \see sampleCaching */
+        int getSampleCacheSize() const;
 	public Q_SLOTS:
         /** \copydoc minSamples */
         void setMinSamples(const unsigned int & __value);
@@ -130,6 +149,16 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPEvaluatedFunctionGraphBase: public JKQTPGraph
         void setDataCleanupMaxAllowedAngleDegree(double __value);
         /** \copydoc displaySamplePoints */
         void setDisplaySamplePoints(bool __value);
+        /** \copydoc parallelEvaluation */
+        void setParallelEvaluation(bool __value);
+        /** \copydoc parallelEvaluationThreads */
+        void setParallelEvaluationThreads(int __value);
+        /** \copydoc sampleCaching */
+        void setSampleCaching(bool __value);
+        /** \copydoc sampleCacheMaxSize */
+        void setSampleCacheMaxSize(int __value);
+        /** \brief clears the cache of function values (see sampleCaching), call this whenever the plot function changes in a way, the graph does not know about */
+        void clearSampleCache();
 
         /** \brief set an internal parameter vector as function parameters, initialized with {p1} */
         void setParamsV(double p1);
@@ -217,6 +246,44 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPEvaluatedFunctionGraphBase: public JKQTPGraph
         double dataCleanupMaxAllowedAngleDegree;
         /** \brief if true [default: off] display the points where the function has been sampled */
         bool displaySamplePoints;
+        /** \brief if true [default: off], the plot function is evaluated in several threads
+         *
+         *  The initial grid of samples and each refinement level of JKQTPAdaptiveFunctionGraphEvaluator are evaluated as one batch,
+         *  which is split over parallelEvaluationThreads threads. The resulting graph is the same as for serial evaluation.
+         *  This pays off for expensive plot functions (e.g. complex fit models).
+         *
+         *  \warning Only activate this, if the plot function is thread-safe!
+         *
+         *  \see JKQTPAdaptiveFunctionGraphEvaluator::setThreads()
+         */
+        bool parallelEvaluation;
+        /** \brief number of threads used, if parallelEvaluation is activated (\c 0 [default]: use QThread::idealThreadCount() threads) */
+        int parallelEvaluationThreads;
+        /** \brief if true [default: off], the function values are cached between calls of createPlotData()
+         *
+         *  The values \f$ \vec{f}(t) \f$ are stored in function-parameter space (i.e. before transforming them to pixels).
+         *  In addition the initial grid of JKQTPAdaptiveFunctionGraphEvaluator is aligned to a power-of-two raster
+         *  (see JKQTPAdaptiveFunctionGraphEvaluator::setAlignedGrid()), so when panning the plot, the function
+         *  is only evaluated in the newly exposed range (and where the pixel density requires a different refinement).
+         *
+         *  The cache is invalidated when the function or its parameters change. Only activate this, if the plot function
+         *  only depends on \f$ t \f$ and the function parameters. If it depends on additional (external) state,
+         *  call clearSampleCache() whenever that changes.
+         *
+         *  \see sampleCacheMaxSize, clearSampleCache()
+         */
+        bool sampleCaching;
+        /** \brief maximum number of function values kept in the cache (see sampleCaching), default: 100000.
+         *
+         *  If the cache grows larger, values outside the current parameter range are dropped first.
+         */
+        int sampleCacheMaxSize;
+        /** \brief cached function values \f$ t\mapsto\vec{f}(t) \f$ \see sampleCaching */
+        QHash<double,QPointF> sampleCache;
+        /** \brief function parameters (see iparams), for which the contents of sampleCache were calculated */
+        QVector<double> sampleCacheParams;
+        /** \brief protects sampleCache during (parallel) function evaluation */
+        std::mutex sampleCacheMutex;
 };
 
 
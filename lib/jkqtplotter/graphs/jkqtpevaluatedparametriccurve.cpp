@@ -233,6 +233,7 @@ void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(const jkqtpParametricCurve
     simplePlotFunction=jkqtpSimpleParametricCurveFunctionType();
     plotFunction = __value;
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(const jkqtpSimpleParametricCurveFunctionType &__value)
@@ -240,6 +241,7 @@ void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(const jkqtpSimpleParametri
     plotFunction=jkqtpParametricCurveFunctionType();
     simplePlotFunction=__value;
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(jkqtpParametricCurveFunctionType &&__value)
@@ -247,6 +249,7 @@ void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(jkqtpParametricCurveFuncti
     simplePlotFunction=jkqtpSimpleParametricCurveFunctionType();
     plotFunction = std::move(__value);
     data.clear();
+    clearSampleCache();
 }
 
 void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(jkqtpSimpleParametricCurveFunctionType &&__value)
@@ -254,6 +257,7 @@ void JKQTPXYFunctionLineGraph::setPlotFunctionFunctor(jkqtpSimpleParametricCurve
     plotFunction=jkqtpParametricCurveFunctionType();
     simplePlotFunction=std::move(__value);
     data.clear();
+    clearSampleCache();
 }
 
 jkqtpParametricCurveFunctionType JKQTPXYFunctionLineGraph::getPlotFunctionFunctor() const
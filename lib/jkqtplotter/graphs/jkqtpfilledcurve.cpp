@@ -131,6 +131,8 @@ void JKQTPFilledCurveXGraph::draw(JKQTPEnhancedPainter& painter) {
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     drawErrorsBefore(painter);
 
@@ -158,31 +160,35 @@ void JKQTPFilledCurveXGraph::draw(JKQTPEnhancedPainter& painter) {
         }
         bool subsequentItem=false;
         intSortData();
-        for (int iii=imin; iii<imax; iii++) {
-            const int i=qBound(imin, getDataIndex(iii), imax);
-            const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-            const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-            //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
-            if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
-                const double x=transformX(xv);
-                const double y=transformY(yv);
-                if (JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
-                    if (subsequentItem) {
-                        pf.lineTo(x, y);
-                        if (getDrawLine()) {
-                            pl.lineTo(x, y);
+        JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+            for (int iii=imin; iii<imax; iii++) {
+                if (isDrawingAborted()) return;
+                const int i=qBound(imin, getDataIndex(iii), imax);
+                const double xv=xCol.getValue(i);
+                const double yv=yCol.getValue(i);
+                //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
+                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
+                    const double x=transformX(xv);
+                    const double y=transformY(yv);
+                    if (JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+                        if (subsequentItem) {
+                            pf.lineTo(x, y);
+                            if (getDrawLine()) {
+                                pl.lineTo(x, y);
+                            }
+                        } else {
+                            if (getDrawLine()) pl.moveTo(x,y);
+                            pf.moveTo(x, y0);
+                            pf.lineTo(x, y);
                         }
-                    } else {
-                        if (getDrawLine()) pl.moveTo(x,y);
-                        pf.moveTo(x, y0);
-                        pf.lineTo(x, y);
+                        xold=x;
+                        //yold=y;
+                        subsequentItem=true;
                     }
-                    xold=x;
-                    //yold=y;
-                    subsequentItem=true;
                 }
             }
-        }
+        });
+        if (isDrawingAborted()) return;
         if (getFillCurve()) {
             pf.lineTo(xold, y0);
             pf.closeSubpath();
@@ -255,6 +261,8 @@ void JKQTPFilledCurveYGraph::draw(JKQTPEnhancedPainter &painter)
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     drawErrorsBefore(painter);
 
@@ -281,32 +289,36 @@ void JKQTPFilledCurveYGraph::draw(JKQTPEnhancedPainter &painter)
         }
         bool first=false;
         intSortData();
-        for (int iii=imin; iii<imax; iii++) {
-            const int i=qBound(imin, getDataIndex(iii), imax);
-            const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-            const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-            //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
-            if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
-                const double x=transformX(xv);
-                const double y=transformY(yv);
-                if (JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
-                    if (first) {
-
-                        pf.lineTo(x, y);
-                        if (getDrawLine()) {
-                            pl.lineTo(x, y);
+        JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+            for (int iii=imin; iii<imax; iii++) {
+                if (isDrawingAborted()) return;
+                const int i=qBound(imin, getDataIndex(iii), imax);
+                const double xv=xCol.getValue(i);
+                const double yv=yCol.getValue(i);
+                //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
+                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
+                    const double x=transformX(xv);
+                    const double y=transformY(yv);
+                    if (JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+                        if (first) {
+
+                            pf.lineTo(x, y);
+                            if (getDrawLine()) {
+                                pl.lineTo(x, y);
+                            }
+                        } else {
+                            if (getDrawLine()) pl.moveTo(x,y);
+                            pf.moveTo(x0, y);
+                            pf.lineTo(x, y);
                         }
-                    } else {
-                        if (getDrawLine()) pl.moveTo(x,y);
-                        pf.moveTo(x0, y);
-                        pf.lineTo(x, y);
+                        //xold=x;
+                        yold=y;
+                        first=true;
                     }
-                    //xold=x;
-                    yold=y;
-                    first=true;
                 }
             }
-        }
+        });
+        if (isDrawingAborted()) return;
         pf.lineTo(x0, yold);
         pf.closeSubpath();
         painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
@@ -461,6 +473,9 @@ void JKQTPFilledVerticalRangeGraph::draw(JKQTPEnhancedPainter &painter)
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
+    const JKQTPColumnView yData2=datastore->getColumnView(yColumn2);
 
     drawErrorsBefore(painter);
     {
@@ -483,10 +498,11 @@ void JKQTPFilledVerticalRangeGraph::draw(JKQTPEnhancedPainter &painter)
 
             intSortData();
             for (int iii=imin; iii<imax; iii++) {
+                if (isDrawingAborted()) return;
                 int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                const double yv2=datastore->get(static_cast<size_t>(yColumn2),static_cast<size_t>(i));
+                const double xv=xData.getValue(i);
+                const double yv=yData.getValue(i);
+                const double yv2=yData2.getValue(i);
                 //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
                 if (JKQTPIsOKFloat(xv)) {
                     const double x=transformX(xv); const bool xok=JKQTPIsOKFloat(x);
@@ -498,6 +514,7 @@ void JKQTPFilledVerticalRangeGraph::draw(JKQTPEnhancedPainter &painter)
                     if (xok&&y2ok) plow.append(QPointF(x,y2));
                 }
             }
+            if (isDrawingAborted()) return;
 
             if (plow.size()>0) {
                 for (int i=plow.size()-1; i>=0; i--) {
@@ -576,6 +593,9 @@ void JKQTPFilledHorizontalRangeGraph::draw(JKQTPEnhancedPainter &painter)
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
+    const JKQTPColumnView xData2=datastore->getColumnView(xColumn2);
 
     drawErrorsBefore(painter);
     {
@@ -598,10 +618,11 @@ void JKQTPFilledHorizontalRangeGraph::draw(JKQTPEnhancedPainter &painter)
 
             intSortData();
             for (int iii=imin; iii<imax; iii++) {
+                if (isDrawingAborted()) return;
                 int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                const double xv2=datastore->get(static_cast<size_t>(xColumn2),static_cast<size_t>(i));
+                const double xv=xData.getValue(i);
+                const double yv=yData.getValue(i);
+                const double xv2=xData2.getValue(i);
                 //std::cout<<"(xv, yv) =    ( "<<xv<<", "<<yv<<" )\n";
                 if (JKQTPIsOKFloat(xv)) {
                     const double x=transformX(xv); const bool xok=JKQTPIsOKFloat(x);
@@ -613,6 +634,7 @@ void JKQTPFilledHorizontalRangeGraph::draw(JKQTPEnhancedPainter &painter)
                     if (xok&&x2ok) plow.append(QPointF(x2,y));
                 }
             }
+            if (isDrawingAborted()) return;
 
             if (plow.size()>0) {
                 for (int i=plow.size()-1; i>=0; i--) {
@@ -62,6 +62,11 @@ JKQTPImageBase::JKQTPImageBase(JKQTPlotter *parent):
 {
 }
 
+bool JKQTPImageBase::canDrawInParallel() const
+{
+    return true;
+}
+
 void JKQTPImageBase::drawKeyMarker(JKQTPEnhancedPainter& /*painter*/, const QRectF& /*rect*/) {
 
 }
@@ -389,7 +394,14 @@ JKQTPMathImageBase::JKQTPMathImageBase(JKQTBasePlotter *parent):
     Nx(0), Ny(0),
     dataModifier(nullptr), datatypeModifier(JKQTPMathImageDataType::DoubleArray),
     internalDataMin(0.0), internalDataMax(0.0),
-    internalModifierMin(0.0), internalModifierMax(0.0)
+    internalModifierMin(0.0), internalModifierMax(0.0),
+    viewportRendering(true),
+    viewportDownsampling(NearestNeighbourDownsampling),
+    useTileCache(false),
+    tileCacheMaxMemory(256*1024*1024),
+    tileCacheParallelBuilding(true),
+    imageDataGeneration(0),
+    detectImageDataChanges(false)
 {
 
 }
@@ -401,7 +413,14 @@ JKQTPMathImageBase::JKQTPMathImageBase(double x, double y, double width, double
     Nx(0), Ny(0),
     dataModifier(nullptr), datatypeModifier(JKQTPMathImageDataType::DoubleArray),
     internalDataMin(0.0), internalDataMax(0.0),
-    internalModifierMin(0.0), internalModifierMax(0.0)
+    internalModifierMin(0.0), internalModifierMax(0.0),
+    viewportRendering(true),
+    viewportDownsampling(NearestNeighbourDownsampling),
+    useTileCache(false),
+    tileCacheMaxMemory(256*1024*1024),
+    tileCacheParallelBuilding(true),
+    imageDataGeneration(0),
+    detectImageDataChanges(false)
 {
 
 }
@@ -535,47 +554,8 @@ void JKQTPMathImageBase::getDataMinMax(double& imin, double& imax) {
     ensureImageData();
     imin=imax=0;
     if (!data) return;
-    switch(datatype) {
-        case JKQTPMathImageDataType::DoubleArray:
-            imin= JKQTPImagePlot_getImageMin<double>(static_cast<const double*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<double>(static_cast<const double*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::FloatArray:
-            imin= JKQTPImagePlot_getImageMin<float>(static_cast<const float*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<float>(static_cast<const float*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt8Array:
-            imin= JKQTPImagePlot_getImageMin<uint8_t>(static_cast<const uint8_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint8_t>(static_cast<const uint8_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt16Array:
-            imin= JKQTPImagePlot_getImageMin<uint16_t>(static_cast<const uint16_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint16_t>(static_cast<const uint16_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt32Array:
-            imin= JKQTPImagePlot_getImageMin<uint32_t>(static_cast<const uint32_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint32_t>(static_cast<const uint32_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt64Array:
-            imin= JKQTPImagePlot_getImageMin<uint64_t>(static_cast<const uint64_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint64_t>(static_cast<const uint64_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int8Array:
-            imin= JKQTPImagePlot_getImageMin<int8_t>(static_cast<const int8_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int8_t>(static_cast<const int8_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int16Array:
-            imin= JKQTPImagePlot_getImageMin<int16_t>(static_cast<const int16_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int16_t>(static_cast<const int16_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int32Array:
-            imin= JKQTPImagePlot_getImageMin<int32_t>(static_cast<const int32_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int32_t>(static_cast<const int32_t*>(data), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int64Array:
-            imin= JKQTPImagePlot_getImageMin<int64_t>(static_cast<const int64_t*>(data), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int64_t>(static_cast<const int64_t*>(data), Nx, Ny);
-            break;
+    if (!getCachedDataRange(TileCacheImage, imin, imax)) {
+        JKQTPImagePlot_getImageMinMax(data, datatype, Nx, Ny, imin, imax);
     }
 }
 
@@ -584,50 +564,16 @@ void JKQTPMathImageBase::getModifierMinMax(double &imin, double &imax)
     ensureImageData();
     imin=imax=0;
     if (!dataModifier) return;
-    switch(datatypeModifier) {
-        case JKQTPMathImageDataType::DoubleArray:
-            imin= JKQTPImagePlot_getImageMin<double>(static_cast<const double*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<double>(static_cast<const double*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::FloatArray:
-            imin= JKQTPImagePlot_getImageMin<float>(static_cast<const float*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<float>(static_cast<const float*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt8Array:
-            imin= JKQTPImagePlot_getImageMin<uint8_t>(static_cast<const uint8_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint8_t>(static_cast<const uint8_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt16Array:
-            imin= JKQTPImagePlot_getImageMin<uint16_t>(static_cast<const uint16_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint16_t>(static_cast<const uint16_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt32Array:
-            imin= JKQTPImagePlot_getImageMin<uint32_t>(static_cast<const uint32_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint32_t>(static_cast<const uint32_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::UInt64Array:
-            imin= JKQTPImagePlot_getImageMin<uint64_t>(static_cast<const uint64_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<uint64_t>(static_cast<const uint64_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int8Array:
-            imin= JKQTPImagePlot_getImageMin<int8_t>(static_cast<const int8_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int8_t>(static_cast<const int8_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int16Array:
-            imin= JKQTPImagePlot_getImageMin<int16_t>(static_cast<const int16_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int16_t>(static_cast<const int16_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int32Array:
-            imin= JKQTPImagePlot_getImageMin<int32_t>(static_cast<const int32_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int32_t>(static_cast<const int32_t*>(dataModifier), Nx, Ny);
-            break;
-        case JKQTPMathImageDataType::Int64Array:
-            imin= JKQTPImagePlot_getImageMin<int64_t>(static_cast<const int64_t*>(dataModifier), Nx, Ny);
-            imax= JKQTPImagePlot_getImageMax<int64_t>(static_cast<const int64_t*>(dataModifier), Nx, Ny);
-            break;
+    if (!getCachedDataRange(TileCacheModifier, imin, imax)) {
+        JKQTPImagePlot_getImageMinMax(dataModifier, datatypeModifier, Nx, Ny, imin, imax);
     }
 }
 
+bool JKQTPMathImageBase::getCachedDataRange(TileCacheChannel /*channel*/, double &/*imin*/, double &/*imax*/) const
+{
+    return false;
+}
+
 QVector<double> JKQTPMathImageBase::getDataAsDoubleVector() const
 {
     switch(datatype) {
@@ -698,6 +644,293 @@ void JKQTPMathImageBase::ensureImageData()
 {
 }
 
+quint64 JKQTPMathImageBase::getImageDataKey() const
+{
+    return calcImageDataKey(static_cast<quint64>(reinterpret_cast<quintptr>(data)), data, datatype);
+}
+
+quint64 JKQTPMathImageBase::calcImageDataKey(quint64 sourceKey, const void *data, JKQTPMathImageDataType datatype) const
+{
+    const quint64 props[5]={sourceKey, static_cast<quint64>(Nx), static_cast<quint64>(Ny), static_cast<quint64>(datatype), imageDataGeneration};
+    const quint64 seed=jkqtp_hash64(props, sizeof(props));
+    if (!detectImageDataChanges || !data || Nx<=0 || Ny<=0) return seed;
+    return jkqtp_hash64(data, static_cast<size_t>(Nx)*static_cast<size_t>(Ny)*JKQTPMathImageDataTypeSize(datatype), seed);
+}
+
+void JKQTPMathImageBase::markImageDataModified()
+{
+    imageDataGeneration++;
+}
+
+void JKQTPMathImageBase::setDetectImageDataChanges(bool __value)
+{
+    detectImageDataChanges=__value;
+}
+
+bool JKQTPMathImageBase::getDetectImageDataChanges() const
+{
+    return detectImageDataChanges;
+}
+
+void JKQTPMathImageBase::setViewportRendering(bool __value)
+{
+    viewportRendering=__value;
+}
+
+bool JKQTPMathImageBase::getViewportRendering() const
+{
+    return viewportRendering;
+}
+
+void JKQTPMathImageBase::setViewportDownsampling(ViewportDownsamplingMode __value)
+{
+    viewportDownsampling=__value;
+}
+
+JKQTPMathImageBase::ViewportDownsamplingMode JKQTPMathImageBase::getViewportDownsampling() const
+{
+    return viewportDownsampling;
+}
+
+void JKQTPMathImageBase::setUseTileCache(bool __value)
+{
+    useTileCache=__value;
+    if (!useTileCache) {
+        for (auto& c: tileCache) c.reset();
+    }
+}
+
+bool JKQTPMathImageBase::getUseTileCache() const
+{
+    return useTileCache;
+}
+
+void JKQTPMathImageBase::setTileCacheMaxMemory(size_t __value)
+{
+    tileCacheMaxMemory=__value;
+    for (auto& c: tileCache) {
+        if (c) c->setMaxMemory(tileCacheMaxMemory);
+    }
+}
+
+size_t JKQTPMathImageBase::getTileCacheMaxMemory() const
+{
+    return tileCacheMaxMemory;
+}
+
+void JKQTPMathImageBase::setTileCacheParallelBuilding(bool __value)
+{
+    tileCacheParallelBuilding=__value;
+    for (auto& c: tileCache) {
+        if (c) c->setParallelBuilding(tileCacheParallelBuilding);
+    }
+}
+
+bool JKQTPMathImageBase::getTileCacheParallelBuilding() const
+{
+    return tileCacheParallelBuilding;
+}
+
+JKQTPImageTilePyramid::Statistics JKQTPMathImageBase::getTileCacheStatistics() const
+{
+    JKQTPImageTilePyramid::Statistics stat;
+    for (const auto& c: tileCache) {
+        if (c) stat+=c->getStatistics();
+    }
+    return stat;
+}
+
+void JKQTPMathImageBase::resetTileCacheStatistics()
+{
+    for (auto& c: tileCache) {
+        if (c) c->resetStatistics();
+    }
+}
+
+void JKQTPMathImageBase::clearTileCache()
+{
+    for (auto& c: tileCache) {
+        if (c) c->clear();
+    }
+}
+
+quint64 JKQTPMathImageBase::getTileCacheDataKey(TileCacheChannel /*channel*/, const void *data, JKQTPMathImageDataType datatype) const
+{
+    return calcImageDataKey(static_cast<quint64>(reinterpret_cast<quintptr>(data)), data, datatype);
+}
+
+namespace {
+    /** \brief samples the image \a data (row-major, width \a Nx ) into \a out : output pixel (u,b) is the average over the
+     *         finite values in the source columns <code>[cols[2*u]..cols[2*u+1])</code> and rows <code>[rows[2*b]..rows[2*b+1])</code>
+     *         (if there are none, the first pixel of the range is used, so NaN/inf are preserved)
+     */
+    template <class T>
+    void JKQTPMathImageSampleRegion(const T* data, int Nx, const std::vector<int>& cols, const std::vector<int>& rows, std::vector<double>& out) {
+        const size_t W=cols.size()/2;
+        const size_t H=rows.size()/2;
+        out.resize(W*H);
+        double* o=out.data();
+        for (size_t b=0; b<H; b++) {
+            const int rs=rows[2*b];
+            const int re=rows[2*b+1];
+            for (size_t u=0; u<W; u++) {
+                const int cs=cols[2*u];
+                const int ce=cols[2*u+1];
+                const T* first=data+static_cast<size_t>(rs)*static_cast<size_t>(Nx)+static_cast<size_t>(cs);
+                if (re-rs==1 && ce-cs==1) {
+                    *o=static_cast<double>(*first);
+                } else {
+                    double sum=0;
+                    int cnt=0;
+                    for (int r=rs; r<re; r++) {
+                        const T* line=data+static_cast<size_t>(r)*static_cast<size_t>(Nx);
+                        for (int c=cs; c<ce; c++) {
+                            const double v=static_cast<double>(line[c]);
+                            if (std::isfinite(v)) {
+                                sum+=v;
+                                cnt++;
+                            }
+                        }
+                    }
+                    *o=(cnt>0)?(sum/static_cast<double>(cnt)):static_cast<double>(*first);
+                }
+                o++;
+            }
+        }
+    }
+
+    void JKQTPMathImageSampleRegion(const void* data, JKQTPMathImageDataType datatype, int Nx, const std::vector<int>& cols, const std::vector<int>& rows, std::vector<double>& out) {
+        switch(datatype) {
+            case JKQTPMathImageDataType::DoubleArray: JKQTPMathImageSampleRegion<double>(static_cast<const double*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::FloatArray: JKQTPMathImageSampleRegion<float>(static_cast<const float*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::UInt8Array: JKQTPMathImageSampleRegion<uint8_t>(static_cast<const uint8_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::UInt16Array: JKQTPMathImageSampleRegion<uint16_t>(static_cast<const uint16_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::UInt32Array: JKQTPMathImageSampleRegion<uint32_t>(static_cast<const uint32_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::UInt64Array: JKQTPMathImageSampleRegion<uint64_t>(static_cast<const uint64_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::Int8Array: JKQTPMathImageSampleRegion<int8_t>(static_cast<const int8_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::Int16Array: JKQTPMathImageSampleRegion<int16_t>(static_cast<const int16_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::Int32Array: JKQTPMathImageSampleRegion<int32_t>(static_cast<const int32_t*>(data), Nx, cols, rows, out); break;
+            case JKQTPMathImageDataType::Int64Array: JKQTPMathImageSampleRegion<int64_t>(static_cast<const int64_t*>(data), Nx, cols, rows, out); break;
+        }
+    }
+
+    /** \brief splits the displayed pixel range <code>[d0..d1)</code> of an image with \a N pixels into \a n output pixels and
+     *         stores the corresponding source ranges (in data coordinates) in \a ranges. The ranges are stored in the order given by
+     *         \a reverseOutput and mapped to the data by \a mirror ( data index = N-1-displayed index ).
+     */
+    void JKQTPMathImageSampleRanges(int d0, int d1, int N, int n, bool boxFilter, bool mirror, bool reverseOutput, std::vector<int>& ranges) {
+        ranges.resize(2*static_cast<size_t>(n));
+        const double step=static_cast<double>(d1-d0)/static_cast<double>(n);
+        for (int i=0; i<n; i++) {
+            int s, e;
+            if (boxFilter) {
+                s=d0+static_cast<int>(floor(static_cast<double>(i)*step));
+                e=qBound(s+1, d0+static_cast<int>(floor(static_cast<double>(i+1)*step)), d1);
+            } else {
+                s=qBound(d0, d0+static_cast<int>(floor((static_cast<double>(i)+0.5)*step)), d1-1);
+                e=s+1;
+            }
+            const size_t idx=static_cast<size_t>(reverseOutput?(n-1-i):i);
+            if (mirror) {
+                ranges[2*idx]=N-e;
+                ranges[2*idx+1]=N-s;
+            } else {
+                ranges[2*idx]=s;
+                ranges[2*idx+1]=e;
+            }
+        }
+    }
+}
+
+bool JKQTPMathImageBase::calcViewportSampling(JKQTPEnhancedPainter &painter, ViewportSampling &sampling) const
+{
+    if (Nx<=0 || Ny<=0) return false;
+    if ((!JKQTPIsOKFloat(x))||(!JKQTPIsOKFloat(y))||(!JKQTPIsOKFloat(width))||(!JKQTPIsOKFloat(height))||(width==0) || (height==0)) return false;
+
+    // determine the shown plot rectangle and the image rectangle in pixel coordinates (same as plotImage())
+    QPointF pix_plot_topleft=transform(parent->getXMin(),parent->getYMax());
+    QPointF pix_plot_bottomright=transform(parent->getXMax(),parent->getYMin());
+    QPointF pix_topleft=transform(x,y+height);
+    QPointF pix_bottomright=transform(x+width,y);
+    bool mirrx=false;
+    bool mirry=false;
+    if (pix_topleft.x()>pix_bottomright.x()) {
+        std::swap(pix_topleft.rx(), pix_bottomright.rx());
+        std::swap(pix_plot_topleft.rx(), pix_plot_bottomright.rx());
+        mirrx=true;
+    }
+    if (pix_topleft.y()>pix_bottomright.y()) {
+        std::swap(pix_topleft.ry(), pix_bottomright.ry());
+        std::swap(pix_plot_topleft.ry(), pix_plot_bottomright.ry());
+        mirry=true;
+    }
+    const double pixwidth=(pix_bottomright.x()-pix_topleft.x())/static_cast<double>(Nx);
+    const double pixheight=(pix_bottomright.y()-pix_topleft.y())/static_cast<double>(Ny);
+    if (!JKQTPIsOKFloat(pixwidth) || !JKQTPIsOKFloat(pixheight) || pixwidth<=0 || pixheight<=0) return false;
+
+    // visible range [c0..c1)x[r0..r1) of the displayed (i.e. possibly mirrored) image
+    const int c0=qBound<int>(0, static_cast<int>(floor((pix_plot_topleft.x()-pix_topleft.x())/pixwidth)), Nx);
+    const int c1=qBound<int>(0, static_cast<int>(ceil((pix_plot_bottomright.x()-pix_topleft.x())/pixwidth)), Nx);
+    const int r0=qBound<int>(0, static_cast<int>(floor((pix_plot_topleft.y()-pix_topleft.y())/pixheight)), Ny);
+    const int r1=qBound<int>(0, static_cast<int>(ceil((pix_plot_bottomright.y()-pix_topleft.y())/pixheight)), Ny);
+    if (c1<=c0 || r1<=r0) return false;
+    sampling.target=QRectF(pix_topleft.x()+c0*pixwidth, pix_topleft.y()+r0*pixheight, (c1-c0)*pixwidth, (r1-r0)*pixheight);
+
+    // output resolution: never more pixels than visible in the image, nor than the device can show
+    const double dpr=painter.device()?painter.device()->devicePixelRatioF():1.0;
+    const double sx=fabs(painter.transform().m11())*dpr;
+    const double sy=fabs(painter.transform().m22())*dpr;
+    sampling.width=qBound<int>(1, static_cast<int>(ceil(sampling.target.width()*sx)), c1-c0);
+    sampling.height=qBound<int>(1, static_cast<int>(ceil(sampling.target.height()*sy)), r1-r0);
+    sampling.downsampling=std::min(static_cast<double>(c1-c0)/static_cast<double>(sampling.width), static_cast<double>(r1-r0)/static_cast<double>(sampling.height));
+
+    // displayed row r shows data row Ny-1-r (or r, if mirrored), array2image() writes data row b into scanline height-1-b
+    const bool boxFilter=(viewportDownsampling==BoxFilterDownsampling);
+    JKQTPMathImageSampleRanges(c0, c1, Nx, sampling.width, boxFilter, mirrx, false, sampling.cols);
+    JKQTPMathImageSampleRanges(r0, r1, Ny, sampling.height, boxFilter, !mirry, true, sampling.rows);
+    return true;
+}
+
+void JKQTPMathImageBase::sampleViewport(const ViewportSampling &sampling, const void *data, JKQTPMathImageDataType datatype, TileCacheChannel channel, std::vector<double> &out)
+{
+    if (useTileCache && sampling.downsampling>=2.0) {
+        auto& cache=tileCache[channel];
+        if (!cache) {
+            cache.reset(new JKQTPImageTilePyramid());
+            cache->setMaxMemory(tileCacheMaxMemory);
+            cache->setParallelBuilding(tileCacheParallelBuilding);
+        }
+        cache->setSource(data, datatype, Nx, Ny, getTileCacheDataKey(channel, data, datatype));
+        const int level=cache->levelForDownsampling(sampling.downsampling);
+        if (level>0) {
+            // map the sampled ranges onto the pixels of the pyramid level and read the covered region
+            const int levelW=cache->getLevelWidth(level);
+            const int levelH=cache->getLevelHeight(level);
+            auto toLevel=[level](const std::vector<int>& ranges, int levelSize, std::vector<int>& levelRanges, int& l0, int& l1) {
+                levelRanges.resize(ranges.size());
+                l0=levelSize;
+                l1=0;
+                for (size_t i=0; i<ranges.size(); i+=2) {
+                    levelRanges[i]=std::min(ranges[i]>>level, levelSize-1);
+                    levelRanges[i+1]=qBound(levelRanges[i]+1, (ranges[i+1]+(1<<level)-1)>>level, levelSize);
+                    l0=std::min(l0, levelRanges[i]);
+                    l1=std::max(l1, levelRanges[i+1]);
+                }
+                for (auto& r: levelRanges) r-=l0;
+            };
+            std::vector<int> cols, rows;
+            int x0, x1, y0, y1;
+            toLevel(sampling.cols, levelW, cols, x0, x1);
+            toLevel(sampling.rows, levelH, rows, y0, y1);
+            if (cache->getRegion(level, x0, y0, x1, y1, viewportTileBuffer)) {
+                JKQTPMathImageSampleRegion<double>(viewportTileBuffer.data(), x1-x0, cols, rows, out);
+                return;
+            }
+        }
+    }
+    JKQTPMathImageSampleRegion(data, datatype, Nx, sampling.cols, sampling.rows, out);
+}
+
 
 
 
@@ -885,6 +1118,7 @@ void JKQTPMathImage::copyColorbarPlotAsImage()
 void JKQTPMathImage::draw(JKQTPEnhancedPainter& painter) {
     ensureImageData();
     if (!data) return;
+    if (viewportRendering && drawVisibleImageRegion(painter)) return;
     QImage img=drawImage();
     plotImage(painter, img, x, y, width, height);
 }
@@ -966,6 +1200,25 @@ void JKQTPMathImage::cbGetModifierDataMinMax(double &imin, double &imax)
     getModifierMinMax(imin, imax);
 }
 
+bool JKQTPMathImage::drawVisibleImageRegion(JKQTPEnhancedPainter &painter)
+{
+    if (painter.painterFlags().testFlag(JKQTPEnhancedPainter::VectorPainting)) return false;
+    ViewportSampling sampling;
+    if (!calcViewportSampling(painter, sampling)) return true;
+
+    getDataMinMax(internalDataMin, internalDataMax);
+    getModifierMinMax(internalModifierMin, internalModifierMax);
+    sampleViewport(sampling, data, datatype, TileCacheImage, viewportSampleBuffer);
+    JKQTPImageTools::array2image<double>(viewportSampleBuffer.data(), sampling.width, sampling.height, viewportImageBuffer, palette, internalDataMin, internalDataMax, rangeMinFailAction, rangeMaxFailAction, rangeMinFailColor, rangeMaxFailColor, nanColor, infColor);
+    if (dataModifier && modifierMode!=JKQTPMathImageModifierMode::ModifyNone) {
+        sampleViewport(sampling, dataModifier, datatypeModifier, TileCacheModifier, viewportSampleBuffer);
+        modifyImage(viewportImageBuffer, viewportSampleBuffer.data(), JKQTPMathImageDataType::DoubleArray, sampling.width, sampling.height, internalModifierMin, internalModifierMax);
+    }
+
+    painter.drawImage(sampling.target, viewportImageBuffer);
+    return true;
+}
+
 
 
 
@@ -1088,20 +1341,43 @@ bool JKQTPColumnMathImage::usesColumn(int c) const
 void JKQTPColumnMathImage::ensureImageData()
 {
 
-    if (this->Nx==0 || imageColumn<0 || !parent->getDatastore()->getColumnPointer(imageColumn,0)) {
+    const JKQTPDatastore* ds=parent->getDatastore();
+    if (this->Nx==0 || imageColumn<0 || !ds->getColumnRawPointer(imageColumn,0)) {
         this->Ny=0;
         this->data=nullptr;
         this->datatype=JKQTPMathImageDataType::DoubleArray;
     } else {
-        this->datatype=JKQTPMathImageDataType::DoubleArray;
-        this->data=parent->getDatastore()->getColumnPointer(imageColumn,0);
-        this->Ny= static_cast<int>(parent->getDatastore()->getRows(imageColumn)/this->Nx);
+        // typed columns (e.g. uint16_t camera frames) are used directly, without conversion to double
+        this->datatype=ds->getColumnDataType(imageColumn);
+        this->data=ds->getColumnRawPointer(imageColumn,0);
+        this->Ny= static_cast<int>(ds->getRows(imageColumn)/this->Nx);
     }
-    if (this->Nx==0 || modifierColumn<0 || !parent->getDatastore()->getColumnPointer(modifierColumn,0)) {
+    if (this->Nx==0 || modifierColumn<0 || !ds->getColumnRawPointer(modifierColumn,0)) {
         this->dataModifier=nullptr;
     } else {
-        this->datatypeModifier=JKQTPMathImageDataType::DoubleArray;
-        this->dataModifier=parent->getDatastore()->getColumnPointer(modifierColumn,0);
+        this->datatypeModifier=ds->getColumnDataType(modifierColumn);
+        this->dataModifier=ds->getColumnRawPointer(modifierColumn,0);
     }
 }
 
+quint64 JKQTPColumnMathImage::getImageDataKey() const
+{
+    return calcImageDataKey(parent->getDatastore()->getColumnDataKey(imageColumn), data, datatype);
+}
+
+quint64 JKQTPColumnMathImage::getTileCacheDataKey(TileCacheChannel channel, const void *data, JKQTPMathImageDataType datatype) const
+{
+    const int column=(channel==TileCacheModifier)?modifierColumn:imageColumn;
+    return calcImageDataKey(parent->getDatastore()->getColumnDataKey(column), data, datatype);
+}
+
+bool JKQTPColumnMathImage::getCachedDataRange(TileCacheChannel channel, double &imin, double &imax) const
+{
+    // the cached range of the column does not follow changes in place, which the image should detect by itself
+    if (detectImageDataChanges) return false;
+    const JKQTPColumnView col=parent->getDatastore()->getColumnView((channel==TileCacheModifier)?modifierColumn:imageColumn);
+    if (!col.isValid()) return false;
+    col.getMinMax(0, static_cast<size_t>(Nx)*static_cast<size_t>(Ny), imin, imax);
+    return true;
+}
+
@@ -26,6 +26,8 @@
 #include <QPainter>
 #include <QImage>
 #include <QIcon>
+#include <vector>
+#include <memory>
 #include "jkqtplotter/graphs/jkqtpscatter.h"
 #include "jkqtplotter/jkqtptools.h"
 #include "jkqtplotter/jkqtpbaseelements.h"
@@ -70,6 +72,8 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPImageBase: public JKQTPGraph {
          *
          */
         JKQTPImageBase(double x, double y, double width, double height, JKQTPlotter* parent);
+        /** \copydoc JKQTPPlotElement::canDrawInParallel() */
+        virtual bool canDrawInParallel() const override;
         /** \brief plots a key marker inside the specified rectangle \a rect */
         virtual void drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect) override;
 
@@ -130,10 +134,41 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPImageBase: public JKQTPGraph {
 
     \image html imageplot.png
 
+    \section JKQTPMathImageViewportRendering Viewport-Aware Rendering
+
+    By default (see setViewportRendering() ) the derived classes do not colorize the complete image in draw(), but only the part of it
+    that is visible in the current plot range. If this part contains more image pixels than the output device has
+    pixels, it is downsampled to the device resolution before colorization (see setViewportDownsampling() ).
+    The result is drawn directly into the plot, so large images that are zoomed into a small region or displayed
+    on a small widget require only work proportional to the number of visible/output pixels. The internal buffers
+    are reused between frames. For vector output (see JKQTPEnhancedPainter::VectorPainting ) the full-resolution
+    path (drawImage() + plotImage() ) is used.
+
+    When zooming out of very large images, even reading all visible pixels once per frame is too slow. For this case, a tile cache
+    can be activated with setUseTileCache(): Then the image (and modifier) data is summarized in a JKQTPImageTilePyramid of
+    box-filtered levels with half the resolution each. Each frame only reads the tiles of the coarsest level that still has
+    at least the output resolution, which also avoids aliasing. The tiles are built lazily (optionally in parallel, see
+    setTileCacheParallelBuilding() ), their memory is limited by setTileCacheMaxMemory() and they are invalidated, when the image data
+    changes (see getTileCacheDataKey() ). This is an O(1) check of the data pointer (or the generation of the JKQTPDatastore column) and
+    of a counter, which is incremented by markImageDataModified(). So if the data is changed in place, call markImageDataModified()
+    (or JKQTPDatastore::markColumnModified() ), or switch on setDetectImageDataChanges(), which hashes the data once per frame.
+    getTileCacheStatistics() returns cache hit statistics.
+
+    \note If you override drawImage() in a derived class, you also have to switch off viewport rendering,
+          as draw() does not call drawImage() in this mode.
  */
 class JKQTPLOTTER_LIB_EXPORT JKQTPMathImageBase: public JKQTPImageBase {
         Q_OBJECT
     public:
+        /** \brief how the visible part of the image is reduced to the output resolution, if it contains more pixels than the output device
+         *
+         *  \see setViewportDownsampling(), \ref JKQTPMathImageViewportRendering
+         */
+        enum ViewportDownsamplingMode {
+            NearestNeighbourDownsampling, /*!< \brief each output pixel shows the image pixel at its center (fastest, but may alias fine structures) */
+            BoxFilterDownsampling, /*!< \brief each output pixel shows the average over all (finite) image pixels it covers */
+        };
+        Q_ENUM(ViewportDownsamplingMode)
 
         /** \brief class constructor
          *
@@ -242,7 +277,106 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPMathImageBase: public JKQTPImageBase {
         QVector<double> getDataAsDoubleVector() const;
         /** \brief returns the contents of the internal modifier image as a QVector<double> */
         QVector<double> getDataModifierAsDoubleVector() const;
+        /** \brief returns a key, that changes whenever the image data (data, datatype, Nx, Ny), but not the modifier, changes.
+         *         This can be used to determine, whether data derived from the image (e.g. contour lines) has to be recalculated.
+         *
+         *  The default implementation combines the data pointer, the size, the data type and the counter incremented by
+         *  markImageDataModified() , i.e. it is an O(1) operation. Classes that read their data from a JKQTPDatastore override this
+         *  and use the data key of the column (see JKQTPDatastore::getColumnDataKey() ) instead of the pointer. Only if
+         *  setDetectImageDataChanges() is switched on, the key also contains a hash over the image data (see jkqtp_hash64() ).
+         *
+         *  \note call this after ensureImageData()
+         */
+        virtual quint64 getImageDataKey() const;
+
+        /** \copydoc viewportRendering */
+        void setViewportRendering(bool __value);
+        /** \copydoc viewportRendering */
+        bool getViewportRendering() const;
+        /** \copydoc viewportDownsampling */
+        void setViewportDownsampling(ViewportDownsamplingMode __value);
+        /** \copydoc viewportDownsampling */
+        ViewportDownsamplingMode getViewportDownsampling() const;
+        /** \copydoc useTileCache */
+        void setUseTileCache(bool __value);
+        /** \copydoc useTileCache */
+        bool getUseTileCache() const;
+        /** \copydoc tileCacheMaxMemory */
+        void setTileCacheMaxMemory(size_t __value);
+        /** \copydoc tileCacheMaxMemory */
+        size_t getTileCacheMaxMemory() const;
+        /** \copydoc tileCacheParallelBuilding */
+        void setTileCacheParallelBuilding(bool __value);
+        /** \copydoc tileCacheParallelBuilding */
+        bool getTileCacheParallelBuilding() const;
+        /** \brief returns the statistics of the tile cache, summed over all channels (image, modifier, ...), see \ref JKQTPMathImageViewportRendering */
+        JKQTPImageTilePyramid::Statistics getTileCacheStatistics() const;
+        /** \brief resets the counters in the statistics of the tile cache */
+        void resetTileCacheStatistics();
+        /** \brief drops all tiles from the tile cache */
+        void clearTileCache();
+        /** \brief tells the graph that the image data (or modifier) was changed in place, so all data derived from it
+         *         (tile cache, cached value range, contour lines, ...) is recalculated on the next draw()
+         *
+         *  \see getImageDataKey(), detectImageDataChanges
+         */
+        void markImageDataModified();
+        /** \copydoc detectImageDataChanges */
+        void setDetectImageDataChanges(bool __value);
+        /** \copydoc detectImageDataChanges */
+        bool getDetectImageDataChanges() const;
     protected:
+        /** \brief channels of the image data, which have their own tile cache */
+        enum TileCacheChannel {
+            TileCacheImage=0, /*!< \brief the image data (i.e. data, or the red channel of a JKQTPRGBMathImage ) */
+            TileCacheModifier=1, /*!< \brief the modifier image dataModifier */
+            TileCacheGreen=2, /*!< \brief the green channel of a JKQTPRGBMathImage */
+            TileCacheBlue=3, /*!< \brief the blue channel of a JKQTPRGBMathImage */
+            TileCacheChannelCount=4
+        };
+        /** \brief describes, which part of the image is visible and how it is sampled to the output resolution, see calcViewportSampling() */
+        struct ViewportSampling {
+            /** \brief rectangle (in pixel coordinates) to draw the sampled image into */
+            QRectF target;
+            /** \brief width of the sampled image in pixels */
+            int width=0;
+            /** \brief height of the sampled image in pixels */
+            int height=0;
+            /** \brief number of image pixels per sampled pixel (minimum over both directions) */
+            double downsampling=1.0;
+            /** \brief for each column \c u of the sampled image, the range <code>[cols[2*u]..cols[2*u+1])</code> of image columns it covers */
+            std::vector<int> cols;
+            /** \brief for each row \c b of the sampled image (in data orientation, i.e. row 0 is drawn at the bottom), the range <code>[rows[2*b]..rows[2*b+1])</code> of image rows it covers */
+            std::vector<int> rows;
+        };
+        /** \brief determines the visible part of the image and how it is sampled to (at most) the resolution of the output device of \a painter
+         *
+         *  \return \c false, if no part of the image is visible
+         */
+        bool calcViewportSampling(JKQTPEnhancedPainter& painter, ViewportSampling& sampling) const;
+        /** \brief samples the image \a data (of type \a datatype and size Nx * Ny ) as described by \a sampling into \a out
+         *         (row-major, \c sampling.width * \c sampling.height ), using the tile cache of \a channel if activated */
+        void sampleViewport(const ViewportSampling& sampling, const void* data, JKQTPMathImageDataType datatype, TileCacheChannel channel, std::vector<double>& out);
+        /** \brief returns a key, that changes whenever the data of the given \a channel changes (the tile cache is invalidated, when it changes)
+         *
+         *  The default implementation uses calcImageDataKey() with the pointer \a data . Classes that read their data from a JKQTPDatastore
+         *  override this and use the data key of the column (see JKQTPDatastore::getColumnDataKey() ).
+         */
+        virtual quint64 getTileCacheDataKey(TileCacheChannel channel, const void* data, JKQTPMathImageDataType datatype) const;
+        /** \brief combines \a sourceKey (e.g. the data pointer or the data key of a column), the size Nx * Ny , \a datatype and the counter
+         *         incremented by markImageDataModified() into a key for data derived from \a data . If detectImageDataChanges is \c true ,
+         *         a hash over \a data is added. */
+        quint64 calcImageDataKey(quint64 sourceKey, const void* data, JKQTPMathImageDataType datatype) const;
+        /** \brief returns \c true and the range of the (finite) values of the given \a channel in \a imin and \a imax , if it is
+         *         available without scanning the data, e.g. from the cached statistics of a JKQTPDatastore column
+         *
+         *  This is used by getDataMinMax() and getModifierMinMax() , so an autoscaled image is not rescanned on every redraw.
+         *  The default implementation returns \c false, as the memory behind a raw data pointer may change without notice.
+         *  Classes that read their data from a JKQTPDatastore override this and use JKQTPColumnView::getMinMax() , which is cached
+         *  until the column is modified (see JKQTPDatastore::getColumnDataKey() ).
+         */
+        virtual bool getCachedDataRange(TileCacheChannel channel, double& imin, double& imax) const;
+
         /** \brief points to the data array, holding the image */
         const void* data;
         /** \brief datatype of the data array data */
@@ -281,6 +415,30 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPMathImageBase: public JKQTPImageBase {
         /** \brief overwrite this to fill the data poiters before they are accessed (e.g. to load data from a column in the datastore */
         virtual void ensureImageData();
 
+        /** \brief if \c true (default), draw() only colorizes the visible part of the image at the output resolution, see \ref JKQTPMathImageViewportRendering */
+        bool viewportRendering;
+        /** \brief how the visible part of the image is downsampled, if it contains more pixels than the output device (default: NearestNeighbourDownsampling ) */
+        ViewportDownsamplingMode viewportDownsampling;
+        /** \brief if \c true, zoomed-out images are drawn from a cached tile pyramid (default: \c false ), see \ref JKQTPMathImageViewportRendering */
+        bool useTileCache;
+        /** \brief maximum memory (in bytes) used by the tile cache of each channel (image, modifier, ...) (default: 256 MiB) */
+        size_t tileCacheMaxMemory;
+        /** \brief if \c true (default), missing tiles are built in parallel threads */
+        bool tileCacheParallelBuilding;
+        /** \brief counter, which is incremented by markImageDataModified() , part of getImageDataKey() and getTileCacheDataKey() */
+        quint64 imageDataGeneration;
+        /** \brief if \c true , changes of the image data in place are detected without markImageDataModified() by a hash over the data
+         *         (default: \c false ). This reads the whole image (and modifier) on every draw(), which is what the data keys avoid otherwise. */
+        bool detectImageDataChanges;
+        /** \brief tile cache for each TileCacheChannel, created on first use */
+        std::unique_ptr<JKQTPImageTilePyramid> tileCache[TileCacheChannelCount];
+        /** \brief internal buffer for the sampled visible image values, reused between frames */
+        std::vector<double> viewportSampleBuffer;
+        /** \brief internal buffer for the pixels read from the tile cache, reused between frames */
+        std::vector<double> viewportTileBuffer;
+        /** \brief internal output image of the viewport rendering, reused between frames */
+        QImage viewportImageBuffer;
+
 
 };
 
@@ -428,6 +586,9 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPImage: public JKQTPImageBase {
     \image html imageplot_modifier.png
     \image html imageplot__smallscaletransparent.png
 
+    By default, only the visible part of the image is colorized, at most at the resolution of the output device,
+    see \ref JKQTPMathImageViewportRendering .
+
     \see \ref JKQTPlotterImagePlotNoDatastore
  */
 class JKQTPLOTTER_LIB_EXPORT JKQTPMathImage: public JKQTPMathImageBase, public JKQTPColorPaletteWithModifierStyleAndToolsMixin {
@@ -534,6 +695,15 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPMathImage: public JKQTPMathImageBase, public J
     protected:
         void initJKQTPMathImage();
 
+        /** \brief draws only the visible part of the image, colorized at (at most) the resolution of the output device
+         *
+         *  \return \c false, if this render path can not be used (e.g. for vector output). Then the caller has to fall back to
+         *          drawImage() and plotImage().
+         *
+         *  \see \ref JKQTPMathImageViewportRendering
+         */
+        bool drawVisibleImageRegion(JKQTPEnhancedPainter& painter);
+
     protected:
         /** \brief QActions that saves the image (asking the user for a filename)
          *
@@ -865,6 +1035,25 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumnMathImage: public JKQTPMathImage {
 
         /** \copydoc JKQTPMathImage::ensureImageData() */
         virtual void ensureImageData() override;
+    public:
+        /** \copydoc JKQTPMathImageBase::getImageDataKey()
+         *
+         *  This implementation uses the data key of the imageColumn in the datastore (see JKQTPDatastore::getColumnDataKey() ),
+         *  i.e. it is an O(1) operation, unless detectImageDataChanges is switched on.
+         */
+        virtual quint64 getImageDataKey() const override;
+    protected:
+        /** \copydoc JKQTPMathImageBase::getTileCacheDataKey()
+         *
+         *  This implementation uses the data key of the imageColumn or modifierColumn in the datastore (see JKQTPDatastore::getColumnDataKey() ),
+         *  i.e. it is an O(1) operation, unless detectImageDataChanges is switched on.
+         */
+        virtual quint64 getTileCacheDataKey(TileCacheChannel channel, const void* data, JKQTPMathImageDataType datatype) const override;
+        /** \copydoc JKQTPMathImageBase::getCachedDataRange()
+         *
+         *  This implementation returns the (cached) range of the imageColumn or modifierColumn in the datastore.
+         */
+        virtual bool getCachedDataRange(TileCacheChannel channel, double& imin, double& imax) const override;
 
     private:
         using JKQTPMathImage::setData;
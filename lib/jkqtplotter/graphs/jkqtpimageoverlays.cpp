@@ -380,8 +380,8 @@ int JKQTPColumnOverlayImageEnhanced::getImageColumn() const
     return this->imageColumn;
 }
 void JKQTPColumnOverlayImageEnhanced::draw(JKQTPEnhancedPainter &painter) {
-    const double* d=parent->getDatastore()->getColumnPointer(imageColumn,0);
-    size_t imgSize=parent->getDatastore()->getRows(imageColumn);
+    const JKQTPColumnView d=parent->getDatastore()->getColumnView(imageColumn);
+    size_t imgSize=d.size();
     QVector<bool> locData(imgSize,false);
     this->data=locData.data();
     this->Ny= static_cast<int>(imgSize/this->Nx);
@@ -126,6 +126,7 @@ void JKQTPRGBMathImage::setParent(JKQTBasePlotter* parent) {
 void JKQTPRGBMathImage::draw(JKQTPEnhancedPainter& painter) {
     ensureImageData();
     if (!data && !dataG && !dataB) return;
+    if (viewportRendering && drawVisibleImageRegion(painter)) return;
     QImage img=drawImage();
     plotImage(painter, img, x, y, width, height);
 }
@@ -876,47 +877,8 @@ void JKQTPRGBMathImage::getDataMinMaxG(double& imin, double& imax) {
     if (autoImageRange) {
         imin=imax=0;
         if (!dataG) return;
-        switch(datatype) {
-            case JKQTPMathImageDataType::DoubleArray:
-                imin= JKQTPImagePlot_getImageMin<double>(static_cast<const double*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<double>(static_cast<const double*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::FloatArray:
-                imin= JKQTPImagePlot_getImageMin<float>(static_cast<const float*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<float>(static_cast<const float*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt8Array:
-                imin= JKQTPImagePlot_getImageMin<uint8_t>(static_cast<const uint8_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint8_t>(static_cast<const uint8_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt16Array:
-                imin= JKQTPImagePlot_getImageMin<uint16_t>(static_cast<const uint16_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint16_t>(static_cast<const uint16_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt32Array:
-                imin= JKQTPImagePlot_getImageMin<uint32_t>(static_cast<const uint32_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint32_t>(static_cast<const uint32_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt64Array:
-                imin= JKQTPImagePlot_getImageMin<uint64_t>(static_cast<const uint64_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint64_t>(static_cast<const uint64_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int8Array:
-                imin= JKQTPImagePlot_getImageMin<int8_t>(static_cast<const int8_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int8_t>(static_cast<const int8_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int16Array:
-                imin= JKQTPImagePlot_getImageMin<int16_t>(static_cast<const int16_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int16_t>(static_cast<const int16_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int32Array:
-                imin= JKQTPImagePlot_getImageMin<int32_t>(static_cast<const int32_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int32_t>(static_cast<const int32_t*>(dataG), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int64Array:
-                imin= JKQTPImagePlot_getImageMin<int64_t>(static_cast<const int64_t*>(dataG), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int64_t>(static_cast<const int64_t*>(dataG), Nx, Ny);
-                break;
+        if (!getCachedDataRange(TileCacheGreen, imin, imax)) {
+            JKQTPImagePlot_getImageMinMax(dataG, datatypeG, Nx, Ny, imin, imax);
         }
     } else {
         imin=imageMinG;
@@ -928,48 +890,9 @@ void JKQTPRGBMathImage::getDataMinMaxB(double& imin, double& imax) {
     ensureImageData();
     if (autoImageRange) {
         imin=imax=0;
-        if (!dataG) return;
-        switch(datatype) {
-            case JKQTPMathImageDataType::DoubleArray:
-                imin= JKQTPImagePlot_getImageMin<double>(static_cast<const double*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<double>(static_cast<const double*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::FloatArray:
-                imin= JKQTPImagePlot_getImageMin<float>(static_cast<const float*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<float>(static_cast<const float*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt8Array:
-                imin= JKQTPImagePlot_getImageMin<uint8_t>(static_cast<const uint8_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint8_t>(static_cast<const uint8_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt16Array:
-                imin= JKQTPImagePlot_getImageMin<uint16_t>(static_cast<const uint16_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint16_t>(static_cast<const uint16_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt32Array:
-                imin= JKQTPImagePlot_getImageMin<uint32_t>(static_cast<const uint32_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint32_t>(static_cast<const uint32_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::UInt64Array:
-                imin= JKQTPImagePlot_getImageMin<uint64_t>(static_cast<const uint64_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<uint64_t>(static_cast<const uint64_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int8Array:
-                imin= JKQTPImagePlot_getImageMin<int8_t>(static_cast<const int8_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int8_t>(static_cast<const int8_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int16Array:
-                imin= JKQTPImagePlot_getImageMin<int16_t>(static_cast<const int16_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int16_t>(static_cast<const int16_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int32Array:
-                imin= JKQTPImagePlot_getImageMin<int32_t>(static_cast<const int32_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int32_t>(static_cast<const int32_t*>(dataB), Nx, Ny);
-                break;
-            case JKQTPMathImageDataType::Int64Array:
-                imin= JKQTPImagePlot_getImageMin<int64_t>(static_cast<const int64_t*>(dataB), Nx, Ny);
-                imax= JKQTPImagePlot_getImageMax<int64_t>(static_cast<const int64_t*>(dataB), Nx, Ny);
-                break;
+        if (!dataB) return;
+        if (!getCachedDataRange(TileCacheBlue, imin, imax)) {
+            JKQTPImagePlot_getImageMinMax(dataB, datatypeB, Nx, Ny, imin, imax);
         }
     } else {
         imin=imageMinB;
@@ -1066,24 +989,66 @@ void JKQTPRGBMathImage::copyImagePlotAsImage()
     }
 }
 
+namespace {
+    /** \brief fills \a img with the initial color for the given \a rgbMode , before the channels are drawn into it */
+    void JKQTPRGBMathImageFillBackground(QImage& img, JKQTPRGBMathImageRGBMode rgbMode) {
+        if (rgbMode==JKQTPRGBMathImageModeRGBMode) {
+            img.fill(Qt::transparent);
+        } else if (rgbMode==JKQTPRGBMathImageModeCMYMode) {
+            img.fill(Qt::white);
+        } else if (rgbMode==JKQTPRGBMathImageModeHSVMode) {
+            QColor c("white");
+            c.setHsv(0,255,255);
+            img.fill(c.rgba());
+        } else if (rgbMode==JKQTPRGBMathImageModeHSLMode) {
+            QColor c("white");
+            c.setHsv(0,255,127);
+            img.fill(c.rgba());
+        }
+    }
+}
+
+bool JKQTPRGBMathImage::drawVisibleImageRegion(JKQTPEnhancedPainter &painter)
+{
+    if (painter.painterFlags().testFlag(JKQTPEnhancedPainter::VectorPainting)) return false;
+    ViewportSampling sampling;
+    if (!calcViewportSampling(painter, sampling)) return true;
+
+    if (viewportImageBuffer.width()!=sampling.width || viewportImageBuffer.height()!=sampling.height || viewportImageBuffer.format()!=QImage::Format_ARGB32) {
+        viewportImageBuffer=QImage(sampling.width, sampling.height, QImage::Format_ARGB32);
+    }
+    JKQTPRGBMathImageFillBackground(viewportImageBuffer, rgbMode);
+    getModifierMinMax(internalModifierMin, internalModifierMax);
+    getDataMinMax(internalDataMin, internalDataMax);
+    getDataMinMaxG(internalDataMinG, internalDataMaxG);
+    getDataMinMaxB(internalDataMinB, internalDataMaxB);
+    if (data) {
+        sampleViewport(sampling, data, datatype, TileCacheImage, viewportSampleBuffer);
+        JKQTPImagePlot_array2RGBimage<double>(viewportSampleBuffer.data(), sampling.width, sampling.height, viewportImageBuffer, 0, internalDataMin, internalDataMax, rgbMode);
+    }
+    if (dataG) {
+        sampleViewport(sampling, dataG, datatypeG, TileCacheGreen, viewportSampleBuffer);
+        JKQTPImagePlot_array2RGBimage<double>(viewportSampleBuffer.data(), sampling.width, sampling.height, viewportImageBuffer, 1, internalDataMinG, internalDataMaxG, rgbMode);
+    }
+    if (dataB) {
+        sampleViewport(sampling, dataB, datatypeB, TileCacheBlue, viewportSampleBuffer);
+        JKQTPImagePlot_array2RGBimage<double>(viewportSampleBuffer.data(), sampling.width, sampling.height, viewportImageBuffer, 2, internalDataMinB, internalDataMaxB, rgbMode);
+    }
+    if (dataModifier && modifierMode!=JKQTPMathImageModifierMode::ModifyNone) {
+        sampleViewport(sampling, dataModifier, datatypeModifier, TileCacheModifier, viewportSampleBuffer);
+        JKQTPModifyImage(viewportImageBuffer, modifierMode, viewportSampleBuffer.data(), JKQTPMathImageDataType::DoubleArray, sampling.width, sampling.height, internalModifierMin, internalModifierMax);
+    }
+
+    painter.drawImage(sampling.target, viewportImageBuffer);
+    return true;
+}
+
 QImage JKQTPRGBMathImage::drawImage() {
     ensureImageData();
     if (!data && !dataG && !dataB) return QImage();
     QImage img(Nx, Ny, QImage::Format_ARGB32);
 
-    if (rgbMode==JKQTPRGBMathImageModeRGBMode) {
-        img.fill(Qt::transparent);
-    } else if (rgbMode==JKQTPRGBMathImageModeCMYMode) {
-        img.fill(Qt::white);
-    } else if (rgbMode==JKQTPRGBMathImageModeHSVMode) {
-        QColor c("white");
-        c.setHsv(0,255,255);
-        img.fill(c.rgba());
-    } else if (rgbMode==JKQTPRGBMathImageModeHSLMode) {
-        QColor c("white");
-        c.setHsv(0,255,127);
-        img.fill(c.rgba());
-    }
+    JKQTPRGBMathImageFillBackground(img, rgbMode);
     getModifierMinMax(internalModifierMin, internalModifierMax);
     getDataMinMax(internalDataMin, internalDataMax);
     getDataMinMaxG(internalDataMinG, internalDataMaxG);
@@ -1274,12 +1239,13 @@ bool JKQTPColumnRGBMathImage::usesColumn(int c) const
 void JKQTPColumnRGBMathImage::ensureImageData()
 {
     JKQTPRGBMathImage::ensureImageData();
-    this->datatype=JKQTPMathImageDataType::DoubleArray;
-    this->datatypeG=JKQTPMathImageDataType::DoubleArray;
-    this->datatypeB=JKQTPMathImageDataType::DoubleArray;
-    this->data=parent->getDatastore()->getColumnPointer(imageRColumn,0);
-    this->dataG=parent->getDatastore()->getColumnPointer(imageGColumn,0);
-    this->dataB=parent->getDatastore()->getColumnPointer(imageBColumn,0);
+    const JKQTPDatastore* ds=parent->getDatastore();
+    this->datatype=ds->getColumnDataType(imageRColumn);
+    this->datatypeG=ds->getColumnDataType(imageGColumn);
+    this->datatypeB=ds->getColumnDataType(imageBColumn);
+    this->data=ds->getColumnRawPointer(imageRColumn,0);
+    this->dataG=ds->getColumnRawPointer(imageGColumn,0);
+    this->dataB=ds->getColumnRawPointer(imageBColumn,0);
     /*if (Nx*Ny==0 || Nx*Ny>parent->getDatastore()->getRows(imageRColumn)) {
         if (Nx>0) {
             Ny=parent->getDatastore()->getRows(imageRColumn)/this->Nx;
@@ -1288,8 +1254,31 @@ void JKQTPColumnRGBMathImage::ensureImageData()
             Ny=1;
         }
     }*/
-    this->datatypeModifier=JKQTPMathImageDataType::DoubleArray;
-    this->dataModifier=parent->getDatastore()->getColumnPointer(modifierColumn,0);
+    this->datatypeModifier=ds->getColumnDataType(modifierColumn);
+    this->dataModifier=ds->getColumnRawPointer(modifierColumn,0);
+}
+
+quint64 JKQTPColumnRGBMathImage::getTileCacheDataKey(TileCacheChannel channel, const void *data, JKQTPMathImageDataType datatype) const
+{
+    int column=imageRColumn;
+    if (channel==TileCacheGreen) column=imageGColumn;
+    else if (channel==TileCacheBlue) column=imageBColumn;
+    else if (channel==TileCacheModifier) column=modifierColumn;
+    return calcImageDataKey(parent->getDatastore()->getColumnDataKey(column), data, datatype);
+}
+
+bool JKQTPColumnRGBMathImage::getCachedDataRange(TileCacheChannel channel, double &imin, double &imax) const
+{
+    // see JKQTPColumnMathImage::getCachedDataRange()
+    if (detectImageDataChanges) return false;
+    int column=imageRColumn;
+    if (channel==TileCacheGreen) column=imageGColumn;
+    else if (channel==TileCacheBlue) column=imageBColumn;
+    else if (channel==TileCacheModifier) column=modifierColumn;
+    const JKQTPColumnView col=parent->getDatastore()->getColumnView(column);
+    if (!col.isValid()) return false;
+    col.getMinMax(0, static_cast<size_t>(Nx)*static_cast<size_t>(Ny), imin, imax);
+    return true;
 }
 
 
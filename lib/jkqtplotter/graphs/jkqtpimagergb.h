@@ -42,6 +42,9 @@
 
     Using setRgbMode() you can also use a different color system than RGB.
 
+    By default, only the visible part of the image is colorized, at most at the resolution of the output device,
+    see \ref JKQTPMathImageViewportRendering .
+
     \image html rgbimageplots.png
     \image html rgbimageplot_opencv.png
 
@@ -329,6 +332,14 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPRGBMathImage: public JKQTPMathImageBase {
 
     protected:
         void initObject();
+        /** \brief draws only the visible part of the image, colorized at (at most) the resolution of the output device
+         *
+         *  \return \c false, if this render path can not be used (e.g. for vector output). Then the caller has to fall back to
+         *          drawImage() and plotImage().
+         *
+         *  \see \ref JKQTPMathImageViewportRendering
+         */
+        bool drawVisibleImageRegion(JKQTPEnhancedPainter& painter);
         /** \brief points to the data array, holding the image */
         const void* dataG;
         /** \brief datatype of the data array data */
@@ -624,6 +635,17 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumnRGBMathImage: public JKQTPRGBMathImage {
         int modifierColumn;
         /** \copydoc JKQTPRGBMathImage::ensureImageData() */
         void ensureImageData() override;
+        /** \copydoc JKQTPMathImageBase::getTileCacheDataKey()
+         *
+         *  This implementation uses the data key of the corresponding image column in the datastore (see JKQTPDatastore::getColumnDataKey() ),
+         *  i.e. it is an O(1) operation, unless detectImageDataChanges is switched on.
+         */
+        virtual quint64 getTileCacheDataKey(TileCacheChannel channel, const void* data, JKQTPMathImageDataType datatype) const override;
+        /** \copydoc JKQTPMathImageBase::getCachedDataRange()
+         *
+         *  This implementation returns the (cached) range of the corresponding image column in the datastore.
+         */
+        virtual bool getCachedDataRange(TileCacheChannel channel, double& imin, double& imax) const override;
 
     private:
         using JKQTPRGBMathImage::setData;
@@ -105,6 +105,7 @@ bool JKQTPImpulsesGraphBase::getValuesMinMax(double &mmin, double &mmax, double
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView dataValues=datastore->getColumnView(datacol);
     int imin=0, imax=0;
     if (getIndexRange(imin, imax)) {
 
@@ -117,7 +118,7 @@ bool JKQTPImpulsesGraphBase::getValuesMinMax(double &mmin, double &mmax, double
                 double xvsgz;
                 xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
             }
-            yv=datastore->get(datacol,static_cast<size_t>(i));
+            yv=dataValues.getValue(i);
             if (JKQTPIsOKFloat(yv)) {
                 if (yv>mmax) mmax=yv;
                 if (yv<mmin) mmin=yv;
@@ -144,10 +145,11 @@ bool JKQTPImpulsesGraphBase::getPositionsMinMax(double &mmin, double &mmax, doub
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView posValues=datastore->getColumnView(poscol);
     int imin=0, imax=0;
     if (getIndexRange(imin, imax)) {
         for (int i=imin; i<imax; i++) {
-            double xv=datastore->get(poscol,static_cast<size_t>(i));
+            double xv=posValues.getValue(i);
 
 
             if (JKQTPIsOKFloat(xv)) {
@@ -190,6 +192,8 @@ void JKQTPImpulsesHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     drawErrorsBefore(painter);
     {
@@ -214,26 +218,30 @@ void JKQTPImpulsesHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
             QVector<QLineF> lines;
             QVector<QPointF> points;
             intSortData();
-            for (int iii=imin; iii<imax; iii++) {
-                const int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
-                    const double x=transformX(xv);
-                    const double y=transformY(yv);
-                    if (firstXY) {
-                        bottom=y;
-                        top=y;
-                    } else {
-                        bottom=qMax(bottom, y);
-                        top=qMin(top, y);
-                    }
-                    firstXY=false;
-                    lines.append(QLineF(x0, y, x, y));
-                    points.append(QPointF(x,y));
+            JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+                for (int iii=imin; iii<imax; iii++) {
+                    if (isDrawingAborted()) return;
+                    const int i=qBound(imin, getDataIndex(iii), imax);
+                    const double xv=xCol.getValue(i);
+                    const double yv=yCol.getValue(i);
+                    if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)) {
+                        const double x=transformX(xv);
+                        const double y=transformY(yv);
+                        if (firstXY) {
+                            bottom=y;
+                            top=y;
+                        } else {
+                            bottom=qMax(bottom, y);
+                            top=qMin(top, y);
+                        }
+                        firstXY=false;
+                        lines.append(QLineF(x0, y, x, y));
+                        points.append(QPointF(x,y));
 
+                    }
                 }
-            }
+            });
+            if (isDrawingAborted()) return;
             painter.setPen(p);
             if (lines.size()>0) painter.drawLines(lines);
             if (drawSymbols && points.size()>0) {
@@ -346,6 +354,8 @@ void JKQTPImpulsesVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     drawErrorsBefore(painter);
     {
@@ -371,28 +381,32 @@ void JKQTPImpulsesVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
             QVector<QLineF> lines;
             QVector<QPointF> points;
             intSortData();
-            for (int iii=imin; iii<imax; iii++) {
-                const int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv) ) {
-                    const double x=transformX(xv);
-                    const double y=transformY(yv);
-                    if (firstXY) {
-                        left=x;
-                        right=x;
-                    } else {
-                        left=qMin(left, x);
-                        right=qMax(right, x);
-                    }
-                    firstXY=false;
-
-
-                    lines.append(QLineF(x, y0, x, y));
-                    points.append(QPointF(x,y));
+            JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+                for (int iii=imin; iii<imax; iii++) {
+                    if (isDrawingAborted()) return;
+                    const int i=qBound(imin, getDataIndex(iii), imax);
+                    const double xv=xCol.getValue(i);
+                    const double yv=yCol.getValue(i);
+                    if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv) ) {
+                        const double x=transformX(xv);
+                        const double y=transformY(yv);
+                        if (firstXY) {
+                            left=x;
+                            right=x;
+                        } else {
+                            left=qMin(left, x);
+                            right=qMax(right, x);
+                        }
+                        firstXY=false;
+
+
+                        lines.append(QLineF(x, y0, x, y));
+                        points.append(QPointF(x,y));
 
+                    }
                 }
-            }
+            });
+            if (isDrawingAborted()) return;
             painter.setPen(p);
             if (lines.size()>0) painter.drawLines(lines);
             if (drawSymbols && points.size()>0) {
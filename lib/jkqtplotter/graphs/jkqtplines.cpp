@@ -53,7 +53,8 @@ JKQTPXYLineGraph::~JKQTPXYLineGraph() = default;
 JKQTPXYLineGraph::JKQTPXYLineGraph(JKQTBasePlotter* parent):
     JKQTPXYGraph(parent),
     drawLine(true),
-    drawLineInForeground(true)
+    drawLineInForeground(true),
+    useMinMaxDecimation(false)
 {
     sortData=JKQTPXYGraph::Unsorted;
 
@@ -68,6 +69,8 @@ void JKQTPXYLineGraph::draw(JKQTPEnhancedPainter& painter) {
     if (parent==nullptr) return;
     const JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     //qDebug()<<"JKQTPXYLineGraph::draw();";
 
@@ -96,36 +99,52 @@ void JKQTPXYLineGraph::draw(JKQTPEnhancedPainter& painter) {
 
             QVector<QPointF> symbols;
             QList<QPolygonF> vec_linesP;
-            vec_linesP.push_back(QPolygonF());
             intSortData();
-            for (int iii=imin; iii<imax; iii++) {
-                const int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                const double x=transformX(xv);
-                const double y=transformY(yv);
-                //qDebug()<<"JKQTPXYLineGraph::draw(): (xv, yv) =    ( "<<xv<<", "<<yv<<" )";
-                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
-
-                    //if (isHighlighted() && getSymbolType()!=JKQTPNoSymbol) {
-                        //JKQTPPlotSymbol(painter, x, y, JKQTPFilledCircle, parent->pt2px(painter, symbolSize*1.5), parent->pt2px(painter, symbolWidth*parent->getLineWidthMultiplier()), penSelection.color(), penSelection.color(),getSymbolFont());
-                    //}
-                    if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
-                        if (symType!=JKQTPNoSymbol && cliprect.contains(x,y)) {
-                            if (drawLineInForeground) plotStyledSymbol(parent, painter, x, y);
-                            else symbols.push_back({x,y});
-                        }
-                        if (drawLine) {
-                            vec_linesP.last() << QPointF(x,y);
-                        }
-                    } else {
-                        if (drawLine) {
-                            if (vec_linesP.size()==0 || vec_linesP.last().size()>0)
-                            vec_linesP.push_back(QPolygonF());
+            bool decimated=false;
+            // the bins of the decimation are the pixel columns of the output device (e.g. on HiDPI screens one logical pixel
+            // covers several device pixels), this is only possible, if the painter does not rotate or shear
+            const QTransform deviceTransform=painter.deviceTransform();
+            if (useMinMaxDecimation && drawLine && symType==JKQTPNoSymbol && deviceTransform.type()<=QTransform::TxScale && deviceTransform.m11()!=0.0) {
+                decimated=buildMinMaxDecimatedLinesFromPyramid(vec_linesP, xData, yData, imin, imax, cliprect, deviceTransform);
+                if (!decimated) decimated=buildMinMaxDecimatedLines(vec_linesP, xData, yData, imin, imax, deviceTransform);
+            }
+            if (!decimated) {
+                vec_linesP.clear();
+                vec_linesP.push_back(QPolygonF());
+                JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+                    for (int iii=imin; iii<imax; iii++) {
+                        if (isDrawingAborted()) return;
+                        const int i=qBound(imin, getDataIndex(iii), imax);
+                        const double xv=xCol.getValue(i);
+                        const double yv=yCol.getValue(i);
+                        const double x=transformX(xv);
+                        const double y=transformY(yv);
+                        //qDebug()<<"JKQTPXYLineGraph::draw(): (xv, yv) =    ( "<<xv<<", "<<yv<<" )";
+                        if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+
+                            //if (isHighlighted() && getSymbolType()!=JKQTPNoSymbol) {
+                                //JKQTPPlotSymbol(painter, x, y, JKQTPFilledCircle, parent->pt2px(painter, symbolSize*1.5), parent->pt2px(painter, symbolWidth*parent->getLineWidthMultiplier()), penSelection.color(), penSelection.color(),getSymbolFont());
+                            //}
+                            if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
+                                if (symType!=JKQTPNoSymbol && cliprect.contains(x,y)) {
+                                    symbols.push_back({x,y});
+                                }
+                                if (drawLine) {
+                                    vec_linesP.last() << QPointF(x,y);
+                                }
+                            } else {
+                                if (drawLine) {
+                                    if (vec_linesP.size()==0 || vec_linesP.last().size()>0)
+                                    vec_linesP.push_back(QPolygonF());
+                                }
+                            }
                         }
                     }
-                }
+                });
+                if (isDrawingAborted()) return;
             }
+            // all visible symbols are drawn with one call, so the symbol sprite is looked up only once per frame
+            if (drawLineInForeground) plotStyledSymbols(parent, painter, symbols);
             //qDebug()<<"JKQTPXYLineGraph::draw(): "<<4<<" lines="<<lines.size();
             //qDebug()<<"JKQTPXYLineGraph::draw(): "<<5<<"  p="<<painter.pen();
             if (drawLine) {
@@ -148,9 +167,7 @@ void JKQTPXYLineGraph::draw(JKQTPEnhancedPainter& painter) {
                     }
                 }
             }
-            for (const auto& s: symbols) {
-                plotStyledSymbol(parent, painter, s.x(), s.y());
-            }
+            if (!drawLineInForeground) plotStyledSymbols(parent, painter, symbols);
             //qDebug()<<"JKQTPXYLineGraph::draw(): "<<6;
         }
     }
@@ -174,6 +191,11 @@ QColor JKQTPXYLineGraph::getKeyLabelColor() const {
     return getSymbolColor();
 }
 
+bool JKQTPXYLineGraph::canDrawInParallel() const
+{
+    return true;
+}
+
 void JKQTPXYLineGraph::setDrawLine(bool __value)
 {
     this->drawLine = __value;
@@ -194,6 +216,145 @@ bool JKQTPXYLineGraph::getDrawLineInForeground() const
     return drawLineInForeground;
 }
 
+void JKQTPXYLineGraph::setUseMinMaxDecimation(bool __value)
+{
+    useMinMaxDecimation=__value;
+}
+
+bool JKQTPXYLineGraph::getUseMinMaxDecimation() const
+{
+    return useMinMaxDecimation;
+}
+
+bool JKQTPXYLineGraph::buildMinMaxDecimatedLines(QList<QPolygonF> &lines, const JKQTPColumnView &xData, const JKQTPColumnView &yData, int imin, int imax, const QTransform &deviceTransform)
+{
+    lines.clear();
+    lines.push_back(QPolygonF());
+    // one bin per device pixel column, i.e. the bin boundaries are at the x-coordinates, where deviceTransform.map(x) is an integer
+    JKQTPMinMaxPolyLineDecimator decimator(&lines.last(), 1.0/fabs(deviceTransform.m11()), -deviceTransform.dx()/deviceTransform.m11());
+    const bool xLog=getXAxis()->isLogAxis();
+    const bool yLog=getYAxis()->isLogAxis();
+    bool ok=true;
+    JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+        for (int iii=imin; iii<imax; iii++) {
+            if (isDrawingAborted()) {
+                ok=false;
+                return;
+            }
+            const int i=qBound(imin, getDataIndex(iii), imax);
+            const double xv=xCol.getValue(i);
+            const double yv=yCol.getValue(i);
+            const double x=transformX(xv);
+            const double y=transformY(yv);
+            if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+                if ((!xLog || xv>0.0) && (!yLog || yv>0.0) ) {
+                    if (!decimator.add(QPointF(x,y))) {
+                        ok=false;
+                        return;
+                    }
+                } else {
+                    // same as in draw(): invalid points on log-axes split the line
+                    decimator.flush();
+                    if (lines.last().size()>0) {
+                        lines.push_back(QPolygonF());
+                        decimator.setOutput(&lines.last());
+                    }
+                }
+            }
+        }
+    });
+    if (!ok) return false;
+    decimator.flush();
+    return true;
+}
+
+bool JKQTPXYLineGraph::buildMinMaxDecimatedLinesFromPyramid(QList<QPolygonF> &lines, const JKQTPColumnView &xData, const JKQTPColumnView &yData, int imin, int imax, const QRectF &cliprect, const QTransform &deviceTransform)
+{
+    // x-coordinate on the output device, the pixel columns of the device are the bins of the decimation
+    const auto deviceX=[&deviceTransform](double x) { return deviceTransform.m11()*x+deviceTransform.dx(); };
+    const double deviceLeft=qMin(deviceX(cliprect.left()), deviceX(cliprect.right()));
+    const double deviceRight=qMax(deviceX(cliprect.left()), deviceX(cliprect.right()));
+    // only worth it, if there are considerably more datapoints than pixel columns
+    if (getDataSortOrder()!=Unsorted || imin<0 || imax-imin<2 || static_cast<double>(imax-imin)<4.0*(deviceRight-deviceLeft)) return false;
+    const auto xPyramid=xData.getMinMaxPyramid();
+    const auto yPyramid=yData.getMinMaxPyramid();
+    if (!xPyramid || !yPyramid) return false;
+    if (!xPyramid->isSortedAscending() && !xPyramid->isSortedDescending()) return false;
+    // NaNs split the line, but their positions are not known from the pyramid
+    if (yPyramid->hasNonFiniteValues()) return false;
+
+    const size_t rmin=static_cast<size_t>(imin);
+    const size_t rmax=static_cast<size_t>(imax);
+    // on log-axes, values <=0 split the line
+    if (getXAxis()->isLogAxis() && (xData[rmin]<=0.0 || xData[rmax-1]<=0.0)) return false;
+    if (getYAxis()->isLogAxis()) {
+        double ymin=0, ymax=0;
+        if (!yData.getMinMax(*yPyramid, rmin, rmax, ymin, ymax) || ymin<=0.0) return false;
+    }
+
+    // key(i) is the index of the device pixel column of row i, with the sign chosen so key(i) is non-decreasing in i
+    const bool pixelsAscending=deviceX(transformX(xData[rmax-1]))>=deviceX(transformX(xData[rmin]));
+    const double keyDir=pixelsAscending?1.0:-1.0;
+    const auto key=[&](size_t i) { return keyDir*floor(deviceX(transformX(xData[i]))); };
+    // returns the first row in [from..to) with key(row)>k (or to), using an exponential, followed by a binary search
+    const auto firstGreater=[&key](size_t from, size_t to, double k) {
+        size_t lo=from;
+        size_t hi=from;
+        while (hi<to && key(hi)<=k) {
+            lo=hi+1;
+            hi=from+2*(hi-from)+1;
+        }
+        if (hi>to) hi=to;
+        while (lo<hi) {
+            const size_t mid=lo+(hi-lo)/2;
+            if (key(mid)<=k) lo=mid+1;
+            else hi=mid;
+        }
+        return lo;
+    };
+
+    // restrict to the visible pixel columns, plus one row on either side, so the line enters/leaves the plot correctly
+    const double keyFirst=pixelsAscending?floor(deviceLeft):-floor(deviceRight);
+    const double keyLast=pixelsAscending?floor(deviceRight):-floor(deviceLeft);
+    size_t i=firstGreater(rmin, rmax, keyFirst-1.0);
+    if (i>rmin) i--;
+    size_t end=firstGreater(i, rmax, keyLast);
+    if (end<rmax) end++;
+
+    lines.clear();
+    lines.push_back(QPolygonF());
+    QPolygonF& line=lines.last();
+    while (i<end) {
+        // rows [i..j) fall into the same pixel column: add first, min, max and last of them
+        const size_t j=firstGreater(i+1, end, key(i));
+        const double yFirst=yData[i];
+        const QPointF first(transformX(xData[i]), transformY(yFirst));
+        line<<first;
+        if (j-i>1) {
+            const double yLast=yData[j-1];
+            const QPointF last(transformX(xData[j-1]), transformY(yLast));
+            double ymin=0, ymax=0;
+            if (j-i>2 && yData.getMinMax(*yPyramid, i+1, j-1, ymin, ymax)) {
+                // the rows of min and max are not known from the pyramid, but they lie in the same device pixel column
+                // as first and last, so xMid is at most half a device pixel off
+                const double xMid=(first.x()+last.x())/2.0;
+                const bool addMin=ymin<qMin(yFirst, yLast);
+                const bool addMax=ymax>qMax(yFirst, yLast);
+                if (yFirst<=yLast) {
+                    if (addMin) line<<QPointF(xMid, transformY(ymin));
+                    if (addMax) line<<QPointF(xMid, transformY(ymax));
+                } else {
+                    if (addMax) line<<QPointF(xMid, transformY(ymax));
+                    if (addMin) line<<QPointF(xMid, transformY(ymin));
+                }
+            }
+            line<<last;
+        }
+        i=j;
+    }
+    return true;
+}
+
 void JKQTPXYLineGraph::setColor(QColor c)
 {
     setLineColor(c);
@@ -230,18 +391,19 @@ bool JKQTPXYLineErrorGraph::getXMinMax(double &minx, double &maxx, double &small
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView xData=datastore->getColumnView(xColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))+getXErrorU(i, datastore);
+                double xv=xData.getValue(i)+getXErrorU(i, datastore);
                 if (JKQTPIsOKFloat(xv)) {
                     if (start || xv>maxx) maxx=xv;
                     if (start || xv<minx) minx=xv;
                     const double xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
                     start=false;
                 }
-                xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))-getXErrorL(i, datastore);
+                xv=xData.getValue(i)-getXErrorL(i, datastore);
                 if (JKQTPIsOKFloat(xv)) {
                     if (start || xv>maxx) maxx=xv;
                     if (start || xv<minx) minx=xv;
@@ -267,18 +429,19 @@ bool JKQTPXYLineErrorGraph::getYMinMax(double &miny, double &maxy, double &small
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView yData=datastore->getColumnView(yColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))+getYErrorU(i, datastore);
+                double yv=yData.getValue(i)+getYErrorU(i, datastore);
                 if (JKQTPIsOKFloat(yv)) {
                     if (start || yv>maxy) maxy=yv;
                     if (start || yv<miny) miny=yv;
                     const double xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
                     start=false;
                 }
-                yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))-getYErrorL(i, datastore);
+                yv=yData.getValue(i)-getYErrorL(i, datastore);
                 if (JKQTPIsOKFloat(yv)) {
                     if (start || yv>maxy) maxy=yv;
                     if (start || yv<miny) miny=yv;
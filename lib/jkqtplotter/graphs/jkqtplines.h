@@ -54,6 +54,10 @@ class JKQTPDatastore;
     \note This classes can (and does by default) apply a line-compression strategy that improves plotting speed
           but reduces accuracy a bit. See JKQTPGraphLinesCompressionMixin for details.
 
+    \note For large datasets with monotonic x-values (e.g. time-series) you can activate a min/max-decimation with
+          setUseMinMaxDecimation(), which reduces the line to at most four points per pixel column before drawing.
+          See useMinMaxDecimation for details.
+
     \see \ref JKQTPlotterAdvancedLineAndFillStyling, \ref JKQTPlotterSimpleTest, \ref JKQTPlotterSymbolsAndStyles,
          jkqtpstatAddVKDE1D(), jkqtpstatAddVKDE1DAutoranged(), jkqtpstatAddHKDE1D(), jkqtpstatAddHKDE1DAutoranged(),
          JKQTPGraphLinesCompressionMixin
@@ -69,6 +73,8 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYLineGraph: public JKQTPXYGraph, public JKQTP
 
         /** \brief plots the graph to the plotter object specified as parent */
         virtual void draw(JKQTPEnhancedPainter& painter) override;
+        /** \copydoc JKQTPPlotElement::canDrawInParallel() */
+        virtual bool canDrawInParallel() const override;
         /** \brief plots a key marker inside the specified rectangle \a rect */
         virtual void drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect) override;
         /** \brief returns the color to be used for the key label */
@@ -83,6 +89,11 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYLineGraph: public JKQTPXYGraph, public JKQTP
         /** \copydoc drawLineInForeground */
         bool getDrawLineInForeground() const;
 
+        /** \copydoc useMinMaxDecimation */
+        void setUseMinMaxDecimation(bool __value);
+        /** \copydoc useMinMaxDecimation */
+        bool getUseMinMaxDecimation() const;
+
         /** \brief set color of line and symbol */
         void setColor(QColor c);
 
@@ -92,6 +103,39 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYLineGraph: public JKQTPXYGraph, public JKQTP
         bool drawLine;
         /** \brief indicates whether to draw the line behind or above the symbols */
         bool drawLineInForeground;
+        /** \brief if \c true, the line is decimated to at most four points (first, min, max, last) per pixel column before drawing
+         *
+         *  This is applied only if the graph draws no symbols and the x-values of the data (in the order given by sortData )
+         *  are monotonic, e.g. for a time-series. In that case the output looks the same as without decimation,
+         *  but the drawing time scales with the width of the plot, not with the number of datapoints.
+         *  If the data is not monotonic in x, the graph falls back to the non-decimated drawing. The pixel columns are those of the output
+         *  device, so on HiDPI screens (or when drawing with a scaled painter) more points are retained.
+         *
+         *  If the x-column is sorted and the y-column contains no NaNs, the min/max of each pixel column is read from the
+         *  (cached) JKQTPColumnMinMaxPyramid of the y-column and only the visible part of the data is considered. Then
+         *  redrawing (e.g. while panning/zooming) takes O(pixels*log N) steps, instead of a full pass over the data.
+         *
+         *  \see JKQTPMinMaxPolyLineDecimator, JKQTPColumnMinMaxPyramid
+         */
+        bool useMinMaxDecimation;
+
+        /** \brief builds the poly-lines to draw for the datapoints \a imin ... \a imax-1 using JKQTPMinMaxPolyLineDecimator
+         *
+         *  The bins are the pixel columns of the output device, as given by \a deviceTransform (see QPainter::deviceTransform() ),
+         *  which has to be a pure scaling/translation.
+         *
+         *  \return \c false if the x-values are not monotonic (then \a lines is not usable)
+         */
+        bool buildMinMaxDecimatedLines(QList<QPolygonF>& lines, const JKQTPColumnView& xData, const JKQTPColumnView& yData, int imin, int imax, const QTransform& deviceTransform);
+        /** \brief builds the min/max-decimated poly-line for the datapoints \a imin ... \a imax-1 within \a cliprect from the min/max pyramid of the y-column
+         *
+         *  For each pixel column of the output device (as given by \a deviceTransform , see QPainter::deviceTransform() ), the rows in it
+         *  are found by a binary search on the sorted x-values and the min/max of these rows is read from the JKQTPColumnMinMaxPyramid of \a yData.
+         *
+         *  \return \c false if this is not applicable (unsorted x-values, NaNs in the y-values, sortData is set, ...),
+         *          then \a lines is not usable and buildMinMaxDecimatedLines() should be used instead
+         */
+        bool buildMinMaxDecimatedLinesFromPyramid(QList<QPolygonF>& lines, const JKQTPColumnView& xData, const JKQTPColumnView& yData, int imin, int imax, const QRectF& cliprect, const QTransform& deviceTransform);
 
 
 };
@@ -26,6 +26,7 @@
 #include <QDebug>
 #include <QElapsedTimer>
 #include <utility>
+#include <mutex>
 
 JKQTPParsedFunctionLineGraphBase::JKQTPParsedFunctionLineGraphBase(const QString& dependentVariableName_, const QString& function_, JKQTBasePlotter *parent):
     JKQTPEvaluatedFunctionWithErrorsGraphDrawingBase(parent),
@@ -64,6 +65,7 @@ JKQTPParsedFunctionLineGraphBase::~JKQTPParsedFunctionLineGraphBase()
 
 void JKQTPParsedFunctionLineGraphBase::setFunction(const QString &__value)
 {
+    if (this->function!=__value) clearSampleCache();
     this->function = __value;
 }
 
@@ -91,7 +93,18 @@ QString JKQTPParsedFunctionLineGraphBase::getDependentVariableName() const
 
 double JKQTPParsedFunctionLineGraphBase::evaluateParsedFunction(double t, ParsedFunctionLineGraphFunctionData *fdata) {
     JKQTPParsedFunctionLineGraphBase::ParsedFunctionLineGraphFunctionData* d=fdata;//static_cast<JKQTPXParsedFunctionLineGraph::JKQTPXParsedFunctionLineGraphFunctionData*>(data);
+    if (d && d->byteCode.isValid()) {
+        try {
+            return d->byteCode.evaluate(t);
+        } catch(std::exception& E) {
+            qDebug()<<QString("parser error: %1").arg(E.what());
+        }
+        return NAN;
+    }
     if (d && d->parser && d->node) {
+        // evaluating the node tree modifies the parser, so it has to be serialized, if setParallelEvaluation() is active
+        static std::mutex treeEvaluationMutex;
+        std::lock_guard<std::mutex> lock(treeEvaluationMutex);
         try {
             d->parser->addVariableDouble(d->dependentVariableName.toStdString(), t);
             JKQTPMathParser::jkmpResult r=d->node->evaluate();
@@ -170,6 +183,7 @@ JKQTPEvaluatedFunctionGraphBase::PlotFunctorSpec JKQTPXParsedFunctionLineGraph::
         fdata.parser->deleteVariable(std::string("p")+jkqtp_inttostr(i+1));
     }
     fdata.varcount=0;
+    fdata.byteCode.clear();
     try {
         for (const auto& p: getInternalParams()) {
             fdata.parser->addVariableDouble(std::string("p")+jkqtp_inttostr(fdata.varcount+1), p);
@@ -178,6 +192,7 @@ JKQTPEvaluatedFunctionGraphBase::PlotFunctorSpec JKQTPXParsedFunctionLineGraph::
         fdata.dependentVariableName=getDependentVariableName();
         fdata.parser->addVariableDouble(getDependentVariableName().toStdString(), 0.0);
         fdata.node=std::shared_ptr<JKQTPMathParser::jkmpNode>(fdata.parser->parse(function.toStdString()));
+        fdata.parser->compileByteCode(fdata.node.get(), fdata.dependentVariableName.toStdString(), fdata.byteCode);
     } catch(std::exception& E) {
         qDebug()<<QString("parser error: %1").arg(E.what());
     }
@@ -201,6 +216,7 @@ std::function<QPointF (double)> JKQTPXParsedFunctionLineGraph::buildErrorFunctor
         efdata.parser->deleteVariable(std::string("p")+jkqtp_inttostr(i+1));
     }
     efdata.varcount=0;
+    efdata.byteCode.clear();
     try {
         for (const auto& p: getInternalErrorParams()) {
             efdata.parser->addVariableDouble(std::string("p")+jkqtp_inttostr(efdata.varcount+1), p);
@@ -209,6 +225,7 @@ std::function<QPointF (double)> JKQTPXParsedFunctionLineGraph::buildErrorFunctor
         efdata.dependentVariableName=getDependentVariableName();
         efdata.parser->addVariableDouble(getDependentVariableName().toStdString(), 0.0);
         efdata.node=std::shared_ptr<JKQTPMathParser::jkmpNode>(efdata.parser->parse(errorFunction.toStdString()));
+        efdata.parser->compileByteCode(efdata.node.get(), efdata.dependentVariableName.toStdString(), efdata.byteCode);
     } catch(std::exception& /*E*/) {
         //qDebug()<<QString("parser error: %1").arg(E.what());
     }
@@ -282,6 +299,7 @@ JKQTPEvaluatedFunctionGraphBase::PlotFunctorSpec JKQTPYParsedFunctionLineGraph::
         fdata.parser->deleteVariable(std::string("p")+jkqtp_inttostr(i+1));
     }
     fdata.varcount=0;
+    fdata.byteCode.clear();
     try {
         for (const auto& p: getInternalParams()) {
             fdata.parser->addVariableDouble(std::string("p")+jkqtp_inttostr(fdata.varcount+1), p);
@@ -290,6 +308,7 @@ JKQTPEvaluatedFunctionGraphBase::PlotFunctorSpec JKQTPYParsedFunctionLineGraph::
         fdata.dependentVariableName=getDependentVariableName();
         fdata.parser->addVariableDouble(getDependentVariableName().toStdString(), 0.0);
         fdata.node=std::shared_ptr<JKQTPMathParser::jkmpNode>(fdata.parser->parse(function.toStdString()));
+        fdata.parser->compileByteCode(fdata.node.get(), fdata.dependentVariableName.toStdString(), fdata.byteCode);
     } catch(std::exception& E) {
         qDebug()<<QString("parser error: %1").arg(E.what());
     }
@@ -313,6 +332,7 @@ std::function<QPointF (double)> JKQTPYParsedFunctionLineGraph::buildErrorFunctor
         efdata.parser->deleteVariable(std::string("p")+jkqtp_inttostr(i+1));
     }
     efdata.varcount=0;
+    efdata.byteCode.clear();
     try {
         for (const auto& p: getInternalErrorParams()) {
             efdata.parser->addVariableDouble(std::string("p")+jkqtp_inttostr(efdata.varcount+1), p);
@@ -321,6 +341,7 @@ std::function<QPointF (double)> JKQTPYParsedFunctionLineGraph::buildErrorFunctor
         efdata.dependentVariableName=getDependentVariableName();
         efdata.parser->addVariableDouble(getDependentVariableName().toStdString(), 0.0);
         efdata.node=std::shared_ptr<JKQTPMathParser::jkmpNode>(efdata.parser->parse(errorFunction.toStdString()));
+        efdata.parser->compileByteCode(efdata.node.get(), efdata.dependentVariableName.toStdString(), efdata.byteCode);
     } catch(std::exception& /*E*/) {
         //qDebug()<<QString("parser error: %1").arg(E.what());
     }
@@ -81,6 +81,8 @@ protected:
         inline ParsedFunctionLineGraphFunctionData(): varcount(0) {};
         std::shared_ptr<JKQTPMathParser> parser;
         std::shared_ptr<JKQTPMathParser::jkmpNode> node;
+        /** \brief \c node compiled to bytecode (if possible), which is used instead of \c node for evaluation */
+        JKQTPMathParser::jkmpByteCode byteCode;
         int varcount;
         QString dependentVariableName;
     };
@@ -98,7 +100,11 @@ protected:
     /** \brief parser data structure for errorFunction */
     ParsedFunctionLineGraphFunctionData efdata;
 
-    /** \brief implements the actual plot function */
+    /** \brief implements the actual plot function
+     *
+     *  This uses the compiled ParsedFunctionLineGraphFunctionData::byteCode if available and falls back
+     *  to evaluating ParsedFunctionLineGraphFunctionData::node otherwise.
+     */
     static double evaluateParsedFunction(double x, ParsedFunctionLineGraphFunctionData* fdata) ;
 };
 
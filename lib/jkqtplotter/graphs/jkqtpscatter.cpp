@@ -25,6 +25,9 @@
 #include <QDebug>
 #include <QMarginsF>
 #include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
 #include "jkqtcommon/jkqtpdrawingtools.h"
 #include "jkqtplotter/jkqtptools.h"
 #include "jkqtplotter/jkqtpimagetools.h"
@@ -68,6 +71,8 @@ void JKQTPXYScatterGraph::draw(JKQTPEnhancedPainter& painter) {
     if (parent==nullptr) return;
     const JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     //qDebug()<<"JKQTPXYScatterGraph::draw();";
 
@@ -90,23 +95,31 @@ void JKQTPXYScatterGraph::draw(JKQTPEnhancedPainter& painter) {
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
-            for (int iii=imin; iii<imax; iii++) {
-                const int i=qBound(imin, getDataIndex(iii), imax);
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                const double x=transformX(xv);
-                const double y=transformY(yv);
-                //qDebug()<<"JKQTPXYScatterGraph::draw(): (xv, yv) =    ( "<<xv<<", "<<yv<<" )";
-                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
-
-                    //if (isHighlighted() && getSymbolType()!=JKQTPNoSymbol) {
-                        //JKQTPPlotSymbol(painter, x, y, JKQTPFilledCircle, parent->pt2px(painter, symbolSize*1.5), parent->pt2px(painter, symbolWidth*parent->getLineWidthMultiplier()), penSelection.color(), penSelection.color());
-                    //}
-                    if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
-                        if (symType!=JKQTPNoSymbol && cliprect.contains(x,y)) plotStyledSymbol(parent, painter, x, y);
+            // the visible symbols are collected and then drawn with one call, so the symbol sprite is looked up only once per frame
+            QVector<QPointF> symbols;
+            if (symType!=JKQTPNoSymbol) symbols.reserve(imax-imin);
+            JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+                for (int iii=imin; iii<imax; iii++) {
+                    if (isDrawingAborted()) return;
+                    const int i=qBound(imin, getDataIndex(iii), imax);
+                    const double xv=xCol.getValue(i);
+                    const double yv=yCol.getValue(i);
+                    const double x=transformX(xv);
+                    const double y=transformY(yv);
+                    //qDebug()<<"JKQTPXYScatterGraph::draw(): (xv, yv) =    ( "<<xv<<", "<<yv<<" )";
+                    if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+
+                        //if (isHighlighted() && getSymbolType()!=JKQTPNoSymbol) {
+                            //JKQTPPlotSymbol(painter, x, y, JKQTPFilledCircle, parent->pt2px(painter, symbolSize*1.5), parent->pt2px(painter, symbolWidth*parent->getLineWidthMultiplier()), penSelection.color(), penSelection.color());
+                        //}
+                        if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
+                            if (symType!=JKQTPNoSymbol && cliprect.contains(x,y)) symbols.push_back(QPointF(x,y));
+                        }
                     }
                 }
-            }
+            });
+            if (isDrawingAborted()) return;
+            plotStyledSymbols(parent, painter, symbols);
 
         }
     }
@@ -115,6 +128,11 @@ void JKQTPXYScatterGraph::draw(JKQTPEnhancedPainter& painter) {
     //qDebug()<<"JKQTPXYScatterGraph::draw() ... done";
 }
 
+bool JKQTPXYScatterGraph::canDrawInParallel() const
+{
+    return true;
+}
+
 void JKQTPXYScatterGraph::drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect) {
     painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
     JKQTPPlotSymbol(painter, rect.left()+rect.width()/2.0, rect.top()+rect.height()/2.0, getSymbolType(), getKeySymbolSizePx(painter, rect, parent), getKeySymbolLineWidthPx(painter, rect, parent), getKeyLabelColor(), getSymbolFillColor(),getSymbolFont());
@@ -158,18 +176,19 @@ bool JKQTPXYScatterErrorGraph::getXMinMax(double &minx, double &maxx, double &sm
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView xData=datastore->getColumnView(xColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))+getXErrorU(i, datastore);
+                double xv=xData.getValue(i)+getXErrorU(i, datastore);
                 if (JKQTPIsOKFloat(xv)) {
                     if (start || xv>maxx) maxx=xv;
                     if (start || xv<minx) minx=xv;
                     const double xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
                     start=false;
                 }
-                xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))-getXErrorL(i, datastore);
+                xv=xData.getValue(i)-getXErrorL(i, datastore);
                 if (JKQTPIsOKFloat(xv)) {
                     if (start || xv>maxx) maxx=xv;
                     if (start || xv<minx) minx=xv;
@@ -195,18 +214,19 @@ bool JKQTPXYScatterErrorGraph::getYMinMax(double &miny, double &maxy, double &sm
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView yData=datastore->getColumnView(yColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))+getYErrorU(i, datastore);
+                double yv=yData.getValue(i)+getYErrorU(i, datastore);
                 if (JKQTPIsOKFloat(yv)) {
                     if (start || yv>maxy) maxy=yv;
                     if (start || yv<miny) miny=yv;
                     const double xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
                     start=false;
                 }
-                yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))-getYErrorL(i, datastore);
+                yv=yData.getValue(i)-getYErrorL(i, datastore);
                 if (JKQTPIsOKFloat(yv)) {
                     if (start || yv>maxy) maxy=yv;
                     if (start || yv<miny) miny=yv;
@@ -264,6 +284,7 @@ JKQTPXYParametrizedScatterGraph::JKQTPXYParametrizedScatterGraph(JKQTBasePlotter
     drawLine=false;
 
     gridModeForSymbolSize=false;
+    groupSymbolsForDrawing=false;
     gridDeltaX=1;
     gridDeltaY=1;
     gridSymbolFractionSize=0.9;
@@ -293,6 +314,8 @@ void JKQTPXYParametrizedScatterGraph::draw(JKQTPEnhancedPainter &painter)
     if (parent==nullptr) return;
     JKQTPDatastore* datastore=parent->getDatastore();
     if (datastore==nullptr) return;
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
 
     cbGetDataMinMax(intColMin, intColMax);
 
@@ -308,16 +331,63 @@ void JKQTPXYParametrizedScatterGraph::draw(JKQTPEnhancedPainter &painter)
     int imin=0;
     if (getIndexRange(imin, imax)) {
 
-
-        QVector<QLineF> lines;
+        // the palette LUT and color range are fetched only once for all datapoints
+        const JKQTPImageTools::LUTType& lut=(palette==JKQTPMathImageUSER_PALETTE)?JKQTPImageTools::LUTType():JKQTPImageTools::getLUTforPalette(palette);
+        double colMin=0;
+        double colMax=0;
+        getLocalColorRange(colMin, colMax);
+        const double symbolLineWidthPx=parent->pt2px(painter, getSymbolLineWidth()*parent->getLineWidthMultiplier());
+
+        // consecutive symbols with the same type, size and color and consecutive line segments with the same color and width
+        // are collected in runs, which are then drawn with a single call to JKQTPPlotSymbols() or drawLines(), so the
+        // datapoints are still drawn in data order. If groupSymbolsForDrawing is set, all datapoints with the same style
+        // are collected into one group (in the order of their first occurence) and the symbol sizes are rounded to
+        // 1/symbolSizeBuckets pixels to keep the number of groups low.
+        const double symbolSizeBuckets=4.0;
+        typedef std::tuple<JKQTPGraphSymbols, double, QRgb> SymbolGroupKey;
+        typedef std::pair<QRgb, double> LineGroupKey;
+        std::vector<SymbolGroup> symbolGroups;
+        std::map<SymbolGroupKey, size_t> symbolGroupIndex;
+        std::vector<std::pair<LineGroupKey, QVector<QLineF> > > lineGroups;
+        std::map<LineGroupKey, size_t> lineGroupIndex;
+        std::vector<std::pair<LineGroupKey, QVector<QLineF> > > lineGroupsHighlighted;
+        std::map<LineGroupKey, size_t> lineGroupHighlightedIndex;
         QPolygonF linesP;
-        QVector<QColor> linecols;
-        QVector<QColor> linecolss;
-        QVector<double> linewidths;
-        QVector<SymbolDescription> symbols;
+        const auto addSymbol=[&](JKQTPGraphSymbols type, double size, QRgb color, QRgb fillColor, double x, double y) {
+            if (groupSymbolsForDrawing) {
+                const SymbolGroupKey key(type, size, color);
+                auto it=symbolGroupIndex.find(key);
+                if (it==symbolGroupIndex.end()) {
+                    it=symbolGroupIndex.emplace(key, symbolGroups.size()).first;
+                    symbolGroups.push_back(SymbolGroup{type, size, QColor::fromRgba(color), QColor::fromRgba(fillColor), QVector<QPointF>()});
+                }
+                symbolGroups[it->second].positions.push_back(QPointF(x,y));
+            } else {
+                if (symbolGroups.empty() || symbolGroups.back().type!=type || symbolGroups.back().size!=size || symbolGroups.back().color.rgba()!=color) {
+                    symbolGroups.push_back(SymbolGroup{type, size, QColor::fromRgba(color), QColor::fromRgba(fillColor), QVector<QPointF>()});
+                }
+                symbolGroups.back().positions.push_back(QPointF(x,y));
+            }
+        };
+        const auto addLine=[&](std::vector<std::pair<LineGroupKey, QVector<QLineF> > >& groups, std::map<LineGroupKey, size_t>& index, const LineGroupKey& key, const QLineF& line) {
+            if (groupSymbolsForDrawing) {
+                auto it=index.find(key);
+                if (it==index.end()) {
+                    it=index.emplace(key, groups.size()).first;
+                    groups.emplace_back(key, QVector<QLineF>());
+                }
+                groups[it->second].second.push_back(line);
+            } else {
+                if (groups.empty() || groups.back().first!=key) groups.emplace_back(key, QVector<QLineF>());
+                groups.back().second.push_back(line);
+            }
+        };
+        // fill colors are derived only once per color
+        QRgb lastColor=0;
+        QRgb lastFillColor=0;
+        bool hasLastColor=false;
         //qDebug()<<"JKQTPXYLineGraph::draw(): "<<3<<" imin="<<imin<<" imax="<<imax;
         {
-            painter.save(); auto __finalpaintinner=JKQTPFinally([&painter]() {painter.restore();});
             double xold=-1;
             double yold=-1;
             bool first=false;
@@ -325,74 +395,84 @@ void JKQTPXYParametrizedScatterGraph::draw(JKQTPEnhancedPainter &painter)
             intSortData();
             double specSymbSize=0;
             bool hasSpecSymbSize=false;
-            for (int iii=imin; iii<imax; iii++) {
-                int i=qBound(imin, getDataIndex(iii), imax);
-                double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-                double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-                double x=transformX(xv);
-                double y=transformY(yv);
-                if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
-                    double symbSize= parent->pt2px(painter, getLocalSymbolSize(i));
-                    double lineW= parent->pt2px(painter, getLocalLineWidth(i));
-
-                    if (gridModeForSymbolSize) {
-                        if (!hasSpecSymbSize) {
-                            double sSX= fabs(transformX( xv+gridDeltaX*gridSymbolFractionSize/2.0)-transformX( xv-gridDeltaX*gridSymbolFractionSize/2.0));
-                            double sSY= fabs(transformY( yv+gridDeltaY*gridSymbolFractionSize/2.0)-transformY( yv-gridDeltaY*gridSymbolFractionSize/2.0));
-                            hasSpecSymbSize=true;
-                            specSymbSize=qMin(sSX,sSY);
+            const bool highlightSymbols=isHighlighted() && getSymbolType()!=JKQTPNoSymbol && symbolColumn<0;
+            const bool roundSize=(groupSymbolsForDrawing && sizeColumn>=0 && !gridModeForSymbolSize);
+            JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+                for (int iii=imin; iii<imax; iii++) {
+                    if (isDrawingAborted()) return;
+                    int i=qBound(imin, getDataIndex(iii), imax);
+                    double xv=xCol.getValue(i);
+                    double yv=yCol.getValue(i);
+                    double x=transformX(xv);
+                    double y=transformY(yv);
+                    if (JKQTPIsOKFloat(xv) && JKQTPIsOKFloat(yv)  &&  JKQTPIsOKFloat(x) && JKQTPIsOKFloat(y)) {
+                        double symbSize= parent->pt2px(painter, getLocalSymbolSize(i));
+                        if (roundSize) symbSize=round(symbSize*symbolSizeBuckets)/symbolSizeBuckets;
+
+                        if (gridModeForSymbolSize) {
+                            if (!hasSpecSymbSize) {
+                                double sSX= fabs(transformX( xv+gridDeltaX*gridSymbolFractionSize/2.0)-transformX( xv-gridDeltaX*gridSymbolFractionSize/2.0));
+                                double sSY= fabs(transformY( yv+gridDeltaY*gridSymbolFractionSize/2.0)-transformY( yv-gridDeltaY*gridSymbolFractionSize/2.0));
+                                hasSpecSymbSize=true;
+                                specSymbSize=qMin(sSX,sSY);
+                            }
+                            symbSize=specSymbSize;
                         }
-                        symbSize=specSymbSize;
-                    }
-                    QColor symbColor=getLocalColor(i);
-                    QColor symbFillColor=JKQTPGetDerivedColor(symbolFillDerivationMode, symbColor);
-                    //qDebug()<<i<<symbolSize<<symbColor;
-                    if (drawLine) {
-                        linesP<<QPointF(x,y);
-                    }
-                    if (first && drawLine) {
-                        double xl1=xold;
-                        double yl1=yold;
-                        double xl2=x;
-                        double yl2=y;
-
-                        if (isHighlighted()) {
-                            if (colorColumn>=0) linecolss<<symbColor.lighter();
-                            else linecolss<<getHighlightingLineColor();
+                        const QRgb symbColor=getLocalColor(i, lut, colMin, colMax);
+                        if (!hasLastColor || symbColor!=lastColor) {
+                            lastColor=symbColor;
+                            lastFillColor=JKQTPGetDerivedColor(symbolFillDerivationMode, QColor::fromRgba(symbColor)).rgba();
+                            hasLastColor=true;
+                        }
+                        //qDebug()<<i<<symbolSize<<symbColor;
+                        if (drawLine) {
+                            linesP<<QPointF(x,y);
+                        }
+                        if (first && drawLine) {
+                            const QLineF line(xold, yold, x, y);
+                            if (isHighlighted() && colorColumn>=0) {
+                                addLine(lineGroupsHighlighted, lineGroupHighlightedIndex, LineGroupKey(QColor::fromRgba(symbColor).lighter().rgba(), 0), line);
+                            }
+                            if (colorColumn>=0 || linewidthColumn>=0) {
+                                addLine(lineGroups, lineGroupIndex, LineGroupKey(symbColor, parent->pt2px(painter, getLocalLineWidth(i))), line);
+                            }
                         }
-                        linecols<<symbColor;
-                        lines<<QLineF(xl1, yl1, xl2, yl2);
-                        linewidths<<lineW;
-                    }
 
-                    if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
-                        if (isHighlighted() && getSymbolType()!=JKQTPNoSymbol && symbolColumn<0) {
-                            JKQTPPlotSymbol(painter, x, y, JKQTPFilledCircle,symbSize*1.25, parent->pt2px(painter, getSymbolLineWidth()*parent->getLineWidthMultiplier()), penSelection.color(), penSelection.color(),getSymbolFont());
-                        } else {
-                            if (drawLineInForeground) JKQTPPlotSymbol(painter, x, y, getLocalSymbolType(i), symbSize, parent->pt2px(painter, getSymbolLineWidth()*parent->getLineWidthMultiplier()), symbColor, symbFillColor,getSymbolFont());
-                            else symbols.push_back({x, y, getLocalSymbolType(i), symbSize, symbColor, symbFillColor});
+                        if ((!getXAxis()->isLogAxis() || xv>0.0) && (!getYAxis()->isLogAxis() || yv>0.0) ) {
+                            if (highlightSymbols) {
+                                addSymbol(JKQTPFilledCircle, symbSize*1.25, penSelection.color().rgba(), penSelection.color().rgba(), x, y);
+                            } else {
+                                addSymbol(getLocalSymbolType(i), symbSize, symbColor, lastFillColor, x, y);
+                            }
                         }
-                    }
 
 
-                    xold=x;
-                    yold=y;
-                    first=true;
+                        xold=x;
+                        yold=y;
+                        first=true;
+                    }
                 }
-            }
+            });
+            if (isDrawingAborted()) return;
         }
 
+        const auto drawSymbols=[&]() {
+            for (const auto& g: symbolGroups) {
+                JKQTPPlotSymbols(painter, g.positions, g.type, g.size, symbolLineWidthPx, g.color, g.fillColor, getSymbolFont());
+            }
+        };
 
+        if (drawLineInForeground) drawSymbols();
 
-        if (lines.size()>0) {
+        if (linesP.size()>1) {
             painter.save(); auto __finalpaintinner=JKQTPFinally([&painter]() {painter.restore();});
             if (isHighlighted()) {
                 QPen pp=penSelection;
                 if (colorColumn>=0) {
-                    for (int i=0; i<lines.size(); i++) {
-                        pp.setColor(linecolss.value(i, getHighlightingLineColor()));
+                    for (const auto& g: lineGroupsHighlighted) {
+                        pp.setColor(QColor::fromRgba(g.first.first));
                         painter.setPen(pp);
-                        painter.drawLine(lines[i]);
+                        painter.drawLines(g.second);
                     }
                 } else {
                     pp.setColor(getHighlightingLineColor());
@@ -402,11 +482,11 @@ void JKQTPXYParametrizedScatterGraph::draw(JKQTPEnhancedPainter &painter)
             }
             QPen pp=p;
             if (colorColumn>=0 || linewidthColumn>=0) {
-                for (int i=0; i<lines.size(); i++) {
-                    pp.setColor(linecols.value(i, getLineColor()));
-                    pp.setWidthF(linewidths.value(i, parent->pt2px(painter, getLineWidth()*parent->getLineWidthMultiplier())));
+                for (const auto& g: lineGroups) {
+                    pp.setColor(QColor::fromRgba(g.first.first));
+                    pp.setWidthF(g.first.second);
                     painter.setPen(pp);
-                    painter.drawLine(lines[i]);
+                    painter.drawLines(g.second);
                 }
             } else {
                 pp.setColor(getHighlightingLineColor());
@@ -414,14 +494,18 @@ void JKQTPXYParametrizedScatterGraph::draw(JKQTPEnhancedPainter &painter)
                 painter.drawPolylineFast(linesP);
             }
         }
-        for (auto& s: symbols) {
-            JKQTPPlotSymbol(painter, s.x, s.y, s.type, s.size, parent->pt2px(painter, getSymbolLineWidth()*parent->getLineWidthMultiplier()), s.color, s.fillColor, getSymbolFont());
-        }
+
+        if (!drawLineInForeground) drawSymbols();
     }
 
     drawErrorsAfter(painter);
 }
 
+bool JKQTPXYParametrizedScatterGraph::canDrawInParallel() const
+{
+    return true;
+}
+
 void JKQTPXYParametrizedScatterGraph::drawKeyMarker(JKQTPEnhancedPainter &painter, const QRectF &rect)
 {
     double symbolSize1=getKeySymbolSizePx(painter, rect, parent, 0.75);
@@ -647,6 +731,16 @@ bool JKQTPXYParametrizedScatterGraph::getGridModeForSymbolSize() const
     return this->gridModeForSymbolSize;
 }
 
+void JKQTPXYParametrizedScatterGraph::setGroupSymbolsForDrawing(bool __value)
+{
+    this->groupSymbolsForDrawing = __value;
+}
+
+bool JKQTPXYParametrizedScatterGraph::getGroupSymbolsForDrawing() const
+{
+    return this->groupSymbolsForDrawing;
+}
+
 void JKQTPXYParametrizedScatterGraph::setGridDeltaX(double __value)
 {
     this->gridDeltaX = __value;
@@ -713,6 +807,7 @@ void JKQTPXYParametrizedScatterGraph::cbGetDataMinMax(double &dmin, double &dmax
         JKQTPDatastore* datastore=parent->getDatastore();
         if (datastore==nullptr) return;
         if (colorColumn<0) return;
+        const JKQTPColumnView colorData=datastore->getColumnView(colorColumn);
         int imax= static_cast<int>(qMin(datastore->getRows(static_cast<size_t>(xColumn)), datastore->getRows(static_cast<size_t>(yColumn))));
         int imin=0;
         if (imax<imin) {
@@ -725,7 +820,7 @@ void JKQTPXYParametrizedScatterGraph::cbGetDataMinMax(double &dmin, double &dmax
 
         bool first=true;
         for (int i=imin; i<imax; i++) {
-            double xv=datastore->get(colorColumn,i);
+            double xv=colorData.getValue(i);
             if (first) {
                 dmin=dmax=xv;
                 first=false;
@@ -808,24 +903,49 @@ QColor JKQTPXYParametrizedScatterGraph::getLocalColor(int i) const
         //QRgb rgb=
         return QRgb(round(datastore->get(colorColumn,i)));
     } else {
-        QImage img;
-        double colorval=0;
-        if (i>=0 && i<(int64_t)datastore->getRows(colorColumn)) colorval=datastore->get(colorColumn,i);
         double colMin=0;
         double colMax=0;
-        if (intColMin==intColMax) {
-            colMin=0;
-            colMax=datastore->getRows(colorColumn)-1;
-        } else {
-            colMin=intColMin;
-            colMax=intColMax;
-        }
-        JKQTPImageTools::array2image(&colorval, 1, 1, img, palette, colMin, colMax);
-        return img.pixel(0,0);
+        getLocalColorRange(colMin, colMax);
+        if (palette==JKQTPMathImageUSER_PALETTE) return QColor::fromRgba(getLocalColor(i, JKQTPImageTools::LUTType(), colMin, colMax));
+        return QColor::fromRgba(getLocalColor(i, JKQTPImageTools::getLUTforPalette(palette), colMin, colMax));
     }
 
 }
 
+QRgb JKQTPXYParametrizedScatterGraph::getLocalColor(int i, const JKQTPImageTools::LUTType &lut, double colMin, double colMax) const
+{
+    if (parent==nullptr) return getLineColor().rgba();
+    const JKQTPDatastore* datastore=parent->getDatastore();
+    if (datastore==nullptr) return getLineColor().rgba();
+    if (colorColumn<0) return getLineColor().rgba();
+    if (colorColumnContainsRGB) {
+        if (i<0 || i>=(int64_t)datastore->getRows(colorColumn)) return getLineColor().rgba();
+        return QColor(QRgb(round(datastore->get(colorColumn,i)))).rgb();
+    }
+    // this reproduces the mapping of JKQTPImageTools::array2image() for a single pixel
+    double colorval=0;
+    if (i>=0 && i<(int64_t)datastore->getRows(colorColumn)) colorval=datastore->get(colorColumn,i);
+    const int lutSize=lut.size();
+    if (lutSize<=0) return qRgb(0,0,0);
+    if (!std::isfinite(colorval)) return QColor("black").rgb();
+    if (jkqtp_approximatelyEqual(colMin, colMax, JKQTP_DOUBLE_EPSILON)) return QColor(lut[0]).rgb();
+    const int v = static_cast<int>((colorval-colMin)/(colMax-colMin)*static_cast<double>(lutSize));
+    return QColor(lut[qBound<int>(0, v, lutSize-1)]).rgb();
+}
+
+void JKQTPXYParametrizedScatterGraph::getLocalColorRange(double &colMin, double &colMax) const
+{
+    colMin=0;
+    colMax=0;
+    if (intColMin==intColMax) {
+        if (parent==nullptr || parent->getDatastore()==nullptr || colorColumn<0) return;
+        colMax=parent->getDatastore()->getRows(colorColumn)-1;
+    } else {
+        colMin=intColMin;
+        colMax=intColMax;
+    }
+}
+
 JKQTPGraphSymbols JKQTPXYParametrizedScatterGraph::getLocalSymbolType(int i)
 {
     if (parent==nullptr) return getSymbolType();
@@ -864,17 +984,18 @@ bool JKQTPXYParametrizedErrorScatterGraph::getXMinMax(double &minx, double &maxx
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView xData=datastore->getColumnView(xColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))+getXErrorU(i, datastore);
+                const double xv=xData.getValue(i)+getXErrorU(i, datastore);
                 if (JKQTPIsOKFloat(xv)  ) {
                     if (start || xv>maxx) maxx=xv;
                     if (start || xv<minx) minx=xv;
                     const double xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
                 }
-                const double xvv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i))-getXErrorL(i, datastore);
+                const double xvv=xData.getValue(i)-getXErrorL(i, datastore);
                 if (JKQTPIsOKFloat(xvv)) {
                     start=false;
                     if (start || xvv>maxx) maxx=xvv;
@@ -902,18 +1023,19 @@ bool JKQTPXYParametrizedErrorScatterGraph::getYMinMax(double &miny, double &maxy
         if (parent==nullptr) return false;
 
         const JKQTPDatastore* datastore=parent->getDatastore();
+        const JKQTPColumnView yData=datastore->getColumnView(yColumn);
         int imax=0;
         int imin=0;
         if (getIndexRange(imin, imax)) {
             for (int i=imin; i<imax; i++) {
-                const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))+getYErrorU(i, datastore);
+                const double yv=yData.getValue(i)+getYErrorU(i, datastore);
                 if (JKQTPIsOKFloat(yv)) {
                     if (start || yv>maxy) maxy=yv;
                     if (start || yv<miny) miny=yv;
                     const double xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
                     start=false;
                 }
-                const double yvv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i))-getYErrorL(i, datastore);
+                const double yvv=yData.getValue(i)-getYErrorL(i, datastore);
                 if (JKQTPIsOKFloat(yvv) ) {
                     if (start || yvv>maxy) maxy=yvv;
                     if (start || yvv<miny) miny=yvv;
@@ -66,6 +66,8 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYScatterGraph: public JKQTPXYGraph, public JK
 
         /** \brief plots the graph to the plotter object specified as parent */
         virtual void draw(JKQTPEnhancedPainter& painter) override;
+        /** \copydoc JKQTPPlotElement::canDrawInParallel() */
+        virtual bool canDrawInParallel() const override;
         /** \brief plots a key marker inside the specified rectangle \a rect */
         virtual void drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect) override;
         /** \brief returns the color to be used for the key label */
@@ -161,6 +163,8 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYParametrizedScatterGraph: public JKQTPXYGrap
 
         /** \brief plots the graph to the plotter object specified as parent */
         virtual void draw(JKQTPEnhancedPainter& painter) override;
+        /** \copydoc JKQTPPlotElement::canDrawInParallel() */
+        virtual bool canDrawInParallel() const override;
         /** \brief plots a key marker inside the specified rectangle \a rect */
         virtual void drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect) override;
         /** \brief returns the color to be used for the key label */
@@ -300,6 +304,10 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYParametrizedScatterGraph: public JKQTPXYGrap
         void setGridModeForSymbolSize(bool __value);
         /** \copydoc gridModeForSymbolSize */
         bool getGridModeForSymbolSize() const;
+        /** \copydoc groupSymbolsForDrawing */
+        void setGroupSymbolsForDrawing(bool __value);
+        /** \copydoc groupSymbolsForDrawing */
+        bool getGroupSymbolsForDrawing() const;
         /** \copydoc gridDeltaX */
         void setGridDeltaX(double __value);
         /** \copydoc gridDeltaX */
@@ -368,6 +376,11 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYParametrizedScatterGraph: public JKQTPXYGrap
         double gridDeltaY;
         /** \brief if the gridModeForSymbolSize mode is actiavted (true), the plot assumes that the scatter symbols are ordered in a grid. It the uses the given griDeltaX and gridDeltaY to calculate the symbol size, so they fill the available space to a fraction gridSymbolFractionSize. */
         double gridSymbolFractionSize;
+        /** \brief if this is true, all symbols (and line segments) with the same type, size and color are drawn together, regardless of their position in the data,
+         *         and variable symbol sizes are rounded to 1/4 pixel. This is faster for large datasets, but changes the stacking order of overlapping symbols.
+         *         If \c false (default) the datapoints are drawn in data order, only consecutive symbols with the same style are drawn together.
+         */
+        bool groupSymbolsForDrawing;
 
         /** \brief if this is true, the value in the colorColumn is converted to an integer, representing a color in ARGB format (as in QRgb) */
         bool colorColumnContainsRGB;
@@ -378,6 +391,11 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYParametrizedScatterGraph: public JKQTPXYGrap
         double getLocalSymbolSize(int i);
         /** \brief retrns the local color for the i-th datapoint */
         QColor getLocalColor(int i) const;
+        /** \brief retrns the local color for the i-th datapoint, as getLocalColor(int), but uses the given palette-LUT \a lut and color range \a colMin ... \a colMax (see getLocalColorRange() ),
+         *         so these have to be determined only once when coloring many datapoints */
+        QRgb getLocalColor(int i, const JKQTPImageTools::LUTType& lut, double colMin, double colMax) const;
+        /** \brief returns the range of values in colorColumn that is mapped onto the color palette by getLocalColor() */
+        void getLocalColorRange(double& colMin, double& colMax) const;
         /** \brief retrns the local symbol type for the i-th datapoint */
         JKQTPGraphSymbols getLocalSymbolType(int i);
 
@@ -405,14 +423,13 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPXYParametrizedScatterGraph: public JKQTPXYGrap
           JKQTPGraphSymbols operator()(double x, double y, double symcolumn) const;
         };
 
-        /** \brief helper struct, which describes a single symbol */
-        struct SymbolDescription {
-            double x;
-            double y;
+        /** \brief helper struct, which describes a group of symbols with the same type, size and color, which are drawn together */
+        struct SymbolGroup {
             JKQTPGraphSymbols type;
             double size;
             QColor color;
             QColor fillColor;
+            QVector<QPointF> positions;
         };
 };
 
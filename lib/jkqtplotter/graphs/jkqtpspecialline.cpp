@@ -161,6 +161,7 @@ void JKQTPSpecialLineHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
         bool firstPoint=true;
         intSortData();
         for (int iii=imin; iii<imax; iii++) {
+            if (isDrawingAborted()) return;
             const int i=qBound(imin, getDataIndex(iii), imax);
             const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
             const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
@@ -259,6 +260,7 @@ void JKQTPSpecialLineHorizontalGraph::draw(JKQTPEnhancedPainter& painter) {
                 }
             }
         }
+        if (isDrawingAborted()) return;
         if (getFillCurve()) {
             pf<<QPointF(xold, y0);
         }
@@ -369,6 +371,7 @@ void JKQTPSpecialLineVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
         bool first=false;
         intSortData();
         for (int iii=imin; iii<imax; iii++) {
+            if (isDrawingAborted()) return;
             const int i=qBound(imin, getDataIndex(iii), imax);
             const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
             const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
@@ -450,6 +453,7 @@ void JKQTPSpecialLineVerticalGraph::draw(JKQTPEnhancedPainter& painter) {
                 }
             }
         }
+        if (isDrawingAborted()) return;
         pf<<QPointF(x0, yold);
         painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
 
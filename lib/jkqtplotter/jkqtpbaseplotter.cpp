@@ -52,6 +52,9 @@
 #include "jkqtplotter/graphs/jkqtpimagergb.h"
 #include "jkqtmathtext/jkqtmathtext.h"
 #include "jkqtplotter/jkqtpkey.h"
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
 #include <algorithm>
 #include <mutex>
 
@@ -72,6 +75,24 @@ void initJKQTBasePlotterResources()
     });
 }
 
+/** \brief the worker threads of JKQTBasePlotter::drawGraphsInParallel(), which are kept alive between frames (shared by all plotters) */
+Q_GLOBAL_STATIC(QThreadPool, jkqtpGraphRenderingThreadPool)
+
+namespace {
+    /** \brief runs \a func in a thread of jkqtpGraphRenderingThreadPool() and releases \a done afterwards */
+    class JKQTPGraphRenderingTask: public QRunnable {
+        public:
+            JKQTPGraphRenderingTask(std::function<void()> func_, QSemaphore* done_): func(std::move(func_)), done(done_) { setAutoDelete(true); }
+            void run() override {
+                func();
+                done->release();
+            }
+        private:
+            std::function<void()> func;
+            QSemaphore* done;
+    };
+}
+
 
 void JKQTBasePlotter::setDefaultJKQTBasePrinterUserSettings(QString userSettigsFilename, const QString& userSettigsPrefix)
 {
@@ -423,8 +444,117 @@ bool JKQTBasePlotter::isEmittingSignalsEnabled() const {
     return this->emitSignals;
 }
 
+void JKQTBasePlotter::abortDrawing(bool abort)
+{
+    drawingAborted=abort;
+}
+
+bool JKQTBasePlotter::isDrawingAborted() const
+{
+    return drawingAborted;
+}
+
+void JKQTBasePlotter::setParallelGraphRendering(bool enabled)
+{
+    parallelGraphRendering=enabled;
+}
+
+bool JKQTBasePlotter::isParallelGraphRendering() const
+{
+    return parallelGraphRendering;
+}
+
+void JKQTBasePlotter::setParallelGraphRenderingThreads(int threads)
+{
+    parallelGraphRenderingThreads=qMax(0, threads);
+}
+
+int JKQTBasePlotter::getParallelGraphRenderingThreads() const
+{
+    return parallelGraphRenderingThreads;
+}
+
+void JKQTBasePlotter::setLayerCaching(bool enabled)
+{
+    layerCaching=enabled;
+    if (!enabled) {
+        for (auto& cache: layerCache) cache=QImage();
+    }
+    invalidateLayers(AllLayers);
+}
+
+bool JKQTBasePlotter::isLayerCaching() const
+{
+    return layerCaching;
+}
+
+void JKQTBasePlotter::setStripChartMode(bool enabled)
+{
+    stripChartMode=enabled;
+    invalidateStripChart();
+}
+
+bool JKQTBasePlotter::isStripChartMode() const
+{
+    return stripChartMode;
+}
+
+void JKQTBasePlotter::invalidateStripChart()
+{
+    stripChartInvalid=true;
+}
+
+void JKQTBasePlotter::setStripChartOverlap(double pixels)
+{
+    stripChartOverlap=qMax(0.0, pixels);
+}
+
+double JKQTBasePlotter::getStripChartOverlap() const
+{
+    return stripChartOverlap;
+}
+
+quint64 JKQTBasePlotter::getStripChartRenderCount() const
+{
+    return stripChartRenderCount;
+}
+
+void JKQTBasePlotter::invalidateLayers(DrawingLayers layers)
+{
+    invalidLayers.fetch_or(static_cast<int>(layers));
+}
+
+quint64 JKQTBasePlotter::getLayerRenderCount(DrawingLayer layer) const
+{
+    for (int i=0; i<DrawingLayerCount; i++) {
+        if (layer==(1<<i)) return layerRenderCount[i];
+    }
+    return 0;
+}
+
+void JKQTBasePlotter::resetLayerRenderCounts()
+{
+    for (auto& cnt: layerRenderCount) cnt=0;
+    stripChartRenderCount=0;
+}
+
+size_t JKQTBasePlotter::drainIngestionQueues()
+{
+    if (!datastore) return 0;
+    const size_t frames=datastore->drainIngestionQueues();
+    if (frames>0) invalidateLayers(GraphsLayer);
+    return frames;
+}
+
 void JKQTBasePlotter::initSettings() {
     useClipping=true;
+    parallelGraphRendering=false;
+    parallelGraphRenderingThreads=0;
+    layerCaching=false;
+    stripChartMode=false;
+    stripChartOverlap=8;
+    stripChartShiftError=0;
+    resetLayerRenderCounts();
     //doDrawing=true;
 
     maintainAspectRatio=false;
@@ -489,7 +619,7 @@ void JKQTBasePlotter::zoomIn(double factor) {
         ax->setRange(qMin(xmin, xmax), qMax(xmin, xmax));
     }
 
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
     if (emitSignals) emit zoomChangedLocally(xAxis->getMin(), xAxis->getMax(), yAxis->getMin(), yAxis->getMax(), this);
 }
 
@@ -514,7 +644,7 @@ void JKQTBasePlotter::setWidgetSize(int wid, int heigh) {
     widgetWidth=wid;
     widgetHeight=heigh;
 
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setWidgetSize(QSize size)
@@ -581,12 +711,12 @@ void JKQTBasePlotter::clearGridPrintingPlotters() {
 
 void JKQTBasePlotter::setWidgetWidth(int wid) {
     widgetWidth=wid;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setWidgetHeight(int heigh) {
     widgetHeight=heigh;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::saveSettings(QSettings& settings, const QString& group) const{
@@ -1297,78 +1427,293 @@ void JKQTBasePlotter::drawPlot(JKQTPEnhancedPainter& painter) {
 #if QT_VERSION<QT_VERSION_CHECK(6,0,0)
     painter.setRenderHint(JKQTPEnhancedPainter::NonCosmeticDefaultPen, true);
 #endif
-    painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.useAntiAliasingForSystem);
-    painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
+    drawPlotLayer(painter, BackgroundLayer);
+    drawPlotLayer(painter, GraphsLayer);
+    if (drawingAborted) return;
+    drawPlotLayer(painter, AxesLayer);
+    drawPlotLayer(painter, KeyLayer);
 
+    //qDebug()<<"  end JKQTBasePlotter::paintPlot";
+}
 
-    // draw background
-    {
-        painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-        painter.setPen(Qt::NoPen);
-        if (plotterStyle.widgetBackgroundBrush!=QBrush(Qt::transparent)) painter.fillRect(QRectF(0,0,widgetWidth/paintMagnification, widgetHeight/paintMagnification), plotterStyle.widgetBackgroundBrush);
+void JKQTBasePlotter::drawPlotLayer(JKQTPEnhancedPainter &painter, DrawingLayer layer)
+{
+    for (int i=0; i<DrawingLayerCount; i++) {
+        if (layer==(1<<i)) layerRenderCount[i]++;
     }
+    if (layer==BackgroundLayer) {
+        painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.useAntiAliasingForSystem);
+        painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
 
-    // calculate rect of the actual plot
-    const QRectF rPlotRect=calcPlotRect();
+        // draw background
+        {
+            painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
+            painter.setPen(Qt::NoPen);
+            if (plotterStyle.widgetBackgroundBrush!=QBrush(Qt::transparent)) painter.fillRect(QRectF(0,0,widgetWidth/paintMagnification, widgetHeight/paintMagnification), plotterStyle.widgetBackgroundBrush);
+        }
 
+        // calculate rect of the actual plot
+        const QRectF rPlotRect=calcPlotRect();
 
-    // draw plot frame
-    {
-        QPen penPlotFrame(Qt::NoPen);
-        if (plotterStyle.plotFrameVisible) {
-            penPlotFrame=QPen(plotterStyle.plotFrameColor);
-            penPlotFrame.setWidthF(qMax(JKQTPlotterDrawingTools::ABS_MIN_LINEWIDTH, pt2px(painter, plotterStyle.plotFrameWidth*lineWidthMultiplier)));
-        }
-        painter.setPen(penPlotFrame);
-        painter.setBrush(plotterStyle.plotBackgroundBrush);
-        painter.drawRoundedRectOrRect(rPlotRect, plotterStyle.plotFrameRounding);
-    }
 
+        // draw plot frame
+        {
+            QPen penPlotFrame(Qt::NoPen);
+            if (plotterStyle.plotFrameVisible) {
+                penPlotFrame=QPen(plotterStyle.plotFrameColor);
+                penPlotFrame.setWidthF(qMax(JKQTPlotterDrawingTools::ABS_MIN_LINEWIDTH, pt2px(painter, plotterStyle.plotFrameWidth*lineWidthMultiplier)));
+            }
+            painter.setPen(penPlotFrame);
+            painter.setBrush(plotterStyle.plotBackgroundBrush);
+            painter.drawRoundedRectOrRect(rPlotRect, plotterStyle.plotFrameRounding);
+        }
 
-    // overlay plot frrame with the grid(s)
-    drawSystemGrid(painter);
 
+        // overlay plot frrame with the grid(s)
+        drawSystemGrid(painter);
 
-    // draw the plot label (typically above the graph)
-    drawPlotLabel(painter);
 
-    // draw the graphs
-    {
+        // draw the plot label (typically above the graph)
+        drawPlotLabel(painter);
+    } else if (layer==GraphsLayer) {
+        // draw the graphs
         painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.graphsStyle.useAntiAliasingForGraphs);
         painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
         painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
         drawGraphs(painter);
+    } else if (layer==AxesLayer) {
+        // draw coordinate systems (first and secondary)
+        painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.useAntiAliasingForSystem);
+        painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
+        drawSystemXAxis(painter);
+        drawSystemYAxis(painter);
+    } else if (layer==KeyLayer) {
+        // draw plot key/legend
+        painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.graphsStyle.useAntiAliasingForGraphs);
+        painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
+        if (plotterStyle.keyStyle.visible) drawKey(painter);
+
+        if (plotterStyle.debugShowRegionBoxes) {
+            const QRectF rPlotRect=calcPlotRect();
+            painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
+            QPen p("red");
+            QColor col=p.color(); col.setAlphaF(0.8f); p.setColor(col);
+            p.setWidthF(plotterStyle.debugRegionLineWidth);
+            p.setStyle(Qt::DashLine);
+            painter.setPen(p);
+            painter.setBrush(QBrush(QColor(Qt::transparent)));
+            painter.drawRect(rPlotRect);
+            col=p.color(); col.setAlphaF(0.8f); p.setColor(col);
+            p.setWidthF(plotterStyle.debugRegionLineWidth);
+            p.setStyle(Qt::SolidLine);
+            painter.setPen(p);
+            painter.drawRect(0, 0, widgetWidth, widgetHeight);
+
+        }
     }
+}
 
-    // draw coordinate systems (first and secondary)
-    painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.useAntiAliasingForSystem);
-    painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
-    drawSystemXAxis(painter);
-    drawSystemYAxis(painter);
+bool JKQTBasePlotter::LayerCacheGeometry::operator==(const LayerCacheGeometry &other) const
+{
+    return deviceSize==other.deviceSize && devicePixelRatio==other.devicePixelRatio && transform==other.transform
+            && clipRegion==other.clipRegion && plotRectAndRanges==other.plotRectAndRanges;
+}
 
-    // draw plot key/legend
-    painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing, plotterStyle.graphsStyle.useAntiAliasingForGraphs);
-    painter.setRenderHint(JKQTPEnhancedPainter::TextAntialiasing, plotterStyle.useAntiAliasingForText);
-    if (plotterStyle.keyStyle.visible) drawKey(painter);
+bool JKQTBasePlotter::drawPlotFromLayerCache(JKQTPEnhancedPainter &painter)
+{
+    if (!supportsLayers(painter)) return false;
+#if QT_VERSION<QT_VERSION_CHECK(6,0,0)
+    painter.setRenderHint(JKQTPEnhancedPainter::NonCosmeticDefaultPen, true);
+#endif
 
-    if (plotterStyle.debugShowRegionBoxes) {
-        painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-        QPen p("red");
-        QColor col=p.color(); col.setAlphaF(0.8f); p.setColor(col);
-        p.setWidthF(plotterStyle.debugRegionLineWidth);
-        p.setStyle(Qt::DashLine);
-        painter.setPen(p);
-        painter.setBrush(QBrush(QColor(Qt::transparent)));
-        painter.drawRect(rPlotRect);
-        col=p.color(); col.setAlphaF(0.8f); p.setColor(col);
-        p.setWidthF(plotterStyle.debugRegionLineWidth);
-        p.setStyle(Qt::SolidLine);
-        painter.setPen(p);
-        painter.drawRect(0, 0, widgetWidth, widgetHeight);
+    LayerCacheGeometry geometry;
+    geometry.deviceSize=QSize(painter.device()->width(), painter.device()->height());
+    geometry.devicePixelRatio=painter.device()->devicePixelRatioF();
+    geometry.transform=painter.combinedTransform();
+    if (painter.hasClipping()) geometry.clipRegion=painter.clipRegion();
+    geometry.plotRectAndRanges<<widgetWidth<<widgetHeight<<paintMagnification<<internalPlotBorderLeft<<internalPlotBorderTop<<internalPlotWidth<<internalPlotHeight;
+    geometry.plotRectAndRanges<<xAxis->getMin()<<xAxis->getMax()<<yAxis->getMin()<<yAxis->getMax();
+    for (const auto* ax: secondaryXAxis) geometry.plotRectAndRanges<<ax->getMin()<<ax->getMax();
+    for (const auto* ax: secondaryYAxis) geometry.plotRectAndRanges<<ax->getMin()<<ax->getMax();
+
+    int redraw=invalidLayers.exchange(0);
+    // in the strip-chart mode, the cached graphs are shifted, if only the x-range moved
+    bool stripChart=false;
+    double stripChartShift=0;
+    if (stripChartMode) {
+        const bool graphsInvalid=stripChartInvalid.exchange(false);
+        const QVector<const JKQTPPlotElement*> visibleGraphs=getVisibleGraphsForStripChart();
+        stripChart=!graphsInvalid && visibleGraphs==stripChartGraphs && calcStripChartShift(layerCacheGeometry, geometry, stripChartShift);
+        stripChartGraphs=visibleGraphs;
+    }
+    if (stripChart) {
+        // the grid and the axes move with the x-range, the key is unchanged
+        redraw=(redraw&~GraphsLayer)|BackgroundLayer|AxesLayer;
+        layerCacheGeometry=geometry;
+    } else if (!(geometry==layerCacheGeometry)) {
+        redraw=AllLayers;
+        layerCacheGeometry=geometry;
+    }
+    for (int i=0; i<DrawingLayerCount; i++) {
+        const DrawingLayer layer=static_cast<DrawingLayer>(1<<i);
+        QImage& cache=layerCache[i];
+        if (stripChart && layer==GraphsLayer) {
+            drawStripChartGraphs(cache, painter, stripChartShift);
+            if (drawingAborted) {
+                // the shifted layer is incomplete, so it has to be drawn completely next time
+                invalidateStripChart();
+                invalidateLayers(DrawingLayers(QFlag(redraw|layer)));
+                return true;
+            }
+        } else if ((redraw&layer)!=0 || cache.isNull()) {
+            if (layer==GraphsLayer) stripChartShiftError=0;
+            JKQTPEnhancedPainter layerPainter;
+            initLayer(cache, layerPainter, painter);
+            drawPlotLayer(layerPainter, layer);
+            layerPainter.end();
+            if (drawingAborted) {
+                // the cached layers are incomplete, so they have to be drawn again next time
+                invalidateLayers(DrawingLayers(QFlag(redraw|layer)));
+                return true;
+            }
+        }
+        drawLayer(painter, cache);
+    }
+    return true;
+}
 
+QVector<const JKQTPPlotElement *> JKQTBasePlotter::getVisibleGraphsForStripChart() const
+{
+    QVector<const JKQTPPlotElement*> visibleGraphs;
+    for (const JKQTPPlotElement* g: graphs) {
+        if (g->isVisible()) visibleGraphs.push_back(g);
+    }
+    return visibleGraphs;
+}
+
+bool JKQTBasePlotter::calcStripChartShift(const LayerCacheGeometry &oldGeometry, const LayerCacheGeometry &newGeometry, double &shiftDevicePixels) const
+{
+    if (layerCache[qCountTrailingZeroBits(static_cast<quint32>(GraphsLayer))].isNull()) return false;
+    if (oldGeometry.deviceSize!=newGeometry.deviceSize || oldGeometry.devicePixelRatio!=newGeometry.devicePixelRatio || oldGeometry.transform!=newGeometry.transform || oldGeometry.clipRegion!=newGeometry.clipRegion) return false;
+    if (newGeometry.transform.type()>QTransform::TxScale) return false;
+    const QVector<double>& o=oldGeometry.plotRectAndRanges;
+    const QVector<double>& n=newGeometry.plotRectAndRanges;
+    if (o.size()!=n.size()) return false;
+    // widget size, magnification and plot rectangle (entries 0..6) have to be unchanged
+    for (int i=0; i<7; i++) {
+        if (o[i]!=n[i]) return false;
+    }
+    // all x-axes have to be linear and shifted by the same number of pixels, all y-axes have to be unchanged
+    QVector<const JKQTPCoordinateAxis*> xAxes;
+    xAxes<<xAxis;
+    for (const auto* ax: secondaryXAxis) xAxes<<ax;
+    double shift=0;
+    bool first=true;
+    auto checkXAxis=[&](const JKQTPCoordinateAxis* ax, int idx) {
+        if (ax->isLogAxis()) return false;
+        const double oldWidth=o[idx+1]-o[idx];
+        const double newWidth=n[idx+1]-n[idx];
+        if (fabs(oldWidth-newWidth)>1e-9*fabs(newWidth)) return false;
+        const double s=ax->x2p(o[idx])-ax->x2p(n[idx]);
+        if (first) { shift=s; first=false; }
+        else if (fabs(s-shift)>1e-3) return false;
+        return true;
+    };
+    if (!checkXAxis(xAxis, 7)) return false;
+    if (o[9]!=n[9] || o[10]!=n[10]) return false;
+    int idx=11;
+    for (const auto* ax: secondaryXAxis) {
+        if (!checkXAxis(ax, idx)) return false;
+        idx+=2;
+    }
+    for (; idx<n.size(); idx++) {
+        if (o[idx]!=n[idx]) return false;
+    }
+    shiftDevicePixels=shift*newGeometry.transform.m11()*newGeometry.devicePixelRatio;
+    // a shift of more than the plot width does not leave anything to reuse
+    return shift!=0 && fabs(shift)<internalPlotWidth;
+}
+
+void JKQTBasePlotter::drawStripChartGraphs(QImage &cache, const JKQTPEnhancedPainter &painter, double shiftDevicePixels)
+{
+    // round the shift to full pixels and keep track of the resulting displacement of the cached content
+    const int shift=jkqtp_roundTo<int>(shiftDevicePixels-stripChartShiftError);
+    stripChartShiftError+=static_cast<double>(shift)-shiftDevicePixels;
+
+    // plot rectangle in device pixels
+    const QTransform transform=painter.combinedTransform();
+    const double dpr=cache.devicePixelRatioF();
+    const QRectF plotRect(internalPlotBorderLeft, internalPlotBorderTop, internalPlotWidth, internalPlotHeight);
+    const QRectF devRectF=transform.mapRect(plotRect);
+    const int left=qMax(0, static_cast<int>(floor(devRectF.left()*dpr)));
+    const int right=qMin(cache.width(), static_cast<int>(ceil(devRectF.right()*dpr)));
+    const int top=qMax(0, static_cast<int>(floor(devRectF.top()*dpr)));
+    const int bottom=qMin(cache.height(), static_cast<int>(ceil(devRectF.bottom()*dpr)));
+    if (right<=left || bottom<=top) return;
+    const int width=right-left;
+
+    // the exposed strip (plus the overlap to connect the new data) is drawn again, it has to be transparent first
+    const int overlap=static_cast<int>(ceil(stripChartOverlap*transform.m11()*dpr));
+    int stripLeft=left, stripRight=right;
+    if (shift<0) stripLeft=qMax(left, right+shift-overlap);
+    else stripRight=qMin(right, left+shift+overlap);
+    const int kept=width-abs(shift);
+    for (int y=top; y<bottom; y++) {
+        QRgb* line=reinterpret_cast<QRgb*>(cache.scanLine(y));
+        if (kept>0) {
+            if (shift<0) memmove(line+left, line+left-shift, static_cast<size_t>(kept)*sizeof(QRgb));
+            else if (shift>0) memmove(line+left+shift, line+left, static_cast<size_t>(kept)*sizeof(QRgb));
+        }
+        std::fill(line+stripLeft, line+stripRight, qRgba(0,0,0,0));
     }
 
-    //qDebug()<<"  end JKQTBasePlotter::paintPlot";
+    // draw the graphs, clipped to the strip
+    const QTransform inverse=transform.inverted();
+    graphsStripRect=inverse.mapRect(QRectF(QPointF(stripLeft/dpr, devRectF.top()), QPointF(stripRight/dpr, devRectF.bottom())));
+    auto __finalStripRect=JKQTPFinally([&]() { graphsStripRect=QRectF(); });
+    JKQTPEnhancedPainter layerPainter;
+    layerPainter.begin(&cache);
+    layerPainter.setPainterFlag(painter.painterFlags());
+    layerPainter.setRenderHints(painter.renderHints());
+    layerPainter.setWorldTransform(transform);
+    drawPlotLayer(layerPainter, GraphsLayer);
+    layerPainter.end();
+    stripChartRenderCount++;
+}
+
+bool JKQTBasePlotter::supportsLayers(const JKQTPEnhancedPainter &painter)
+{
+    const QPaintDevice* target=painter.device();
+    if (target==nullptr || (target->devType()!=QInternal::Image && target->devType()!=QInternal::Pixmap)) return false;
+    return !painter.painterFlags().testFlag(JKQTPEnhancedPainter::VectorPainting) && painter.compositionMode()==QPainter::CompositionMode_SourceOver;
+}
+
+void JKQTBasePlotter::initLayer(QImage &layer, JKQTPEnhancedPainter &layerPainter, const JKQTPEnhancedPainter &painter)
+{
+    const QPaintDevice* target=painter.device();
+    layer=QImage(target->width(), target->height(), QImage::Format_ARGB32_Premultiplied);
+    layer.setDevicePixelRatio(target->devicePixelRatioF());
+    if (target->devType()==QInternal::Image) {
+        layer.setDotsPerMeterX(static_cast<const QImage*>(target)->dotsPerMeterX());
+        layer.setDotsPerMeterY(static_cast<const QImage*>(target)->dotsPerMeterY());
+    } else {
+        layer.setDotsPerMeterX(qRound(target->logicalDpiX()/0.0254));
+        layer.setDotsPerMeterY(qRound(target->logicalDpiY()/0.0254));
+    }
+    layer.fill(Qt::transparent);
+    layerPainter.begin(&layer);
+    layerPainter.setPainterFlag(painter.painterFlags());
+    layerPainter.setRenderHints(painter.renderHints());
+    layerPainter.setWorldTransform(painter.combinedTransform());
+    if (painter.hasClipping()) layerPainter.setClipRegion(painter.clipRegion());
+}
+
+void JKQTBasePlotter::drawLayer(JKQTPEnhancedPainter &painter, const QImage &layer)
+{
+    if (layer.isNull()) return;
+    painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
+    painter.resetTransform();
+    painter.drawImage(QPointF(0,0), layer);
 }
 
 
@@ -2413,7 +2758,7 @@ void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QRect& re
     #ifdef JKQTBP_DEBUGTIMING
         time.start();
     #endif
-        drawPlot(painter);
+        if (!layerCaching || !drawPlotFromLayerCache(painter)) drawPlot(painter);
     #ifdef JKQTBP_DEBUGTIMING
         qDebug()<<on<<"::drawNonGrid ... paintPlot       = " <<time.nsecsElapsed()/1000<<" usecs = "<<static_cast<double>(time.nsecsElapsed())/1000000.0<<" msecs";
     #endif
@@ -2427,12 +2772,24 @@ void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QRect& re
 }
 
 
-void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& pos) {
+void JKQTBasePlotter::prepareDrawNonGrid(JKQTPEnhancedPainter &painter)
+{
+    bool oldEmitPlotSignals=emitPlotSignals;
+    emitPlotSignals=false;
+    calcPlotScaling(painter);
+    emitPlotSignals=oldEmitPlotSignals;
+}
+
+void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& pos, bool calculatePlotScaling) {
 #ifdef JKQTBP_AUTOTIMER
     JKQTPAutoOutputTimer jkaaot(QString("JKQTBasePlotter::drawNonGrid(pos)"));
 #endif
-    bool oldEmitPlotSignals=emitPlotSignals;
-    emitPlotSignals=false;
+    // without calculatePlotScaling, the plotter is only read (see prepareDrawNonGrid() ), so this may run in a background thread
+    bool oldEmitPlotSignals=false;
+    if (calculatePlotScaling) {
+        oldEmitPlotSignals=emitPlotSignals;
+        emitPlotSignals=false;
+    }
 #ifdef JKQTBP_DEBUGTIMING
     QString on=objectName();
     if (on.isEmpty() && parent()) on=parent()->objectName();
@@ -2447,7 +2804,7 @@ void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& p
     QElapsedTimer time;
     time.start();
 #endif
-    calcPlotScaling(painter);
+    if (calculatePlotScaling) calcPlotScaling(painter);
 #ifdef JKQTBP_DEBUGTIMING
     qDebug()<<on<<"::drawNonGrid ... calcPlotScaling = " <<time.nsecsElapsed()/1000<<" usecs = "<<static_cast<double>(time.nsecsElapsed())/1000000.0<<" msecs";
 #endif
@@ -2462,7 +2819,7 @@ void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& p
     #ifdef JKQTBP_DEBUGTIMING
         time.start();
     #endif
-        drawPlot(painter);
+        if (!layerCaching || !drawPlotFromLayerCache(painter)) drawPlot(painter);
     #ifdef JKQTBP_DEBUGTIMING
         qDebug()<<on<<"::drawNonGrid ... paintPlot       = " <<time.nsecsElapsed()/1000<<" usecs = "<<static_cast<double>(time.nsecsElapsed())/1000000.0<<" msecs";
     #endif
@@ -2472,7 +2829,7 @@ void JKQTBasePlotter::drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& p
 #ifdef JKQTBP_DEBUGTIMING
     qDebug()<<on<<"::drawNonGrid ... DONE            = "<<timeAll.nsecsElapsed()/1000<<" usecs = "<<static_cast<double>(timeAll.nsecsElapsed())/1000000.0<<" msecs";
 #endif
-    emitPlotSignals=oldEmitPlotSignals;
+    if (calculatePlotScaling) emitPlotSignals=oldEmitPlotSignals;
 }
 
 void JKQTBasePlotter::updateSecondaryAxes()
@@ -2480,6 +2837,15 @@ void JKQTBasePlotter::updateSecondaryAxes()
 
 }
 
+void JKQTBasePlotter::redrawPlotLayers(DrawingLayers layers)
+{
+    invalidateLayers(layers);
+    if (emitPlotSignals) {
+        emit plotLayersUpdated(layers);
+        emit plotUpdated();
+    }
+}
+
 void JKQTBasePlotter::setEmittingPlotSignalsEnabled(bool __value)
 {
     this->emitPlotSignals = __value;
@@ -2553,7 +2919,7 @@ void JKQTBasePlotter::setBackgroundColor(const QColor &__value)
 {
     if (this->plotterStyle.widgetBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.widgetBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2566,7 +2932,7 @@ void JKQTBasePlotter::setExportBackgroundColor(const QColor &__value)
 {
     if (this->plotterStyle.exportBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.exportBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2660,7 +3026,7 @@ void JKQTBasePlotter::setPlotLabelFontSize(double __value)
 {
     if (jkqtp_approximatelyUnequal(this->plotterStyle.plotLabelFontSize , __value)) {
         this->plotterStyle.plotLabelFontSize = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2673,7 +3039,7 @@ void JKQTBasePlotter::setPlotLabelOffset(double __value)
 {
     if (jkqtp_approximatelyUnequal(this->plotterStyle.plotLabelOffset , __value)) {
         this->plotterStyle.plotLabelOffset = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2686,7 +3052,7 @@ void JKQTBasePlotter::setPlotLabelTopBorder(double __value)
 {
     if (jkqtp_approximatelyUnequal(this->plotterStyle.plotLabelTopBorder , __value)) {
         this->plotterStyle.plotLabelTopBorder = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2699,7 +3065,7 @@ void JKQTBasePlotter::setPlotLabelColor(QColor __value)
 {
     if (this->plotterStyle.plotLabelColor != __value) {
         this->plotterStyle.plotLabelColor = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2712,7 +3078,7 @@ void JKQTBasePlotter::setplotLabelFontName(const QString &__value)
 {
     if (this->plotterStyle.plotLabelFontName != __value) {
         this->plotterStyle.plotLabelFontName = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2725,7 +3091,7 @@ void JKQTBasePlotter::setPlotLabel(const QString &__value)
 {
     if (this->plotLabel != __value) {
         this->plotLabel = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2739,7 +3105,7 @@ void JKQTBasePlotter::setPlotBackgroundColor(const QColor &__value)
 {
     if (this->plotterStyle.plotBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.plotBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2747,7 +3113,7 @@ void JKQTBasePlotter::setBackgroundBrush(const QBrush &__value)
 {
     if (this->plotterStyle.widgetBackgroundBrush != (__value)) {
         this->plotterStyle.widgetBackgroundBrush=(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2755,7 +3121,7 @@ void JKQTBasePlotter::setExportBackgroundBrush(const QBrush &__value)
 {
     if (this->plotterStyle.exportBackgroundBrush != (__value)) {
         this->plotterStyle.exportBackgroundBrush=(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2763,7 +3129,7 @@ void JKQTBasePlotter::setPlotBackgroundBrush(const QBrush &__value)
 {
     if (this->plotterStyle.plotBackgroundBrush != (__value)) {
         this->plotterStyle.plotBackgroundBrush=(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2771,7 +3137,7 @@ void JKQTBasePlotter::setBackgroundGradient(const QGradient &__value)
 {
     if (this->plotterStyle.widgetBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.widgetBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2779,7 +3145,7 @@ void JKQTBasePlotter::setExportBackgroundGradient(const QGradient &__value)
 {
     if (this->plotterStyle.exportBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.exportBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2787,7 +3153,7 @@ void JKQTBasePlotter::setPlotBackgroundGradient(const QGradient &__value)
 {
     if (this->plotterStyle.plotBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.plotBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 
 }
@@ -2796,7 +3162,7 @@ void JKQTBasePlotter::setBackgroundTexture(const QPixmap &__value)
 {
     if (this->plotterStyle.widgetBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.widgetBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2804,7 +3170,7 @@ void JKQTBasePlotter::setExportBackgroundTexture(const QPixmap &__value)
 {
     if (this->plotterStyle.exportBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.exportBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2812,7 +3178,7 @@ void JKQTBasePlotter::setPlotBackgroundTexture(const QPixmap &__value)
 {
     if (this->plotterStyle.plotBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.plotBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2820,7 +3186,7 @@ void JKQTBasePlotter::setBackgroundTexture(const QImage &__value)
 {
     if (this->plotterStyle.widgetBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.widgetBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2828,7 +3194,7 @@ void JKQTBasePlotter::setExportBackgroundTexture(const QImage &__value)
 {
     if (this->plotterStyle.exportBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.exportBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2836,7 +3202,7 @@ void JKQTBasePlotter::setPlotBackgroundTexture(const QImage &__value)
 {
     if (this->plotterStyle.plotBackgroundBrush != QBrush(__value)) {
         this->plotterStyle.plotBackgroundBrush=QBrush(__value);
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2864,7 +3230,7 @@ void JKQTBasePlotter::setPlotFrameWidth(double __value)
 {
     if (jkqtp_approximatelyUnequal(this->plotterStyle.plotFrameWidth , __value)) {
         this->plotterStyle.plotFrameWidth = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2872,7 +3238,7 @@ void JKQTBasePlotter::setPlotFrameRounding(double __value)
 {
     if (jkqtp_approximatelyUnequal(this->plotterStyle.plotFrameRounding , __value)) {
         this->plotterStyle.plotFrameRounding = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2880,7 +3246,7 @@ void JKQTBasePlotter::setPlotFrameColor(QColor __value)
 {
     if (this->plotterStyle.plotFrameColor != __value) {
         this->plotterStyle.plotFrameColor = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2888,7 +3254,7 @@ void JKQTBasePlotter::setPlotFrameVisible(bool __value)
 {
     if (this->plotterStyle.plotFrameVisible != __value) {
         this->plotterStyle.plotFrameVisible = __value;
-        redrawPlot();
+        redrawPlotLayers(BackgroundLayer);
     }
 }
 
@@ -2904,7 +3270,7 @@ void JKQTBasePlotter::setUseAntiAliasingForGraphs(bool __value)
 {
     if (this->plotterStyle.graphsStyle.useAntiAliasingForGraphs != __value) {
         this->plotterStyle.graphsStyle.useAntiAliasingForGraphs = __value;
-        redrawPlot();
+        redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
     }
 }
 
@@ -2912,7 +3278,7 @@ void JKQTBasePlotter::setUseAntiAliasingForSystem(bool __value)
 {
     if (this->plotterStyle.useAntiAliasingForSystem != __value) {
         this->plotterStyle.useAntiAliasingForSystem = __value;
-        redrawPlot();
+        redrawPlotLayers(DrawingLayers(BackgroundLayer|AxesLayer));
     }
 }
 
@@ -4031,31 +4397,31 @@ void JKQTBasePlotter::setPlotBorder(int left, int right, int top, int bottom){
     plotterStyle.plotBorderBottom=bottom;
     plotterStyle.plotBorderRight=right;
     //updateGeometry();
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setPlotBorderLeft(int left)
 {
     plotterStyle.plotBorderLeft=left;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setPlotBorderRight(int right)
 {
     plotterStyle.plotBorderRight=right;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setPlotBorderTop(int top)
 {
     plotterStyle.plotBorderTop=top;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::setPlotBorderBottom(int bottom)
 {
     plotterStyle.plotBorderBottom=bottom;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers());
 }
 
 void JKQTBasePlotter::synchronizeToMaster(JKQTBasePlotter* master, SynchronizationDirection synchronizeDirection, bool synchronizeAxisLength, bool synchronizeZoomingMasterToSlave, bool synchronizeZoomingSlaveToMaster) {
@@ -4150,13 +4516,86 @@ void JKQTBasePlotter::synchronizeXYAxis(double newxmin, double newxmax, double n
 
 
 
+bool JKQTBasePlotter::drawGraphsInParallel(JKQTPEnhancedPainter &painter)
+{
+    if (!parallelGraphRendering || !supportsLayers(painter)) return false;
+    const int threads=(parallelGraphRenderingThreads>0)?parallelGraphRenderingThreads:QThread::idealThreadCount();
+    if (threads<2) return false;
+    int parallelGraphs=0;
+    for (const JKQTPPlotElement* g: graphs) {
+        if (g->isVisible() && g->canDrawInParallel()) parallelGraphs++;
+    }
+    if (parallelGraphs<2) return false;
+
+    const auto drawBatch=[&](JKQTPEnhancedPainter& layerPainter, const QVector<JKQTPPlotElement*>& batch) {
+        for (JKQTPPlotElement* g: batch) {
+            if (drawingAborted) break;
+            g->draw(layerPainter);
+        }
+        layerPainter.end();
+    };
+
+    int j=0;
+    while (j<graphs.size() && !drawingAborted) {
+        JKQTPPlotElement* g=graphs[j];
+        if (!g->isVisible()) {
+            j++;
+        } else if (!g->canDrawInParallel()) {
+            g->draw(painter);
+            j++;
+        } else {
+            // collect a run of consecutive graphs, which can be drawn in parallel
+            QVector<JKQTPPlotElement*> run;
+            while (j<graphs.size() && (!graphs[j]->isVisible() || graphs[j]->canDrawInParallel())) {
+                if (graphs[j]->isVisible()) run.push_back(graphs[j]);
+                j++;
+            }
+            if (run.size()==1) {
+                run.first()->draw(painter);
+                continue;
+            }
+            // split the run into batches of consecutive graphs, so the layers can be composited in z-order
+            const int layerCount=qMin(threads, static_cast<int>(run.size()));
+            std::vector<QImage> layers(static_cast<size_t>(layerCount));
+            std::vector<QVector<JKQTPPlotElement*> > batches(static_cast<size_t>(layerCount));
+            // each batch is drawn into a layer, which is set up like painter, so the graphs look exactly as when drawn on painter
+            std::vector<std::unique_ptr<JKQTPEnhancedPainter> > layerPainters;
+            for (int l=0; l<layerCount; l++) {
+                const int first=static_cast<int>(run.size())*l/layerCount;
+                const int last=static_cast<int>(run.size())*(l+1)/layerCount;
+                batches[static_cast<size_t>(l)]=run.mid(first, last-first);
+                layerPainters.emplace_back(new JKQTPEnhancedPainter());
+                initLayer(layers[static_cast<size_t>(l)], *layerPainters.back(), painter);
+            }
+            // the batches 1.. are drawn by the persistent thread pool, batch 0 by the calling thread
+            QThreadPool* pool=jkqtpGraphRenderingThreadPool();
+            if (pool->maxThreadCount()<layerCount-1) pool->setMaxThreadCount(layerCount-1);
+            QSemaphore done;
+            for (size_t l=1; l<layers.size(); l++) {
+                pool->start(new JKQTPGraphRenderingTask([&, l]() { drawBatch(*layerPainters[l], batches[l]); }, &done));
+            }
+            drawBatch(*layerPainters[0], batches[0]);
+            done.acquire(layerCount-1);
+
+            for (const QImage& layer: layers) {
+                drawLayer(painter, layer);
+            }
+        }
+    }
+    return true;
+}
+
 void JKQTBasePlotter::drawGraphs(JKQTPEnhancedPainter& painter){
 #ifdef JKQTBP_AUTOTIMER
     JKQTPAutoOutputTimer jkaaot(QString("JKQTBasePlotter::plotGraphs"));
 #endif
     if (datastore==nullptr || graphs.isEmpty()) return;
     //qDebug()<<"start JKQTBasePlotter::plotGraphs()";
-    if (useClipping) {
+    if (graphsStripRect.isValid()) {
+        // strip-chart mode: only the newly exposed strip is drawn (see drawStripChartGraphs() )
+        painter.setClipping(true);
+        painter.setClipRect(graphsStripRect);
+    } else if (useClipping) {
         QRegion cregion(jkqtp_roundTo<int>(internalPlotBorderLeft), jkqtp_roundTo<int>(internalPlotBorderTop), jkqtp_roundTo<int>(internalPlotWidth), jkqtp_roundTo<int>(internalPlotHeight));
         painter.setClipping(true);
         painter.setClipRegion(cregion);
@@ -4172,14 +4611,20 @@ void JKQTBasePlotter::drawGraphs(JKQTPEnhancedPainter& painter){
     double ibRight=rGORight.left();
 
 
-    for (int j=0; j<graphs.size(); j++) {
-        JKQTPPlotElement* g=graphs[j];
-        if (g->isVisible()) g->draw(painter);
+    if (!drawGraphsInParallel(painter)) {
+        for (int j=0; j<graphs.size(); j++) {
+            if (drawingAborted) return;
+            JKQTPPlotElement* g=graphs[j];
+            if (g->isVisible()) g->draw(painter);
+        }
     }
+    if (drawingAborted) return;
 
-    if (useClipping) {
+    if (useClipping || graphsStripRect.isValid()) {
         painter.setClipping(false);
     }
+    // the parts of the graphs outside the plot rectangle do not move with the strip-chart and are kept
+    if (graphsStripRect.isValid()) return;
 
     for (int j=0; j<graphs.size(); j++) {
         JKQTPPlotElement* g=graphs[j];
@@ -4401,7 +4846,7 @@ void JKQTBasePlotter::deleteGraph(size_t i, bool deletegraph) {
     JKQTPPlotElement* g=graphs[static_cast<int>(i)];
     graphs.removeAt(static_cast<int>(i));
     if (deletegraph && g) delete g;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 };
 
 void JKQTBasePlotter::deleteGraph(JKQTPPlotElement* gr, bool deletegraph) {
@@ -4412,7 +4857,7 @@ void JKQTBasePlotter::deleteGraph(JKQTPPlotElement* gr, bool deletegraph) {
     }
 
     if (deletegraph && gr) delete gr;
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::clearGraphs(bool deleteGraphs) {
@@ -4422,7 +4867,7 @@ void JKQTBasePlotter::clearGraphs(bool deleteGraphs) {
     }
     graphs.clear();
     usedStyles.clear();
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::setAllGraphsInvisible()
@@ -4431,7 +4876,7 @@ void JKQTBasePlotter::setAllGraphsInvisible()
         JKQTPPlotElement* g=graphs[i];
         g->setVisible(false);
     }
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::setAllGraphsVisible()
@@ -4440,14 +4885,14 @@ void JKQTBasePlotter::setAllGraphsVisible()
         JKQTPPlotElement* g=graphs[i];
         g->setVisible(true);
     }
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::setGraphVisible(int i, bool visible)
 {
     JKQTPPlotElement* g=graphs.value(i, nullptr);
     if (g) g->setVisible(visible);
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::setGraphInvisible(int i)
@@ -4463,7 +4908,7 @@ void JKQTBasePlotter::setOnlyGraphVisible(int gr)
     }
     JKQTPPlotElement* g=graphs.value(gr, nullptr);
     if (g) g->setVisible(true);
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::setOnlyNthGraphsVisible(int start, int n)
@@ -4476,7 +4921,7 @@ void JKQTBasePlotter::setOnlyNthGraphsVisible(int start, int n)
         JKQTPPlotElement* g=graphs.value(i, nullptr);
         if (g) g->setVisible(true);
     }
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 size_t JKQTBasePlotter::addGraphOnTop(JKQTPPlotElement* gr) {
@@ -4486,7 +4931,7 @@ size_t JKQTBasePlotter::addGraphOnTop(JKQTPPlotElement* gr) {
         graphs.removeAt(indexGR);
     }
     graphs.push_back(gr);
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
     return static_cast<size_t>(graphs.size()-1);
 }
 
@@ -4497,7 +4942,7 @@ size_t JKQTBasePlotter::addGraphAtBottom(JKQTPPlotElement* gr) {
         graphs.removeAt(indexGR);
     }
     graphs.push_front(gr);
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
     return static_cast<size_t>(0);
 
 }
@@ -4507,7 +4952,7 @@ void JKQTBasePlotter::moveGraphTop(int idx) {
         JKQTPPlotElement* g=graphs[idx];
         graphs.removeAt(idx);
         graphs.push_back(g);
-        redrawPlot();
+        redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
     } else {
         throw std::out_of_range("index out of range in JKQTBasePlotter::moveGraphTop()");
     }
@@ -4519,7 +4964,7 @@ void JKQTBasePlotter::moveGraphBottom(int idx)
         JKQTPPlotElement* g=graphs[idx];
         graphs.removeAt(idx);
         graphs.push_front(g);
-        redrawPlot();
+        redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
     } else {
         throw std::out_of_range("index out of range in JKQTBasePlotter::moveGraphBottom()");
     }
@@ -4538,7 +4983,7 @@ void JKQTBasePlotter::moveGraphUp(int idx)
     if (idx>=0 && idx<graphs.size()) {
         if (idx+1<graphs.size()) {
             graphs.move(idx, idx+1);
-            redrawPlot();
+            redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
         }
     } else {
         throw std::out_of_range("index out of range in JKQTBasePlotter::moveGraphUp()");
@@ -4550,7 +4995,7 @@ void JKQTBasePlotter::moveGraphDown(int idx)
     if (idx>=0 && idx<graphs.size()) {
         if (idx-1>=0) {
             graphs.move(idx-1, idx);
-            redrawPlot();
+            redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
         }
     } else {
         throw std::out_of_range("index out of range in JKQTBasePlotter::moveGraphDown()");
@@ -4581,14 +5026,14 @@ void JKQTBasePlotter::modifyGraphs(const std::function<void (JKQTPPlotElement *)
     for (int i=0; i<graphs.size(); i++) {
         func(graphs[i]);
     }
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 }
 
 void JKQTBasePlotter::sortGraphs(const std::function<bool (const JKQTPPlotElement *, const JKQTPPlotElement *)> &compareLess)
 {
     if (!compareLess) return;
     std::sort(graphs.begin(), graphs.end(), compareLess);
-    redrawPlot();
+    redrawPlotLayers(DrawingLayers(GraphsLayer|KeyLayer));
 };
 
 bool JKQTBasePlotter::containsGraph(const JKQTPPlotElement* gr) const {
@@ -50,8 +50,11 @@
 #include <QPointer>
 #include <QListWidget>
 #include <QComboBox>
+#include <QImage>
 
 #include <vector>
+#include <atomic>
+#include <functional>
 #include <cmath>
 #include <iostream>
 #include "jkqtplotter/jkqtplotter_imexport.h"
@@ -397,6 +400,21 @@ class JKQTPLOTTER_LIB_EXPORT JKQTBasePlotter: public QObject {
         typedef QMap<QString, QList<QPointer<QAction> > > AdditionalActionsMap;
         typedef QMapIterator<QString, QList<QPointer<QAction> > > AdditionalActionsMapIterator;
 
+        /** \brief layers of a plot, which are drawn on top of each other (in the order of the enum values) and may be cached separately
+         *
+         *  \see setLayerCaching(), invalidateLayers()
+         */
+        enum DrawingLayer {
+            BackgroundLayer = 0x01, /*!< \brief background of the widget and the plot, plot frame, coordinate grid and plot label */
+            GraphsLayer = 0x02, /*!< \brief the graphs */
+            AxesLayer = 0x04, /*!< \brief the coordinate axes (incl. labels) */
+            KeyLayer = 0x08, /*!< \brief the key/legend */
+            AllLayers = BackgroundLayer|GraphsLayer|AxesLayer|KeyLayer /*!< \brief all layers */
+        };
+        Q_DECLARE_FLAGS(DrawingLayers, DrawingLayer)
+        /** \brief number of entries in DrawingLayer (without AllLayers) */
+        static constexpr int DrawingLayerCount=4;
+
         /** \brief set a global preset/default value for the userSettigsFilename and userSettigsPrefix properties of JKQTBasePlotter
          *
          *  These presets are application global and will be used ONLY on initialization of a JKQTBasePlotter. You can overwrite them
@@ -987,12 +1005,182 @@ class JKQTPLOTTER_LIB_EXPORT JKQTBasePlotter: public QObject {
         /*! \brief draw the contained graph (including grid prints) into the given JKQTPEnhancedPainter
             \param painter JKQTPEnhancedPainter to which the plot should be drawn
             \param pos where to plot the painter (left-top corner)
+            \param calculatePlotScaling if \c false, the layout of the plot (borders, key size, axis scaling) is not recalculated,
+                   but the one from a preceding call of prepareDrawNonGrid() is used. Then drawing only reads the state of the plotter.
          */
-        void drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& pos=QPoint(0,0));
+        void drawNonGrid(JKQTPEnhancedPainter& painter, const QPoint& pos=QPoint(0,0), bool calculatePlotScaling=true);
+
+        /*! \brief calculates the layout of the plot (borders, key size, axis scaling) for drawNonGrid(painter, pos, false)
+            \param painter JKQTPEnhancedPainter to which the plot will be drawn (used to measure texts)
 
+            This is the part of drawNonGrid() that modifies the plotter and emits beforePlotScalingRecalculate() and plotScalingRecalculated().
+            JKQTPlotter calls it in the GUI thread, before the plot is drawn in a background thread (see JKQTPlotter::setBackgroundRendering() ).
 
-        /** \brief emit plotUpdated(), which can be used by e.g. a widget class to update the displayed plot */
-        inline void redrawPlot() { if (emitPlotSignals) emit plotUpdated(); }
+            \note JKQTBasePlotter is not thread-safe. A drawNonGrid(painter, pos, false) in another thread only reads the plotter, its graphs
+                  and the datastore, but it writes the render state of the plotter (layer cache, strip-chart state) and of the graphs
+                  (e.g. the sort order of their data). So while it runs, the thread that owns the plotter may only call abortDrawing(),
+                  invalidateLayers(), invalidateStripChart() and the const getters of the layout (e.g. x2p(), p2x() ). All other functions
+                  (setters, drawing, exporting) have to wait until the drawing thread returned.
+         */
+        void prepareDrawNonGrid(JKQTPEnhancedPainter& painter);
+
+        /** \brief requests (\a abort \c ==true ) that a draw() or drawNonGrid() running in another thread returns as soon as possible,
+         *         or resets this request (\a abort \c ==false )
+         *
+         *  The drawing functions check this flag between two graphs and the graphs with many data points also check it in their
+         *  loop over the data (see JKQTPPlotElement::isDrawingAborted() ), so all further points and graphs, the coordinate axes and
+         *  the key are skipped and the result is incomplete. The flag is not reset automatically, so call \c abortDrawing(false)
+         *  before starting a new frame. It may be set from any thread.
+         *
+         *  This is used by JKQTPlotter to cancel outdated frames in background rendering mode (see JKQTPlotter::setBackgroundRendering() ).
+         *
+         *  \see isDrawingAborted()
+         */
+        void abortDrawing(bool abort=true);
+        /** \brief returns \c true, if abortDrawing() was called (i.e. the last frame may be incomplete)
+         *
+         *  \see abortDrawing()
+         */
+        bool isDrawingAborted() const;
+
+        /** \brief activates/deactivates drawing the graphs in several threads (default: \c false )
+         *
+         *  If activated and the plot is drawn onto a QImage (e.g. in JKQTPlotter or grabPixelImage() ), consecutive graphs that
+         *  support this (see JKQTPPlotElement::canDrawInParallel() ) are split into batches. Each batch is drawn into its own transparent
+         *  layer by a separate thread and the layers are then composited in the order of the graphs, so the result looks the same
+         *  as when drawing serially (up to rounding of the colors in antialiased, overlapping pixels). Graphs that do not support
+         *  parallel drawing (e.g. because they render text) are drawn serially in between.
+         *
+         *  This speeds up drawing plots with many graphs (e.g. multi-channel recordings) on multi-core machines, but needs
+         *  one image of the size of the plot per thread. Vector output (PDF, SVG, printing) is always drawn serially.
+         *  The worker threads are taken from a thread pool, which is shared by all plotters and kept alive between frames.
+         *
+         *  \see isParallelGraphRendering(), setParallelGraphRenderingThreads()
+         */
+        void setParallelGraphRendering(bool enabled);
+        /** \brief returns whether the graphs are drawn in several threads
+         *
+         *  \see setParallelGraphRendering()
+         */
+        bool isParallelGraphRendering() const;
+        /** \brief sets the maximum number of threads used to draw the graphs, if setParallelGraphRendering() is activated
+         *         (\c 0 (default): use QThread::idealThreadCount() threads)
+         *
+         *  \see setParallelGraphRendering()
+         */
+        void setParallelGraphRenderingThreads(int threads);
+        /** \brief returns the maximum number of threads used to draw the graphs \see setParallelGraphRenderingThreads() */
+        int getParallelGraphRenderingThreads() const;
+
+        /** \brief activates/deactivates caching the layers of the plot (see DrawingLayer ) as separate images (default: \c false )
+         *
+         *  If activated and the plot is drawn onto a QImage or QPixmap with drawNonGrid() (e.g. in JKQTPlotter ), every layer is drawn into its own image,
+         *  which is kept and composited onto the output. On the next call of drawNonGrid() only the layers that were invalidated
+         *  with invalidateLayers() since the last call are drawn again, all others are copied from the cache.
+         *  If the size, scaling or transformation of the output, the plot rectangle or the range of any axis changed (e.g. after zooming),
+         *  all layers are drawn again automatically.
+         *
+         *  So e.g. when only the data or the highlighting of a graph changes, call
+         *  \code
+         *    plot->getPlotter()->invalidateLayers(JKQTBasePlotter::GraphsLayer);
+         *  \endcode
+         *  (or JKQTPlotter::redrawPlotLayers() ) and only the graphs are drawn again. Note that JKQTPlotter::redrawPlot() invalidates all layers.
+         *  The setters of the plotter, the key and the axes and JKQTPPlotElement::setHighlighted() only invalidate the layers they affect
+         *  (see redrawPlotLayers() ).
+         *
+         *  The cache needs memory for one image of the size of the plot per layer. Exports (images, PDF, SVG, printing) are never cached.
+         *
+         *  \see isLayerCaching(), invalidateLayers(), getLayerRenderCount()
+         */
+        void setLayerCaching(bool enabled);
+        /** \brief returns whether the layers of the plot are cached \see setLayerCaching() */
+        bool isLayerCaching() const;
+        /** \brief activates/deactivates the strip-chart mode (default: \c false ), in which an advancing x-range is drawn incrementally
+         *
+         *  For strip-charts (e.g. a rolling oscilloscope display), the x-range advances by a small amount every frame and new data is only
+         *  appended at the leading edge. If the strip-chart mode and layer caching (see setLayerCaching() ) are activated and only the x-range
+         *  moved since the last frame (same width, linear axes, no other change of the geometry or of the visible graphs), the cached
+         *  GraphsLayer is shifted by the corresponding number of pixels and only the newly exposed strip (plus getStripChartOverlap() pixels,
+         *  to connect the new data) is drawn again. The background (grid) and the axes are drawn completely, as they move with the x-range.
+         *  In every other case, the plot is drawn completely. A typical update looks like this:
+         *
+         *  \code
+         *    plot->getPlotter()->setLayerCaching(true);
+         *    plot->getPlotter()->setStripChartMode(true);
+         *    // ... for every frame:
+         *    datastore->appendFramesToColumns({cT, cY}, samples.data(), samples.size()/2);
+         *    plot->setX(tNow-windowWidth, tNow);
+         *  \endcode
+         *
+         *  The shifts are rounded to full (device-)pixels, so the older parts of the graphs may be displaced by up to half a pixel.
+         *
+         *  \note In the strip-chart mode, invalidating the GraphsLayer (e.g. by JKQTPlotter::redrawPlot() ) only draws the newly exposed strip,
+         *        if the x-range moved in the same frame. So after changing the style of a graph, call invalidateStripChart() .
+         *
+         *  \see isStripChartMode(), invalidateStripChart(), setStripChartOverlap(), getStripChartRenderCount()
+         */
+        void setStripChartMode(bool enabled);
+        /** \brief returns whether the strip-chart mode is activated \see setStripChartMode() */
+        bool isStripChartMode() const;
+        /** \brief forces a complete redraw of the GraphsLayer on the next frame, also in the strip-chart mode (e.g. after changing the style of a graph)
+         *
+         *  This function may be called while the plot is drawn in another thread.
+         *
+         *  \see setStripChartMode()
+         */
+        void invalidateStripChart();
+        /** \brief sets the width (in pixels) of the region in front of the newly exposed strip, which is drawn again in the strip-chart mode (default: \c 8 ).
+         *         This has to be large enough to cover line segments and symbols that connect the old and the new data.
+         *
+         *  \see setStripChartMode()
+         */
+        void setStripChartOverlap(double pixels);
+        /** \brief returns the width (in pixels) of the region in front of the newly exposed strip, which is drawn again in the strip-chart mode \see setStripChartOverlap() */
+        double getStripChartOverlap() const;
+        /** \brief returns how often the GraphsLayer was updated incrementally in the strip-chart mode (these updates are also counted by getLayerRenderCount() )
+         *
+         *  \see setStripChartMode(), resetLayerRenderCounts()
+         */
+        quint64 getStripChartRenderCount() const;
+        /** \brief marks the given \a layers as changed, so they are drawn again on the next call of drawNonGrid() (if layer caching is activated)
+         *
+         *  This function may be called while the plot is drawn in another thread (e.g. JKQTPlotter::setBackgroundRendering() ).
+         *
+         *  \see setLayerCaching()
+         */
+        void invalidateLayers(DrawingLayers layers=AllLayers);
+        /** \brief returns how often the given \a layer was drawn (with or without layer caching), since the construction of the plotter or the last call of
+         *         resetLayerRenderCounts(), this is useful to check how efficient the layer caching is
+         *
+         *  \see setLayerCaching(), resetLayerRenderCounts()
+         */
+        quint64 getLayerRenderCount(DrawingLayer layer) const;
+        /** \brief resets the counters returned by getLayerRenderCount() */
+        void resetLayerRenderCounts();
+        /** \brief appends the frames from the ingestion queues of the datastore to their columns (see JKQTPDatastore::drainIngestionQueues() )
+         *         and marks the GraphsLayer as changed, if any data was appended. Returns the number of appended frames.
+         *
+         *  JKQTPlotter calls this at the start of every redraw. If you draw a JKQTBasePlotter yourself, call this before drawing,
+         *  in the thread that draws the plot.
+         *
+         *  \see JKQTPDatastore::addIngestionQueue()
+         */
+        size_t drainIngestionQueues();
+
+
+        /** \brief marks all layers as changed and emits plotUpdated(), which can be used by e.g. a widget class to update the displayed plot
+         *
+         *  \see redrawPlotLayers()
+         */
+        inline void redrawPlot() { redrawPlotLayers(AllLayers); }
+        /** \brief marks the given \a layers as changed (see invalidateLayers() ) and emits plotLayersUpdated() and plotUpdated(),
+         *         which can be used by e.g. a widget class to update the displayed plot
+         *
+         *  The setters of JKQTBasePlotter, the key and the axes call this with the layers they affect (e.g. KeyLayer for the style of the key),
+         *  changes of the size of the plot, the plot borders or the axis ranges call this without any layers, as they are detected
+         *  by the layer cache itself (see setLayerCaching() ).
+         */
+        void redrawPlotLayers(DrawingLayers layers);
 
         /** \brief controls, whether the signals plotUpdated() are emitted */
         void setEmittingPlotSignalsEnabled(bool __value);
@@ -1784,6 +1972,8 @@ public Q_SLOTS:
 
         /** \brief emitted when the plot has to be updated */
         void plotUpdated();
+        /** \brief emitted when the plot has to be updated, \a layers are the layers that changed (see redrawPlotLayers() ) */
+        void plotLayersUpdated(JKQTBasePlotter::DrawingLayers layers);
 
         /** \brief emitted when the plot scaling had to be recalculated */
         void plotScalingRecalculated();
@@ -2223,6 +2413,24 @@ public Q_SLOTS:
          *  \param painter JKQTPEnhancedPainter to draw on
          */
         void drawPlot(JKQTPEnhancedPainter& painter);
+        /** \brief paints the given \a layer of the plot onto \a painter , drawPlot() calls this for all layers */
+        void drawPlotLayer(JKQTPEnhancedPainter& painter, DrawingLayer layer);
+        /** \brief paints the plot onto \a painter using the cached layers (and updates the invalid ones), returns \c false, if \a painter
+         *         does not support this (then nothing is drawn)
+         *
+         *  \see setLayerCaching()
+         */
+        bool drawPlotFromLayerCache(JKQTPEnhancedPainter& painter);
+        /** \brief returns \c true, if \a painter draws onto a pixel device, for which the plot can be drawn in layers (QImage, QPixmap) */
+        static bool supportsLayers(const JKQTPEnhancedPainter& painter);
+        /** \brief creates an empty (transparent) layer image for \a painter and a painter \a layerPainter on it, which is set up
+         *         (transformation, clipping, render hints, ...) like \a painter
+         *
+         *  Compositing the layer onto \a painter (with an identity transformation) gives the same result as drawing on \a painter directly.
+         */
+        static void initLayer(QImage& layer, JKQTPEnhancedPainter& layerPainter, const JKQTPEnhancedPainter& painter);
+        /** \brief composites the \a layer (created by initLayer() ) onto \a painter */
+        static void drawLayer(JKQTPEnhancedPainter& painter, const QImage& layer);
         /** \brief simply calls paintPlot() if grid printing mode is deactivated and prints the graph grid otherwise
          *         \a pageRect is used to determine the size of the page to draw on. If this does not coincide with
          *         the widget extents this function calculates a scaling factor so the graphs fit onto the page. This
@@ -2249,6 +2457,12 @@ public Q_SLOTS:
         void drawSystemYAxis(JKQTPEnhancedPainter& painter);
         /** \brief plot the graphs in the order they appear in the list graphs, i.e. initially the order of the addGraph() calls. So the graph at the end of the list is drawn ON TOP. */
         void drawGraphs(JKQTPEnhancedPainter& painter);
+        /** \brief draws the graphs in several threads into separate layers, which are then composited onto \a painter , returns \c false,
+         *         if this is not possible (then nothing is drawn)
+         *
+         *  \see setParallelGraphRendering()
+         */
+        bool drawGraphsInParallel(JKQTPEnhancedPainter& painter);
         /** \brief plot a key */
         void drawKey(JKQTPEnhancedPainter& painter);
         /** \brief plot the plot label */
@@ -2777,6 +2991,57 @@ public Q_SLOTS:
 
         /** \brief controls, whether the signals plotUpdated() are emitted */
         bool emitPlotSignals;
+        /** \brief set by abortDrawing(), checked by the drawing functions */
+        std::atomic<bool> drawingAborted{false};
+        /** \brief if \c true, the graphs are drawn in several threads \see setParallelGraphRendering() */
+        bool parallelGraphRendering;
+        /** \brief maximum number of threads used by drawGraphsInParallel() (0: QThread::idealThreadCount() ) \see setParallelGraphRenderingThreads() */
+        int parallelGraphRenderingThreads;
+        /** \brief if \c true, the layers of the plot are cached \see setLayerCaching() */
+        bool layerCaching;
+        /** \brief layers that were invalidated since the last drawPlotFromLayerCache() \see invalidateLayers() */
+        std::atomic<int> invalidLayers{AllLayers};
+        /** \brief describes the geometry of the output for which the layers in layerCache were drawn. If it changes, all layers are drawn again */
+        struct LayerCacheGeometry {
+            /** \brief size of the output device in pixels */
+            QSize deviceSize;
+            /** \brief device pixel ratio of the output device */
+            qreal devicePixelRatio{1.0};
+            /** \brief transformation of the output painter */
+            QTransform transform;
+            /** \brief clipping of the output painter */
+            QRegion clipRegion;
+            /** \brief plot rectangle and ranges of all axes */
+            QVector<double> plotRectAndRanges;
+            bool operator==(const LayerCacheGeometry& other) const;
+        };
+        /** \brief geometry of the output, for which the layers in layerCache were drawn */
+        LayerCacheGeometry layerCacheGeometry;
+        /** \brief cached image for every DrawingLayer (index \c i corresponds to the layer \c 1<<i ) \see setLayerCaching() */
+        QImage layerCache[DrawingLayerCount];
+        /** \brief counts how often every DrawingLayer (index \c i corresponds to the layer \c 1<<i ) was drawn \see getLayerRenderCount() */
+        std::atomic<quint64> layerRenderCount[DrawingLayerCount];
+        /** \brief if \c true, shifts of the x-range are drawn incrementally \see setStripChartMode() */
+        bool stripChartMode;
+        /** \brief width of the region in front of the new strip, that is drawn again \see setStripChartOverlap() */
+        double stripChartOverlap;
+        /** \brief set by invalidateStripChart(), forces a complete redraw of the GraphsLayer */
+        std::atomic<bool> stripChartInvalid{true};
+        /** \brief displacement (in device pixels) of the content of the cached GraphsLayer, due to rounding the shifts \see setStripChartMode() */
+        double stripChartShiftError;
+        /** \brief the visible graphs, when the cached GraphsLayer was drawn \see setStripChartMode() */
+        QVector<const JKQTPPlotElement*> stripChartGraphs;
+        /** \brief if valid, drawGraphs() only draws this strip of the plot (in the strip-chart mode) \see setStripChartMode() */
+        QRectF graphsStripRect;
+        /** \brief counts the incremental updates of the GraphsLayer \see getStripChartRenderCount() */
+        std::atomic<quint64> stripChartRenderCount{0};
+        /** \brief determines whether the GraphsLayer in layerCache can be shifted from the geometry \a oldGeometry to \a newGeometry and returns the shift in device pixels in \a shiftDevicePixels
+         *  \see setStripChartMode() */
+        bool calcStripChartShift(const LayerCacheGeometry& oldGeometry, const LayerCacheGeometry& newGeometry, double& shiftDevicePixels) const;
+        /** \brief shifts the cached GraphsLayer \a cache by \a shiftDevicePixels and draws the newly exposed strip \see setStripChartMode() */
+        void drawStripChartGraphs(QImage& cache, const JKQTPEnhancedPainter& painter, double shiftDevicePixels);
+        /** \brief returns the currently visible graphs \see stripChartGraphs */
+        QVector<const JKQTPPlotElement*> getVisibleGraphsForStripChart() const;
 
 
         static QString globalUserSettigsFilename;
@@ -2821,6 +3086,8 @@ public Q_SLOTS:
 
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(JKQTBasePlotter::DrawingLayers)
+
 /** \brief qHash()-specialization
  *   \ingroup jkqtpplottersupprt
  */
@@ -84,7 +84,9 @@ void JKQTPCoordinateAxis::redrawPlot() {
     calcPlotScaling();
     if (parent) {
         parent->updateSecondaryAxes();
-        parent->redrawPlot();
+        // the grid is drawn in the background and the graphs depend on the axis transformation (e.g. logarithmic axes),
+        // changes of the range are detected by the layer cache itself
+        parent->redrawPlotLayers(JKQTBasePlotter::BackgroundLayer|JKQTBasePlotter::GraphsLayer|JKQTBasePlotter::AxesLayer);
     }
 }
 
@@ -25,6 +25,8 @@
 #include <limits>
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
 /**************************************************************************************************************************
  * JKQTPColumn
@@ -34,6 +36,8 @@ JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_):
     data(nullptr),
     rows(0),
     datavec(),
+    typedData(nullptr),
+    dataType(JKQTPMathImageDataType::DoubleArray),
     storageType(StorageType::Vector),
     imageColumns(1),
     datastore(datastore_),
@@ -48,6 +52,8 @@ JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, DataT
     data(data_),
     rows(datasize_),
     datavec(),
+    typedData(nullptr),
+    dataType(JKQTPMathImageDataType::DoubleArray),
     storageType(StorageType::External),
     imageColumns(imageColumns_),
     datastore(datastore_),
@@ -83,10 +89,68 @@ JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, DataT
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, DataTransferMode transferMode, const void *data_, JKQTPMathImageDataType dataType_, size_t datasize_, size_t imageColumns_):
+    data(nullptr),
+    rows(datasize_),
+    datavec(),
+    typedData(const_cast<void*>(data_)),
+    dataType(dataType_),
+    storageType(StorageType::TypedExternal),
+    imageColumns(imageColumns_),
+    datastore(datastore_),
+    name(name_),
+    valid(true)
+{
+    if (!data_) {
+        rows=0;
+        typedData=nullptr;
+        dataType=JKQTPMathImageDataType::DoubleArray;
+        storageType=StorageType::Vector;
+        imageColumns=1;
+    } else if (dataType_==JKQTPMathImageDataType::DoubleArray) {
+        // double data does not need a typed column
+        typedData=nullptr;
+        switch(transferMode) {
+        case DataTransferMode::TransferOwnership:
+            storageType=StorageType::Internal;
+            data=static_cast<double*>(const_cast<void*>(data_));
+            break;
+        case DataTransferMode::CopyData:
+            storageType=StorageType::Vector;
+            rows=0;
+            datavec.resize(datasize_);
+            std::memcpy(datavec.data(), data_, datasize_*sizeof(double));
+            break;
+        case DataTransferMode::ExternallyOwned:
+            storageType=StorageType::External;
+            data=static_cast<double*>(const_cast<void*>(data_));
+            break;
+        }
+    } else {
+        switch(transferMode) {
+        case DataTransferMode::TransferOwnership:
+            storageType=StorageType::TypedInternal;
+            break;
+        case DataTransferMode::CopyData: {
+                const size_t bytes=datasize_*JKQTPMathImageDataTypeSize(dataType_);
+                storageType=StorageType::TypedInternal;
+                typedData=std::malloc(std::max<size_t>(bytes, 1));
+                if (bytes>0) std::memcpy(typedData, data_, bytes);
+            } break;
+        case DataTransferMode::ExternallyOwned:
+            storageType=StorageType::TypedExternal;
+            break;
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, const double *data_, size_t datasize_, size_t imageColumns_):
     data(nullptr),
     rows(0),
+    typedData(nullptr),
+    dataType(JKQTPMathImageDataType::DoubleArray),
     storageType(StorageType::Vector),
     imageColumns(imageColumns_),
     datastore(datastore_),
@@ -106,6 +170,8 @@ JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, const
     data(nullptr),
     rows(0),
     datavec(data_),
+    typedData(nullptr),
+    dataType(JKQTPMathImageDataType::DoubleArray),
     storageType(StorageType::Vector),
     imageColumns(imageColumns_),
     datastore(datastore_),
@@ -120,6 +186,8 @@ JKQTPColumn::JKQTPColumn(JKQTPDatastore *datastore_, const QString &name_, QVect
     data(nullptr),
     rows(0),
     datavec(std::forward<QVector<double>>(data_)),
+    typedData(nullptr),
+    dataType(JKQTPMathImageDataType::DoubleArray),
     storageType(StorageType::Vector),
     imageColumns(imageColumns_),
     datastore(datastore_),
@@ -155,33 +223,55 @@ JKQTPColumn::JKQTPColumn(JKQTPColumn && other):
     data(other.data),
     rows(other.rows),
     datavec(std::move(other.datavec)),
+    typedData(other.typedData),
+    dataType(other.dataType),
     storageType(other.storageType),
+    ringCapacity(other.ringCapacity),
+    ringStart(other.ringStart),
     imageColumns(other.imageColumns),
     datastore(other.datastore),
     name(other.name),
-    valid(other.valid)
+    valid(other.valid),
+    detectExternalChanges(other.detectExternalChanges)
 {
+    other.ringCapacity=0;
+    other.ringStart=0;
     other.data=nullptr;
+    other.typedData=nullptr;
     other.rows=0;
+    other.storageType=StorageType::Vector;
     other.valid=false;
+    // other is empty now, so the summaries it may have cached are outdated
+    other.markModified();
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 JKQTPColumn& JKQTPColumn::operator=(JKQTPColumn && other)
 {
-    clear();
+    clear(); // also outdates the summaries cached in this column
     data=other.data;
     rows=other.rows;
     datavec=std::move(other.datavec);
+    typedData=other.typedData;
+    dataType=other.dataType;
     storageType=other.storageType;
+    ringCapacity=other.ringCapacity;
+    ringStart=other.ringStart;
     imageColumns=other.imageColumns;
     datastore=other.datastore;
     name=other.name;
     valid=other.valid;
+    detectExternalChanges=other.detectExternalChanges;
+    other.ringCapacity=0;
+    other.ringStart=0;
     other.data=nullptr;
+    other.typedData=nullptr;
     other.rows=0;
+    other.storageType=StorageType::Vector;
     other.valid=false;
+    // other is empty now, so the summaries it may have cached are outdated
+    other.markModified();
     return *this;
 }
 
@@ -195,6 +285,11 @@ bool JKQTPColumn::operator==(const JKQTPColumn &other) const {
         case StorageType::Internal:
         case StorageType::External:
             return data==other.data && rows==other.rows;
+        case StorageType::TypedInternal:
+        case StorageType::TypedExternal:
+            return typedData==other.typedData && dataType==other.dataType && rows==other.rows;
+        case StorageType::RingBuffer:
+            return datavec==other.datavec && ringStart==other.ringStart && rows==other.rows;
         }
     }
 
@@ -211,6 +306,7 @@ void JKQTPColumn::setName(const QString &__value)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::setImageColumns(size_t imageWidth)
 {
+    if (datastore) datastore->beforeModification();
     imageColumns=imageWidth;
 }
 
@@ -218,8 +314,13 @@ void JKQTPColumn::setImageColumns(size_t imageWidth)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::copyData(QVector<double> &copyTo) const
 {
-    const auto* p=getPointer();
     const auto N=getRows();
+    if (isTypedColumn() && typedData && N>0) {
+        copyTo.resize(N);
+        for (size_t i=0; i<N; i++) copyTo[i]=JKQTPMathImageGetValue(typedData, dataType, i);
+        return;
+    }
+    const auto* p=getPointer();
     if (N==0 || p==nullptr) {
         copyTo.clear();
         return;
@@ -239,12 +340,20 @@ QVector<double> JKQTPColumn::copyData()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::clear()
 {
+    markModified();
     if (storageType==StorageType::Internal) {
         if (data && rows>0) std::free(data);
     }
+    if (storageType==StorageType::TypedInternal) {
+        if (typedData) std::free(typedData);
+    }
     data=nullptr;
+    typedData=nullptr;
+    dataType=JKQTPMathImageDataType::DoubleArray;
     rows=0;
     datavec.clear();
+    ringCapacity=0;
+    ringStart=0;
     imageColumns=1;
     storageType=StorageType::Vector;
     valid=true;
@@ -255,6 +364,13 @@ void JKQTPColumn::clear()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 size_t JKQTPColumn::copy(const double *data, size_t N, size_t offset) {
+    markModified();
+    if (isTypedColumn()) {
+        if (!typedData || offset>=rows) return 0;
+        const size_t Ntocopy=(N+offset<=rows) ? N: (rows-offset);
+        for (size_t i=0; i<Ntocopy; i++) JKQTPMathImageSetValue(typedData, dataType, offset+i, data[i]);
+        return Ntocopy;
+    }
     auto* p=getPointer(offset);
     if (!p) return 0;
     const auto rows = getRows();
@@ -274,7 +390,15 @@ size_t JKQTPColumn::copy(const double *data, size_t N, size_t offset) {
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::exchange(double value, double replace)
 {
+    markModified();
     const size_t rows=getRows();
+    if (isTypedColumn()) {
+        if (!typedData) return;
+        for (size_t i=0; i<rows; i++) {
+            if (JKQTPMathImageGetValue(typedData, dataType, i)==value) JKQTPMathImageSetValue(typedData, dataType, i, replace);
+        }
+        return;
+    }
     auto* p=getPointer();
     if (!p) return;
     for (size_t i=0; i<rows; i++) {
@@ -286,7 +410,15 @@ void JKQTPColumn::exchange(double value, double replace)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::subtract(double value)
 {
+    markModified();
     const size_t rows=getRows();
+    if (isTypedColumn()) {
+        if (!typedData) return;
+        for (size_t i=0; i<rows; i++) {
+            JKQTPMathImageSetValue(typedData, dataType, i, JKQTPMathImageGetValue(typedData, dataType, i) - value);
+        }
+        return;
+    }
     auto* p=getPointer();
     if (!p) return;
     for (size_t i=0; i<rows; i++) {
@@ -297,7 +429,15 @@ void JKQTPColumn::subtract(double value)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::scale(double factor)
 {
+    markModified();
     const size_t rows=getRows();
+    if (isTypedColumn()) {
+        if (!typedData) return;
+        for (size_t i=0; i<rows; i++) {
+            JKQTPMathImageSetValue(typedData, dataType, i, JKQTPMathImageGetValue(typedData, dataType, i) * factor);
+        }
+        return;
+    }
     auto* p=getPointer();
     if (!p) return;
     for (size_t i=0; i<rows; i++) {
@@ -308,7 +448,15 @@ void JKQTPColumn::scale(double factor)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::setAll(double value)
 {
+    markModified();
     const size_t rows=getRows();
+    if (isTypedColumn()) {
+        if (!typedData) return;
+        for (size_t i=0; i<rows; i++) {
+            JKQTPMathImageSetValue(typedData, dataType, i, value);
+        }
+        return;
+    }
     auto* p=getPointer();
     if (!p) return;
     for (size_t i=0; i<rows; i++) {
@@ -330,6 +478,27 @@ bool JKQTPColumn::convertToVectorColumn()
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPColumn::convertToRingBufferColumn(size_t capacity)
+{
+    QVector<double> old;
+    if (isValid()) copyData(old);
+    const size_t N=std::min<size_t>(static_cast<size_t>(old.size()), capacity);
+    clear();
+    storageType=StorageType::RingBuffer;
+    ringCapacity=capacity;
+    ringStart=0;
+    rows=N;
+    datavec.resize(2*capacity);
+    double* d=datavec.data();
+    const double* src=old.constData()+(old.size()-N);
+    for (size_t i=0; i<N; i++) {
+        d[i]=src[i];
+        d[i+capacity]=src[i];
+    }
+    valid=true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPColumn::convertToVectorColumnFromRanges(size_t start1, size_t end1, size_t start2, size_t end2)
 {
@@ -370,6 +539,259 @@ void JKQTPColumn::convertToVectorColumnFromRange(size_t start1, size_t end1)
     convertToVectorColumnFromRanges(start1,end1, getRows(), getRows());
 }
 
+namespace {
+    /** \brief calls \a f(value) for all values in the rows \a start ... \a end-1 of \a column */
+    template <class TFunc>
+    inline void jkqtp_forEachColumnValue(const JKQTPColumn& column, size_t start, size_t end, TFunc f) {
+        const double* p=column.getPointer(0);
+        if (p) {
+            for (size_t i=start; i<end; i++) f(p[i]);
+        } else {
+            for (size_t i=start; i<end; i++) f(column.getValue(i));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPColumn::initialGeneration()
+{
+    static std::atomic<quint64> columnCounter(0);
+    return (columnCounter.fetch_add(1)+1)<<32;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<const JKQTPColumnMinMaxPyramid> JKQTPColumn::getMinMaxPyramid() const
+{
+    const quint64 gen=getGeneration();
+    const quint64 key=getDataKey();
+    {
+        JKQTPSynchronized<CachedSummaries>::ReadLocker lock(cachedSummaries);
+        if (cachedSummaries->minMaxPyramid && cachedSummaries->minMaxPyramidDataKey==key) return cachedSummaries->minMaxPyramid;
+    }
+    // build outside the lock, so concurrent readers are not blocked by the (possibly long) pass over the data
+    auto pyramid=std::make_shared<const JKQTPColumnMinMaxPyramid>(*this);
+    JKQTPSynchronized<CachedSummaries>::WriteLocker lock(cachedSummaries);
+    if (!cachedSummaries->minMaxPyramid || cachedSummaries->minMaxPyramidGeneration<=gen) {
+        cachedSummaries->minMaxPyramid=pyramid;
+        cachedSummaries->minMaxPyramidGeneration=gen;
+        cachedSummaries->minMaxPyramidDataKey=key;
+    }
+    return pyramid;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnStatistics JKQTPColumn::getStatistics() const
+{
+    const quint64 gen=getGeneration();
+    const quint64 key=getDataKey();
+    std::shared_ptr<const JKQTPColumnMinMaxPyramid> pyramid;
+    {
+        JKQTPSynchronized<CachedSummaries>::ReadLocker lock(cachedSummaries);
+        if (cachedSummaries->hasStatistics && cachedSummaries->statisticsDataKey==key) return cachedSummaries->statistics;
+        if (cachedSummaries->minMaxPyramid && cachedSummaries->minMaxPyramidDataKey==key) pyramid=cachedSummaries->minMaxPyramid;
+    }
+
+    JKQTPColumnStatistics stat;
+    stat.generation=gen;
+    stat.rows=getRows();
+    JKQTPColumnMinMaxPyramid::Summary summary;
+    if (pyramid && pyramid->getLevelCount()>0) {
+        // an up-to-date pyramid already contains all information
+        summary=pyramid->getLevel(pyramid->getLevelCount()-1)[0];
+        stat.hasNonFiniteValues=pyramid->hasNonFiniteValues();
+        stat.sortedAscending=pyramid->isSortedAscending();
+        stat.sortedDescending=pyramid->isSortedDescending();
+    } else if (stat.rows>0) {
+        stat.sortedAscending=stat.sortedDescending=true;
+        size_t i=0;
+        double last=0;
+        jkqtp_forEachColumnValue(*this, 0, stat.rows, [&](double v) {
+            summary.add(v);
+            if (!std::isfinite(v)) {
+                stat.hasNonFiniteValues=true;
+                stat.sortedAscending=stat.sortedDescending=false;
+            } else if (i>0) {
+                if (v<last) stat.sortedAscending=false;
+                if (v>last) stat.sortedDescending=false;
+            }
+            last=v;
+            i++;
+        });
+    }
+    stat.hasFiniteValues=!summary.isEmpty();
+    if (stat.hasFiniteValues) {
+        stat.minValue=summary.minValue;
+        stat.maxValue=summary.maxValue;
+    }
+    stat.smallestGreaterZero=summary.smallestGreaterZero;
+
+    JKQTPSynchronized<CachedSummaries>::WriteLocker lock(cachedSummaries);
+    if (!cachedSummaries->hasStatistics || cachedSummaries->statistics.generation<=gen) {
+        cachedSummaries->statistics=stat;
+        cachedSummaries->statisticsDataKey=key;
+        cachedSummaries->hasStatistics=true;
+    }
+    return stat;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPColumn::getMinMax(size_t start, size_t end, double &min, double &max, double *smallestGreaterZero) const
+{
+    min=max=0;
+    if (smallestGreaterZero) *smallestGreaterZero=0;
+    if (!isValid() || start>=end || start>=getRows()) return false;
+    if (start==0 && end>=getRows()) {
+        const JKQTPColumnStatistics stat=getStatistics();
+        if (smallestGreaterZero) *smallestGreaterZero=stat.smallestGreaterZero;
+        min=stat.minValue;
+        max=stat.maxValue;
+        return stat.hasFiniteValues;
+    }
+    const JKQTPColumnMinMaxPyramid::Summary s=getMinMaxPyramid()->query(*this, start, end);
+    if (smallestGreaterZero) *smallestGreaterZero=s.smallestGreaterZero;
+    if (s.isEmpty()) return false;
+    min=s.minValue;
+    max=s.maxValue;
+    return true;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnMinMaxPyramid::JKQTPColumnMinMaxPyramid(const JKQTPColumn &column):
+    m_rows(column.getRows()),
+    m_levels(),
+    m_sortedAscending(true),
+    m_sortedDescending(true),
+    m_hasNonFiniteValues(false)
+{
+    if (m_rows==0) return;
+
+    // level 0 + sortedness in one pass over the data
+    std::vector<Summary> level0((m_rows+LeafSize-1)/LeafSize);
+    size_t i=0;
+    double last=0;
+    jkqtp_forEachColumnValue(column, 0, m_rows, [&](double v) {
+        level0[i/LeafSize].add(v);
+        if (!std::isfinite(v)) {
+            m_hasNonFiniteValues=true;
+            m_sortedAscending=m_sortedDescending=false;
+        } else if (i>0) {
+            if (v<last) m_sortedAscending=false;
+            if (v>last) m_sortedDescending=false;
+        }
+        last=v;
+        i++;
+    });
+    m_levels.push_back(std::move(level0));
+
+    // higher levels
+    while (m_levels.back().size()>1) {
+        const std::vector<Summary>& below=m_levels.back();
+        std::vector<Summary> above((below.size()+Fanout-1)/Fanout);
+        for (size_t b=0; b<below.size(); b++) above[b/Fanout].add(below[b]);
+        m_levels.push_back(std::move(above));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnMinMaxPyramid::Summary JKQTPColumnMinMaxPyramid::query(const JKQTPColumn &column, size_t start, size_t end) const
+{
+    Summary res;
+    end=std::min(end, m_rows);
+    if (start>=end) return res;
+    const auto addRows=[&res, &column](size_t s, size_t e) {
+        jkqtp_forEachColumnValue(column, s, e, [&res](double v) { res.add(v); });
+    };
+
+    // the range covers the full level-0 blocks [b0..b1), the rows outside these blocks are read from the column
+    size_t b0=(start+LeafSize-1)/LeafSize;
+    size_t b1=end/LeafSize;
+    if (b0>=b1) {
+        addRows(start, end);
+        return res;
+    }
+    addRows(start, b0*LeafSize);
+    addRows(b1*LeafSize, end);
+
+    // in every level: use the entries at the borders of [b0..b1) and continue with the entries [p0..p1) of the next level,
+    // that cover the inner part
+    for (size_t l=0; l<m_levels.size() && b0<b1; l++) {
+        const std::vector<Summary>& level=m_levels[l];
+        const size_t p0=(b0+Fanout-1)/Fanout;
+        const size_t p1=b1/Fanout;
+        if (l+1>=m_levels.size() || p0>=p1) {
+            for (size_t b=b0; b<b1; b++) res.add(level[b]);
+            break;
+        }
+        for (size_t b=b0; b<p0*Fanout; b++) res.add(level[b]);
+        for (size_t b=p1*Fanout; b<b1; b++) res.add(level[b]);
+        b0=p0;
+        b1=p1;
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPXYSpatialIndex::JKQTPXYSpatialIndex(const JKQTPColumnView &x, const JKQTPColumnView &y, size_t start, size_t end)
+{
+    end=qMin(end, qMin(x.getRows(), y.getRows()));
+    std::vector<Point> points;
+    if (start<end) points.reserve(end-start);
+    JKQTPVisitColumnViews(x, y, [&](const auto& xCol, const auto& yCol) {
+        for (size_t i=start; i<end; i++) {
+            const double xv=xCol[i];
+            const double yv=yCol[i];
+            if (std::isfinite(xv) && std::isfinite(yv)) points.push_back(Point{xv, yv, i});
+        }
+    });
+    const size_t N=points.size();
+    if (N==0) {
+        m_xEdges={0.0, 0.0};
+        m_yEdges={0.0, 0.0};
+        m_cellStart={0, 0};
+        return;
+    }
+
+    // cell borders at quantiles of the x- and y-values, estimated from a sample of at most 64k points
+    const size_t cellsPerDim=qBound<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(double(N)/double(PointsPerCell)))), 1024);
+    const size_t sampleStep=qMax<size_t>(1, N/65536);
+    const auto calcEdges=[&](std::vector<double>& edges, double Point::*coord) {
+        std::vector<double> sample;
+        sample.reserve(N/sampleStep+1);
+        double vmin=points[0].*coord, vmax=points[0].*coord;
+        for (size_t i=0; i<N; i++) {
+            const double v=points[i].*coord;
+            if (v<vmin) vmin=v;
+            if (v>vmax) vmax=v;
+            if (i%sampleStep==0) sample.push_back(v);
+        }
+        std::sort(sample.begin(), sample.end());
+        edges.resize(cellsPerDim+1);
+        edges[0]=vmin;
+        for (size_t c=1; c<cellsPerDim; c++) edges[c]=sample[c*sample.size()/cellsPerDim];
+        edges[cellsPerDim]=vmax;
+    };
+    calcEdges(m_xEdges, &Point::x);
+    calcEdges(m_yEdges, &Point::y);
+
+    // sort the points by cell (counting sort)
+    const size_t nx=getCellCountX();
+    std::vector<uint32_t> cells(N);
+    m_cellStart.assign(nx*getCellCountY()+1, 0);
+    for (size_t i=0; i<N; i++) {
+        cells[i]=static_cast<uint32_t>(cellIndex(m_yEdges, points[i].y)*nx+cellIndex(m_xEdges, points[i].x));
+        m_cellStart[cells[i]+1]++;
+    }
+    for (size_t c=1; c<m_cellStart.size(); c++) m_cellStart[c]+=m_cellStart[c-1];
+    std::vector<size_t> fill(m_cellStart.begin(), m_cellStart.end()-1);
+    m_points.resize(N);
+    for (size_t i=0; i<N; i++) {
+        m_points[fill[cells[i]]++]=points[i];
+    }
+}
+
 
 
 
@@ -384,11 +806,87 @@ void JKQTPColumn::convertToVectorColumnFromRange(size_t start1, size_t end1)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 size_t JKQTPDatastore::addColumn(JKQTPColumn &&col) {
+    beforeModification();
     columns.insert(maxColumnsID, std::make_shared<JKQTPColumn>(std::forward<JKQTPColumn>(col)));
     maxColumnsID++;
     return maxColumnsID-1;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPDatastoreIngestionQueue::JKQTPDatastoreIngestionQueue(const std::vector<size_t> &columns, size_t capacityFrames):
+    m_columns(columns),
+    m_queue(std::max<size_t>(capacityFrames, 1)*columns.size()),
+    m_pushedFrames(0),
+    m_droppedFrames(0),
+    m_drainedFrames(0),
+    m_drainCount(0),
+    m_maxPendingFrames(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastoreIngestionQueue::pushFrames(const double *frames, size_t frameCount)
+{
+    const size_t C=getFrameSize();
+    const size_t accepted=m_queue.push(frames, frameCount*C, C)/C;
+    m_pushedFrames.fetch_add(accepted, std::memory_order_relaxed);
+    if (accepted<frameCount) m_droppedFrames.fetch_add(frameCount-accepted, std::memory_order_relaxed);
+    // only the producer writes m_maxPendingFrames
+    const size_t pending=getPendingFrames();
+    if (pending>m_maxPendingFrames.load(std::memory_order_relaxed)) m_maxPendingFrames.store(pending, std::memory_order_relaxed);
+    return accepted;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastoreIngestionQueue::pushFrame(std::initializer_list<double> frame)
+{
+    if (frame.size()!=getFrameSize()) return false;
+    return pushFrames(frame.begin(), 1)==1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPDatastoreIngestionQueue::Statistics JKQTPDatastoreIngestionQueue::getStatistics() const
+{
+    Statistics stat;
+    stat.pushedFrames=m_pushedFrames.load(std::memory_order_relaxed);
+    stat.droppedFrames=m_droppedFrames.load(std::memory_order_relaxed);
+    stat.drainedFrames=m_drainedFrames.load(std::memory_order_relaxed);
+    stat.drainCount=m_drainCount.load(std::memory_order_relaxed);
+    stat.maxPendingFrames=m_maxPendingFrames.load(std::memory_order_relaxed);
+    stat.capacityFrames=getCapacityFrames();
+    return stat;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastoreIngestionQueue::resetStatistics()
+{
+    m_pushedFrames=0;
+    m_droppedFrames=0;
+    m_drainedFrames=0;
+    m_drainCount=0;
+    m_maxPendingFrames=0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastoreIngestionQueue::drainInto(JKQTPDatastore *datastore)
+{
+    const size_t C=getFrameSize();
+    bool ok=true;
+    // the capacity of the queue is a multiple of C, so both segments contain complete frames
+    const size_t frames=m_queue.consume([&](const double* data, size_t count) {
+        ok=datastore->appendFramesToColumns(m_columns, data, count/C) && ok;
+    })/C;
+    if (frames==0) return 0;
+    if (!ok) {
+        // the columns were deleted in the meantime
+        m_droppedFrames.fetch_add(frames, std::memory_order_relaxed);
+        return 0;
+    }
+    m_drainedFrames.fetch_add(frames, std::memory_order_relaxed);
+    m_drainCount.fetch_add(1, std::memory_order_relaxed);
+    return frames;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 JKQTPDatastore::JKQTPDatastore():
     m_invalidColumn(new JKQTPColumn),
@@ -518,8 +1016,10 @@ JKQTPColumnBackInserter JKQTPDatastore::backInserter(size_t i)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPDatastore::clear(){
+    beforeModification();
     maxColumnsID=0;
     columns.clear();
+    ingestionQueues.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -553,15 +1053,188 @@ void JKQTPDatastore::deleteAllPrefixedColumns(QString prefix) {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPMathImageDataType JKQTPDatastore::getColumnDataType(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return JKQTPMathImageDataType::DoubleArray;
+    return it.value()->getDataType();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPMathImageDataType JKQTPDatastore::getColumnDataType(int column) const
+{
+    if (column<0) return JKQTPMathImageDataType::DoubleArray;
+    return getColumnDataType(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+const void *JKQTPDatastore::getColumnRawPointer(size_t column, size_t row) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return nullptr;
+    return static_cast<const JKQTPColumn*>(it.value().get())->getRawPointer(row);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+const void *JKQTPDatastore::getColumnRawPointer(int column, size_t row) const
+{
+    if (column<0) return nullptr;
+    return getColumnRawPointer(static_cast<size_t>(column), row);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnView JKQTPDatastore::getColumnView(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return JKQTPColumnView();
+    return JKQTPColumnView(it.value());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnView JKQTPDatastore::getColumnView(int column) const
+{
+    if (column<0) return JKQTPColumnView();
+    return getColumnView(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnStatistics JKQTPDatastore::getColumnStatistics(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return JKQTPColumnStatistics();
+    return it.value()->getStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnStatistics JKQTPDatastore::getColumnStatistics(int column) const
+{
+    if (column<0) return JKQTPColumnStatistics();
+    return getColumnStatistics(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::markColumnModified(size_t column)
+{
+    auto it=columns.find(column);
+    if (it!=columns.end()) it.value()->markModified();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::markColumnModified(int column)
+{
+    if (column<0) return;
+    markColumnModified(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::setColumnDetectExternalChanges(size_t column, bool enabled)
+{
+    auto it=columns.find(column);
+    if (it!=columns.end()) it.value()->setDetectExternalChanges(enabled);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::setColumnDetectExternalChanges(int column, bool enabled)
+{
+    if (column<0) return;
+    setColumnDetectExternalChanges(static_cast<size_t>(column), enabled);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastore::getColumnDetectExternalChanges(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return false;
+    return it.value()->getDetectExternalChanges();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastore::getColumnDetectExternalChanges(int column) const
+{
+    if (column<0) return false;
+    return getColumnDetectExternalChanges(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::setModificationGuard(const void *owner, const std::function<void ()> &guard)
+{
+    JKQTPSynchronized<QMap<const void*, std::function<void()> > >::WriteLocker lock(modificationGuards);
+    modificationGuards->insert(owner, guard);
+    modificationGuardCount.store(static_cast<int>(modificationGuards->size()), std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::removeModificationGuard(const void *owner)
+{
+    JKQTPSynchronized<QMap<const void*, std::function<void()> > >::WriteLocker lock(modificationGuards);
+    modificationGuards->remove(owner);
+    modificationGuardCount.store(static_cast<int>(modificationGuards->size()), std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::callModificationGuards()
+{
+    // the guards are called without holding the lock, as they may wait for a thread that reads the datastore
+    QList<std::function<void()> > guards;
+    {
+        JKQTPSynchronized<QMap<const void*, std::function<void()> > >::ReadLocker lock(modificationGuards);
+        guards=modificationGuards->values();
+    }
+    for (const auto& guard: guards) {
+        if (guard) guard();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 quint16 JKQTPDatastore::getColumnChecksum(int column) const
 {
     return columns[column]->calculateChecksum();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPDatastore::getColumnHash64(int column) const
+{
+    if (column<0) return 0;
+    auto it=columns.find(static_cast<size_t>(column));
+    if (it==columns.end()) return 0;
+    return it.value()->calculateHash64();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPDatastore::getColumnGeneration(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return 0;
+    return it.value()->getGeneration();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPDatastore::getColumnGeneration(int column) const
+{
+    if (column<0) return 0;
+    return getColumnGeneration(static_cast<size_t>(column));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPDatastore::getColumnDataKey(size_t column) const
+{
+    auto it=columns.find(column);
+    if (it==columns.end()) return 0;
+    return it.value()->getDataKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPDatastore::getColumnDataKey(int column) const
+{
+    if (column<0) return 0;
+    return getColumnDataKey(static_cast<size_t>(column));
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPDatastore::deleteColumn(size_t column) {
+    beforeModification();
     columns.remove(column);
 }
 
@@ -641,6 +1314,44 @@ size_t JKQTPDatastore::addInternalImageColumn(double *data, size_t width, size_t
     return addColumn(JKQTPColumn(this, name, JKQTPColumn::TransferOwnership, data, width*height, width));
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addTypedColumn(const void *data, JKQTPMathImageDataType dataType, size_t rows, const QString &name)
+{
+    return addColumn(JKQTPColumn(this, name, JKQTPColumn::ExternallyOwned, data, dataType, rows));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addInternalTypedColumn(void *data, JKQTPMathImageDataType dataType, size_t rows, const QString &name)
+{
+    return addColumn(JKQTPColumn(this, name, JKQTPColumn::TransferOwnership, data, dataType, rows));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addCopiedTypedColumn(const void *data, JKQTPMathImageDataType dataType, size_t rows, const QString &name)
+{
+    return addColumn(JKQTPColumn(this, name, JKQTPColumn::CopyData, data, dataType, rows));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addTypedImageColumn(const void *data, JKQTPMathImageDataType dataType, size_t width, size_t height, const QString &name)
+{
+    return addColumn(JKQTPColumn(this, name, JKQTPColumn::ExternallyOwned, data, dataType, width*height, width));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addCopiedTypedImageColumn(const void *data, JKQTPMathImageDataType dataType, size_t width, size_t height, const QString &name)
+{
+    return addColumn(JKQTPColumn(this, name, JKQTPColumn::CopyData, data, dataType, width*height, width));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::addRingBufferColumn(size_t capacity, const QString &name)
+{
+    JKQTPColumn col(this, name);
+    col.convertToRingBufferColumn(capacity);
+    return addColumn(std::move(col));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPDatastore::setColumnImageWidth(size_t column, size_t imageWidth)
 {
@@ -650,13 +1361,14 @@ void JKQTPDatastore::setColumnImageWidth(size_t column, size_t imageWidth)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 bool JKQTPDatastore::isColumnDataExternal(size_t column) const
 {
-    return columns[column]->getStorageType()==JKQTPColumn::StorageType::External;
+    const auto st=columns[column]->getStorageType();
+    return st==JKQTPColumn::StorageType::External || st==JKQTPColumn::StorageType::TypedExternal;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 bool JKQTPDatastore::isColumnDataExternal(int column) const
 {
-    return columns[column]->getStorageType()==JKQTPColumn::StorageType::External;
+    return isColumnDataExternal(static_cast<size_t>(column));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -683,6 +1395,18 @@ void JKQTPDatastore::convertToVectorColumn(int column)
     convertToVectorColumn(static_cast<size_t>(column));
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::convertToRingBufferColumn(size_t column, size_t capacity)
+{
+    columns[column]->convertToRingBufferColumn(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastore::isRingBufferColumn(size_t column) const
+{
+    return columns.contains(column) && columns[column]->isRingBufferColumn();
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 void JKQTPDatastore::setColumnImageHeight(size_t column, size_t imageHeight)
@@ -1622,6 +2346,82 @@ void JKQTPDatastore::appendToColumns(size_t column1, size_t column2, size_t colu
     appendToColumn(column5,value5);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastore::appendFramesToColumns(const std::vector<size_t> &columnIDs, const double *frames, size_t frameCount)
+{
+    // look up all columns first, so either all or none are extended
+    std::vector<JKQTPColumn*> cols;
+    cols.reserve(columnIDs.size());
+    for (size_t id: columnIDs) {
+        auto it=columns.find(id);
+        if (it == columns.end()) {
+            qDebug()<<"column "<<id<<" does not exist, so we cannnot add a frame";
+            return false;
+        }
+        cols.push_back(it.value().get());
+    }
+    if (cols.empty() || frameCount==0) return true;
+    const size_t C=cols.size();
+    for (size_t c=0; c<C; c++) {
+        JKQTPColumn* col=cols[c];
+        if (col->isRingBufferColumn()) {
+            col->markModified();
+            for (size_t f=0; f<frameCount; f++) col->appendToRingBuffer(frames[f*C+c]);
+        } else {
+            if (!col->isVectorColumn()) col->convertToVectorColumn();
+            col->markModified();
+            for (size_t f=0; f<frameCount; f++) col->datavec.push_back(frames[f*C+c]);
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<JKQTPDatastoreIngestionQueue> JKQTPDatastore::addIngestionQueue(const std::vector<size_t> &columnIDs, size_t capacityFrames)
+{
+    if (columnIDs.empty()) return nullptr;
+    for (size_t id: columnIDs) {
+        if (!hasColumn(id)) {
+            qDebug()<<"column "<<id<<" does not exist, so we cannnot add an ingestion queue for it";
+            return nullptr;
+        }
+    }
+    std::shared_ptr<JKQTPDatastoreIngestionQueue> queue(new JKQTPDatastoreIngestionQueue(columnIDs, capacityFrames));
+    ingestionQueues.push_back(queue);
+    return queue;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+void JKQTPDatastore::removeIngestionQueue(const std::shared_ptr<JKQTPDatastoreIngestionQueue> &queue)
+{
+    ingestionQueues.erase(std::remove(ingestionQueues.begin(), ingestionQueues.end(), queue), ingestionQueues.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::drainIngestionQueues()
+{
+    size_t frames=0;
+    for (auto& queue: ingestionQueues) {
+        frames+=queue->drainInto(this);
+    }
+    return frames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+bool JKQTPDatastore::hasPendingIngestion() const
+{
+    for (const auto& queue: ingestionQueues) {
+        if (queue->getPendingFrames()>0) return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+size_t JKQTPDatastore::getIngestionQueueCount() const
+{
+    return ingestionQueues.size();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 size_t JKQTPDatastore::getColumnImageWidth(int column) const
 {
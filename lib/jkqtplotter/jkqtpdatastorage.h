@@ -25,10 +25,18 @@
 #include "jkqtplotter/jkqtptools.h"
 #include "jkqtcommon/jkqtpdebuggingtools.h"
 #include "jkqtcommon/jkqttools.h"
+#include "jkqtcommon/jkqtpbasicimagetools.h"
+#include "jkqtcommon/jkqtpconcurrencytools.h"
 #include <vector>
 #include <cmath>
 #include <iostream>
 #include <memory>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <initializer_list>
+#include <functional>
+#include <type_traits>
 #include <QString>
 #include <QMap>
 #include <QList>
@@ -48,6 +56,9 @@ class JKQTPColumnIterator; // forward declaration
 class JKQTPColumnConstIterator; // forward declaration
 class JKQTPDatastoreModel; // forward declaration
 class JKQTPColumnBackInserter; // forward declaration
+class JKQTPColumnView; // forward declaration
+class JKQTPColumnMinMaxPyramid; // forward declaration
+class JKQTPDatastoreIngestionQueue; // forward declaration
 
 
 
@@ -91,7 +102,11 @@ class JKQTPColumnBackInserter; // forward declaration
   *     on a rectangular grid (useful for calculating image data)
   *   <li> addCalculatedColumn() calculates a column, based on row numbers and a C++ functor
   *   <li> addCalculatedColumnFromColumn() calculates a column, based on another column data
+  *   <li> addRingBufferColumn() adds a column with a fixed capacity, where appending drops the oldest value (for live data)
   *   <li> addCopiedMap() copies data from a std::map/QMap into two columns
+  *   <li> addTypedColumn(), addCopiedTypedColumn() and addTypedImageColumn() store (or reference) data with an element type other
+  *     than \c double (e.g. \c int16_t from an ADC or \c uint16_t camera frames, see JKQTPMathImageDataType ) without converting it.
+  *     The values are converted to \c double only when they are read.
   *   <li> ... several more functions for specific cases exist.
   *   <li> Also note that there are even library extensions that allow to import data directly from OpenCV matrices: JKQTPCopyCvMatToColumn()
   * </ul>
@@ -108,7 +123,15 @@ class JKQTPColumnBackInserter; // forward declaration
   * The properties of columns may be accessed using:
   *   - getRows() returns the number of rows in a specific column
   *   - getColumnPointer() returns a pointer to the data in the column
+  *   - getColumnView() returns a read-only JKQTPColumnView (pointer and length) onto the data in the column
+  *     JKQTPColumnView::getMinMax() returns the range of the data in any set of rows in O(log N), using a cached JKQTPColumnMinMaxPyramid
+  *   - getColumnStatistics() returns (cached) min/max/sortedness of a column. Direct changes to external memory that is referenced
+  *     by a column have to be signalled with markColumnModified(), or detected by a hash over the data, if this is switched on
+  *     for the column with setColumnDetectExternalChanges()
+  *   - getColumnDataType() and getColumnRawPointer() return the element type and the data of typed columns (see addTypedColumn() )
   *   - getColumnChecksum() calculated a checksum over the data in the column
+  *   - getColumnGeneration() returns a counter that changes whenever the data in the column changes,
+  *     getColumnHash64() calculates a 64-bit hash of the data and getColumnDataKey() returns the key to use for caching
   *   - getColumnNames() / getColumnName()
   * .
   *
@@ -124,6 +147,7 @@ class JKQTPColumnBackInserter; // forward declaration
   *   - inc() / dec() increment/decrement a column entry
   *   - appendToColumn() (adds a single row/new value to a column, if the column was not internally managed before, it will be copied into a new internal memory segment by the first call to this function!)
   *   - appendToColumns() (adds several values to several columns simultaneously, i.e. a shortcut to prevents writing several consecutive appendToColumn() for each column separately)
+  *   - appendFramesToColumns() (adds blocks of interleaved values to several columns, looking up the columns only once)
   *   - appendFromContainerToColumn() (adds several rows from a container to a column, if the column was not internally managed before, it will be copied into a new internal memory segment by the first call to this function!)
   * .
   *
@@ -235,6 +259,25 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
          *  \see columns
          */
         size_t maxColumnsID;
+
+        /** \brief the ingestion queues, that are drained by drainIngestionQueues()
+         *  \internal
+         *  \see addIngestionQueue()
+         */
+        std::vector<std::shared_ptr<JKQTPDatastoreIngestionQueue> > ingestionQueues;
+
+        /** \brief the guards, registered with setModificationGuard(), called by beforeModification()
+         *  \internal
+         */
+        JKQTPSynchronized<QMap<const void*, std::function<void()> > > modificationGuards;
+        /** \brief number of entries in modificationGuards, allows beforeModification() to return without locking, if there are none
+         *  \internal
+         */
+        std::atomic<int> modificationGuardCount{0};
+        /** \brief calls all guards in modificationGuards
+         *  \internal
+         */
+        void callModificationGuards();
     protected:
 
         /** \brief add a new column to the datastore and return its ID */
@@ -330,6 +373,78 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
         void deleteAllPrefixedColumns(QString prefix);
 
 
+        /** \brief returns a read-only view (pointer and length) onto the data in column \a column
+         *
+         *  The column is looked up only once, so iterating over the returned JKQTPColumnView is much cheaper
+         *  than calling get() for every row. The view keeps the column object alive, but the data pointer
+         *  is only valid until the next operation that changes the size of the column (e.g. appendToColumn() ).
+         *  Use this in tight loops, e.g. in the draw() or getXMinMax() functions of a graph.
+         *
+         *  If the column does not exist, an invalid view (JKQTPColumnView::isValid() \c ==false ) is returned.
+         */
+        JKQTPColumnView getColumnView(size_t column) const;
+        /** \copydoc getColumnView(size_t) const */
+        JKQTPColumnView getColumnView(int column) const;
+        /** \brief returns statistics (min, max, smallest value >0, sortedness, ...) over all rows in column \a column
+         *
+         *  The statistics are cached in the column, until its data is modified, so calling this repeatedly (e.g. for autoscaling
+         *  many plots that show the same data) does not rescan the data. An invalid/empty JKQTPColumnStatistics is returned,
+         *  if the column does not exist.
+         *
+         *  \see JKQTPColumn::getStatistics(), markColumnModified()
+         */
+        JKQTPColumnStatistics getColumnStatistics(size_t column) const;
+        /** \copydoc getColumnStatistics(size_t) const */
+        JKQTPColumnStatistics getColumnStatistics(int column) const;
+        /** \brief marks the data in column \a column as modified, i.e. outdates all data cached for the column (e.g. getColumnStatistics() )
+         *
+         *  All functions of JKQTPDatastore that change data do this automatically. You only have to call this, if you changed the
+         *  data of a column that references external memory (e.g. addColumn(double*,size_t,const QString&) ) directly in that memory.
+         *
+         *  \see JKQTPColumn::markModified(), setColumnDetectExternalChanges()
+         */
+        void markColumnModified(size_t column);
+        /** \copydoc markColumnModified(size_t) */
+        void markColumnModified(int column);
+        /** \brief if \a enabled , changes to the external memory referenced by column \a column are detected without markColumnModified()
+         *
+         *  The data key of the column (see getColumnDataKey() ) then also contains a hash over the data. So every validation of data cached
+         *  from the column (statistics, min/max pyramid, images, contour lines, ...) reads the whole column once. Only switch this on for
+         *  small columns, or if the code that changes the memory cannot call markColumnModified().
+         *  This has no effect for columns that own their memory. The default is \c false .
+         *
+         *  \see JKQTPColumn::setDetectExternalChanges()
+         */
+        void setColumnDetectExternalChanges(size_t column, bool enabled);
+        /** \copydoc setColumnDetectExternalChanges(size_t,bool) */
+        void setColumnDetectExternalChanges(int column, bool enabled);
+        /** \brief returns \c true if changes to the external memory of column \a column are detected by a hash (see setColumnDetectExternalChanges() ) */
+        bool getColumnDetectExternalChanges(size_t column) const;
+        /** \copydoc getColumnDetectExternalChanges(size_t) const */
+        bool getColumnDetectExternalChanges(int column) const;
+        /** \brief registers a function \a guard under the key \a owner , which is called before the data or the set of columns of this datastore is modified
+         *
+         *  All functions of JKQTPDatastore and JKQTPColumn that change data (see JKQTPColumn::markModified() ) or add/delete columns
+         *  call beforeModification() first, which calls all registered guards in the modifying thread. JKQTPlotter registers a guard
+         *  for the duration of a frame, that is drawn in a background thread (see JKQTPlotter::setBackgroundRendering() ). The guard aborts
+         *  this frame, so its outdated result is never displayed, and warns about modifications from other threads. A guard must not wait
+         *  for the drawing thread, as it may be called from the GUI thread. A second call with the same \a owner replaces the guard.
+         *
+         *  \note Changes that are done directly in externally owned memory (see JKQTPColumn::isExternalColumn() ) cannot be detected,
+         *        so call markColumnModified() <b>before</b> such a change, if the datastore may be drawn in the background.
+         *
+         *  \see removeModificationGuard(), beforeModification()
+         */
+        void setModificationGuard(const void* owner, const std::function<void()>& guard);
+        /** \brief removes the guard, registered with setModificationGuard() under the key \a owner */
+        void removeModificationGuard(const void* owner);
+        /** \brief calls all guards registered with setModificationGuard() (without locking, if there are none)
+         *
+         *  This is called by all modifying functions of JKQTPDatastore and JKQTPColumn.
+         */
+        inline void beforeModification() {
+            if (modificationGuardCount.load(std::memory_order_acquire)>0) callModificationGuards();
+        }
         /** \brief returns the number of rows in the column \a column */
         inline size_t getRows(size_t column) const;
         /** \brief returns a pointer to the data in column \a column, starting ar row \a row */
@@ -342,6 +457,19 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
         inline const double* getColumnPointer(int column, size_t row=0) const;
         /** \brief returns a pointer to the data in column \a column, starting ar row \a row */
         inline double* getColumnPointer(int column, size_t row=0);
+        /** \brief returns the type of the elements stored in column \a column (JKQTPMathImageDataType::DoubleArray, unless the column was added with e.g. addTypedColumn() )
+         *
+         *  \see getColumnRawPointer() */
+        JKQTPMathImageDataType getColumnDataType(size_t column) const;
+        /** \copydoc getColumnDataType(size_t) const */
+        JKQTPMathImageDataType getColumnDataType(int column) const;
+        /** \brief returns a pointer to the data in column \a column, starting ar row \a row, in the original type of the data (see getColumnDataType() ).
+         *
+         *  In contrast to getColumnPointer() this also works for columns that do not store \c double values (e.g. added with addTypedColumn() ).
+         */
+        const void* getColumnRawPointer(size_t column, size_t row=0) const;
+        /** \copydoc getColumnRawPointer(size_t,size_t) const */
+        const void* getColumnRawPointer(int column, size_t row=0) const;
         /** \brief returns the width of the image, represented by \a column (in row-major ordering).
          *         Internally this returns the imageColumns or image width, if set in the column */
         size_t getColumnImageWidth(int column) const;
@@ -372,9 +500,37 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
         void convertToVectorColumn(size_t column);
         /** \brief converts datastoreage of column \a column to an internally managed vector (with vector coulmns, resizing operations, such as appending are relatively cheap). This function does nothing if the column already is a vector column. */
         void convertToVectorColumn(int column);
+        /** \brief converts the column \a column into a ring-buffer column of the given \a capacity, keeping the newest rows
+         *
+         *  \see addRingBufferColumn(), JKQTPColumn::convertToRingBufferColumn() */
+        void convertToRingBufferColumn(size_t column, size_t capacity);
+        /** \brief returns \c true, if the column \a column is a ring-buffer column (see addRingBufferColumn() ) */
+        bool isRingBufferColumn(size_t column) const;
 
-        /** \brief returns the data checksum of the given column \a column */
+        /** \brief returns the data checksum of the given column \a column
+         *
+         *  \note To detect changes of the data, use getColumnGeneration() , which does not have to read the data and does not collide.
+         */
         quint16 getColumnChecksum(int column) const;
+        /** \brief returns a 64-bit hash of the data in column \a column (see JKQTPColumn::calculateHash64() ), or 0 if the column does not exist */
+        quint64 getColumnHash64(int column) const;
+        /** \brief returns the generation of the data in column \a column (see JKQTPColumn::getGeneration() ), or 0 if the column does not exist
+         *
+         *  The generation changes whenever the data in the column is modified (through the JKQTPDatastore, or as signalled by markColumnModified() )
+         *  or the column is replaced. Use this to check whether data cached from the column is still valid. This is an O(1) operation.
+         */
+        quint64 getColumnGeneration(size_t column) const;
+        /** \copydoc getColumnGeneration(size_t) const */
+        quint64 getColumnGeneration(int column) const;
+        /** \brief returns a key that identifies the current data in column \a column (see JKQTPColumn::getDataKey() ), or 0 if the column does not exist
+         *
+         *  This equals getColumnGeneration(), i.e. it is an O(1) operation. Only for columns that reference external memory and
+         *  have setColumnDetectExternalChanges() switched on, it also contains getColumnHash64() .
+         *  Use this as key for data that is cached from a column.
+         */
+        quint64 getColumnDataKey(size_t column) const;
+        /** \copydoc getColumnDataKey(size_t) const */
+        quint64 getColumnDataKey(int column) const;
 
         /** \brief returns the value at position (\c column, \c row). \c column is the logical column and will be mapped to the according memory block internally!)  */
         inline double get(size_t column, size_t row) const ;
@@ -547,6 +703,69 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
          */
         void appendToColumns(size_t column1, size_t column2, size_t column3, size_t column4, size_t column5, double value1, double value2, double value3, double value4, double value5);
 
+        /** \brief appends \a frameCount frames of values to the columns \a columns , i.e. the values of one row for all columns at a time
+         *
+         *  \param columns the columns to append to
+         *  \param frames the values to append, interleaved frame by frame, i.e. \c frames[f*columns.size()+c] is appended to \c columns[c] .
+         *                 This array has to contain \a frameCount \c * \c columns.size() values.
+         *  \param frameCount number of frames in \a frames
+         *  \return \c true on success. If any of the \a columns does not exist, nothing is appended and \c false is returned.
+         *
+         *  In contrast to calling appendToColumn() for every value, the columns are looked up only once per call and
+         *  either all columns receive all frames, or none does, so the columns keep the same length.
+         *  Together with ring-buffer columns (see addRingBufferColumn() ), this allows to stream data into a plot without
+         *  reallocations.
+         *
+         *  \note JKQTPDatastore is not thread-safe, so the frames have to be appended in the thread that draws the plot
+         *        (or while drawing is blocked).
+         *
+         *  \see appendToColumns(), addRingBufferColumn(), addIngestionQueue()
+         */
+        bool appendFramesToColumns(const std::vector<size_t>& columns, const double* frames, size_t frameCount=1);
+
+        /** \brief adds a queue, into which (exactly) one acquisition thread can push frames for the columns \a columns without any locking.
+         *         The frames are appended to the columns by drainIngestionQueues().
+         *
+         *  \param columns the columns that are fed by the queue (a frame contains one value per column, see appendFramesToColumns() )
+         *  \param capacityFrames maximum number of frames that can be queued between two calls of drainIngestionQueues().
+         *                        If the queue is full, JKQTPDatastoreIngestionQueue::pushFrames() drops the new frames (back pressure)
+         *                        and counts them in JKQTPDatastoreIngestionQueue::Statistics::droppedFrames .
+         *  \return the new queue (or \c nullptr , if \a columns is empty or contains a column that does not exist).
+         *          Hand it to the producer thread, the datastore keeps a reference until removeIngestionQueue() or clear() is called.
+         *
+         *  JKQTPDatastore itself is not thread-safe. With an ingestion queue, the producer thread does not need to marshal its data into the GUI thread
+         *  (or lock the plot): it only copies the frames into the queue and JKQTPlotter appends them to the columns in the GUI thread, at the start of
+         *  every redraw (see JKQTPlotter::setIngestionMaxFrameRate() for redrawing automatically, whenever new data is available):
+         *
+         *  \code
+         *    const size_t cT=datastore->addRingBufferColumn(100000, "time");
+         *    const size_t cY=datastore->addRingBufferColumn(100000, "signal");
+         *    std::shared_ptr<JKQTPDatastoreIngestionQueue> queue=datastore->addIngestionQueue({cT, cY}, 50000);
+         *    plot.setIngestionMaxFrameRate(30);
+         *    // ... in the acquisition thread, for each block of samples (interleaved as t0,y0,t1,y1,...):
+         *    queue->pushFrames(samples.data(), samples.size()/2);
+         *  \endcode
+         *
+         *  \see JKQTPDatastoreIngestionQueue, drainIngestionQueues(), hasPendingIngestion(), removeIngestionQueue()
+         */
+        std::shared_ptr<JKQTPDatastoreIngestionQueue> addIngestionQueue(const std::vector<size_t>& columns, size_t capacityFrames=65536);
+        /** \brief removes the ingestion queue \a queue (see addIngestionQueue() ) from the datastore. Frames that are still queued are discarded. */
+        void removeIngestionQueue(const std::shared_ptr<JKQTPDatastoreIngestionQueue>& queue);
+        /** \brief appends all frames that are queued in the ingestion queues (see addIngestionQueue() ) to their columns and returns the number of appended frames.
+         *
+         *  This has to be called in the thread that draws the plot (or while drawing is blocked), JKQTPlotter does this at the start of every redraw.
+         *
+         *  \see addIngestionQueue(), hasPendingIngestion()
+         */
+        size_t drainIngestionQueues();
+        /** \brief \c true, if any of the ingestion queues (see addIngestionQueue() ) contains frames, i.e. drainIngestionQueues() would change the data
+         *
+         *  \see addIngestionQueue(), drainIngestionQueues()
+         */
+        bool hasPendingIngestion() const;
+        /** \brief number of ingestion queues in the datastore \see addIngestionQueue() */
+        size_t getIngestionQueueCount() const;
+
 
 
 
@@ -725,6 +944,104 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
          */
         size_t addInternalImageColumn(double *data, size_t width, size_t height, const QString& name);
 
+        /** \brief add one external column with elements of type \a dataType to the datastore. It contains \a rows rows.
+         *         Data is not owned by the JKQTPDatastore and is \b not converted to \c double , i.e. no copy is made!
+         *
+         *   \param data data array to be referenced (elements of type \a dataType )
+         *   \param dataType type of the elements in \a data
+         *   \param rows number of rows in the data array
+         *   \param name name for the column
+         *   \return the ID of the newly created column
+         *
+         *  Typed columns need less memory than \c double columns (e.g. 4x less for \c int16_t data). Their values are converted
+         *  to \c double when read, e.g. with get(), JKQTPColumnView or the const iterators, so they can be used in any graph:
+         *
+         *  \code
+         *    QVector<int16_t> adcData; // filled by the acquisition
+         *    linegraph->setYColumn(datastore->addTypedColumn(adcData.data(), JKQTPMathImageDataType::Int16Array, adcData.size(), "ADC"));
+         *  \endcode
+         *
+         *  \see addTypedColumn(const T*,size_t,const QString&), addCopiedTypedColumn(), addInternalTypedColumn(), JKQTPColumn::isTypedColumn(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addTypedColumn(const void* data, JKQTPMathImageDataType dataType, size_t rows, const QString& name=QString(""));
+        /** \brief add one external column with elements of type \a T to the datastore (without copy or conversion)
+         *
+         *  \see addTypedColumn(const void*,JKQTPMathImageDataType,size_t,const QString&)
+         */
+        template<typename T>
+        inline size_t addTypedColumn(const T* data, size_t rows, const QString& name=QString("")) {
+            return addTypedColumn(static_cast<const void*>(data), JKQTPMathImageDataTypeOf<T>(), rows, name);
+        }
+        /** \brief add a column with elements of type \a dataType to the datastore, ownership of the memory behind \a data is transfered to the datastore.
+         *         The data is \b not converted to \c double .
+         *
+         *   \param data data array (elements of type \a dataType ), allocated with \c std::malloc()
+         *   \param dataType type of the elements in \a data
+         *   \param rows number of rows in the data array
+         *   \param name name for the column
+         *   \return the ID of the newly created column
+         *
+         *  \see addTypedColumn(), addCopiedTypedColumn(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addInternalTypedColumn(void* data, JKQTPMathImageDataType dataType, size_t rows, const QString& name=QString(""));
+        /** \brief copies the array \a data with elements of type \a dataType into a new column of the datastore.
+         *         The data is kept in its original type, i.e. is \b not converted to \c double .
+         *
+         *   \param data data array to be copied (elements of type \a dataType )
+         *   \param dataType type of the elements in \a data
+         *   \param rows number of rows in the data array
+         *   \param name name for the column
+         *   \return the ID of the newly created column
+         *
+         *  \see addTypedColumn(), addInternalTypedColumn(), addCopiedColumn(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addCopiedTypedColumn(const void* data, JKQTPMathImageDataType dataType, size_t rows, const QString& name=QString(""));
+        /** \brief copies the array \a data with elements of type \a T into a new column of the datastore (without conversion to \c double )
+         *
+         *  \see addCopiedTypedColumn(const void*,JKQTPMathImageDataType,size_t,const QString&)
+         */
+        template<typename T>
+        inline size_t addCopiedTypedColumn(const T* data, size_t rows, const QString& name=QString("")) {
+            return addCopiedTypedColumn(static_cast<const void*>(data), JKQTPMathImageDataTypeOf<T>(), rows, name);
+        }
+        /** \brief add one external column with elements of type \a dataType to the datastore. It contains \a width * \a height rows.
+         *         Data is not owned by the JKQTPDatastore and not converted to \c double .
+         *         The column is meant to represent an image in row-major order with x-dimention \a width and y-dimension \a height .
+         *
+         *  Image graphs, such as JKQTPColumnMathImage, use the data directly in its original type.
+         *
+         *  \see addTypedColumn(), addCopiedTypedImageColumn(), addImageColumn(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addTypedImageColumn(const void* data, JKQTPMathImageDataType dataType, size_t width, size_t height, const QString& name=QString(""));
+        /** \brief copies the image \a data with elements of type \a dataType ( \a width * \a height entries, row-major) into a new column of the datastore.
+         *         The data is kept in its original type, i.e. is \b not converted to \c double .
+         *
+         *  \see addCopiedTypedColumn(), addTypedImageColumn(), addImageColumn(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addCopiedTypedImageColumn(const void* data, JKQTPMathImageDataType dataType, size_t width, size_t height, const QString& name=QString(""));
+        /** \brief add a new (empty) ring-buffer column with a fixed capacity of \a capacity rows to the datastore
+         *
+         *   \param capacity maximum number of rows in the column
+         *   \param name name for the column
+         *   \return the ID of the newly created column
+         *
+         *  Appending to a ring-buffer column (appendToColumn(), appendFramesToColumns(), ...) takes O(1) and never reallocates
+         *  or moves memory. When the column is full, the oldest row is dropped, i.e. row 0 is always the oldest value.
+         *  The rows are contiguous in memory (at the cost of twice the memory, see JKQTPColumn::convertToRingBufferColumn() ),
+         *  so graphs read them directly. This is meant for live data, e.g. a strip chart of the last \a capacity samples:
+         *
+         *  \code
+         *    const size_t cT=datastore->addRingBufferColumn(100000, "time");
+         *    const size_t cY=datastore->addRingBufferColumn(100000, "signal");
+         *    linegraph->setXYColumns(cT, cY);
+         *    // ... for each block of samples from the acquisition (interleaved as t0,y0,t1,y1,...):
+         *    datastore->appendFramesToColumns({cT, cY}, samples.data(), samples.size()/2);
+         *  \endcode
+         *
+         *  \see convertToRingBufferColumn(), isRingBufferColumn(), appendFramesToColumns(), \ref JKQTPlotterBasicJKQTPDatastore
+         */
+        size_t addRingBufferColumn(size_t capacity, const QString& name=QString(""));
+
 
 
         /** \brief copies the given \a old_column into a new one, reading the data with the given start column and stride
@@ -1391,12 +1708,49 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastore{
 
 
 
+/** \brief statistics over all rows of a JKQTPColumn, see JKQTPColumn::getStatistics() and JKQTPDatastore::getColumnStatistics()
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * Non-finite values (NaN, inf) are ignored for minValue, maxValue and smallestGreaterZero.
+ */
+struct JKQTPColumnStatistics {
+    inline JKQTPColumnStatistics(): generation(0), rows(0), minValue(0), maxValue(0), smallestGreaterZero(0), hasFiniteValues(false), hasNonFiniteValues(false), sortedAscending(false), sortedDescending(false) {}
+    /** \brief generation of the column data (JKQTPColumn::getGeneration() ) these statistics were calculated for */
+    quint64 generation;
+    /** \brief number of rows */
+    size_t rows;
+    /** \brief minimum of the finite values (0 if hasFiniteValues \c ==false ) */
+    double minValue;
+    /** \brief maximum of the finite values (0 if hasFiniteValues \c ==false ) */
+    double maxValue;
+    /** \brief smallest value >0 (0 if there is none) */
+    double smallestGreaterZero;
+    /** \brief \c true, if the column contains at least one finite value */
+    bool hasFiniteValues;
+    /** \brief \c true, if the column contains at least one non-finite value (NaN, inf) */
+    bool hasNonFiniteValues;
+    /** \brief \c true, if all values are finite and sorted in ascending order */
+    bool sortedAscending;
+    /** \brief \c true, if all values are finite and sorted in descending order */
+    bool sortedDescending;
+};
+
 /** \brief Manages one column of data. Data may either be stored internally as double* array or QVector<double>
  *         or the object may reference an external array of data. This class also provides basic tools to edit the data,
  *         change column size etc.
  * \ingroup jkqtpdatastorage_classes
  * \internal
  *
+ * In addition to \c double data, a column may also store (or reference) an array of a different element type
+ * (see JKQTPMathImageDataType, e.g. \c int16_t from an ADC, or \c uint16_t camera frames), which are converted
+ * to \c double on read access (getValue(), JKQTPColumnView, const_iterator). Element-wise write access (setValue(), incValue(), ...)
+ * writes directly into the typed memory (with rounding and clipping to the range of the type). Operations that
+ * require a \c double& or \c double* into the column (non-const getPointer(), at(), operator[](), iterator, append(), resize())
+ * first convert the column into a \c double vector column (see convertToVectorColumn() ).
+ *
+ * For live data, a column can also be a ring-buffer of fixed capacity (see convertToRingBufferColumn() ),
+ * where append() takes O(1) and never reallocates.
+ *
  * \see JKQTPDatastore
  */
 class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
@@ -1404,7 +1758,10 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     enum class StorageType {
         External, /*!< \brief data is stored in an externally managed (=not owned) C-array */
         Internal, /*!< \brief data is stored in an internally managed (=owned) C-array */
-        Vector    /*!< \brief data is stored in the internal \a QVector<double> datavec */
+        Vector,   /*!< \brief data is stored in the internal \a QVector<double> datavec */
+        TypedExternal, /*!< \brief data of type dataType is stored in an externally managed (=not owned) C-array typedData */
+        TypedInternal,  /*!< \brief data of type dataType is stored in an internally managed (=owned) C-array typedData */
+        RingBuffer     /*!< \brief data is stored in a ring-buffer of fixed capacity ringCapacity in \a QVector<double> datavec (see convertToRingBufferColumn() ) */
     };
   private:
     /** \brief how data is represented in this JKQTPColumn */
@@ -1415,8 +1772,19 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     size_t rows;
     /** \brief iif \a storageType is \c StorageType::Vector, the data is actually save here  */
     QVector<double> datavec;
+    /** \brief a pointer to the actual data (if \c storageType==StorageType::TypedExternal or \c storageType==StorageType::TypedInternal ), elements are of type \a dataType */
+    void* typedData;
+    /** \brief type of the elements in the column (JKQTPMathImageDataType::DoubleArray, unless \c storageType is \c StorageType::TypedExternal or \c StorageType::TypedInternal ) */
+    JKQTPMathImageDataType dataType;
     /** \brief specifies whether the datastore manages the memory (\c true , i.e. may also free the data) or whether the user application does this (\c false , i.e. the datastore never frees the data) .*/
     StorageType storageType;
+    /** \brief capacity of a ring-buffer column (\c storageType==StorageType::RingBuffer ).
+     *
+     *  datavec then contains every value twice, at the positions \c i and \c i+ringCapacity , so the
+     *  \a rows values, starting with the oldest at \c datavec[ringStart] , are always contiguous in memory. */
+    size_t ringCapacity{0};
+    /** \brief position of the oldest row of a ring-buffer column in datavec (\c 0 ... \c ringCapacity-1 ) */
+    size_t ringStart{0};
 
     /** \brief number of image columns, if the data in this column is interpreted as a row-major image (e.g. for display in a JKQTPMathImage ) */
     size_t imageColumns;
@@ -1426,6 +1794,32 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     QString name;
     /** \brief is this item valid/usable? */
     bool valid;
+    /** \brief modification counter of the data in this column, see getGeneration() */
+    std::atomic<quint64> generation{JKQTPColumn::initialGeneration()};
+    /** \brief if \c true , getDataKey() of an external column also contains a hash of the data, see setDetectExternalChanges() */
+    bool detectExternalChanges{false};
+    /** \brief returns the start value for generation of a new column, these are distinct for all columns
+     *         (i.e. the upper 32 bits count the columns, the lower 32 bits the modifications) */
+    static quint64 initialGeneration();
+    /** \brief summaries of the data in this column, which are built lazily on first use. Each summary
+     *         is stored together with the generation it was built for and is rebuilt, if that is outdated */
+    struct CachedSummaries {
+        inline CachedSummaries(): minMaxPyramid(), minMaxPyramidGeneration(0), minMaxPyramidDataKey(0), statistics(), statisticsDataKey(0), hasStatistics(false) {}
+        /** \brief min/max pyramid, see getMinMaxPyramid() */
+        std::shared_ptr<const JKQTPColumnMinMaxPyramid> minMaxPyramid;
+        /** \brief generation of the data, minMaxPyramid was built for */
+        quint64 minMaxPyramidGeneration;
+        /** \brief getDataKey() of the data, minMaxPyramid was built for */
+        quint64 minMaxPyramidDataKey;
+        /** \brief statistics, see getStatistics() */
+        JKQTPColumnStatistics statistics;
+        /** \brief getDataKey() of the data, statistics were calculated for */
+        quint64 statisticsDataKey;
+        /** \brief \c true if statistics contains valid data (for the generation statistics.generation ) */
+        bool hasStatistics;
+    };
+    /** \brief cached summaries of the data in this column, see getMinMaxPyramid() and getStatistics() */
+    mutable JKQTPSynchronized<CachedSummaries> cachedSummaries;
   public:
     typedef JKQTPColumnIterator iterator;
     typedef JKQTPColumnConstIterator const_iterator;
@@ -1442,6 +1836,13 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
      *         Depending on \a transferMode the data is either copied into the column, managed as internally owned or externally owned array
      */
     JKQTPColumn(JKQTPDatastore* datastore_, const QString& name_, DataTransferMode transferMode, double* data_, size_t datasize_, size_t imageColumns_=1);
+    /** \brief class constructor that binds the column to a specific array \a data_ (size \a datasize_ ) with elements of type \a dataType_ .
+     *         Depending on \a transferMode the data is either copied into the column, managed as internally owned or externally owned array.
+     *         In all cases the data is kept in its original type (i.e. is not converted to \c double ).
+     *
+     *  \note if \a transferMode \c ==TransferOwnership the memory has to be allocated with \c std::malloc() as it is freed with \c std::free()
+     */
+    JKQTPColumn(JKQTPDatastore* datastore_, const QString& name_, DataTransferMode transferMode, const void* data_, JKQTPMathImageDataType dataType_, size_t datasize_, size_t imageColumns_=1);
     /** \brief class constructor that creates a column, which is initialized by c copy of the array \a data_ (size \a datasize_ ).
      */
     JKQTPColumn(JKQTPDatastore* datastore_, const QString& name_, const double* data_, size_t datasize_, size_t imageColumns_=1);
@@ -1498,15 +1899,70 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
         return storageType==StorageType::Vector;
     }
 
+    /** \brief returns \c true if data is stored with an element type other than \c double (see getDataType() ) */
+    inline bool isTypedColumn() const {
+        return storageType==StorageType::TypedExternal || storageType==StorageType::TypedInternal;
+    }
+
+    /** \brief returns \c true if data is stored in a ring-buffer of fixed capacity (see convertToRingBufferColumn() ) */
+    inline bool isRingBufferColumn() const {
+        return storageType==StorageType::RingBuffer;
+    }
+
+    /** \brief returns \c true if the column references externally owned memory (\c StorageType::External or \c StorageType::TypedExternal ), which may be changed without the column noticing */
+    inline bool isExternalColumn() const {
+        return storageType==StorageType::External || storageType==StorageType::TypedExternal;
+    }
+
+    /** \brief returns the capacity of a ring-buffer column (see convertToRingBufferColumn() ), or \c 0 for other columns */
+    inline size_t getRingBufferCapacity() const {
+        return isRingBufferColumn()?ringCapacity:0;
+    }
+
+    /** \brief converts the column into a ring-buffer column with a fixed capacity of \a capacity rows
+     *
+     *  The newest (i.e. last) \c min(getRows(),capacity) rows of the column are kept. Afterwards append()
+     *  adds a row in O(1), without reallocating or moving memory. If the column is full, the oldest row is
+     *  dropped. Row 0 is always the oldest row in the buffer.
+     *
+     *  Internally every value is stored twice, so the rows are always contiguous in memory and can be read with
+     *  getPointer(), JKQTPColumnView etc. without copy (at the cost of twice the memory).
+     *
+     *  setValue() and incValue() keep the ring-buffer, while all operations that require a \c double& or \c double* into the column
+     *  (non-const getPointer(), at(), operator[](), iterator, resize()) convert the column into a \c double vector column (see convertToVectorColumn() ).
+     */
+    void convertToRingBufferColumn(size_t capacity);
+
+    /** \copydoc dataType */
+    inline JKQTPMathImageDataType getDataType() const {
+        return dataType;
+    }
+
+    /** \brief returns a pointer to the \a n -th element in the column, in its original type (see getDataType() ) */
+    inline const void* getRawPointer(size_t n=0) const {
+        if (!isValid()) return nullptr;
+        if (isTypedColumn()) {
+            if (!typedData) return nullptr;
+            return static_cast<const char*>(typedData)+n*JKQTPMathImageDataTypeSize(dataType);
+        }
+        return getPointer(n);
+    }
+
     /** \brief returns the number of rows in this column (accesses the datastore) */
     inline size_t getRows() const noexcept {
         if (!isValid()) return 0;
         if (storageType==StorageType::Vector) return datavec.size();
         else return rows;
     }
-    /** \brief gets a pointer to the \a n -th value in the column */
+    /** \brief gets a pointer to the \a n -th value in the column
+     *
+     *  \note This returns \c nullptr for columns with a data type other than \c double (isTypedColumn() \c ==true ),
+     *        use getRawPointer() or getValue() instead.
+     */
     inline const double* getPointer(size_t n=0) const {
         if (!isValid()) return nullptr;
+        if (isTypedColumn()) return nullptr;
+        if (storageType==StorageType::RingBuffer) return datavec.constData()+ringStart+n;
         if (storageType==StorageType::Vector) {
             if (n<=0) return datavec.data();
             else return &(datavec[n]);
@@ -1517,9 +1973,16 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
         }
     }
 
-    /** \brief gets a pointer to the \a n -th value in the column */
+    /** \brief gets a pointer to the \a n -th value in the column
+     *
+     *  \note For columns with a data type other than \c double (isTypedColumn() \c ==true ) and for ring-buffer columns
+     *        (isRingBufferColumn() \c ==true ), the column is converted into a \c double vector column first (see convertToVectorColumn() )!
+     */
     inline double* getPointer(size_t n=0)  {
         if (!isValid()) return nullptr;
+        // the caller may write through the returned pointer
+        markModified();
+        if (isTypedColumn() || isRingBufferColumn()) convertToVectorColumn();
         if (storageType==StorageType::Vector) {
             if (n<=0) return datavec.data();
             else return &(datavec[n]);
@@ -1662,9 +2125,18 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     /** \brief set all values in the column to a specific \a value */
     void setAll(double value);
 
-    /** \brief append \a value to the column, Possibly converts the column to a vector column, if necessary */
+    /** \brief append \a value to the column, Possibly converts the column to a vector column, if necessary
+     *
+     *  For ring-buffer columns (see convertToRingBufferColumn() ), this drops the oldest row, if the buffer is full.
+     */
     void append(double val) {
+        if (isRingBufferColumn()) {
+            markModified();
+            appendToRingBuffer(val);
+            return;
+        }
         if (!isVectorColumn()) convertToVectorColumn();
+        markModified();
         datavec.push_back(val);
     }
     /** \brief append \a value to the column, Possibly converts the column to a vector column, if necessary */
@@ -1674,6 +2146,7 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     /** \brief resize the column to \a new_size (possibly filling with \a added_vala ), Possibly converts the column to a vector column, if necessary */
     void resize(size_t new_size, double added_vala=0.0) {
         if (!isVectorColumn()) convertToVectorColumn();
+        markModified();
         size_t old_size=datavec.size();
         datavec.resize(new_size);
         if (new_size>old_size) {
@@ -1682,8 +2155,92 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
     }
 
 
-    /** \brief calculates a checksum over the contents of the column (using <a href="https://doc.qt.io/qt-5/qbytearray.html#qChecksum">qChecksum()</a>) */
+    /** \brief calculates a checksum over the contents of the column (using <a href="https://doc.qt.io/qt-5/qbytearray.html#qChecksum">qChecksum()</a>)
+     *
+     *  \note for typed columns, the checksum is calculated over the raw (non-converted) memory.
+     *  \note To detect changes of the data, use getGeneration() , which does not have to read the data and does not collide.
+     */
     inline quint16 calculateChecksum() const;
+    /** \brief calculates a 64-bit hash over the contents of the column (using jkqtp_hash64() )
+     *
+     *  This has to read all data, but is much faster than calculateChecksum() and has a negligible collision probability.
+     *  It can be used to detect changes in externally owned memory, that were not signalled with markModified().
+     *
+     *  \note for typed columns, the hash is calculated over the raw (non-converted) memory. */
+    inline quint64 calculateHash64() const;
+
+    /** \brief returns a hierarchical min/max summary of the data in this column (see JKQTPColumnMinMaxPyramid )
+     *
+     *  The pyramid is built on the first call (i.e. one pass over the data) and then cached, until the data is changed
+     *  (see getDataKey() ). This function is thread-safe.
+     */
+    std::shared_ptr<const JKQTPColumnMinMaxPyramid> getMinMaxPyramid() const;
+    /** \brief determines the minimum, the maximum and the smallest value >0 of the (finite) values in the rows \a start ... \a end-1
+     *
+     *  For the full column, this uses getStatistics(), otherwise getMinMaxPyramid(). So after the first call, it does not scan the data,
+     *  but takes only O(1) or O(log(end-start)) steps respectively.
+     *
+     *  \param start first row to consider
+     *  \param end one behind the last row to consider (clipped to getRows() )
+     *  \param[out] min minimum of the finite values in the range (0 if there are none)
+     *  \param[out] max maximum of the finite values in the range (0 if there are none)
+     *  \param[out] smallestGreaterZero if not \c nullptr, this receives the smallest value >0 in the range (0 if there is none)
+     *  \return \c false if there are no finite values in the given range
+     */
+    bool getMinMax(size_t start, size_t end, double& min, double& max, double* smallestGreaterZero=nullptr) const;
+    /** \brief returns statistics (min, max, smallest value >0, sortedness, ...) over all rows in this column
+     *
+     *  The statistics are calculated on the first call (i.e. one pass over the data) and then cached, until the data
+     *  is changed (see getDataKey() ). So e.g. autoscaling many graphs to the same columns does not rescan the data.
+     *  This function is thread-safe.
+     */
+    JKQTPColumnStatistics getStatistics() const;
+    /** \brief returns the generation of the data in this column, i.e. a counter that is incremented, whenever the data was modified
+     *
+     *  All functions of this class that (may) change the data (setValue(), append(), resize(), scale(), setAll(), non-const access
+     *  via getPointer(), at(), operator[]() or an iterator, ...) call markModified(), which increments the generation.
+     *  Caches of data derived from the column (e.g. getStatistics() , getMinMaxPyramid() , or the contour lines in a JKQTPColumnContourPlot )
+     *  store the generation they were calculated for and are recalculated, when it changed. In contrast to calculateChecksum() this
+     *  is an O(1) operation. Caches use getDataKey(), which equals the generation, unless setDetectExternalChanges() is switched on.
+     *
+     *  The generations of different columns start at different values (that are 2^32 apart), so the generation also
+     *  changes, if a column in a JKQTPDatastore is replaced by a new one.
+     */
+    inline quint64 getGeneration() const {
+        return generation.load();
+    }
+    /** \brief marks the data in this column as modified, i.e. increments getGeneration() , which outdates all cached summaries
+     *
+     *  This is called by all functions of this class that (may) change the data. If you change the memory of an
+     *  externally owned column (JKQTPColumn::ExternallyOwned ) directly, you have to call this function yourself
+     *  (or JKQTPDatastore::markColumnModified() ).
+     *
+     *  Before the generation is incremented, JKQTPDatastore::beforeModification() of the owning datastore is called.
+     */
+    inline void markModified() {
+        if (datastore) datastore->beforeModification();
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+    /** \brief returns a key that identifies the current contents of this column, use this to validate data cached from the column
+     *
+     *  This is getGeneration() , i.e. an O(1) operation. So changes in externally owned memory (see isExternalColumn() ) have to be
+     *  signalled with markModified(). Only if setDetectExternalChanges() is switched on for an external column, the key also contains
+     *  calculateHash64(), i.e. every call reads the whole column.
+     */
+    inline quint64 getDataKey() const {
+        const quint64 gen=getGeneration();
+        if (!detectExternalChanges || !isExternalColumn()) return gen;
+        return jkqtp_hash64(&gen, sizeof(gen), calculateHash64());
+    }
+    /** \brief if \a enabled , getDataKey() of an external column also contains a hash over the data, so changes of the external memory
+     *         are detected without markModified() (at the cost of reading the whole column for every validation of a cache) */
+    inline void setDetectExternalChanges(bool enabled) {
+        detectExternalChanges=enabled;
+    }
+    /** \brief returns \c true , if changes of the external memory are detected by a hash (see setDetectExternalChanges() ) */
+    inline bool getDetectExternalChanges() const {
+        return detectExternalChanges;
+    }
 
     /** \brief returns an iterator to the internal data
      * \see JKQTPColumnIterator */
@@ -1708,6 +2265,31 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
 
       inline JKQTPDatastore* getDatastore() { return datastore; }
       inline const JKQTPDatastore* getDatastore() const { return datastore; }
+      /** \brief adds \a val to a ring-buffer column (without calling markModified() ), the oldest row is overwritten, if the buffer is full */
+      inline void appendToRingBuffer(double val) {
+          if (ringCapacity==0) return;
+          size_t pos;
+          if (rows<ringCapacity) {
+              pos=ringStart+rows;
+              if (pos>=ringCapacity) pos-=ringCapacity;
+              rows++;
+          } else {
+              pos=ringStart;
+              ringStart++;
+              if (ringStart>=ringCapacity) ringStart=0;
+          }
+          double* d=datavec.data();
+          d[pos]=val;
+          d[pos+ringCapacity]=val;
+      }
+      /** \brief sets row \a n of a ring-buffer column to \a val (both copies in datavec, without calling markModified() ) */
+      inline void setRingBufferValue(size_t n, double val) {
+          if (n>=rows) return;
+          size_t pos=ringStart+n;
+          if (pos>=ringCapacity) pos-=ringCapacity;
+          datavec[pos]=val;
+          datavec[pos+ringCapacity]=val;
+      }
       /** \brief removes the entry \a row
        *
        *  \warning this function throws an exception if the column is NOT a vector column!
@@ -1758,6 +2340,165 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPColumn {
 
 };
 
+
+/** \brief hierarchical min/max summary ("pyramid") of the data in a JKQTPColumn
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * Level 0 of the pyramid stores the minimum, the maximum and the smallest value >0 of every block of LeafSize consecutive rows.
+ * Every higher level combines Fanout entries of the level below, up to a level with a single entry.
+ * query() determines the minimum and maximum of any range of rows by reading at most 2*LeafSize rows at the borders
+ * of the range and at most 2*Fanout entries per level, i.e. in O(log N) instead of O(N) steps. This allows e.g. to
+ * draw the min/max envelope of a very large dataset in O(pixels*log N) (see JKQTPXYLineGraph::setUseMinMaxDecimation() )
+ * or to autoscale to it without scanning all data (see JKQTPXYGraph::getXMinMax() ).
+ *
+ * Non-finite values (NaN, inf) are ignored. The pyramid needs about 5% of the memory of the (\c double ) data.
+ * While building the pyramid, it is also determined whether the data is sorted (see isSortedAscending() ).
+ *
+ * The pyramid of a column is built and cached lazily by JKQTPColumn::getMinMaxPyramid(), so you usually don't create
+ * instances of this class yourself.
+ *
+ * \see JKQTPColumn::getMinMax(), JKQTPColumnView::getMinMax()
+ */
+class JKQTPLOTTER_LIB_EXPORT JKQTPColumnMinMaxPyramid {
+    public:
+        /** \brief number of rows summarized by one entry of level 0 */
+        static constexpr size_t LeafSize=64;
+        /** \brief number of entries of one level that are combined into one entry of the next level */
+        static constexpr size_t Fanout=8;
+
+        /** \brief summary of a range of rows, i.e. one entry of the pyramid */
+        struct Summary {
+            inline Summary(): minValue(std::numeric_limits<double>::infinity()), maxValue(-std::numeric_limits<double>::infinity()), smallestGreaterZero(0) {}
+            /** \brief minimum of the finite values */
+            double minValue;
+            /** \brief maximum of the finite values */
+            double maxValue;
+            /** \brief smallest value >0, or 0 if there is none */
+            double smallestGreaterZero;
+            /** \brief \c true, if the summarized range does not contain any finite value */
+            inline bool isEmpty() const { return minValue>maxValue; }
+            /** \brief adds the value \a v to the summary (non-finite values are ignored) */
+            inline void add(double v) {
+                if (std::isfinite(v)) {
+                    if (v<minValue) minValue=v;
+                    if (v>maxValue) maxValue=v;
+                    if (v>10.0*std::numeric_limits<double>::min() && (smallestGreaterZero<10.0*std::numeric_limits<double>::min() || v<smallestGreaterZero)) smallestGreaterZero=v;
+                }
+            }
+            /** \brief combines \a other into this summary */
+            inline void add(const Summary& other) {
+                if (other.minValue<minValue) minValue=other.minValue;
+                if (other.maxValue>maxValue) maxValue=other.maxValue;
+                if (other.smallestGreaterZero>0 && (smallestGreaterZero<=0 || other.smallestGreaterZero<smallestGreaterZero)) smallestGreaterZero=other.smallestGreaterZero;
+            }
+        };
+
+        /** \brief builds the pyramid over the data in \a column (one pass over the data) */
+        explicit JKQTPColumnMinMaxPyramid(const JKQTPColumn& column);
+
+        /** \brief returns a summary of the rows \a start ... \a end-1 of \a column, which has to be the column this pyramid was built for */
+        Summary query(const JKQTPColumn& column, size_t start, size_t end) const;
+
+        /** \brief number of rows in the column, when the pyramid was built */
+        inline size_t getRows() const { return m_rows; }
+        /** \brief number of levels in the pyramid (0 for an empty column) */
+        inline size_t getLevelCount() const { return m_levels.size(); }
+        /** \brief returns the entries of level \a level, where entry \c i summarizes the rows \c i*LeafSize*Fanout^level ... \c (i+1)*LeafSize*Fanout^level-1 */
+        inline const std::vector<Summary>& getLevel(size_t level) const { return m_levels[level]; }
+        /** \brief \c true, if all values are finite and sorted in ascending order */
+        inline bool isSortedAscending() const { return m_sortedAscending; }
+        /** \brief \c true, if all values are finite and sorted in descending order */
+        inline bool isSortedDescending() const { return m_sortedDescending; }
+        /** \brief \c true, if the column contains any non-finite value (NaN, inf) */
+        inline bool hasNonFiniteValues() const { return m_hasNonFiniteValues; }
+    private:
+        /** \brief number of rows in the column */
+        size_t m_rows;
+        /** \brief the levels of the pyramid, \c m_levels[0] summarizes blocks of LeafSize rows */
+        std::vector<std::vector<Summary> > m_levels;
+        /** \brief \c true, if all values are finite and sorted in ascending order */
+        bool m_sortedAscending;
+        /** \brief \c true, if all values are finite and sorted in descending order */
+        bool m_sortedDescending;
+        /** \brief \c true, if the column contains any non-finite value */
+        bool m_hasNonFiniteValues;
+};
+
+
+/** \brief lock-free queue, which transfers frames (one value per column) from one acquisition thread to a group of columns in a JKQTPDatastore
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * Instances are created by JKQTPDatastore::addIngestionQueue(). Exactly one producer thread may call pushFrames(), the queued frames are
+ * appended to the columns by JKQTPDatastore::drainIngestionQueues() (called by JKQTPlotter at the start of each redraw), directly from
+ * the memory of the queue. The producer never waits for the GUI: if the queue is full, the new frames are dropped and counted
+ * (see getStatistics() ), so a producer can detect and react to back pressure (e.g. by decimating its data).
+ *
+ * \see JKQTPDatastore::addIngestionQueue(), JKQTPSPSCQueue
+ */
+class JKQTPLOTTER_LIB_EXPORT JKQTPDatastoreIngestionQueue {
+    public:
+        /** \brief statistics of a JKQTPDatastoreIngestionQueue, see getStatistics() */
+        struct Statistics {
+            inline Statistics(): pushedFrames(0), droppedFrames(0), drainedFrames(0), drainCount(0), maxPendingFrames(0), capacityFrames(0) {}
+            /** \brief number of frames, that were accepted by pushFrames() */
+            uint64_t pushedFrames;
+            /** \brief number of frames, that were dropped by pushFrames(), because the queue was full (or the columns of the queue were deleted) */
+            uint64_t droppedFrames;
+            /** \brief number of frames, that were appended to the columns */
+            uint64_t drainedFrames;
+            /** \brief number of calls to JKQTPDatastore::drainIngestionQueues(), that appended frames from this queue */
+            uint64_t drainCount;
+            /** \brief maximum number of frames, that were waiting in the queue */
+            size_t maxPendingFrames;
+            /** \brief capacity of the queue in frames */
+            size_t capacityFrames;
+        };
+
+        /** \brief the columns, the frames are appended to */
+        inline const std::vector<size_t>& getColumns() const { return m_columns; }
+        /** \brief number of values in one frame, i.e. number of columns */
+        inline size_t getFrameSize() const { return m_columns.size(); }
+        /** \brief maximum number of frames in the queue */
+        inline size_t getCapacityFrames() const { return m_queue.capacity()/getFrameSize(); }
+        /** \brief number of frames, that are currently waiting in the queue (snapshot) */
+        inline size_t getPendingFrames() const { return m_queue.size()/getFrameSize(); }
+
+        /** \brief <b>producer thread:</b> appends \a frameCount frames (interleaved, i.e. \c frames[f*getFrameSize()+c] belongs to column \c getColumns()[c] )
+         *         to the queue and returns the number of frames that were accepted. The remaining frames are dropped (back pressure, see Statistics::droppedFrames ).
+         *
+         *  This never blocks and never allocates memory.
+         */
+        size_t pushFrames(const double* frames, size_t frameCount=1);
+        /** \brief <b>producer thread:</b> appends one frame, given as a list of getFrameSize() values, returns \c false if it was dropped */
+        bool pushFrame(std::initializer_list<double> frame);
+
+        /** \brief returns the statistics of the queue (may be called from any thread) */
+        Statistics getStatistics() const;
+        /** \brief resets the counters in the statistics of the queue (may be called from any thread) */
+        void resetStatistics();
+    protected:
+        friend class JKQTPDatastore;
+        /** \brief constructs a queue for the columns \a columns , which holds up to \a capacityFrames frames */
+        JKQTPDatastoreIngestionQueue(const std::vector<size_t>& columns, size_t capacityFrames);
+        /** \brief <b>consumer thread:</b> appends all queued frames to the columns in \a datastore and returns their number */
+        size_t drainInto(JKQTPDatastore* datastore);
+    private:
+        /** \brief the columns, the frames are appended to */
+        const std::vector<size_t> m_columns;
+        /** \brief the queued values, capacity is a multiple of the frame size, so frames never wrap around */
+        JKQTPSPSCQueue<double> m_queue;
+        /** \brief statistics: see Statistics::pushedFrames */
+        std::atomic<uint64_t> m_pushedFrames;
+        /** \brief statistics: see Statistics::droppedFrames */
+        std::atomic<uint64_t> m_droppedFrames;
+        /** \brief statistics: see Statistics::drainedFrames */
+        std::atomic<uint64_t> m_drainedFrames;
+        /** \brief statistics: see Statistics::drainCount */
+        std::atomic<uint64_t> m_drainCount;
+        /** \brief statistics: see Statistics::maxPendingFrames */
+        std::atomic<size_t> m_maxPendingFrames;
+};
+
 #pragma pack(push,1)
 /** \brief iterator over the data in the column of a JKQTPDatastore
  * \ingroup jkqtpdatastorage_classes
@@ -2093,7 +2834,8 @@ class JKQTPColumnConstIterator {
         typedef JKQTPColumnConstIterator self_type;
         typedef JKQTPColumnIterator nonconst_variant_type;
         typedef double value_type;
-        typedef const double& reference;
+        /** \brief values are returned by value, so the iterator also works for columns with data types other than \c double (see JKQTPColumn::isTypedColumn() ) */
+        typedef double reference;
         typedef reference const_reference;
         typedef const double* pointer;
         typedef std::forward_iterator_tag iterator_category;
@@ -2219,25 +2961,25 @@ class JKQTPColumnConstIterator {
             JKQTPASSERT(col_!=nullptr );
             JKQTPASSERT( pos_>=0 );
             JKQTPASSERT( pos_<static_cast<int>(col_->getRows()));
-            return col_->at(pos_);
+            return col_->getValue(pos_);
         }
         inline reference operator[](difference_type off) const
         {
             if (!isValid() && off<0) {
                 JKQTPASSERT(col_!=nullptr);
-                return col_->at(static_cast<int>(col_->getRows())+off);
+                return col_->getValue(static_cast<int>(col_->getRows())+off);
             }
             JKQTPASSERT(col_!=nullptr );
             JKQTPASSERT( pos_+off>=0 );
             JKQTPASSERT( pos_+off<static_cast<int>(col_->getRows()));
-            return col_->at(pos_+off);
+            return col_->getValue(pos_+off);
         }
         /** \brief dereferences the iterator, throws an exception if the iterator is invalid (see isValid() ) or the value does not exist in the column */
         inline const_reference operator*() const {
             JKQTPASSERT(col_!=nullptr );
             JKQTPASSERT( pos_>=0 );
             JKQTPASSERT( pos_<static_cast<int>(col_->getRows()));
-            return col_->at(pos_);
+            return col_->getValue(pos_);
         }
         /** \brief comparison operator (less than)
          *
@@ -2368,6 +3110,301 @@ class JKQTPColumnConstIterator {
 #pragma pack(pop)
 
 
+
+/** \brief read-only view onto the data of a JKQTPColumn (pointer and number of rows)
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * A JKQTPColumnView is obtained by JKQTPDatastore::getColumnView(). It looks up the column only once and then allows
+ * to access the rows by simple pointer arithmetic, which avoids the per-row column lookup done by JKQTPDatastore::get().
+ * This is intended for tight loops in drawing code:
+ *
+ * \code{.cpp}
+ *     const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+ *     const JKQTPColumnView yData=datastore->getColumnView(yColumn);
+ *     for (int i=imin; i<imax; i++) {
+ *         const double xv=xData.getValue(i);
+ *         const double yv=yData.getValue(i);
+ *         // ...
+ *     }
+ * \endcode
+ *
+ * The view holds a reference to the column object, so the column is not freed while the view exists (e.g. during a draw() ),
+ * even if it is deleted from the JKQTPDatastore in the meantime.
+ *
+ * For columns with a data type other than \c double (see JKQTPColumn::isTypedColumn() ), getPointer() returns \c nullptr
+ * and the values are converted to \c double on access. Use getDataType() and getRawPointer() to access the data in its original type.
+ * operator[] has to check the data type for every row. Hot loops therefore use visit() or JKQTPVisitColumnViews(), which check the
+ * data type once and then call the loop with a JKQTPTypedColumnView, which reads the rows by plain pointer access:
+ *
+ * \code{.cpp}
+ *     JKQTPVisitColumnViews(xData, yData, [&](const auto& x, const auto& y) {
+ *         for (int i=imin; i<imax; i++) {
+ *             const double xv=x.getValue(i);
+ *             const double yv=y.getValue(i);
+ *             // ...
+ *         }
+ *     });
+ * \endcode
+ *
+ * \warning The data pointer is only valid as long as the memory of the column is not reallocated,
+ *          i.e. do not append to or resize the column while using a view to it!
+ *
+ * \see JKQTPDatastore::getColumnView()
+ */
+class JKQTPColumnView {
+    public:
+        /** \brief constructs an invalid view */
+        inline JKQTPColumnView(): m_column(), m_data(nullptr), m_rawData(nullptr), m_dataType(JKQTPMathImageDataType::DoubleArray), m_rows(0) {}
+        /** \brief constructs a view onto the data of the column \a col */
+        inline explicit JKQTPColumnView(const std::shared_ptr<const JKQTPColumn>& col);
+        inline JKQTPColumnView(const JKQTPColumnView&)=default;
+        inline JKQTPColumnView(JKQTPColumnView&&)=default;
+        inline JKQTPColumnView& operator=(const JKQTPColumnView&)=default;
+        inline JKQTPColumnView& operator=(JKQTPColumnView&&)=default;
+
+        /** \brief returns \c true, if the view references a valid column */
+        inline bool isValid() const { return static_cast<bool>(m_column); }
+        /** \brief number of rows in the view */
+        inline size_t size() const { return m_rows; }
+        /** \brief number of rows in the view */
+        inline size_t getRows() const { return m_rows; }
+        /** \brief pointer to the first row, \c nullptr if the data type of the column is not \c double (see getDataType() ) */
+        inline const double* getPointer() const { return m_data; }
+        /** \brief pointer to the first row, in the original data type of the column (see getDataType() ) */
+        inline const void* getRawPointer() const { return m_rawData; }
+        /** \brief data type of the elements in the column */
+        inline JKQTPMathImageDataType getDataType() const { return m_dataType; }
+        /** \brief returns the \a i -th row, without range checking
+         *
+         *  \note This checks the data type of the column for every call. Use visit() in loops over many rows.
+         */
+        inline double operator[](size_t i) const {
+            if (m_data) return m_data[i];
+            return JKQTPMathImageGetValue(m_rawData, m_dataType, i);
+        }
+        /** \brief returns the \a i -th row or \c JKQTP_NAN if \a i is out of range (same semantics as JKQTPDatastore::get() ) */
+        inline double getValue(size_t i) const {
+            if (i>=m_rows) return JKQTP_NAN;
+            return operator[](i);
+        }
+        /** \brief returns the \a i -th row or \c JKQTP_NAN if \a i is out of range (same semantics as JKQTPDatastore::get() ) */
+        inline double getValue(int i) const {
+            if (i<0) return JKQTP_NAN;
+            return getValue(static_cast<size_t>(i));
+        }
+        /** \brief calls \a f (const JKQTPTypedColumnView<T>& view) with a view of the original data type \c T of the column
+         *
+         *  The data type is checked once, so the loops in \a f read the rows by plain pointer access. \a f is usually a generic lambda,
+         *  which is instantiated for every data type. An invalid view calls \a f with an empty JKQTPTypedColumnView<double>.
+         */
+        template <class TFunc>
+        inline void visit(TFunc&& f) const;
+        /** \brief determines the minimum, the maximum and the smallest value >0 of the rows \a start ... \a end-1 (see JKQTPColumn::getMinMax() )
+         *
+         *  \return \c false if the view is invalid or there are no finite values in the given range
+         */
+        inline bool getMinMax(size_t start, size_t end, double& min, double& max, double* smallestGreaterZero=nullptr) const {
+            min=max=0;
+            if (smallestGreaterZero) *smallestGreaterZero=0;
+            if (!m_column) return false;
+            return m_column->getMinMax(start, qMin(end, m_rows), min, max, smallestGreaterZero);
+        }
+        /** \brief determines the minimum and the maximum of the rows \a start ... \a end-1 , using a \a pyramid returned by getMinMaxPyramid() before
+         *
+         *  In contrast to getMinMax(size_t,size_t,double&,double&,double*) const this does not check whether the pyramid is up-to-date,
+         *  so use it for many queries during one pass over unchanged data.
+         *
+         *  \return \c false if the view is invalid or there are no finite values in the given range
+         */
+        inline bool getMinMax(const JKQTPColumnMinMaxPyramid& pyramid, size_t start, size_t end, double& min, double& max) const {
+            min=max=0;
+            if (!m_column) return false;
+            const JKQTPColumnMinMaxPyramid::Summary s=pyramid.query(*m_column, start, qMin(end, m_rows));
+            if (s.isEmpty()) return false;
+            min=s.minValue;
+            max=s.maxValue;
+            return true;
+        }
+        /** \brief returns the min/max pyramid of the column (see JKQTPColumn::getMinMaxPyramid() ), or \c nullptr for an invalid view */
+        inline std::shared_ptr<const JKQTPColumnMinMaxPyramid> getMinMaxPyramid() const {
+            if (!m_column) return nullptr;
+            return m_column->getMinMaxPyramid();
+        }
+        /** \brief returns the generation of the column (see JKQTPColumn::getGeneration() ), or 0 for an invalid view */
+        inline quint64 getGeneration() const {
+            if (!m_column) return 0;
+            return m_column->getGeneration();
+        }
+        /** \brief returns a key identifying the current data of the column (see JKQTPColumn::getDataKey() ), or 0 for an invalid view */
+        inline quint64 getDataKey() const {
+            if (!m_column) return 0;
+            return m_column->getDataKey();
+        }
+    private:
+        /** \brief the column, referenced by this view (pinned, so it is not freed while the view exists) */
+        std::shared_ptr<const JKQTPColumn> m_column;
+        /** \brief pointer to the first row (\c nullptr if m_dataType is not JKQTPMathImageDataType::DoubleArray ) */
+        const double* m_data;
+        /** \brief pointer to the first row, in the original data type */
+        const void* m_rawData;
+        /** \brief data type of the elements in m_rawData */
+        JKQTPMathImageDataType m_dataType;
+        /** \brief number of rows */
+        size_t m_rows;
+};
+
+
+/** \brief read-only view onto the rows of a column with the element type \a T , passed to the functors of JKQTPColumnView::visit()
+ *         and JKQTPVisitColumnViews()
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * It provides the same read access as JKQTPColumnView, but without checking the data type on every access.
+ * It does not pin the column, so only use it while the JKQTPColumnView it was obtained from exists.
+ */
+template <typename T>
+class JKQTPTypedColumnView {
+    public:
+        inline JKQTPTypedColumnView(const T* data, size_t rows): m_data(data), m_rows(rows) {}
+        /** \brief number of rows in the view */
+        inline size_t size() const { return m_rows; }
+        /** \brief number of rows in the view */
+        inline size_t getRows() const { return m_rows; }
+        /** \brief pointer to the first row */
+        inline const T* getPointer() const { return m_data; }
+        /** \brief returns the \a i -th row, without range checking */
+        inline double operator[](size_t i) const { return static_cast<double>(m_data[i]); }
+        /** \brief returns the \a i -th row or \c JKQTP_NAN if \a i is out of range (same semantics as JKQTPDatastore::get() ) */
+        inline double getValue(size_t i) const {
+            if (i>=m_rows) return JKQTP_NAN;
+            return static_cast<double>(m_data[i]);
+        }
+        /** \brief returns the \a i -th row or \c JKQTP_NAN if \a i is out of range (same semantics as JKQTPDatastore::get() ) */
+        inline double getValue(int i) const {
+            if (i<0) return JKQTP_NAN;
+            return getValue(static_cast<size_t>(i));
+        }
+    private:
+        const T* m_data;
+        size_t m_rows;
+};
+
+template <class TFunc>
+inline void JKQTPColumnView::visit(TFunc&& f) const {
+    if (m_data || !m_rawData) {
+        f(JKQTPTypedColumnView<double>(m_data, m_rows));
+        return;
+    }
+    switch(m_dataType) {
+        case JKQTPMathImageDataType::FloatArray: f(JKQTPTypedColumnView<float>(static_cast<const float*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::DoubleArray: f(JKQTPTypedColumnView<double>(static_cast<const double*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::UInt8Array: f(JKQTPTypedColumnView<uint8_t>(static_cast<const uint8_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::UInt16Array: f(JKQTPTypedColumnView<uint16_t>(static_cast<const uint16_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::UInt32Array: f(JKQTPTypedColumnView<uint32_t>(static_cast<const uint32_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::UInt64Array: f(JKQTPTypedColumnView<uint64_t>(static_cast<const uint64_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::Int8Array: f(JKQTPTypedColumnView<int8_t>(static_cast<const int8_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::Int16Array: f(JKQTPTypedColumnView<int16_t>(static_cast<const int16_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::Int32Array: f(JKQTPTypedColumnView<int32_t>(static_cast<const int32_t*>(m_rawData), m_rows)); break;
+        case JKQTPMathImageDataType::Int64Array: f(JKQTPTypedColumnView<int64_t>(static_cast<const int64_t*>(m_rawData), m_rows)); break;
+    }
+}
+
+/** \brief calls \a f (const A& a, const B& b) with typed views (see JKQTPColumnView::visit() ) onto the columns \a a and \a b
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * If both columns have the same data type, \a f is called with two JKQTPTypedColumnView of that type, so the loops in \a f do not check the
+ * data type per row. Only for columns with different data types \a f is called with the JKQTPColumnView \a a and \a b themselves, which
+ * keeps the number of instantiations of \a f small.
+ */
+template <class TFunc>
+inline void JKQTPVisitColumnViews(const JKQTPColumnView& a, const JKQTPColumnView& b, TFunc&& f) {
+    const bool aDouble=(a.getPointer()!=nullptr || a.getRawPointer()==nullptr);
+    const bool bDouble=(b.getPointer()!=nullptr || b.getRawPointer()==nullptr);
+    if (aDouble && bDouble) {
+        f(JKQTPTypedColumnView<double>(a.getPointer(), a.size()), JKQTPTypedColumnView<double>(b.getPointer(), b.size()));
+    } else if (!aDouble && !bDouble && a.getDataType()==b.getDataType()) {
+        a.visit([&](const auto& ta) {
+            using TValue=typename std::remove_const<typename std::remove_pointer<decltype(ta.getPointer())>::type>::type;
+            f(ta, JKQTPTypedColumnView<TValue>(static_cast<const TValue*>(b.getRawPointer()), b.size()));
+        });
+    } else {
+        f(a, b);
+    }
+}
+
+
+/** \brief spatial index over the points (x,y) given by two columns, which allows to find all points inside a rectangle
+ *         without scanning all points
+ * \ingroup jkqtpdatastorage_classes
+ *
+ * The index is a grid in data coordinates. The cell borders are placed at quantiles of the x- and y-values, so the cells
+ * contain similar numbers of points (about PointsPerCell), also for clustered or logarithmically distributed data.
+ * The points are stored sorted by cell, so forEachPointInRect() only reads the points in the cells that overlap the
+ * rectangle. Points with non-finite coordinates are not stored.
+ *
+ * Building the index needs one pass over the data and about 24 bytes per point. It is used (and cached) by
+ * JKQTPXYGraph::hitTest() to find the datapoint closest to the mouse in O(PointsPerCell) instead of O(N) steps.
+ *
+ * \see JKQTPXYGraph::hitTest()
+ */
+class JKQTPLOTTER_LIB_EXPORT JKQTPXYSpatialIndex {
+    public:
+        /** \brief average number of points per cell of the grid */
+        static constexpr size_t PointsPerCell=16;
+        /** \brief a single point in the index */
+        struct Point {
+            /** \brief x-coordinate */
+            double x;
+            /** \brief y-coordinate */
+            double y;
+            /** \brief row of the point in the columns */
+            size_t row;
+        };
+
+        /** \brief builds the index over the points (\a x [i], \a y [i]) for the rows \a start ... \a end-1 */
+        JKQTPXYSpatialIndex(const JKQTPColumnView& x, const JKQTPColumnView& y, size_t start, size_t end);
+
+        /** \brief number of (finite) points in the index */
+        inline size_t getPointCount() const { return m_points.size(); }
+        /** \brief number of cells in x-direction */
+        inline size_t getCellCountX() const { return m_xEdges.size()-1; }
+        /** \brief number of cells in y-direction */
+        inline size_t getCellCountY() const { return m_yEdges.size()-1; }
+        /** \brief returns \c true, if the rectangle \a xmin ... \a xmax , \a ymin ... \a ymax contains the bounding box of all points in the index */
+        inline bool rectContainsAllPoints(double xmin, double xmax, double ymin, double ymax) const {
+            return m_points.size()==0 || (xmin<=m_xEdges.front() && xmax>=m_xEdges.back() && ymin<=m_yEdges.front() && ymax>=m_yEdges.back());
+        }
+        /** \brief calls \a f (const Point& p) for all points in the rectangle \a xmin ... \a xmax , \a ymin ... \a ymax (borders included) */
+        template <class TFunc>
+        inline void forEachPointInRect(double xmin, double xmax, double ymin, double ymax, TFunc f) const {
+            if (m_points.size()==0 || xmin>xmax || ymin>ymax || xmax<m_xEdges.front() || xmin>m_xEdges.back() || ymax<m_yEdges.front() || ymin>m_yEdges.back()) return;
+            const size_t cx0=cellIndex(m_xEdges, xmin), cx1=cellIndex(m_xEdges, xmax);
+            const size_t cy0=cellIndex(m_yEdges, ymin), cy1=cellIndex(m_yEdges, ymax);
+            const size_t nx=getCellCountX();
+            for (size_t cy=cy0; cy<=cy1; cy++) {
+                for (size_t i=m_cellStart[cy*nx+cx0]; i<m_cellStart[cy*nx+cx1+1]; i++) {
+                    const Point& p=m_points[i];
+                    if (p.x>=xmin && p.x<=xmax && p.y>=ymin && p.y<=ymax) f(p);
+                }
+            }
+        }
+    private:
+        /** \brief returns the cell (0 ... edges.size()-2) that contains \a v, values outside the grid are clamped */
+        static inline size_t cellIndex(const std::vector<double>& edges, double v) {
+            const size_t n=edges.size()-1;
+            if (n<=1) return 0;
+            const size_t c=static_cast<size_t>(std::upper_bound(edges.begin()+1, edges.end()-1, v)-(edges.begin()+1));
+            return qMin(c, n-1);
+        }
+        /** \brief the borders of the cells in x-direction (size: getCellCountX()+1, the first/last entry are the min/max of the x-values) */
+        std::vector<double> m_xEdges;
+        /** \brief the borders of the cells in y-direction (size: getCellCountY()+1, the first/last entry are the min/max of the y-values) */
+        std::vector<double> m_yEdges;
+        /** \brief index of the first point of each cell in m_points (cells are stored row-wise, the last entry is m_points.size() ) */
+        std::vector<size_t> m_cellStart;
+        /** \brief the points, sorted by cell */
+        std::vector<Point> m_points;
+};
+
 /** \brief     QAbstractTableModel descendent that allows to view data in a JKQTPDatastore
  * \ingroup jkqtpdatastorage_classes
  *
@@ -2401,6 +3438,16 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPDatastoreModel: public QAbstractTableModel {
 ////////////////////////////////////////////////////////////////////////////////////////////////
 inline void JKQTPColumn::setValue(size_t n, double val){
     if (isValid()) {
+        if (isTypedColumn()) {
+            markModified();
+            if (typedData && n<rows) JKQTPMathImageSetValue(typedData, dataType, n, val);
+            return;
+        }
+        if (isRingBufferColumn()) {
+            markModified();
+            setRingBufferValue(n, val);
+            return;
+        }
         double* p = getPointer(n);
         if (p) {
             *p=val;
@@ -2411,6 +3458,16 @@ inline void JKQTPColumn::setValue(size_t n, double val){
 ////////////////////////////////////////////////////////////////////////////////////////////////
 inline void JKQTPColumn::incValue(size_t n, double increment){
     if (isValid()) {
+        if (isTypedColumn()) {
+            markModified();
+            if (typedData && n<rows) JKQTPMathImageSetValue(typedData, dataType, n, JKQTPMathImageGetValue(typedData, dataType, n)+increment);
+            return;
+        }
+        if (isRingBufferColumn()) {
+            markModified();
+            if (n<rows) setRingBufferValue(n, getValue(n)+increment);
+            return;
+        }
         double* p = getPointer(n);
         if (p) {
             *p=*p+increment;
@@ -2421,11 +3478,23 @@ inline void JKQTPColumn::incValue(size_t n, double increment){
 ////////////////////////////////////////////////////////////////////////////////////////////////
 quint16 JKQTPColumn::calculateChecksum() const
 {
+    if (isTypedColumn()) {
+        if (!typedData) return 0;
+        return jkqtp_checksum(static_cast<const char*>(typedData), static_cast<uint>(getRows()*JKQTPMathImageDataTypeSize(dataType)));
+    }
     auto* p=getPointer();
     if (!p) return 0;
     return jkqtp_checksum(reinterpret_cast<const char*>(p), static_cast<uint>(getRows()*sizeof(double)));
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 JKQTPColumn::calculateHash64() const
+{
+    const void* p=getRawPointer(0);
+    if (!p) return 0;
+    return jkqtp_hash64(p, getRows()*JKQTPMathImageDataTypeSize(dataType));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 JKQTPColumn::iterator JKQTPColumn::begin() {
     return JKQTPColumn::iterator(this, 0);
@@ -2460,6 +3529,7 @@ void JKQTPColumn::eraseFromVectorColumn(size_t row, size_t rowEnd) {
         JKQTPASSERT(rowEnd>=0);
         JKQTPASSERT(row<datavec.size());
         JKQTPASSERT(rowEnd<datavec.size());
+        markModified();
         datavec.erase(datavec.begin()+row, datavec.begin()+rowEnd+1);
     }
 }
@@ -2476,6 +3546,9 @@ inline double JKQTPColumn::getValue(size_t n) const {
     if (p) {
         return p[n];
     }
+    if (isTypedColumn() && typedData) {
+        return JKQTPMathImageGetValue(typedData, dataType, n);
+    }
     return JKQTP_NAN;
 }
 
@@ -2520,6 +3593,20 @@ inline double& JKQTPColumn::operator[](int n)  {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+JKQTPColumnView::JKQTPColumnView(const std::shared_ptr<const JKQTPColumn> &col):
+    m_column(col), m_data(nullptr), m_rawData(nullptr), m_dataType(JKQTPMathImageDataType::DoubleArray), m_rows(0)
+{
+    if (m_column && m_column->isValid()) {
+        m_data=m_column->getPointer(0);
+        m_rawData=m_column->getRawPointer(0);
+        m_dataType=m_column->getDataType();
+        m_rows=(m_rawData)?m_column->getRows():0;
+    } else {
+        m_column.reset();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 size_t JKQTPDatastore::getRows(size_t column) const {
     return columns[column]->getRows();
@@ -2529,7 +3616,7 @@ size_t JKQTPDatastore::getRows(size_t column) const {
 const double *JKQTPDatastore::getColumnPointer(int column, size_t row) const
 {
     if (column<0) return nullptr;
-    return columns[static_cast<size_t>(column)]->getPointer(row);
+    return getColumnPointer(static_cast<size_t>(column), row);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2548,7 +3635,9 @@ size_t JKQTPDatastore::getRows(int column) const {
 ////////////////////////////////////////////////////////////////////////////////////////////////
 const double *JKQTPDatastore::getColumnPointer(size_t column, size_t row) const
 {
-    return columns[column]->getPointer(row);
+    // use the const overload of JKQTPColumn::getPointer(), so typed columns are not converted
+    const JKQTPColumn& col=*columns[column];
+    return col.getPointer(row);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -90,7 +90,10 @@ bool JKQTPPlotElement::isVisible() const
 
 void JKQTPPlotElement::setHighlighted(bool __value)
 {
+    if (highlighted==__value) return;
     highlighted=__value;
+    // the highlighting is not shown in the key, so only the graphs have to be drawn again
+    if (parent) parent->redrawPlotLayers(JKQTBasePlotter::GraphsLayer);
 }
 
 bool JKQTPPlotElement::isHighlighted() const
@@ -123,20 +126,23 @@ bool JKQTPGraph::getDataMinMax(int column, double &minx, double &maxx, double &s
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView columnData=datastore->getColumnView(column);
     int imin=0;
     int imax=static_cast<int>(datastore->getRows(column));
 
     if (imin<0) imin=0;
     if (imax<0) imax=0;
 
-    for (int i=imin; i<imax; i++) {
-        double xv=datastore->get(column,static_cast<size_t>(i));
-        if (start || xv>maxx) maxx=xv;
-        if (start || xv<minx) minx=xv;
-        double xvsgz;
-        xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
-        start=false;
-    }
+    columnData.visit([&](const auto& col) {
+        for (int i=imin; i<imax; i++) {
+            double xv=col.getValue(i);
+            if (start || xv>maxx) maxx=xv;
+            if (start || xv<minx) minx=xv;
+            double xvsgz;
+            xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
+            start=false;
+        }
+    });
     return !start;
 }
 
@@ -151,6 +157,16 @@ void JKQTPPlotElement::drawOutside(JKQTPEnhancedPainter& /*painter*/, QRect /*le
 
 }
 
+bool JKQTPPlotElement::canDrawInParallel() const
+{
+    return false;
+}
+
+bool JKQTPPlotElement::isDrawingAborted() const
+{
+    return parent && parent->isDrawingAborted();
+}
+
 
 QString JKQTPPlotElement::formatHitTestDefaultLabel(double x, double y, int index, const JKQTPDatastore* datastore) const {
     const JKQTPXGraphErrorData* errgx=dynamic_cast<const JKQTPXGraphErrorData*>(this);
@@ -337,7 +353,6 @@ JKQTPXYGraph::JKQTPXYGraph(JKQTBasePlotter* parent):
 
 
 bool JKQTPXYGraph::getXMinMax(double& minx, double& maxx, double& smallestGreaterZero) {
-    bool start=true;
     minx=0;
     maxx=0;
     smallestGreaterZero=0;
@@ -345,25 +360,18 @@ bool JKQTPXYGraph::getXMinMax(double& minx, double& maxx, double& smallestGreate
     if (parent==nullptr)  return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
+    if (imax<=imin) return false;
 
-    for (int i=imin; i<imax; i++) {
-        double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-        if (JKQTPIsOKFloat(xv)) {
-            if (start || xv>maxx) maxx=xv;
-            if (start || xv<minx) minx=xv;
-            double xvsgz;
-            xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
-            start=false;
-        }
-    }
-    return !start;
+    // the range does not depend on the order of the datapoints, so the (cached) min/max pyramid of the column is used,
+    // which avoids a full scan over the data on every call
+    return xData.getMinMax(static_cast<size_t>(imin), static_cast<size_t>(imax), minx, maxx, &smallestGreaterZero);
 }
 
 bool JKQTPXYGraph::getYMinMax(double& miny, double& maxy, double& smallestGreaterZero) {
-    bool start=true;
     miny=0;
     maxy=0;
     smallestGreaterZero=0;
@@ -371,22 +379,14 @@ bool JKQTPXYGraph::getYMinMax(double& miny, double& maxy, double& smallestGreate
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
+    if (imax<=imin) return false;
 
-
-    for (int i=imin; i<imax; i++) {
-        double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
-        if (JKQTPIsOKFloat(yv)) {
-            if (start || yv>maxy) maxy=yv;
-            if (start || yv<miny) miny=yv;
-            double xvsgz;
-            xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
-            start=false;
-        }
-    }
-    return !start;
+    // see getXMinMax()
+    return yData.getMinMax(static_cast<size_t>(imin), static_cast<size_t>(imax), miny, maxy, &smallestGreaterZero);
 }
 
 bool JKQTPXYGraph::usesColumn(int column) const
@@ -504,6 +504,8 @@ double JKQTPXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyste
     if (JKQTPIsOKFloat(baseclassResult)) return baseclassResult;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
     int imin=0;
     int imax=0;
     if (!getIndexRange(imin, imax)) return JKQTP_NAN;
@@ -514,8 +516,7 @@ double JKQTPXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyste
     double closedistsec=JKQTP_NAN;
     QPointF closestPos;
     QPointF posF=transform(posSystem);
-    for (int i=imin; i<imax; i++) {
-        const QPointF x(datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i)), datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i)));
+    const auto testPoint=[&](int i, const QPointF& x) {
         const QPointF xpix = transform(x);
         if (JKQTPIsOKFloat(xpix.x())&&JKQTPIsOKFloat(xpix.y())) {
             double d=0, dsecondary=0;
@@ -524,14 +525,46 @@ double JKQTPXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyste
                 case HitTestXOnly: d=fabs(xpix.x()-posF.x()); dsecondary=fabs(xpix.y()-posF.y()); break;
                 case HitTestYOnly: d=fabs(xpix.y()-posF.y()); dsecondary=fabs(xpix.x()-posF.x()); break;
             }
-            if (closest<0 || d<closedist || (jkqtp_approximatelyEqual(d,closedist) && dsecondary<closedistsec)) {
+            // points are not tested in the order of their index, so ties are resolved towards the smaller index
+            const bool same=(closest>=0 && jkqtp_approximatelyEqual(d,closedist));
+            if (closest<0 || (!same && d<closedist) || (same && (dsecondary<closedistsec || (dsecondary==closedistsec && i<closest)))) {
                 closest=i;
                 closedist=d;
                 closedistsec=dsecondary;
                 closestPos=x;
-                //qDebug()<<"hitTest("<<posSystem<<"[="<<posF<<"pix]...): found closest="<<closest<<", closedist="<<closedist<<", closedistsec="<<closedistsec<<", closestPos="<<closestPos;
             }
         }
+    };
+    if (imax-imin<HitTestIndexMinPoints) {
+        JKQTPVisitColumnViews(xData, yData, [&](const auto& xCol, const auto& yCol) {
+            for (int i=imin; i<imax; i++) {
+                testPoint(i, QPointF(xCol.getValue(i), yCol.getValue(i)));
+            }
+        });
+    } else {
+        // search the points in a rectangle (in pixels) around posF, which is enlarged until it contains the closest point
+        const std::shared_ptr<const JKQTPXYSpatialIndex> index=getHitTestIndex(xData, yData, imin, imax);
+        const double inf=std::numeric_limits<double>::infinity();
+        const auto backRange=[](double a, double b, double& vmin, double& vmax) {
+            vmin=qMin(a,b);
+            vmax=qMax(a,b);
+            if (!JKQTPIsOKFloat(vmin)) vmin=-std::numeric_limits<double>::infinity();
+            if (!JKQTPIsOKFloat(vmax)) vmax=std::numeric_limits<double>::infinity();
+        };
+        double lastXMin=inf, lastXMax=-inf, lastYMin=inf, lastYMax=-inf;
+        for (double r=8; JKQTPIsOKFloat(r); r*=4.0) {
+            double xmin=-inf, xmax=inf, ymin=-inf, ymax=inf;
+            if (mode!=HitTestYOnly) backRange(backtransformX(posF.x()-r), backtransformX(posF.x()+r), xmin, xmax);
+            if (mode!=HitTestXOnly) backRange(backtransformY(posF.y()-r), backtransformY(posF.y()+r), ymin, ymax);
+            // the rectangle does not grow any more (e.g. limits of a logarithmic axis reached)
+            if (xmin==lastXMin && xmax==lastXMax && ymin==lastYMin && ymax==lastYMax) break;
+            index->forEachPointInRect(xmin, xmax, ymin, ymax, [&](const JKQTPXYSpatialIndex::Point& p) {
+                testPoint(static_cast<int>(p.row), QPointF(p.x, p.y));
+            });
+            // all points closer than r are inside the rectangle
+            if ((closest>=0 && closedist<=r) || index->rectContainsAllPoints(xmin, xmax, ymin, ymax)) break;
+            lastXMin=xmin; lastXMax=xmax; lastYMin=ymin; lastYMax=ymax;
+        }
     }
     if (closest>=0) {
         if (label) *label=formatHitTestDefaultLabel(closestPos.x(), closestPos.y(), closest, datastore);
@@ -545,6 +578,32 @@ double JKQTPXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyste
 
 
 
+std::shared_ptr<const JKQTPXYSpatialIndex> JKQTPXYGraph::getHitTestIndex(const JKQTPColumnView &xData, const JKQTPColumnView &yData, int imin, int imax) const
+{
+    // the generations are O(1), so a cache hit does not read the data (changes in external memory have to be signalled
+    // with JKQTPDatastore::markColumnModified() )
+    const quint64 xGeneration=xData.getGeneration();
+    const quint64 yGeneration=yData.getGeneration();
+    {
+        JKQTPSynchronized<HitTestIndexCache>::ReadLocker lock(hitTestIndexCache);
+        if (hitTestIndexCache->index && hitTestIndexCache->xGeneration==xGeneration && hitTestIndexCache->yGeneration==yGeneration
+            && hitTestIndexCache->imin==imin && hitTestIndexCache->imax==imax) {
+            return hitTestIndexCache->index;
+        }
+    }
+    auto index=std::make_shared<const JKQTPXYSpatialIndex>(xData, yData, static_cast<size_t>(qMax(0, imin)), static_cast<size_t>(qMax(0, imax)));
+    JKQTPSynchronized<HitTestIndexCache>::WriteLocker lock(hitTestIndexCache);
+    hitTestIndexCache->index=index;
+    hitTestIndexCache->xGeneration=xGeneration;
+    hitTestIndexCache->yGeneration=yGeneration;
+    hitTestIndexCache->imin=imin;
+    hitTestIndexCache->imax=imax;
+    return index;
+}
+
+
+
+
 JKQTPSingleColumnGraph::JKQTPSingleColumnGraph(JKQTBasePlotter *parent):
     JKQTPGraph(parent), dataColumn(-1), dataDirection(DataDirection::Y), sortData(Unsorted)
 {
@@ -607,6 +666,7 @@ void JKQTPSingleColumnGraph::intSortData()
     if (parent==nullptr)  return ;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView dataValues=datastore->getColumnView(dataColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
@@ -616,7 +676,7 @@ void JKQTPSingleColumnGraph::intSortData()
     if (sortData==JKQTPSingleColumnGraph::Sorted) {
 
         for (int i=0; i<imax; i++) {
-            double xv=datastore->get(dataColumn,static_cast<size_t>(i));
+            double xv=dataValues.getValue(i);
             sortedIndices<<i;
             datas<<xv;
         }
@@ -671,6 +731,8 @@ void JKQTPXYGraph::intSortData()
     if (sortData==JKQTPXYLineGraph::Unsorted) return ;
 
     JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
@@ -680,7 +742,7 @@ void JKQTPXYGraph::intSortData()
     if (sortData==JKQTPXYLineGraph::SortedX) {
 
         for (int i=0; i<imax; i++) {
-            double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
+            double xv=xData.getValue(i);
             sortedIndices<<i;
             datas<<xv;
         }
@@ -691,7 +753,7 @@ void JKQTPXYGraph::intSortData()
     } else if (sortData==JKQTPXYLineGraph::SortedY) {
 
         for (int i=0; i<imax; i++) {
-            double xv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
+            double xv=yData.getValue(i);
             sortedIndices<<i;
             datas<<xv;
         }
@@ -766,13 +828,15 @@ bool JKQTPXYYGraph::getYMinMax(double &miny, double &maxy, double &smallestGreat
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
+    const JKQTPColumnView yData2=datastore->getColumnView(yColumn2);
     int imin=0;
     int imax=0;
     if (getIndexRange(imin, imax)) {
 
 
         for (int i=imin; i<imax; i++) {
-            const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
+            const double yv=yData.getValue(i);
             if (JKQTPIsOKFloat(yv)) {
                 if (start || yv>maxy) maxy=yv;
                 if (start || yv<miny) miny=yv;
@@ -780,7 +844,7 @@ bool JKQTPXYYGraph::getYMinMax(double &miny, double &maxy, double &smallestGreat
                 xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
                 start=false;
             }
-            const double yv2=datastore->get(static_cast<size_t>(yColumn2),static_cast<size_t>(i));
+            const double yv2=yData2.getValue(i);
             if (JKQTPIsOKFloat(yv2)) {
                 if (start || yv2>maxy) maxy=yv2;
                 if (start || yv2<miny) miny=yv2;
@@ -813,6 +877,8 @@ double JKQTPXYYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyst
     if (JKQTPIsOKFloat(baseclassResult)) return baseclassResult;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData2=datastore->getColumnView(yColumn2);
     int imin=0;
     int imax=0;
     if (!getIndexRange(imin, imax)) return JKQTP_NAN;
@@ -824,7 +890,7 @@ double JKQTPXYYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyst
     QPointF closestPos;
     QPointF posF=transform(posSystem);
     for (int i=imin; i<imax; i++) {
-        const QPointF x(datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i)), datastore->get(static_cast<size_t>(yColumn2),static_cast<size_t>(i)));
+        const QPointF x(xData.getValue(i), yData2.getValue(i));
         const QPointF xpix = transform(x);
         if (JKQTPIsOKFloat(xpix.x())&&JKQTPIsOKFloat(xpix.y())) {
             double d=0, dsecondary=0;
@@ -919,13 +985,15 @@ bool JKQTPXXYGraph::getXMinMax(double &minx, double &maxx, double &smallestGreat
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView xData2=datastore->getColumnView(xColumn2);
     int imin=0;
     int imax=0;
     if (getIndexRange(imin, imax)) {
 
 
         for (int i=imin; i<imax; i++) {
-            const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
+            const double xv=xData.getValue(i);
             if (JKQTPIsOKFloat(xv)) {
                 if (start || xv>maxx) maxx=xv;
                 if (start || xv<minx) minx=xv;
@@ -933,7 +1001,7 @@ bool JKQTPXXYGraph::getXMinMax(double &minx, double &maxx, double &smallestGreat
                 xvsgz=xv; SmallestGreaterZeroCompare_xvsgz();
                 start=false;
             }
-            const double xv2=datastore->get(static_cast<size_t>(xColumn2),static_cast<size_t>(i));
+            const double xv2=xData2.getValue(i);
             if (JKQTPIsOKFloat(xv2)) {
                 if (start || xv2>maxx) maxx=xv2;
                 if (start || xv2<minx) minx=xv2;
@@ -976,6 +1044,8 @@ double JKQTPXXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyst
     if (JKQTPIsOKFloat(baseclassResult)) return baseclassResult;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData2=datastore->getColumnView(xColumn2);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
     int imin=0;
     int imax=0;
     if (!getIndexRange(imin, imax)) return JKQTP_NAN;
@@ -987,7 +1057,7 @@ double JKQTPXXYGraph::hitTest(const QPointF &posSystem, QPointF *closestSpotSyst
     QPointF closestPos;
     QPointF posF=transform(posSystem);
     for (int i=imin; i<imax; i++) {
-        const QPointF x(datastore->get(static_cast<size_t>(xColumn2),static_cast<size_t>(i)), datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i)));
+        const QPointF x(xData2.getValue(i), yData.getValue(i));
         const QPointF xpix = transform(x);
         if (JKQTPIsOKFloat(xpix.x())&&JKQTPIsOKFloat(xpix.y())) {
             double d=0, dsecondary=0;
@@ -1080,6 +1150,7 @@ bool JKQTPXYBaselineGraph::getMinMaxWithBaseline(int dataColumn, double &minv, d
     if (parent==nullptr) return false;
 
     JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView dataValues=datastore->getColumnView(dataColumn);
     int imax=0;
     int imin=0;
     if (getIndexRange(imin, imax)) {
@@ -1093,7 +1164,7 @@ bool JKQTPXYBaselineGraph::getMinMaxWithBaseline(int dataColumn, double &minv, d
                 double xvsgz;
                 xvsgz=yv; SmallestGreaterZeroCompare_xvsgz();
             }
-            yv=datastore->get(static_cast<size_t>(dataColumn),static_cast<size_t>(i));
+            yv=dataValues.getValue(i);
             if (JKQTPIsOKFloat(yv)) {
                 if (yv>maxv) maxv=yv;
                 if (yv<minv) minv=yv;
@@ -1121,14 +1192,15 @@ bool JKQTPXYBaselineGraph::getMinMaxWithErrorsAndBaseline(int dataColumn, int er
     if (parent==nullptr) return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView dataValues=datastore->getColumnView(dataColumn);
     int imax=0;
     int imin=0;
     if (getIndexRange(imin, imax)) {
 
 
         for (int i=imin; i<imax; i++) {
-            const double yv=datastore->get(static_cast<size_t>(dataColumn),static_cast<size_t>(i))+getErrorU(i, datastore, errorColumn);
-            const double yvv=datastore->get(static_cast<size_t>(dataColumn),static_cast<size_t>(i))-getErrorL(i, datastore, errorColumn, errorColumnLower, errorSymmetric);
+            const double yv=dataValues.getValue(i)+getErrorU(i, datastore, errorColumn);
+            const double yvv=dataValues.getValue(i)-getErrorL(i, datastore, errorColumn, errorColumnLower, errorSymmetric);
             if (JKQTPIsOKFloat(yv) && JKQTPIsOKFloat(yvv) ) {
                 if (start || yv>maxv) maxv=yv;
                 if (start || yv<minv) minv=yv;
@@ -1355,12 +1427,13 @@ bool JKQTPXGraph::getXMinMax(double &minx, double &maxx, double &smallestGreater
     if (parent==nullptr)  return false;
 
     const JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
 
     for (int i=imin; i<imax; i++) {
-        double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
+        double xv=xData.getValue(i);
         if (JKQTPIsOKFloat(xv)) {
             if (start || xv>maxx) maxx=xv;
             if (start || xv<minx) minx=xv;
@@ -1427,6 +1500,7 @@ void JKQTPXGraph::intSortData()
     if (sortData==JKQTPXGraph::Unsorted) return ;
 
     JKQTPDatastore* datastore=parent->getDatastore();
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
     int imin=0;
     int imax=0;
     getIndexRange(imin, imax);
@@ -1436,7 +1510,7 @@ void JKQTPXGraph::intSortData()
     if (sortData==SortedX) {
 
         for (int i=0; i<imax; i++) {
-            double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
+            double xv=xData.getValue(i);
             sortedIndices<<i;
             datas<<xv;
         }
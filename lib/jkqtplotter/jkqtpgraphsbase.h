@@ -71,6 +71,20 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPPlotElement: public QObject {
 
         /** \brief plots the graph to the plotter object specified as parent */
         virtual void draw(JKQTPEnhancedPainter& painter)=0;
+        /** \brief returns \c true, if draw() may be called in a worker thread, concurrently with draw() of other graphs (default: \c false )
+         *
+         *  This requires that draw() only reads the state of the parent plotter and the datastore and does not use objects
+         *  that are shared between graphs, like the JKQTMathText instance of the parent, which renders the text in the plot.
+         *
+         *  \see JKQTBasePlotter::setParallelGraphRendering()
+         */
+        virtual bool canDrawInParallel() const;
+        /** \brief returns \c true, if drawing the parent plotter was aborted (see JKQTBasePlotter::abortDrawing() )
+         *
+         *  Implementations of draw() check this in their loops over the data points and return early, so an outdated frame,
+         *  which is drawn in a background thread (see JKQTPlotter::setBackgroundRendering() ), is cancelled quickly.
+         */
+        bool isDrawingAborted() const;
 
         /** \brief plots a key marker inside the specified rectangle \a rect */
         virtual void drawKeyMarker(JKQTPEnhancedPainter& painter, const QRectF& rect)=0;
@@ -123,7 +137,7 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPPlotElement: public QObject {
     public Q_SLOTS:
         /** \brief sets whether the graph is visible in the plot  */
         void setVisible(bool __value);
-        /** \brief sets whether the graph is drawn in a highlighted style in the plot  */
+        /** \brief sets whether the graph is drawn in a highlighted style in the plot, a change marks the JKQTBasePlotter::GraphsLayer of the parent as changed (see JKQTBasePlotter::redrawPlotLayers() ) */
         void setHighlighted(bool __value);
         /** \brief sets the title of the plot (for display in key!).
          *
@@ -634,9 +648,16 @@ public:
      * \note This function first checks whether JKQTPPlotElement::hitTest() returns any result, so you can use the basic implementation
      *       in JKQTPPlotElement to override the behaviour here, by simply calling addHitTestData() during your draw() implementation
      *
+     * For graphs with at least HitTestIndexMinPoints points, the search uses a JKQTPXYSpatialIndex over the data, which is built on the first call
+     * and cached until the data in xColumn or yColumn changes (see JKQTPDatastore::getColumnGeneration() ). The search starts with a small
+     * rectangle around \a posSystem and enlarges it, until the closest point is found, so a call reads only a few points
+     * instead of all N points of the graph. This makes the tooltip and ruler tools of JKQTPlotter usable for graphs with millions of points.
+     *
      * \see See JKQTPPlotElement::hitTest() for details on the function definition!
      */
     virtual double hitTest(const QPointF &posSystem, QPointF* closestSpotSystem=nullptr, QString* label=nullptr, HitTestMode mode=HitTestXY) const override;
+    /** \brief graphs with less points are searched by hitTest() without a spatial index */
+    static constexpr int HitTestIndexMinPoints=2048;
 public Q_SLOTS:
     /** \brief sets xColumn and yColumn at the same time */
     void setXYColumns(size_t xCol, size_t yCol);
@@ -700,6 +721,29 @@ protected:
      *  \return \c true on success and \c false if the information is not available
      */
     virtual bool getIndexRange(int &imin, int &imax) const;
+
+    /** \brief returns a spatial index over the rows \a imin ... \a imax-1 of \a xData and \a yData, which is cached until the data changes
+     *
+     *  \see hitTest()
+     */
+    std::shared_ptr<const JKQTPXYSpatialIndex> getHitTestIndex(const JKQTPColumnView& xData, const JKQTPColumnView& yData, int imin, int imax) const;
+private:
+    /** \brief cached spatial index for hitTest(), together with the data it was built for */
+    struct HitTestIndexCache {
+        inline HitTestIndexCache(): index(), xGeneration(0), yGeneration(0), imin(0), imax(0) {}
+        /** \brief the index */
+        std::shared_ptr<const JKQTPXYSpatialIndex> index;
+        /** \brief generation of the x-column (see JKQTPColumn::getGeneration() ), for which index was built */
+        quint64 xGeneration;
+        /** \brief generation of the y-column (see JKQTPColumn::getGeneration() ), for which index was built */
+        quint64 yGeneration;
+        /** \brief first row in index */
+        int imin;
+        /** \brief last row (+1) in index */
+        int imax;
+    };
+    /** \brief cached spatial index for hitTest() \see getHitTestIndex() */
+    mutable JKQTPSynchronized<HitTestIndexCache> hitTestIndexCache;
 };
 
 
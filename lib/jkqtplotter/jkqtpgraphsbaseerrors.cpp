@@ -260,6 +260,31 @@ void JKQTPGraphErrorStyleMixin::setErrorFillTransform(const QTransform &b)
     m_errorFillBrush.setTransform(b);
 }
 
+namespace {
+    /** \brief geometry of error indicators with the same color, which is collected by JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators()
+     *         and then drawn with as few painter calls as possible */
+    struct JKQTPErrorIndicatorBatch {
+        /** \brief the batch uses the default error colors (i.e. the pen/brush of the error style) */
+        bool defaultColor;
+        QColor lineColor;
+        QColor fillColor;
+        /** \brief error bars and bar-indicators */
+        QVector<QLineF> bars;
+        /** \brief (filled) arrow indicators */
+        QVector<QPolygonF> arrows;
+        /** \brief error boxes */
+        QVector<QRectF> boxes;
+        /** \brief error ellipses */
+        QVector<QRectF> ellipses;
+        /** \brief error lines */
+        QVector<QLineF> errorLines;
+
+        inline int count() const {
+            return bars.size()+arrows.size()+boxes.size()+ellipses.size()+errorLines.size();
+        }
+    };
+}
+
 void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& painter, const JKQTBasePlotter* parent, const JKQTPGraph* parentGraph, int xColumn, int yColumn, int xErrorColumn, int yErrorColumn, JKQTPErrorPlotstyle xErrorStyle, JKQTPErrorPlotstyle yErrorStyle, int xErrorColumnLower, int yErrorColumnLower, bool xErrorSymmetric, bool yErrorSymmetric, double xrelshift, double yrelshift, const  QVector<int>* dataorder) const {
     //std::cout<<"JKQTPGraphErrors::intPlotXYErrorIndicators(p, "<<parent<<", "<<xColumn<<", "<<yColumn<<", "<<xErrorColumn<<", "<<yErrorColumn<<", "<<xErrorStyle<<", "<<yErrorStyle<<", ...)\n";
     if (parent==nullptr) return;
@@ -281,13 +306,17 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
 
     QBrush b=getErrorFillBrush(painter, parent);
     QPen p=getErrorLinePen(painter, parent);
-    QPen pr=getErrorLinePenForRects(painter, parent);
     painter.setPen(p);
 
-    size_t imaxx=0, imaxy=0;
-    if (xColumn>=0) imaxx=datastore->getRows(static_cast<size_t>(xColumn));
-    if (yColumn>=0) imaxy=datastore->getRows(static_cast<size_t>(yColumn));
-    size_t imax=qMin(imaxx, imaxy);
+    // the columns are looked up only once
+    const JKQTPColumnView xData=datastore->getColumnView(xColumn);
+    const JKQTPColumnView yData=datastore->getColumnView(yColumn);
+    const JKQTPColumnView xErrorData=datastore->getColumnView(xErrorColumn);
+    const JKQTPColumnView yErrorData=datastore->getColumnView(yErrorColumn);
+    const JKQTPColumnView xErrorLowerData=datastore->getColumnView(xErrorColumnLower);
+    const JKQTPColumnView yErrorLowerData=datastore->getColumnView(yErrorColumnLower);
+
+    size_t imax=qMin(xData.size(), yData.size());
     size_t imin=0;
     if (imax<imin) {
         size_t h=imin;
@@ -303,18 +332,55 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
     double ymold=-1;
     bool pastFirst=false;
     double ebs_px=parent->pt2px(painter, m_errorBarCapSize);
+    // bar-caps and arrows are only generated, if their center is inside this rectangle
+    const QRectF capCliprect=cliprect.adjusted(-ebs_px, -ebs_px, ebs_px, ebs_px);
     QPolygonF polyX, polyY;
     QPolygonF polyXTopPoints, polyXBottomPoints, polyYTopPoints, polyYBottomPoints;
     QList<QColor> errFC, errC;
     bool defaultErrorColor=true;
 
+    // the error indicators are collected in batches with the same color, which are drawn when the color changes
+    // or the batch becomes too large (to limit the memory consumption)
+    const int maxBatchSize=65536;
+    JKQTPErrorIndicatorBatch batch;
+    batch.defaultColor=true;
+    const auto drawBatch=[&]() {
+        if (batch.count()<=0) return;
+        painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
+        QPen pp=p;
+        if (!batch.defaultColor) pp.setColor(batch.lineColor);
+        painter.setPen(pp);
+        if (batch.bars.size()>0) painter.drawLines(batch.bars);
+        if (batch.arrows.size()>0) {
+            painter.setBrush(pp.color());
+            for (const QPolygonF& a: batch.arrows) painter.drawPolygon(a);
+        }
+        if (batch.boxes.size()>0 || batch.ellipses.size()>0) {
+            QBrush bb=b;
+            if (!batch.defaultColor) bb.setColor(batch.fillColor);
+            painter.setBrush(bb);
+            if (batch.boxes.size()>0) painter.drawRects(batch.boxes);
+            for (const QRectF& e: batch.ellipses) painter.drawEllipse(e);
+        }
+        if (batch.errorLines.size()>0) painter.drawLines(batch.errorLines);
+        batch.bars.clear();
+        batch.arrows.clear();
+        batch.boxes.clear();
+        batch.ellipses.clear();
+        batch.errorLines.clear();
+    };
+    const auto addClippedLine=[&cliprect](QVector<QLineF>& lines, const QLineF& line) {
+        const QLineF l=JKQTPClipLine(line, cliprect);
+        if (l.length()>0) lines.push_back(l);
+    };
+
 
 
     for (size_t iii=imin; iii<imax; iii++) {
         int i=static_cast<int>(iii);
         if (dataorder) i=dataorder->value(static_cast<int>(iii), static_cast<int>(iii));
-        const double xv=datastore->get(static_cast<size_t>(xColumn),static_cast<size_t>(i));
-        const double yv=datastore->get(static_cast<size_t>(yColumn),static_cast<size_t>(i));
+        const double xv=xData.getValue(i);
+        const double yv=yData.getValue(i);
 
         double deltax=1;
         double deltapx=0;
@@ -323,12 +389,12 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
             deltamx=0.5;
             deltapx=0.5;
         } else if (static_cast<int>(i)==static_cast<int>(imax)-1&& static_cast<int>(i)-1>=0) { // the right-most x-value
-            deltapx=deltamx=fabs(xv-datastore->get(xColumn,static_cast<size_t>(i-1)))/2.0;
+            deltapx=deltamx=fabs(xv-xData.getValue(i-1))/2.0;
         } else if (i==static_cast<int>(imin) && i+1<static_cast<int>(imax)) { // the left-most x-value
-            deltamx=deltapx=fabs(datastore->get(xColumn,static_cast<size_t>(i+1))-xv)/2.0;
+            deltamx=deltapx=fabs(xData.getValue(i+1)-xv)/2.0;
         } else {
-            if (static_cast<int>(i)-1>=0) deltamx=fabs(xv-datastore->get(xColumn,static_cast<size_t>(i-1)))/2.0;
-            if (i+1<static_cast<int>(imax)) deltapx=fabs(datastore->get(xColumn,static_cast<size_t>(i+1))-xv)/2.0;
+            if (static_cast<int>(i)-1>=0) deltamx=fabs(xv-xData.getValue(i-1))/2.0;
+            if (i+1<static_cast<int>(imax)) deltapx=fabs(xData.getValue(i+1)-xv)/2.0;
         }
         deltax=deltapx+deltamx;
 
@@ -339,12 +405,12 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
             deltamy=0.5;
             deltapy=0.5;
         } else if (i==static_cast<int>(imax)-1&& static_cast<int>(i)-1>=0) { // the right-most y-value
-            deltapy=deltamy=fabs(yv-datastore->get(yColumn,static_cast<size_t>(i-1)))/2.0;
+            deltapy=deltamy=fabs(yv-yData.getValue(i-1))/2.0;
         } else if (i==static_cast<int>(imin) && i+1<static_cast<int>(imax)) { // the left-most y-value
-            deltamy=deltapy=fabs(datastore->get(yColumn,static_cast<size_t>(i+1))-yv)/2.0;
+            deltamy=deltapy=fabs(yData.getValue(i+1)-yv)/2.0;
         } else {
-            if (static_cast<int>(i)-1>=0) deltamy=fabs(yv-datastore->get(yColumn,static_cast<size_t>(i-1)))/2.0;
-            if (i+1<static_cast<int>(imax)) deltapy=fabs(datastore->get(yColumn,static_cast<size_t>(i+1))-yv)/2.0;
+            if (static_cast<int>(i)-1>=0) deltamy=fabs(yv-yData.getValue(i-1))/2.0;
+            if (i+1<static_cast<int>(imax)) deltapy=fabs(yData.getValue(i+1)-yv)/2.0;
         }
         deltay=deltapy+deltamy;
 
@@ -353,12 +419,12 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
         bool plotlowerbary=false;
         bool plotupperbary=false;
 
-        double xe=0;   if (xErrorStyle!=JKQTPNoError && xErrorColumn>=0) { xe=datastore->get(xErrorColumn,static_cast<size_t>(i)); plotupperbarx=true; }
-        double ye=0;   if (yErrorStyle!=JKQTPNoError && yErrorColumn>=0) { ye=datastore->get(yErrorColumn,static_cast<size_t>(i)); plotupperbary=true; }
+        double xe=0;   if (xErrorStyle!=JKQTPNoError && xErrorColumn>=0) { xe=xErrorData.getValue(i); plotupperbarx=true; }
+        double ye=0;   if (yErrorStyle!=JKQTPNoError && yErrorColumn>=0) { ye=yErrorData.getValue(i); plotupperbary=true; }
         double xl=0;   if (xErrorSymmetric) { xl=xe; plotlowerbarx=plotupperbarx||(xl>0); }
-                       else if (xErrorStyle!=JKQTPNoError && xErrorColumnLower>=0) { xl=datastore->get(xErrorColumnLower,static_cast<size_t>(i)); plotlowerbarx=true; }
+                       else if (xErrorStyle!=JKQTPNoError && xErrorColumnLower>=0) { xl=xErrorLowerData.getValue(i); plotlowerbarx=true; }
         double yl=0;   if (yErrorSymmetric) { yl=ye; plotlowerbary=plotupperbary||(yl>0); }
-                       else if (yErrorStyle!=JKQTPNoError && yErrorColumnLower>=0) { yl=datastore->get(yErrorColumnLower,static_cast<size_t>(i)); plotlowerbary=true; }
+                       else if (yErrorStyle!=JKQTPNoError && yErrorColumnLower>=0) { yl=yErrorLowerData.getValue(i); plotlowerbary=true; }
 
         if (xErrorStyle.testFlag(JKQTPErrorDirectionOutwards)) {
             if (xv>=0.0) { xl=0; plotlowerbarx=false; }
@@ -391,28 +457,30 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
             QColor terrCol=getErrorLineColor();
             QColor terrFillCol=getErrorFillColor();
             defaultErrorColor = defaultErrorColor && !this->intPlotXYErrorIndicatorsGetColor(painter, parent, parentGraph, xColumn, yColumn, xErrorColumn, yErrorColumn, xErrorStyle, yErrorStyle, i, terrCol, terrFillCol);
+            if (batch.defaultColor!=defaultErrorColor || (!defaultErrorColor && (batch.lineColor!=terrCol || batch.fillColor!=terrFillCol)) || batch.count()>=maxBatchSize) {
+                drawBatch();
+                batch.defaultColor=defaultErrorColor;
+                batch.lineColor=terrCol;
+                batch.fillColor=terrFillCol;
+            }
+
+            const double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); const bool x0ok=JKQTPIsOKFloat(x0);
+            const double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); const bool x1ok=JKQTPIsOKFloat(x1);
+            const double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); const bool y0ok=JKQTPIsOKFloat(y0);
+            const double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); const bool y1ok=JKQTPIsOKFloat(y1);
 
             // x-errorpolygons
             if (xErrorStyle.testFlag(JKQTPErrorPolygons)) {
-                double xl2m=parentGraph->transformX(xv+xrelshift*deltax-xl);
-                double xl2p=parentGraph->transformX(xv+xrelshift*deltax+xe);
-                double yl2=y;
-
-                polyXTopPoints<<QPointF(xl2p, yl2);
-                polyXBottomPoints<<QPointF(xl2m, yl2);
+                polyXTopPoints<<QPointF(x1, y);
+                polyXBottomPoints<<QPointF(x0, y);
                 errFC<<terrFillCol;
                 errC<<terrCol;
             }
 
             // y-errorpolygons
             if (yErrorStyle.testFlag(JKQTPErrorPolygons)) {
-
-                double yl2m=parentGraph->transformY(yv+yrelshift*deltay-yl);
-                double yl2p=parentGraph->transformY(yv+yrelshift*deltay+ye);
-                double xl2=x;
-
-                polyYTopPoints<<QPointF(xl2, yl2p);
-                polyYBottomPoints<<QPointF(xl2, yl2m);
+                polyYTopPoints<<QPointF(x, y1);
+                polyYBottomPoints<<QPointF(x, y0);
                 errFC<<terrFillCol;
                 errC<<terrCol;
             }
@@ -421,181 +489,92 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
             //x-errorbars
             if ((xErrorColumn>=0 || xErrorColumnLower>=0) && (xErrorStyle.testFlag(JKQTPErrorSimpleBars)))
             {
-                    double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); bool x0ok=JKQTPIsOKFloat(x0);
-                    double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); bool x1ok=JKQTPIsOKFloat(x1);
-                    painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                    QPen pp=p;
-                    if (!defaultErrorColor) pp.setColor(terrCol);
-                    painter.setPen(pp);
-                    QList<QLineF> elines;
                     if (x0ok&&x1ok&&xok&&yok) {
-                        elines<<QLineF(x0, y, x1, y);
+                        addClippedLine(batch.bars, QLineF(x0, y, x1, y));
                     } else if (x0ok&&!x1ok&&xok&&yok) {
-                        elines<<QLineF(x0, y, x, y);
-                        if (x0<x) elines<<QLineF(x,y,parentGraph->transformX(parent->getXMax()),y);
-                        else elines<<QLineF(x,y,parentGraph->transformX(parent->getXMin()),y);
+                        addClippedLine(batch.bars, QLineF(x0, y, x, y));
+                        if (x0<x) addClippedLine(batch.bars, QLineF(x,y,parentGraph->transformX(parent->getXMax()),y));
+                        else addClippedLine(batch.bars, QLineF(x,y,parentGraph->transformX(parent->getXMin()),y));
                     } else if (!x0ok&&x1ok&&xok&&yok) {
-                        elines<<QLineF(x1, y, x, y);
-                        if (x1<x) elines<<QLineF(x,y,parentGraph->transformX(parent->getXMin()),y);
-                        else elines<<QLineF(x,y,parentGraph->transformX(parent->getXMax()),y);
-                    }
-                    for (QLineF& l: elines) {
-                        l=JKQTPClipLine(l, cliprect);
-                        if (l.length()>0) painter.drawLine(l);
+                        addClippedLine(batch.bars, QLineF(x1, y, x, y));
+                        if (x1<x) addClippedLine(batch.bars, QLineF(x,y,parentGraph->transformX(parent->getXMin()),y));
+                        else addClippedLine(batch.bars, QLineF(x,y,parentGraph->transformX(parent->getXMax()),y));
                     }
             }
             // x-bar indicators
             if ((xErrorColumn>=0 || xErrorColumnLower>=0) && (xErrorStyle.testFlag(JKQTPErrorIndicatorBar)))
             {
-                double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); bool x0ok=JKQTPIsOKFloat(x0);
-                double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); bool x1ok=JKQTPIsOKFloat(x1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (x0ok&&xok && plotlowerbarx) painter.drawLine(QLineF(x0, y-ebs_px/2.0,x0, y+ebs_px/2.0));
-                if (x1ok&&xok && plotupperbarx) painter.drawLine(QLineF(x1, y-ebs_px/2.0,x1, y+ebs_px/2.0));
+                if (x0ok&&xok && plotlowerbarx && capCliprect.contains(x0, y)) batch.bars<<QLineF(x0, y-ebs_px/2.0,x0, y+ebs_px/2.0);
+                if (x1ok&&xok && plotupperbarx && capCliprect.contains(x1, y)) batch.bars<<QLineF(x1, y-ebs_px/2.0,x1, y+ebs_px/2.0);
             }
 
             // x-inwardArrow indicators
             if ((xErrorColumn>=0 || xErrorColumnLower>=0) && (xErrorStyle.testFlag(JKQTPErrorIndicatorInwardArrows)))
             {
-                double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); bool x0ok=JKQTPIsOKFloat(x0);
-                double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); bool x1ok=JKQTPIsOKFloat(x1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (x0ok&&xok && plotlowerbarx) painter.drawPolygon(QPolygonF()<<QPointF(x0,y)<<QPointF(x0-ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x0-ebs_px/2.0,y-ebs_px/2.0));
-                if (x1ok&&xok && plotupperbarx) painter.drawPolygon(QPolygonF()<<QPointF(x1,y)<<QPointF(x1+ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x1+ebs_px/2.0,y-ebs_px/2.0));
+                if (x0ok&&xok && plotlowerbarx && capCliprect.contains(x0, y)) batch.arrows<<(QPolygonF()<<QPointF(x0,y)<<QPointF(x0-ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x0-ebs_px/2.0,y-ebs_px/2.0));
+                if (x1ok&&xok && plotupperbarx && capCliprect.contains(x1, y)) batch.arrows<<(QPolygonF()<<QPointF(x1,y)<<QPointF(x1+ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x1+ebs_px/2.0,y-ebs_px/2.0));
             }
 
             // x-arrow indicators
             if ((xErrorColumn>=0 || xErrorColumnLower>=0) && (xErrorStyle.testFlag(JKQTPErrorIndicatorArrows)))
             {
-                double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); bool x0ok=JKQTPIsOKFloat(x0);
-                double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); bool x1ok=JKQTPIsOKFloat(x1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (x0ok&&xok && plotlowerbarx) painter.drawPolygon(QPolygonF()<<QPointF(x0,y)<<QPointF(x0+ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x0+ebs_px/2.0,y-ebs_px/2.0));
-                if (x1ok&&xok && plotupperbarx) painter.drawPolygon(QPolygonF()<<QPointF(x1,y)<<QPointF(x1-ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x1-ebs_px/2.0,y-ebs_px/2.0));
+                if (x0ok&&xok && plotlowerbarx && capCliprect.contains(x0, y)) batch.arrows<<(QPolygonF()<<QPointF(x0,y)<<QPointF(x0+ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x0+ebs_px/2.0,y-ebs_px/2.0));
+                if (x1ok&&xok && plotupperbarx && capCliprect.contains(x1, y)) batch.arrows<<(QPolygonF()<<QPointF(x1,y)<<QPointF(x1-ebs_px/2.0,y+ebs_px/2.0)<<QPointF(x1-ebs_px/2.0,y-ebs_px/2.0));
             }
 
             // y-errorbars
             if ((yErrorColumn>=0 || yErrorColumnLower>=0) && (yErrorStyle.testFlag(JKQTPErrorSimpleBars)))
             {
-                double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); bool y0ok=JKQTPIsOKFloat(y0);
-                double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); bool y1ok=JKQTPIsOKFloat(y1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                QList<QLineF> elines;
                 if (y0ok&&y1ok&&xok&&yok) {
-                    elines<<QLineF(x, y0, x, y1);
+                    addClippedLine(batch.bars, QLineF(x, y0, x, y1));
                 } else if (y0ok&&!y1ok&&xok&&yok) {   // upper errorbar OK, lower errorbar NAN
-                    elines<<QLineF(x, y0, x, y);
-                    if (y0<y) elines<<QLineF(x,y,x,parentGraph->transformY(parent->getYMin()));
-                    else elines<<QLineF(x,y,x,parentGraph->transformY(parent->getYMax())); // inverted axis!
+                    addClippedLine(batch.bars, QLineF(x, y0, x, y));
+                    if (y0<y) addClippedLine(batch.bars, QLineF(x,y,x,parentGraph->transformY(parent->getYMin())));
+                    else addClippedLine(batch.bars, QLineF(x,y,x,parentGraph->transformY(parent->getYMax()))); // inverted axis!
                 } else if (!y0ok&&y1ok&&xok&&yok) {
-                    elines<<QLineF(x, y1, x, y);
-                    if (y1<y) elines<<QLineF(x,y,x,parentGraph->transformY(parent->getYMax()));
-                    else elines<<QLineF(x,y,x,parentGraph->transformY(parent->getYMin()));
-                }
-                for (QLineF& l: elines) {
-                    l=JKQTPClipLine(l, cliprect);
-                    if (l.length()>0) painter.drawLine(l);
+                    addClippedLine(batch.bars, QLineF(x, y1, x, y));
+                    if (y1<y) addClippedLine(batch.bars, QLineF(x,y,x,parentGraph->transformY(parent->getYMax())));
+                    else addClippedLine(batch.bars, QLineF(x,y,x,parentGraph->transformY(parent->getYMin())));
                 }
             }
             // y-bar indicators
             if ((yErrorColumn>=0 || yErrorColumnLower>=0) && (yErrorStyle.testFlag(JKQTPErrorIndicatorBar)))
             {
-                double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); bool y0ok=JKQTPIsOKFloat(y0);
-                double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); bool y1ok=JKQTPIsOKFloat(y1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (y0ok&&xok && plotlowerbary) painter.drawLine(QLineF(x-ebs_px/2.0,y0,x+ebs_px/2.0,y0));
-                if (y1ok&&xok && plotupperbary) painter.drawLine(QLineF(x-ebs_px/2.0,y1,x+ebs_px/2.0,y1));
+                if (y0ok&&xok && plotlowerbary && capCliprect.contains(x, y0)) batch.bars<<QLineF(x-ebs_px/2.0,y0,x+ebs_px/2.0,y0);
+                if (y1ok&&xok && plotupperbary && capCliprect.contains(x, y1)) batch.bars<<QLineF(x-ebs_px/2.0,y1,x+ebs_px/2.0,y1);
             }
 
             // y-inwardArrow indicators
             if ((yErrorColumn>=0 || yErrorColumnLower>=0) && (yErrorStyle.testFlag(JKQTPErrorIndicatorInwardArrows)))
             {
-                double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); bool y0ok=JKQTPIsOKFloat(y0);
-                double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); bool y1ok=JKQTPIsOKFloat(y1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (y0ok&&xok && plotlowerbary) painter.drawPolygon(QPolygonF()<<QPointF(x,y0)<<QPointF(x-ebs_px/2.0,y0+ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y0+ebs_px/2.0));
-                if (y1ok&&xok && plotupperbary) painter.drawPolygon(QPolygonF()<<QPointF(x,y1)<<QPointF(x-ebs_px/2.0,y1-ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y1-ebs_px/2.0));
+                if (y0ok&&xok && plotlowerbary && capCliprect.contains(x, y0)) batch.arrows<<(QPolygonF()<<QPointF(x,y0)<<QPointF(x-ebs_px/2.0,y0+ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y0+ebs_px/2.0));
+                if (y1ok&&xok && plotupperbary && capCliprect.contains(x, y1)) batch.arrows<<(QPolygonF()<<QPointF(x,y1)<<QPointF(x-ebs_px/2.0,y1-ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y1-ebs_px/2.0));
             }
 
             // y-arrow indicators
             if ((yErrorColumn>=0 || yErrorColumnLower>=0) && (yErrorStyle.testFlag(JKQTPErrorIndicatorArrows)))
             {
-                double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); bool y0ok=JKQTPIsOKFloat(y0);
-                double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); bool y1ok=JKQTPIsOKFloat(y1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                painter.setBrush(pp.color());
-                if (y0ok&&xok && plotlowerbary) painter.drawPolygon(QPolygonF()<<QPointF(x,y0)<<QPointF(x-ebs_px/2.0,y0-ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y0-ebs_px/2.0));
-                if (y1ok&&xok && plotupperbary) painter.drawPolygon(QPolygonF()<<QPointF(x,y1)<<QPointF(x-ebs_px/2.0,y1+ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y1+ebs_px/2.0));
+                if (y0ok&&xok && plotlowerbary && capCliprect.contains(x, y0)) batch.arrows<<(QPolygonF()<<QPointF(x,y0)<<QPointF(x-ebs_px/2.0,y0-ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y0-ebs_px/2.0));
+                if (y1ok&&xok && plotupperbary && capCliprect.contains(x, y1)) batch.arrows<<(QPolygonF()<<QPointF(x,y1)<<QPointF(x-ebs_px/2.0,y1+ebs_px/2.0)<<QPointF(x+ebs_px/2.0,y1+ebs_px/2.0));
             }
 
             // error boxes
             if (yErrorStyle.testFlag(JKQTPErrorBoxes) || xErrorStyle.testFlag(JKQTPErrorBoxes) || yErrorStyle.testFlag(JKQTPErrorEllipses) || xErrorStyle.testFlag(JKQTPErrorEllipses) ) {
-                double y0=parentGraph->transformY(yv+yrelshift*deltay-yl); bool y0ok=JKQTPIsOKFloat(y0);
-                double y1=parentGraph->transformY(yv+yrelshift*deltay+ye); bool y1ok=JKQTPIsOKFloat(y1);
-                double x0=parentGraph->transformX(xv+xrelshift*deltax-xl); bool x0ok=JKQTPIsOKFloat(x0);
-                double x1=parentGraph->transformX(xv+xrelshift*deltax+xe); bool x1ok=JKQTPIsOKFloat(x1);
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                QBrush bb=b;
-                if (!defaultErrorColor) bb.setColor(terrFillCol);
-                painter.setBrush(bb);
-
                 const QRectF errRect=QRectF(QPointF(x0,y0), QPointF(x1,y1));
                 if (((y0ok&&y1ok)||(x0ok&&x1ok))&&cliprect.intersects(errRect)) {
-                    if (yErrorStyle.testFlag(JKQTPErrorEllipses) || xErrorStyle.testFlag(JKQTPErrorEllipses)) painter.drawEllipse(errRect);
-                    else painter.drawRect(errRect);
+                    if (yErrorStyle.testFlag(JKQTPErrorEllipses) || xErrorStyle.testFlag(JKQTPErrorEllipses)) batch.ellipses<<errRect;
+                    else batch.boxes<<errRect;
                 }
 
 
             }
             // x-errorlines
             if (pastFirst && (xErrorStyle.testFlag(JKQTPErrorLines))) {
-                double xl1m=xmold;
-                double xl1p=xpold;
-                double yl1=yold;
-                double xl2m=parentGraph->transformX(xv+xrelshift*deltax-xl);
-                double xl2p=parentGraph->transformX(xv+xrelshift*deltax+xe);
-                double yl2=y;
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                if (JKQTPIsOKFloat(xl1m)&&JKQTPIsOKFloat(yl1)&&JKQTPIsOKFloat(xl2m)&&JKQTPIsOKFloat(yl2)) {
-                    const QLineF l=JKQTPClipLine(QLineF(xl1m, yl1, xl2m, yl2),cliprect);
-                    if (l.length()>0) painter.drawLine(l);
+                if (JKQTPIsOKFloat(xmold)&&JKQTPIsOKFloat(yold)&&x0ok&&yok) {
+                    addClippedLine(batch.errorLines, QLineF(xmold, yold, x0, y));
                 }
-                if (JKQTPIsOKFloat(xl1p)&&JKQTPIsOKFloat(yl1)&&JKQTPIsOKFloat(xl2p)&&JKQTPIsOKFloat(yl2)) {
-                    const QLineF l=JKQTPClipLine(QLineF(xl1p, yl1, xl2p, yl2),cliprect);
-                    if (l.length()>0) painter.drawLine(l);
+                if (JKQTPIsOKFloat(xpold)&&JKQTPIsOKFloat(yold)&&x1ok&&yok) {
+                    addClippedLine(batch.errorLines, QLineF(xpold, yold, x1, y));
                 }
 
             }
@@ -603,23 +582,11 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
 
             // y-errorlines
             if (pastFirst && (yErrorStyle.testFlag(JKQTPErrorLines))) {
-                double yl1m=ymold;
-                double yl1p=ypold;
-                double xl1=xold;
-                double yl2m=parentGraph->transformY(yv+yrelshift*deltay-yl);
-                double yl2p=parentGraph->transformY(yv+yrelshift*deltay+ye);
-                double xl2=x;
-                painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
-                QPen pp=p;
-                if (!defaultErrorColor) pp.setColor(terrCol);
-                painter.setPen(pp);
-                if (JKQTPIsOKFloat(xl1)&&JKQTPIsOKFloat(yl1m)&&JKQTPIsOKFloat(xl2)&&JKQTPIsOKFloat(yl2m)) {
-                    const QLineF l=JKQTPClipLine(QLineF(xl1, yl1m, xl2, yl2m),cliprect);
-                    if (l.length()>0) painter.drawLine(l);
+                if (JKQTPIsOKFloat(xold)&&JKQTPIsOKFloat(ymold)&&xok&&y0ok) {
+                    addClippedLine(batch.errorLines, QLineF(xold, ymold, x, y0));
                 }
-                if (JKQTPIsOKFloat(xl1)&&JKQTPIsOKFloat(yl1p)&&JKQTPIsOKFloat(xl2)&&JKQTPIsOKFloat(yl2p)) {
-                    const QLineF l=JKQTPClipLine(QLineF(xl1, yl1p, xl2, yl2p),cliprect);
-                    if (l.length()>0) painter.drawLine(l);
+                if (JKQTPIsOKFloat(xold)&&JKQTPIsOKFloat(ypold)&&xok&&y1ok) {
+                    addClippedLine(batch.errorLines, QLineF(xold, ypold, x, y1));
                 }
 
             }
@@ -628,13 +595,14 @@ void JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators(JKQTPEnhancedPainter& p
 
             pastFirst=true;
             xold=x;
-            xmold=parentGraph->transformX(xv+xrelshift*deltax-xl);
-            xpold=parentGraph->transformX(xv+xrelshift*deltax+xe);
+            xmold=x0;
+            xpold=x1;
             yold=y;
-            ymold=parentGraph->transformY(yv+yrelshift*deltay-yl);
-            ypold=parentGraph->transformY(yv+yrelshift*deltay+ye);
+            ymold=y0;
+            ypold=y1;
         }
     }
+    drawBatch();
     // x-errorpolygons
     if ((polyXTopPoints.size()>0 || polyXBottomPoints.size()>0) && (xErrorStyle.testFlag(JKQTPErrorPolygons))) {
         painter.save(); auto __finalpaint=JKQTPFinally([&painter]() {painter.restore();});
@@ -503,6 +503,19 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPGraphSymbolStyleMixin {
         {
             JKQTPPlotSymbol(painter, x, y,m_symbolType, parent->pt2px(painter, m_symbolSize), parent->pt2px(painter, m_symbolLineWidth*parent->getLineWidthMultiplier()), color, fillColor, getSymbolFont());
         }
+        /*! \brief plot a symbol at every location in \a points (in painter coordinates), using the current style
+
+            This draws the same as calling plotStyledSymbol() for every point, but uses JKQTPPlotSymbols(), so the symbol is set up
+            (or looked up in the sprite cache) only once.
+
+            \param parent parent JKQTBasePlotter of the graph that uses this mix-in (used e.g. for line-width transformation)
+            \param painter the <a href="http://doc.qt.io/qt-5/qpainter.html">QPainter</a> to draw to
+            \param points center positions of the symbols
+         */
+        inline void plotStyledSymbols(JKQTBasePlotter* parent, JKQTPEnhancedPainter& painter, const QVector<QPointF>& points) const
+        {
+            JKQTPPlotSymbols(painter, points, m_symbolType, parent->pt2px(painter, m_symbolSize), parent->pt2px(painter, m_symbolLineWidth*parent->getLineWidthMultiplier()), m_symbolColor, m_symbolFillColor, getSymbolFont());
+        }
         /** \brief returns the symbol linewidth for drawing symbols in a key entry with \a keyRect for the symbol, using \a painter and \a parent  . \a maxSymbolSizeFracton specifies the maximum fraction of \a keyRect to be used for the symbol. */
         double getKeySymbolLineWidthPx(JKQTPEnhancedPainter &painter, const QRectF &keyRect, const JKQTBasePlotter *parent, double maxSymbolSizeFracton=0.9) const;
         /** \brief returns the symbol size for drawing symbols in a key entry with \a keyRect for the symbol, using \a painter and \a parent . \a maxSymbolSizeFracton specifies the maximum fraction of \a keyRect to be used for the symbol. */
@@ -49,7 +49,7 @@ void JKQTPBaseKey::setParent(JKQTBasePlotter* parent) {
 void JKQTPBaseKey::redrawPlot() {
     if (parent)  {
         parent->updateSecondaryAxes();
-        parent->redrawPlot();
+        parent->redrawPlotLayers(JKQTBasePlotter::KeyLayer);
     }
 }
 
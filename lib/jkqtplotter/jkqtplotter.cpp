@@ -65,6 +65,9 @@ JKQTPlotter::JKQTPlotter(bool datastore_internal, QWidget* parent, JKQTPDatastor
     mouseDragRectYStartPixel(0), mouseDragRectYEnd(0),
     mouseDragMarkers(),
     image(), oldImage(),
+    backgroundRendering(false), backgroundRenderThread(), backgroundFrameID(0), backgroundRenderedFrame(), backgroundRenderMilliseconds(0),
+    backgroundRenderPending(false), frameRequestTimer(), backgroundFrameRequestTimer(), pendingMouseMove(), overlayRenderCount(0),
+    redrawTimer(), maxFrameRate(0), lastFrameStartTimer(), pendingRedrawReasons(), pendingRedrawLayers(), backgroundFrameReasons(), renderStatistics(), ingestionTimer(), ingestionMaxFrameRate(0), backgroundRenderDatastore(nullptr),
     menuSpecialContextMenu(nullptr),toolbar(nullptr), masterPlotterX(nullptr), masterPlotterY(nullptr),
     mousePosX(0), mousePosY(0),
     magnification(1),
@@ -81,13 +84,16 @@ JKQTPlotter::JKQTPlotter(bool datastore_internal, QWidget* parent, JKQTPDatastor
 
     setParent(parent);
     connect(&resizeTimer, SIGNAL(timeout()), this, SLOT(delayedResizeEvent()));
+    connect(&ingestionTimer, SIGNAL(timeout()), this, SLOT(ingestionTimerTimeout()));
+    redrawTimer.setSingleShot(true);
+    connect(&redrawTimer, SIGNAL(timeout()), this, SLOT(redrawTimerTimeout()));
 
     plotter=new JKQTBasePlotter(datastore_internal, this, datast);
     plotter->setEmittingSignalsEnabled(false);
     fixBasePlotterSettings();
 
 
-    connect(plotter, SIGNAL(plotUpdated()), this, SLOT(redrawPlot()));
+    connect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
     connect(plotter, SIGNAL(beforePlotScalingRecalculate()), this, SLOT(intBeforePlotScalingRecalculate()));
     connect(plotter, SIGNAL(zoomChangedLocally(double, double, double, double, JKQTBasePlotter*)), this, SLOT(pzoomChangedLocally(double, double, double, double, JKQTBasePlotter*)));
 
@@ -131,6 +137,7 @@ JKQTPlotter::JKQTPlotter(bool datastore_internal, QWidget* parent, JKQTPDatastor
 
 
     toolbar=new JKVanishQToolBar(this);
+    toolbar->installEventFilter(this);
     toolbar->clear();
     toolbar->move(1,1);
     toolbar->hide();
@@ -163,8 +170,11 @@ JKQTPlotter::JKQTPlotter(QWidget *parent):
 }
 
 JKQTPlotter::~JKQTPlotter() {
+    ingestionTimer.stop();
+    redrawTimer.stop();
+    waitForBackgroundRendering(true);
     resetContextMenu(false);
-    disconnect(plotter, SIGNAL(plotUpdated()), this, SLOT(redrawPlot()));
+    disconnect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
     disconnect(plotter, SIGNAL(beforePlotScalingRecalculate()), this, SLOT(intBeforePlotScalingRecalculate()));
     disconnect(plotter, SIGNAL(zoomChangedLocally(double, double, double, double, JKQTBasePlotter*)), this, SLOT(pzoomChangedLocally(double, double, double, double, JKQTBasePlotter*)));
     delete plotter;
@@ -544,6 +554,7 @@ void JKQTPlotter::fillInternalStructForToolTipOfClosestDataPoint(double x0, doub
 
 void JKQTPlotter::paintUserAction() {
     if ((currentMouseDragAction.isValid() && mouseDragingRectangle) || (!currentMouseMoveAction.isEmpty())) {
+        overlayRenderCount++;
         image=oldImage;
         if (image.width()>0 && image.height()>0 && !image.isNull()) {
             JKQTPEnhancedPainter painter(&image);
@@ -776,6 +787,23 @@ void JKQTPlotter::correctZoomRectForPanning(QRectF &zoomRect) const
 
 
 void JKQTPlotter::mouseMoveEvent ( QMouseEvent * event ) {
+    if (backgroundRenderThread.joinable()) {
+        // the plotter is busy drawing in the background: only remember the last mouse position
+        // and replay it, when the frame is finished (see backgroundRenderingFinished() )
+        pendingMouseMove.valid=true;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+        pendingMouseMove.localPos=event->position();
+        pendingMouseMove.globalPos=event->globalPosition();
+#else
+        pendingMouseMove.localPos=event->localPos();
+        pendingMouseMove.globalPos=event->screenPos();
+#endif
+        pendingMouseMove.buttons=event->buttons();
+        pendingMouseMove.modifiers=event->modifiers();
+        event->accept();
+        return;
+    }
+    pendingMouseMove.valid=false;
     if (plotterStyle.displayMousePosition) {
         mousePosX=plotter->p2x(event->pos().x()/magnification);
         mousePosY=plotter->p2y((event->pos().y()-getPlotYOffset())/magnification);
@@ -888,6 +916,7 @@ void JKQTPlotter::mouseMoveEvent ( QMouseEvent * event ) {
 
 
 void JKQTPlotter::mousePressEvent ( QMouseEvent * event ){
+    waitForBackgroundRendering();
     MouseDragAction prevAction = currentMouseDragAction;
     currentMouseDragAction.clear();
     mouseDragMarkers.clear();
@@ -935,6 +964,7 @@ void JKQTPlotter::mousePressEvent ( QMouseEvent * event ){
 }
 
 void JKQTPlotter::mouseReleaseEvent ( QMouseEvent * event ){
+    waitForBackgroundRendering();
     if ((event->flags()&Qt::MouseEventCreatedDoubleClick)==Qt::MouseEventCreatedDoubleClick) {
         return;
     }
@@ -1005,6 +1035,7 @@ void JKQTPlotter::resetCurrentMouseDragAction () {
 }
 
 void JKQTPlotter::mouseDoubleClickEvent ( QMouseEvent * event ){
+    waitForBackgroundRendering();
     bool foundIT=false;
     JKQTPMouseDoubleClickActionsHashMapIterator itAction=findMatchingMouseDoubleClickAction(event->button(), event->modifiers(), &foundIT);
     if (foundIT)  {
@@ -1059,6 +1090,7 @@ void JKQTPlotter::mouseDoubleClickEvent ( QMouseEvent * event ){
 }
 
 void JKQTPlotter::keyReleaseEvent(QKeyEvent *event) {
+    waitForBackgroundRendering();
     QWidget::keyPressEvent(event);
     if (event->key()==Qt::Key_Escape && event->modifiers()==Qt::NoModifier) {
         if (mouseDragingRectangle || currentMouseDragAction.isValid()) {
@@ -1073,6 +1105,7 @@ void JKQTPlotter::keyReleaseEvent(QKeyEvent *event) {
 }
 
 void JKQTPlotter::wheelEvent ( QWheelEvent * event ) {
+    waitForBackgroundRendering();
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
     const double wheel_x=event->position().x();
     const double wheel_y=event->position().y();
@@ -1415,11 +1448,54 @@ void JKQTPlotter::synchronizeXYAxis(double newxmin, double newxmax, double newym
 
 
 void JKQTPlotter::redrawPlot() {
+    requestRedraw(RedrawRequested, JKQTBasePlotter::AllLayers);
+}
+
+void JKQTPlotter::redrawPlotLayers(JKQTBasePlotter::DrawingLayers layers) {
+    requestRedraw(RedrawRequested, layers);
+}
+
+void JKQTPlotter::requestRedraw(RedrawReasons reasons, JKQTBasePlotter::DrawingLayers layers)
+{
+    pendingRedrawLayers|=layers;
+    if (!doDrawing) return;
+    renderStatistics.requestedFrames++;
+    for (int i=0; i<RedrawReasonCount; i++) {
+        if (reasons.testFlag(static_cast<RedrawReason>(1<<i))) renderStatistics.requestsPerReason[i]++;
+    }
+    pendingRedrawReasons|=reasons;
+    if (!frameRequestTimer.isValid()) frameRequestTimer.start();
+    if (maxFrameRate>0) {
+        // coalesce all requests until the next frame is due
+        if (!redrawTimer.isActive()) {
+            const double frameIntervalMS=1000.0/maxFrameRate;
+            const double sinceLastFrameMS=lastFrameStartTimer.isValid()?static_cast<double>(lastFrameStartTimer.nsecsElapsed())/1.0e6:frameIntervalMS;
+            redrawTimer.start(qMax(0, static_cast<int>(ceil(frameIntervalMS-sinceLastFrameMS))));
+        }
+        return;
+    }
+    renderRequestedFrame();
+}
+
+void JKQTPlotter::renderRequestedFrame() {
 #ifdef JKQTBP_AUTOTIMER
-    JKQTPAutoOutputTimer jkaaot(QString("JKQTPlotter::redrawPlot()"));
+    JKQTPAutoOutputTimer jkaaot(QString("JKQTPlotter::renderRequestedFrame()"));
 #endif
+    redrawTimer.stop();
     if (!doDrawing) return;
-    disconnect(plotter, SIGNAL(plotUpdated()), this, SLOT(redrawPlot()));
+    if (!frameRequestTimer.isValid()) frameRequestTimer.start();
+    lastFrameStartTimer.start();
+    if (backgroundRendering) {
+        startBackgroundRendering();
+        return;
+    }
+    const RedrawReasons reasons=pendingRedrawReasons;
+    pendingRedrawReasons=RedrawReasons();
+    applyPendingRedrawLayers();
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    plotter->drainIngestionQueues();
+    disconnect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
     plotter->setWidgetSize(jkqtp_roundTo<int>(width()/magnification), jkqtp_roundTo<int>(height()/magnification-getPlotYOffset()));
     JKQTPEnhancedPainter painter(&image);
     if (painter.isActive()) {
@@ -1430,8 +1506,276 @@ void JKQTPlotter::redrawPlot() {
         //qDebug()<<"drawNonGrid"<<objectName()<<": "<<t.elapsed()<<"ms";
     }
     oldImage=image;
-    connect(plotter, SIGNAL(plotUpdated()), this, SLOT(redrawPlot()));
+    connect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
     update();
+    const double renderMS=static_cast<double>(renderTimer.nsecsElapsed())/1.0e6;
+    recordRenderedFrame(reasons, renderMS);
+    emit plotRendered(static_cast<double>(frameRequestTimer.nsecsElapsed())/1.0e6, renderMS);
+    frameRequestTimer.invalidate();
+}
+
+void JKQTPlotter::recordRenderedFrame(RedrawReasons reasons, double renderMilliseconds)
+{
+    renderStatistics.renderedFrames++;
+    renderStatistics.lastFrameReasons=reasons;
+    renderStatistics.lastRenderMilliseconds=renderMilliseconds;
+    renderStatistics.maxRenderMilliseconds=qMax(renderStatistics.maxRenderMilliseconds, renderMilliseconds);
+    renderStatistics.totalRenderMilliseconds+=renderMilliseconds;
+    int bin=0;
+    while (bin<RenderTimeHistogramBins-1 && renderMilliseconds>=RenderStatistics::renderTimeHistogramBinLimit(bin)) bin++;
+    renderStatistics.renderTimeHistogram[bin]++;
+}
+
+void JKQTPlotter::redrawTimerTimeout()
+{
+    renderRequestedFrame();
+}
+
+void JKQTPlotter::plotterLayersUpdated(JKQTBasePlotter::DrawingLayers layers)
+{
+    requestRedraw(RedrawPropertiesChanged, layers);
+}
+
+JKQTPlotter::RenderStatistics::RenderStatistics():
+    requestedFrames(0), renderedFrames(0), abortedFrames(0), lastFrameReasons(), lastRenderMilliseconds(0), maxRenderMilliseconds(0), totalRenderMilliseconds(0)
+{
+    for (auto& cnt: requestsPerReason) cnt=0;
+    for (auto& cnt: renderTimeHistogram) cnt=0;
+}
+
+double JKQTPlotter::RenderStatistics::renderTimeHistogramBinLimit(int bin)
+{
+    if (bin>=RenderTimeHistogramBins-1) return std::numeric_limits<double>::infinity();
+    return static_cast<double>(1<<bin);
+}
+
+void JKQTPlotter::setMaxFrameRate(double framesPerSecond)
+{
+    maxFrameRate=qMax(0.0, framesPerSecond);
+    if (maxFrameRate<=0 && redrawTimer.isActive()) {
+        // render the pending frame now, as there is no limit any more
+        renderRequestedFrame();
+    }
+}
+
+double JKQTPlotter::getMaxFrameRate() const
+{
+    return maxFrameRate;
+}
+
+bool JKQTPlotter::isRedrawPending() const
+{
+    return redrawTimer.isActive();
+}
+
+JKQTPlotter::RedrawReasons JKQTPlotter::getPendingRedrawReasons() const
+{
+    return pendingRedrawReasons;
+}
+
+JKQTBasePlotter::DrawingLayers JKQTPlotter::getPendingRedrawLayers() const
+{
+    return pendingRedrawLayers;
+}
+
+void JKQTPlotter::applyPendingRedrawLayers()
+{
+    plotter->invalidateLayers(pendingRedrawLayers);
+    pendingRedrawLayers=JKQTBasePlotter::DrawingLayers();
+}
+
+const JKQTPlotter::RenderStatistics &JKQTPlotter::getRenderStatistics() const
+{
+    return renderStatistics;
+}
+
+void JKQTPlotter::resetRenderStatistics()
+{
+    renderStatistics=RenderStatistics();
+}
+
+bool JKQTPlotter::isBackgroundRendering() const
+{
+    return backgroundRendering;
+}
+
+void JKQTPlotter::setBackgroundRendering(bool enabled)
+{
+    if (backgroundRendering==enabled) return;
+    if (!enabled) {
+        waitForBackgroundRendering(false);
+        backgroundRendering=false;
+        if (backgroundRenderPending) {
+            backgroundRenderPending=false;
+            renderRequestedFrame();
+        }
+    } else {
+        backgroundRendering=true;
+    }
+}
+
+bool JKQTPlotter::isBackgroundRenderingRunning() const
+{
+    return backgroundRenderThread.joinable();
+}
+
+quint64 JKQTPlotter::getOverlayRenderCount() const
+{
+    return overlayRenderCount;
+}
+
+void JKQTPlotter::setIngestionMaxFrameRate(double framesPerSecond)
+{
+    ingestionMaxFrameRate=qMax(0.0, framesPerSecond);
+    if (ingestionMaxFrameRate>0) {
+        ingestionTimer.start(qMax(1, jkqtp_roundTo<int>(1000.0/ingestionMaxFrameRate)));
+    } else {
+        ingestionTimer.stop();
+    }
+}
+
+double JKQTPlotter::getIngestionMaxFrameRate() const
+{
+    return ingestionMaxFrameRate;
+}
+
+void JKQTPlotter::ingestionTimerTimeout()
+{
+    // a running background frame is finished first, the data is drained with the next frame
+    if (!doDrawing || backgroundRenderThread.joinable() || !plotter->getDatastore()->hasPendingIngestion()) return;
+    requestRedraw(RedrawDataChanged, JKQTBasePlotter::DrawingLayers());
+}
+
+void JKQTPlotter::waitForBackgroundRendering(bool abort)
+{
+    if (!backgroundRenderThread.joinable()) return;
+    if (abort) plotter->abortDrawing();
+    backgroundRenderThread.join();
+    if (backgroundRenderDatastore) {
+        backgroundRenderDatastore->removeModificationGuard(this);
+        backgroundRenderDatastore=nullptr;
+    }
+    if (!plotter->isDrawingAborted() && !backgroundRenderedFrame.isNull()) {
+        image=InternalBufferImageType::fromImage(backgroundRenderedFrame);
+        oldImage=image;
+        update();
+        recordRenderedFrame(backgroundFrameReasons, backgroundRenderMilliseconds);
+        emit plotRendered(static_cast<double>(backgroundFrameRequestTimer.nsecsElapsed())/1.0e6, backgroundRenderMilliseconds);
+    } else {
+        // the frame was aborted, so the request has to be rendered again
+        renderStatistics.abortedFrames++;
+        pendingRedrawReasons|=backgroundFrameReasons;
+        backgroundRenderPending=true;
+        if (!frameRequestTimer.isValid()) frameRequestTimer=backgroundFrameRequestTimer;
+    }
+    backgroundRenderedFrame=QImage();
+    plotter->abortDrawing(false);
+}
+
+void JKQTPlotter::startBackgroundRendering()
+{
+    if (backgroundRenderThread.joinable()) {
+        // the frame that is currently rendered is outdated: abort it and render a new one, when the thread returns
+        backgroundRenderPending=true;
+        plotter->abortDrawing();
+        return;
+    }
+    backgroundRenderPending=false;
+    backgroundFrameReasons=pendingRedrawReasons;
+    pendingRedrawReasons=RedrawReasons();
+    applyPendingRedrawLayers();
+    // the state of the plotter (widget size, ...) is prepared in the GUI thread, the worker only draws
+    plotter->drainIngestionQueues();
+    disconnect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
+    plotter->setWidgetSize(jkqtp_roundTo<int>(width()/magnification), jkqtp_roundTo<int>(height()/magnification-getPlotYOffset()));
+    connect(plotter, SIGNAL(plotLayersUpdated(JKQTBasePlotter::DrawingLayers)), this, SLOT(plotterLayersUpdated(JKQTBasePlotter::DrawingLayers)));
+    plotter->abortDrawing(false);
+    float scale=1.0;
+    QImage frame(getImageBufferSize(&scale), QImage::Format_ARGB32_Premultiplied);
+    frame.setDevicePixelRatio(scale);
+    frame.fill(Qt::transparent);
+    const double mag=magnification;
+    {
+        // the layout writes the borders and axis scaling, which are also read in the GUI thread (paintEvent(), mouse actions),
+        // and emits the signals of the plotter, so it is done here and the worker only reads the plotter
+        JKQTPEnhancedPainter painter(&frame);
+        if (painter.isActive()) {
+            painter.scale(mag, mag);
+            plotter->prepareDrawNonGrid(painter);
+        }
+    }
+    // a slot, connected to the signals emitted by the layout, may already have started a newer frame
+    if (backgroundRenderThread.joinable()) return;
+    // from now on, every modification of the datastore aborts the frame
+    backgroundRenderForeignModificationReported=false;
+    backgroundRenderDatastore=plotter->getDatastore();
+    backgroundRenderDatastore->setModificationGuard(this, [this]() { backgroundRenderingModificationGuard(); });
+    backgroundFrameRequestTimer=frameRequestTimer;
+    frameRequestTimer.invalidate();
+    backgroundFrameID++;
+    const quint64 frameID=backgroundFrameID;
+    backgroundRenderThread=std::thread([this, frame, frameID, mag]() mutable {
+        QElapsedTimer renderTimer;
+        renderTimer.start();
+        {
+            JKQTPEnhancedPainter painter(&frame);
+            if (painter.isActive()) {
+                painter.scale(mag, mag);
+                plotter->drawNonGrid(painter, QPoint(0,0), false);
+            }
+        }
+        backgroundRenderMilliseconds=static_cast<double>(renderTimer.nsecsElapsed())/1.0e6;
+        backgroundRenderedFrame=frame;
+        QMetaObject::invokeMethod(this, "backgroundRenderingFinished", Qt::QueuedConnection, Q_ARG(quint64, frameID));
+    });
+}
+
+void JKQTPlotter::backgroundRenderingModificationGuard()
+{
+    if (QThread::currentThread()!=thread()) {
+        // the datastore is not thread-safe, so other threads have to use an ingestion queue
+        if (!backgroundRenderForeignModificationReported.exchange(true)) {
+            qWarning()<<"JKQTPlotter: the datastore was modified from another thread, while the plot was drawn in the background. Use JKQTPDatastore::addIngestionQueue() to pass data from other threads!";
+        }
+        return;
+    }
+    // never wait for the worker here: waitForBackgroundRendering() finds the frame aborted and marks it as pending,
+    // so backgroundRenderingFinished() renders the new state
+    plotter->abortDrawing();
+}
+
+void JKQTPlotter::backgroundRenderingFinished(quint64 frameID)
+{
+    // the frame may already have been collected by waitForBackgroundRendering() and a new frame may have been started
+    if (frameID==backgroundFrameID) waitForBackgroundRendering(false);
+    if (backgroundRenderThread.joinable()) return;
+    if (backgroundRenderPending && doDrawing) {
+        // the layers, that changed in the meantime, are still pending and invalidated, when the frame is started
+        renderRequestedFrame();
+    } else if (pendingMouseMove.valid) {
+        pendingMouseMove.valid=false;
+        QMouseEvent event(QEvent::MouseMove, pendingMouseMove.localPos, pendingMouseMove.globalPos, Qt::NoButton, pendingMouseMove.buttons, pendingMouseMove.modifiers);
+        mouseMoveEvent(&event);
+    }
+}
+
+bool JKQTPlotter::eventFilter(QObject *watched, QEvent *event)
+{
+    if (backgroundRenderThread.joinable()) {
+        switch(event->type()) {
+            case QEvent::MouseButtonPress:
+            case QEvent::MouseButtonRelease:
+            case QEvent::MouseButtonDblClick:
+            case QEvent::KeyPress:
+            case QEvent::KeyRelease:
+            case QEvent::Show:
+                waitForBackgroundRendering(true);
+                break;
+            default:
+                break;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
 }
 
 
@@ -1504,7 +1848,7 @@ void JKQTPlotter::delayedResizeEvent()
     if (getImageBufferSize() != image.size()) {
         image=createImageBuffer();
         emit widgetResized(width(), height(), this);
-        redrawPlot();
+        requestRedraw(RedrawResized, JKQTBasePlotter::AllLayers);
     }
 }
 
@@ -1583,7 +1927,7 @@ void JKQTPlotter::resetMasterSynchronization(JKQTBasePlotter::SynchronizationDir
 
 void JKQTPlotter::masterPlotScalingRecalculated() {
     //qDebug()<<"this="<<this<<", sender="<<sender()<<" --> masterPlotScalingRecalculated()";
-    redrawPlot();
+    requestRedraw(RedrawZoomChanged, JKQTBasePlotter::AllLayers);
 }
 
 void JKQTPlotter::setGridPrinting(bool enabled)
@@ -1621,6 +1965,11 @@ bool JKQTPlotter::isPlotUpdateEnabled() const {
 }
 
 void JKQTPlotter::pzoomChangedLocally(double newxmin, double newxmax, double newymin, double newymax, JKQTBasePlotter* /*sender*/) {
+    // the plotter requests the redraw itself (before or after this signal), so only the reason is recorded:
+    // either for the frame that is pending, or for the frame that was just rendered
+    if (redrawTimer.isActive() || backgroundRenderThread.joinable() || pendingRedrawReasons!=RedrawReasons()) pendingRedrawReasons|=RedrawZoomChanged;
+    else renderStatistics.lastFrameReasons|=RedrawZoomChanged;
+    renderStatistics.requestsPerReason[qCountTrailingZeroBits(static_cast<quint32>(RedrawZoomChanged))]++;
     emit zoomChangedLocally(newxmin, newxmax, newymin, newymax, this);
     minSize=QSizeF(plotter->getInternalPlotBorderLeft()+plotter->getInternalPlotBorderRight()+10, plotter->getInternalPlotBorderTop()+plotter->getInternalPlotBorderBottom()+10).toSize();
 }
@@ -1890,6 +2239,7 @@ void JKQTPlotter::openStandardContextMenu(int x, int y)
     mouseContextX=plotter->p2x(x/magnification);
     mouseContextY=plotter->p2y((y-getPlotYOffset())/magnification);
     initContextMenu();
+    contextMenu->installEventFilter(this);
     contextMenu->popup(mapToGlobal(QPoint(x,y)));
     //qDebug()<<" -> "<<mapToGlobal(QPoint(x,y))<<contextMenu->size()<<contextMenu->pos()<<contextMenu->parent();
     emit contextMenuOpened(mouseContextX, mouseContextY, contextMenu);
@@ -1910,6 +2260,7 @@ void JKQTPlotter::openSpecialContextMenu(int x, int y)
         mouseContextX=plotter->p2x(x/magnification);
         mouseContextY=plotter->p2y((y-getPlotYOffset())/magnification);
         menuSpecialContextMenu->close();
+        menuSpecialContextMenu->installEventFilter(this);
         menuSpecialContextMenu->popup(mapToGlobal(QPoint(x,y)));
         menuSpecialContextMenu->resize(menuSpecialContextMenu->sizeHint());
         //qDebug()<<" -> "<<mapToGlobal(QPoint(x,y))<<menuSpecialContextMenu->size()<<menuSpecialContextMenu->pos()<<menuSpecialContextMenu->parent();
@@ -1937,6 +2288,7 @@ void JKQTPlotter::openStandardAndSpecialContextMenu(int x, int y)
         }
     }
 
+    contextMenu->installEventFilter(this);
     contextMenu->popup(mapToGlobal(QPoint(x,y)));
     //qDebug()<<" -> "<<mapToGlobal(QPoint(x,y))<<contextMenu->size()<<contextMenu->pos()<<contextMenu->parent();
     emit contextMenuOpened(mouseContextX, mouseContextY, contextMenu);
@@ -2008,6 +2360,8 @@ JKQTPMouseMoveActionsHashMapIterator JKQTPlotter::findMatchingMouseMoveAction(Qt
 
 void JKQTPlotter::setPlotUpdateEnabled(bool enable)
 {
+    // the worker thread must not draw, while the plot is modified, and its frame is outdated afterwards
+    if (!enable) waitForBackgroundRendering(true);
     doDrawing=enable;
     plotter->setEmittingSignalsEnabled(enable);
     //qDebug()<<objectName()<<"  doDrawing="<<doDrawing;
@@ -41,6 +41,8 @@
 #include <cmath>
 #include <iostream>
 #include <atomic>
+#include <thread>
+#include <QElapsedTimer>
 
 #include "jkqtplotter/jkqtpbaseplotter.h"
 #include "jkqtplotter/jkqtplotterstyle.h"
@@ -646,6 +648,9 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
          */
         bool isPlotUpdateEnabled() const;
         /** \brief sets whether automatic redrawing the plot is currently activated (e.g. you can sett his to \c false while performing major updates on the plot)
+         *
+         * Deactivating aborts a frame that is rendered in the background (see setBackgroundRendering() ) and waits for the worker,
+         * so the plot can be modified afterwards.
          *
          * \see JKQTPlotterUpdateGuard for a guard class coupling calls to setPlotUpdateEnabled() and redrawPlot() with the lifetime of a code block.
          *      See \ref jkqtplotter_general_usage_speedplotsetup for a detailed description.
@@ -653,6 +658,149 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
          */
         void setPlotUpdateEnabled(bool enable);
 
+        /** \brief reasons for redrawing the plot, see requestRedraw() and RenderStatistics */
+        enum RedrawReason {
+            RedrawRequested = 0x01, /*!< \brief redrawPlot() or redrawPlotLayers() was called */
+            RedrawDataChanged = 0x02, /*!< \brief the data changed (e.g. new frames in the ingestion queues, see setIngestionMaxFrameRate() ) */
+            RedrawPropertiesChanged = 0x04, /*!< \brief a property of the plot or a graph changed (signalled by JKQTBasePlotter::plotLayersUpdated() ) */
+            RedrawZoomChanged = 0x08, /*!< \brief the visible range of the axes changed (zooming, panning, synchronized plots) */
+            RedrawResized = 0x10, /*!< \brief the widget was resized */
+        };
+        Q_DECLARE_FLAGS(RedrawReasons, RedrawReason)
+        /** \brief number of entries in RedrawReason */
+        static constexpr int RedrawReasonCount=5;
+        /** \brief number of bins in RenderStatistics::renderTimeHistogram */
+        static constexpr int RenderTimeHistogramBins=10;
+
+        /** \brief statistics about the requested and rendered frames of a JKQTPlotter, see getRenderStatistics() */
+        struct JKQTPLOTTER_LIB_EXPORT RenderStatistics {
+            RenderStatistics();
+            /** \brief number of redraw requests (requestRedraw(), redrawPlot(), ...) */
+            quint64 requestedFrames;
+            /** \brief number of frames that were rendered and displayed */
+            quint64 renderedFrames;
+            /** \brief number of frames that were aborted, because they were outdated before they were finished (see setBackgroundRendering() ) */
+            quint64 abortedFrames;
+            /** \brief number of redraw requests per RedrawReason, \c requestsPerReason[i] counts the reason \c 1<<i */
+            quint64 requestsPerReason[RedrawReasonCount];
+            /** \brief the reasons for the last rendered frame */
+            RedrawReasons lastFrameReasons;
+            /** \brief time needed to render the last frame in milliseconds */
+            double lastRenderMilliseconds;
+            /** \brief maximum time needed to render a frame in milliseconds */
+            double maxRenderMilliseconds;
+            /** \brief sum of the times needed to render all frames in milliseconds */
+            double totalRenderMilliseconds;
+            /** \brief histogram of the render times: bin \c i counts the frames that took less than renderTimeHistogramBinLimit(i) milliseconds
+             *         (and not less than the limit of bin \c i-1 ), the last bin counts all slower frames */
+            quint64 renderTimeHistogram[RenderTimeHistogramBins];
+            /** \brief number of redraw requests that were coalesced with other requests, i.e. that did not need a frame of their own */
+            inline quint64 coalescedRequests() const { return (requestedFrames>renderedFrames+abortedFrames)?(requestedFrames-renderedFrames-abortedFrames):0; }
+            /** \brief average time needed to render a frame in milliseconds */
+            inline double averageRenderMilliseconds() const { return (renderedFrames>0)?(totalRenderMilliseconds/static_cast<double>(renderedFrames)):0.0; }
+            /** \brief upper limit (in milliseconds) of the bin \a bin in renderTimeHistogram, i.e. 1, 2, 4, ..., 256ms and infinity for the last bin */
+            static double renderTimeHistogramBinLimit(int bin);
+        };
+
+        /** \brief requests a redraw of the plot for the given \a reasons , after the given \a layers changed
+         *
+         *  If setMaxFrameRate() is \c 0 (default), the plot is redrawn immediately (like redrawPlotLayers() ). Otherwise all requests
+         *  are coalesced and the plot is redrawn (once) from the event loop, at most with the frame rate set by setMaxFrameRate() .
+         *  This is the preferred way to trigger redraws from slots that are called at a high rate (e.g. whenever new data arrives).
+         *  The \a layers of all coalesced requests are collected and invalidated in the layer cache of the plotter, when the frame is started.
+         *
+         *  \see setMaxFrameRate(), getRenderStatistics(), redrawPlot(), redrawPlotLayers()
+         */
+        void requestRedraw(RedrawReasons reasons=RedrawDataChanged, JKQTBasePlotter::DrawingLayers layers=JKQTBasePlotter::AllLayers);
+        /** \brief sets the maximum frame rate (frames per second) at which the plot is redrawn. \c 0 (default) deactivates the frame rate limit
+         *
+         *  If a limit is set, all requests to redraw the plot (redrawPlot(), redrawPlotLayers(), requestRedraw(), changes of the plot
+         *  properties, zooming, ...) only mark the plot as dirty and the plot is redrawn (once) from the event loop, when
+         *  at least \c 1/framesPerSecond seconds passed since the last frame. A value around the refresh rate of the screen (e.g. \c 60 )
+         *  ensures that the GUI stays responsive, even if redraws are requested much more often.
+         *
+         *  \see getMaxFrameRate(), requestRedraw(), getRenderStatistics(), isRedrawPending()
+         */
+        void setMaxFrameRate(double framesPerSecond);
+        /** \brief returns the maximum frame rate (frames per second) at which the plot is redrawn (\c 0: no limit) \see setMaxFrameRate() */
+        double getMaxFrameRate() const;
+        /** \brief returns \c true, if a redraw was requested (see setMaxFrameRate() ), that was not yet started */
+        bool isRedrawPending() const;
+        /** \brief returns the reasons of the redraw requests since the last frame was started \see requestRedraw() */
+        RedrawReasons getPendingRedrawReasons() const;
+        /** \brief returns the layers that were marked as changed by the redraw requests since the last frame was started \see requestRedraw() */
+        JKQTBasePlotter::DrawingLayers getPendingRedrawLayers() const;
+        /** \brief returns statistics about the requested and rendered frames \see resetRenderStatistics(), setMaxFrameRate() */
+        const RenderStatistics& getRenderStatistics() const;
+        /** \brief resets the statistics, returned by getRenderStatistics() */
+        void resetRenderStatistics();
+
+        /** \brief returns, whether the plot is rendered in a background thread
+         *
+         * \see setBackgroundRendering()
+         */
+        bool isBackgroundRendering() const;
+        /** \brief activates/deactivates rendering the plot in a background thread (default: \c false )
+         *
+         * By default redrawPlot() renders the plot synchronously in the GUI thread, which blocks the user interface for plots
+         * that take long to draw. If background rendering is activated, redrawPlot() returns immediately and the plot is rendered into a
+         * QImage by a worker thread. The widget keeps displaying the last complete frame until the new frame is ready. If redrawPlot() is called
+         * again while a frame is rendered, this (outdated) frame is aborted (see JKQTBasePlotter::abortDrawing() ) and a new frame is
+         * rendered, as soon as the worker returns, i.e. redraw requests never wait for the worker. The graphs check for the abort in their
+         * loops over the data, so an outdated frame returns quickly. Mouse movements during rendering are processed, when the frame is finished.
+         * The signal plotRendered() reports the latency of every frame.
+         *
+         * The layout of the plot (borders, key size, axis scaling, see JKQTBasePlotter::prepareDrawNonGrid() ) is calculated in the GUI thread,
+         * before the frame is started, so the signals of the plotter are emitted in the GUI thread. The worker draws the plotter itself (not a copy),
+         * so the following thread contract applies, while a frame is rendered (see isBackgroundRenderingRunning() ):
+         *   - The plotter, its axes, its key, its graphs and the datastore must not be modified. Modify them in the GUI thread inside a
+         *     JKQTPlotterUpdateGuard (or after waitForBackgroundRendering() and followed by redrawPlot() ). Both abort the running frame first.
+         *     JKQTPlotter does this for its own user interactions (mouse, keys, toolbar, context menu) and for the functions that draw the plot
+         *     in the GUI thread (grabPixelImage(), saveImage(), print(), ...).
+         *   - The worker writes the render state of the plotter (layer cache, strip-chart state, see JKQTBasePlotter::prepareDrawNonGrid() )
+         *     and of the graphs, so the GUI thread must not draw the plotter directly (e.g. via getPlotter() ) at the same time.
+         *   - Other threads must never modify the datastore directly, but pass their data through an ingestion queue (see JKQTPDatastore::addIngestionQueue() ).
+         *     Modifications of the datastore during a frame are detected (see JKQTPDatastore::setModificationGuard() ): in the GUI thread, they abort the
+         *     frame (without waiting for it), so its outdated result is never displayed, modifications from other threads are rejected with a warning.
+         *
+         * \see isBackgroundRendering(), waitForBackgroundRendering(), isBackgroundRenderingRunning(), plotRendered()
+         */
+        void setBackgroundRendering(bool enabled);
+        /** \brief returns \c true, while a frame is rendered in the background
+         *
+         * \see setBackgroundRendering()
+         */
+        bool isBackgroundRenderingRunning() const;
+        /** \brief waits until a frame that is currently rendered in the background is finished. If \a abort \c ==true, the frame is aborted
+         *         (and discarded), otherwise it is displayed.
+         *
+         * Afterwards, the plot can be modified safely from the GUI thread.
+         *
+         * \see setBackgroundRendering()
+         */
+        void waitForBackgroundRendering(bool abort=true);
+        /** \brief returns how often the overlays of user actions (zoom rectangle, ruler, tooltips, ...) were drawn. These are drawn onto a copy of the last plot,
+         *         so this does not require drawing the plot.
+         *
+         *  \see JKQTBasePlotter::getLayerRenderCount()
+         */
+        quint64 getOverlayRenderCount() const;
+        /** \brief sets the maximum rate (in frames per second), at which the plot is redrawn automatically, when the ingestion queues of the datastore
+         *         contain new data (see JKQTPDatastore::addIngestionQueue() ). \c 0 (default) deactivates the automatic redrawing.
+         *
+         *  Independent of this setting, the ingestion queues are drained at the start of every redraw. If a frame is still rendered in the
+         *  background (see setBackgroundRendering() ), it is finished first, i.e. new data never aborts a frame.
+         *
+         *  \see getIngestionMaxFrameRate(), JKQTPDatastore::addIngestionQueue()
+         */
+        void setIngestionMaxFrameRate(double framesPerSecond);
+        /** \brief returns the maximum rate (in frames per second), at which the plot is redrawn automatically, when the ingestion queues
+         *         of the datastore contain new data (\c 0: deactivated)
+         *
+         *  \see setIngestionMaxFrameRate()
+         */
+        double getIngestionMaxFrameRate() const;
+
         /** \brief registeres a certain mouse drag action \a action to be executed when a mouse drag operation is
          *         initialized with the given \a button and \a modifier */
         void registerMouseDragAction(Qt::MouseButton button, Qt::KeyboardModifiers modifier, JKQTPMouseDragActions action);
@@ -921,10 +1069,12 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
 
         /** \copydoc JKQTBasePlotter::grabPixelImage()   */
         inline QImage grabPixelImage(QSize size=QSize(), bool showPreview=false) {
+            waitForBackgroundRendering(false);
             return plotter->grabPixelImage(size,showPreview);
         }
         /** \copydoc JKQTBasePlotter::copyPixelImage()   */
         inline void copyPixelImage(bool showPreview=true) {
+            waitForBackgroundRendering(false);
             plotter->copyPixelImage(showPreview);
         }
 
@@ -993,19 +1143,21 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
 
         /** \copydoc JKQTBasePlotter::saveImage() */
         inline bool saveImage(const QString& filename=QString(""), bool displayPreview=true) {
+            waitForBackgroundRendering(false);
             return plotter->saveImage(filename, displayPreview);
         }
 
         /** \copydoc JKQTBasePlotter::saveAsPixelImage() */
         inline bool saveAsPixelImage(const QString& filename=QString(""), bool displayPreview=true, const QByteArray &outputFormat=QByteArray(), const QSize& outputSizeIncrease=QSize(0,0)) {
+            waitForBackgroundRendering(false);
             return plotter->saveAsPixelImage(filename, displayPreview, outputFormat, outputSizeIncrease);
         }
 
 #ifndef JKQTPLOTTER_COMPILE_WITHOUT_PRINTSUPPORT
         /** \copydoc JKQTBasePlotter::saveAsSVG() */
-        inline bool saveAsSVG(const QString& filename=QString(""), bool displayPreview=true) { return plotter->saveAsSVG(filename, displayPreview); }
+        inline bool saveAsSVG(const QString& filename=QString(""), bool displayPreview=true) { waitForBackgroundRendering(false); return plotter->saveAsSVG(filename, displayPreview); }
         /** \copydoc JKQTBasePlotter::saveAsPDF() */
-        inline bool saveAsPDF(const QString& filename=QString(""), bool displayPreview=true) { return plotter->saveAsPDF(filename, displayPreview); }
+        inline bool saveAsPDF(const QString& filename=QString(""), bool displayPreview=true) { waitForBackgroundRendering(false); return plotter->saveAsPDF(filename, displayPreview); }
 #endif
 
         /** \copydoc JKQTBasePlotter::saveAsCSV() */
@@ -1032,6 +1184,7 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
 #ifndef JKQTPLOTTER_COMPILE_WITHOUT_PRINTSUPPORT
         /** \copydoc JKQTBasePlotter::print() */
         inline void print(QPrinter* printer=nullptr) {
+            waitForBackgroundRendering(false);
             plotter->print(printer);
         }
 #endif
@@ -1057,8 +1210,19 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
         /** \copydoc JKQTBasePlotter::zoomOut() */
         inline void zoomOut(double factor=2.0) { plotter->zoomOut(factor); }
 
-        /** \brief update the plot and the overlays */
+        /** \brief update the plot and the overlays
+         *
+         *  \see requestRedraw(), setMaxFrameRate()
+         */
         void redrawPlot();
+        /** \brief update the plot, after only the given \a layers changed (e.g. JKQTBasePlotter::GraphsLayer after the data or the highlighting of a graph changed)
+         *
+         *  If layer caching is activated (see JKQTBasePlotter::setLayerCaching() ), all other layers are taken from the cache, otherwise this
+         *  is the same as redrawPlot().
+         *
+         *  \see requestRedraw(), setMaxFrameRate()
+         */
+        void redrawPlotLayers(JKQTBasePlotter::DrawingLayers layers);
 
         /** \brief allows to activate/deactivate toolbar buttons that can activate certain mouse drag actions
          *
@@ -1284,6 +1448,15 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
          */
         void widgetResized(int new_width, int new_height, JKQTPlotter* sender);
 
+        /** \brief emitted whenever a new frame of the plot is displayed
+         *
+         * \param latencyMilliseconds time between the (first) redrawPlot() request shown in this frame and its display (in milliseconds)
+         * \param renderMilliseconds time needed to render the frame (in milliseconds)
+         *
+         * \see setBackgroundRendering()
+         */
+        void plotRendered(double latencyMilliseconds, double renderMilliseconds);
+
         /** \brief emitted when the mouse action JKQTPlotter::ScribbleEvents and a click event from the mouse occurs inside the plot,
          *         or the mouse moved while the left button is pressed down
          *
@@ -1497,6 +1670,79 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
          */
         QSize getImageBufferSize(float* scale_out=nullptr) const;
 
+        /** \brief if \c true, redrawPlot() renders the plot in a background thread \see setBackgroundRendering() */
+        bool backgroundRendering;
+        /** \brief thread that renders the current frame in background rendering mode (not joinable, if no frame is rendered) */
+        std::thread backgroundRenderThread;
+        /** \brief ID of the frame rendered by backgroundRenderThread */
+        quint64 backgroundFrameID;
+        /** \brief frame rendered by backgroundRenderThread, the GUI thread accesses this only after joining backgroundRenderThread */
+        QImage backgroundRenderedFrame;
+        /** \brief time needed to render backgroundRenderedFrame in milliseconds (written by backgroundRenderThread) */
+        double backgroundRenderMilliseconds;
+        /** \brief set, if redrawPlot() was called while a frame was rendered, i.e. a new frame has to be rendered afterwards */
+        bool backgroundRenderPending;
+        /** \brief measures the time since the oldest redrawPlot() request, which was not yet rendered (invalid if there is none) */
+        QElapsedTimer frameRequestTimer;
+        /** \brief measures the time since the oldest redrawPlot() request, which is rendered in backgroundRenderThread */
+        QElapsedTimer backgroundFrameRequestTimer;
+        /** \brief a mouse move, that occured while a frame was rendered in the background */
+        struct PendingMouseMove {
+            inline PendingMouseMove(): valid(false), localPos(), globalPos(), buttons(Qt::NoButton), modifiers(Qt::NoModifier) {}
+            /** \brief indicates whether a mouse move is stored */
+            bool valid;
+            /** \brief position of the mouse in the widget */
+            QPointF localPos;
+            /** \brief position of the mouse on the screen */
+            QPointF globalPos;
+            /** \brief pressed mouse buttons */
+            Qt::MouseButtons buttons;
+            /** \brief pressed keyboard modifiers */
+            Qt::KeyboardModifiers modifiers;
+        };
+        /** \brief the last mouse move, that occured while a frame was rendered in the background, it is processed when the frame is finished */
+        PendingMouseMove pendingMouseMove;
+        /** \brief counts the calls of paintUserAction(), that drew an overlay \see getOverlayRenderCount() */
+        quint64 overlayRenderCount;
+        /** \brief single-shot timer, that starts the next frame, if the frame rate is limited \see setMaxFrameRate() */
+        QTimer redrawTimer;
+        /** \brief maximum frame rate \see setMaxFrameRate() */
+        double maxFrameRate;
+        /** \brief measures the time since the last frame was started (invalid if there was none) \see setMaxFrameRate() */
+        QElapsedTimer lastFrameStartTimer;
+        /** \brief reasons of the redraw requests since the last frame was started \see requestRedraw() */
+        RedrawReasons pendingRedrawReasons;
+        /** \brief layers that were marked as changed by the redraw requests since the last frame was started \see requestRedraw() */
+        JKQTBasePlotter::DrawingLayers pendingRedrawLayers;
+        /** \brief reasons of the frame, that is rendered in backgroundRenderThread */
+        RedrawReasons backgroundFrameReasons;
+        /** \brief statistics about the requested and rendered frames \see getRenderStatistics() */
+        RenderStatistics renderStatistics;
+        /** \brief renders the requested frame (synchronously or in the background), called by requestRedraw() or redrawTimer */
+        void renderRequestedFrame();
+        /** \brief invalidates the pendingRedrawLayers in the layer cache of the plotter and clears them, called when a frame is started */
+        void applyPendingRedrawLayers();
+        /** \brief adds a rendered frame, with the \a reasons that required it, to renderStatistics */
+        void recordRenderedFrame(RedrawReasons reasons, double renderMilliseconds);
+        /** \brief timer that checks the ingestion queues of the datastore for new data \see setIngestionMaxFrameRate() */
+        QTimer ingestionTimer;
+        /** \brief maximum rate of redraws, triggered by new data in the ingestion queues \see setIngestionMaxFrameRate() */
+        double ingestionMaxFrameRate;
+        /** \brief starts rendering a frame in backgroundRenderThread, or aborts the current frame and marks that a new frame is required */
+        void startBackgroundRendering();
+        /** \brief the datastore, on which backgroundRenderingModificationGuard() is registered, while backgroundRenderThread runs */
+        JKQTPDatastore* backgroundRenderDatastore;
+        /** \brief called before the datastore is modified, while backgroundRenderThread runs: aborts the frame (without waiting for it), if called
+         *         from the GUI thread, and rejects the modification with a warning, if called from another thread
+         *
+         *  \see JKQTPDatastore::setModificationGuard(), setBackgroundRendering()
+         */
+        void backgroundRenderingModificationGuard();
+        /** \brief set, when backgroundRenderingModificationGuard() warned about a modification from another thread, so this is reported once per frame */
+        std::atomic<bool> backgroundRenderForeignModificationReported{false};
+        /** \brief waits in the event handlers of JKQTPlotter for the background rendering to finish, and is installed on the toolbar and context menus */
+        virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
 
         /** \brief use this QMenu instance instead of the standard context menu of this widget
          *  \see \ref JKQTPLOTTER_SPECIALCONTEXTMENU
@@ -1692,6 +1938,10 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
 
         virtual bool event(QEvent *event) override;
     protected Q_SLOTS:
+        /** \brief called (in the GUI thread) by backgroundRenderThread, when the frame \a frameID is finished: displays it and starts the next frame, if necessary
+        * \internal
+        */
+        void backgroundRenderingFinished(quint64 frameID);
         /** \brief while the window is resized, the plot is only redrawn after a restartable delay, implemented by this function and resizeTimer
         * \internal
         * \see resizeTimer
@@ -1699,6 +1949,20 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
         * \image html jkqtplotter_fastresizing.gif
         */
         void delayedResizeEvent();
+        /** \brief called by ingestionTimer: redraws the plot, if the ingestion queues of the datastore contain new data
+        * \internal
+        * \see setIngestionMaxFrameRate()
+        */
+        void ingestionTimerTimeout();
+        /** \brief called by redrawTimer: renders the frame, that was requested since the last frame
+        * \internal
+        * \see setMaxFrameRate()
+        */
+        void redrawTimerTimeout();
+        /** \brief connected to JKQTBasePlotter::plotLayersUpdated(): requests a redraw of the changed \a layers with the reason RedrawPropertiesChanged
+        * \internal
+        */
+        void plotterLayersUpdated(JKQTBasePlotter::DrawingLayers layers);
 
         /** \brief connected to plotScalingRecalculated() of the masterPlotter */
         void masterPlotScalingRecalculated();
@@ -1726,6 +1990,8 @@ class JKQTPLOTTER_LIB_EXPORT JKQTPlotter: public QWidget {
 
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(JKQTPlotter::RedrawReasons)
+
 
 /** \brief Guard Class (RAII construct) for JKQTPlotter that disables replotting on construction and reenables it on destruction
  * \ingroup jkqtpplotterclasses
@@ -0,0 +1,83 @@
+#include <QObject>
+#include <QtTest>
+#include "jkqtcommon/jkqtpconcurrencytools.h"
+#include <thread>
+
+#ifndef QCOMPARE_EQ
+#define QCOMPARE_EQ(A,B) if (!static_cast<bool>((A)==(B))) {qDebug()<<QTest::toString(A)<< "!=" << QTest::toString(B); } QVERIFY((A)==(B))
+#endif
+
+
+class JKQTPConcurrencyToolsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPConcurrencyToolsTest() {
+    }
+
+    inline ~JKQTPConcurrencyToolsTest() {
+    }
+
+private slots:
+
+
+    inline void test_JKQTPSPSCQueue_SingleThread() {
+        JKQTPSPSCQueue<int> q(5);
+        QCOMPARE_EQ(q.capacity(), static_cast<size_t>(5));
+        QVERIFY(q.empty());
+        const int data[]={1,2,3,4,5,6,7};
+        // only 5 items fit, in chunks of 2 only 4 are accepted
+        QCOMPARE_EQ(q.push(data, 7, 2), static_cast<size_t>(4));
+        QCOMPARE_EQ(q.size(), static_cast<size_t>(4));
+        QVERIFY(q.push(5));
+        QVERIFY(!q.push(6));
+        int out[10];
+        QCOMPARE_EQ(q.pop(out, 3), static_cast<size_t>(3));
+        QCOMPARE_EQ(out[0], 1);
+        QCOMPARE_EQ(out[2], 3);
+        // wrap around the end of the ring-buffer
+        QCOMPARE_EQ(q.push(data+4, 3), static_cast<size_t>(3));
+        std::vector<size_t> segments;
+        std::vector<int> values;
+        QCOMPARE_EQ(q.consume([&](const int* d, size_t n) { segments.push_back(n); values.insert(values.end(), d, d+n); }), static_cast<size_t>(5));
+        QCOMPARE_EQ(segments.size(), static_cast<size_t>(2));
+        QVERIFY((values==std::vector<int>{4,5,5,6,7}));
+        QVERIFY(q.empty());
+        QCOMPARE_EQ(q.clear(), static_cast<size_t>(0));
+    }
+
+    inline void test_JKQTPSPSCQueue_ProducerConsumer() {
+        JKQTPSPSCQueue<uint64_t> q(1000);
+        const uint64_t N=2000000;
+        std::thread producer([&q, N]() {
+            uint64_t block[37];
+            uint64_t next=0;
+            while (next<N) {
+                const size_t n=static_cast<size_t>(std::min<uint64_t>(37, N-next));
+                for (size_t i=0; i<n; i++) block[i]=next+i;
+                next+=q.push(block, n);
+            }
+        });
+        uint64_t expected=0;
+        bool ok=true;
+        while (expected<N) {
+            q.consume([&](const uint64_t* d, size_t n) {
+                for (size_t i=0; i<n; i++) {
+                    if (d[i]!=expected) ok=false;
+                    expected++;
+                }
+            });
+        }
+        producer.join();
+        QVERIFY(ok);
+        QCOMPARE_EQ(expected, N);
+        QVERIFY(q.empty());
+    }
+
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPConcurrencyToolsTest)
+
+#include "JKQTPConcurrencyTools_test.moc"
@@ -0,0 +1,131 @@
+#include <QObject>
+#include <QtTest>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include "jkqtcommon/jkqtpgeometrytools.h"
+
+#ifndef QCOMPARE_EQ
+#define QCOMPARE_EQ(A,B) if (!static_cast<bool>((A)==(B))) {qDebug()<<QTest::toString(A)<< "!=" << QTest::toString(B); } QVERIFY((A)==(B))
+#endif
+
+
+class JKQTPGeometryToolsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPGeometryToolsTest() {
+    }
+
+    inline ~JKQTPGeometryToolsTest() {
+    }
+
+private slots:
+
+    inline void test_JKQTPAdaptiveFunctionGraphEvaluator() {
+        std::atomic<int> calls{0};
+        auto f=[&calls](double t) { calls++; return QPointF(t*100.0, 100.0*sin(t)*exp(-t/5.0)); };
+        JKQTPAdaptiveFunctionGraphEvaluator eval(f, 50, 5, 0.005, 32);
+        QCOMPARE_EQ(eval.getThreads(), 1);
+        const QVector<QPointF> serial=eval.evaluate(0, 20);
+        const int serialCalls=calls;
+        // the initial grid of 50 intervals is refined, not all midpoints are kept
+        QVERIFY(serial.size()>51);
+        QVERIFY(serialCalls>=serial.size());
+        QCOMPARE_EQ(serial.first(), f(0));
+        QCOMPARE_EQ(serial.last(), f(20));
+        for (int i=1; i<serial.size(); i++) {
+            QVERIFY(serial[i].x()>serial[i-1].x());
+        }
+        // evaluating again yields the same points
+        QVERIFY(eval.evaluate(0, 20)==serial);
+        // the result does not depend on the number of threads
+        for (int threads: {0, 2, 3, 7}) {
+            eval.setThreads(threads);
+            calls=0;
+            QVERIFY(eval.evaluate(0, 20)==serial);
+            QCOMPARE_EQ(static_cast<int>(calls), serialCalls);
+        }
+        // reversed range
+        eval.setThreads(1);
+        const QVector<QPointF> reversed=eval.evaluate(5, 0);
+        QVERIFY(reversed.size()>=2);
+        for (int i=1; i<reversed.size(); i++) {
+            QVERIFY(reversed[i].x()<reversed[i-1].x());
+        }
+    }
+
+    inline void test_JKQTPAdaptiveFunctionGraphEvaluator_alignedGrid() {
+        std::mutex mutex;
+        std::set<double> positions;
+        size_t newPositions=0;
+        auto f=[&](double t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (positions.insert(t).second) newPositions++;
+            return QPointF(t*50.0, 100.0*sin(t)*exp(-t/50.0));
+        };
+        JKQTPAdaptiveFunctionGraphEvaluator eval(f, 50, 5, 0.005, 32);
+        eval.setAlignedGrid(true);
+        QVERIFY(eval.isAlignedGrid());
+        const QVector<QPointF> first=eval.evaluate(0.3, 20.3);
+        const size_t firstPositions=newPositions;
+        QCOMPARE_EQ(first.first(), f(0.3));
+        QCOMPARE_EQ(first.last(), f(20.3));
+        // panning by 2.5% samples mostly at known positions
+        for (int i=1; i<=5; i++) {
+            newPositions=0;
+            const QVector<QPointF> panned=eval.evaluate(0.3+0.5*i, 20.3+0.5*i);
+            QVERIFY(newPositions<firstPositions/5);
+            for (int j=1; j<panned.size(); j++) {
+                QVERIFY(panned[j].x()>panned[j-1].x());
+            }
+        }
+        // ... also when evaluating in parallel
+        eval.setThreads(3);
+        newPositions=0;
+        eval.evaluate(0.8, 20.8);
+        QCOMPARE_EQ(newPositions, size_t(0));
+    }
+
+    inline void test_JKQTPMarchingSquaresContour() {
+        const int N=101;
+        std::vector<double> cone(static_cast<size_t>(N*N));
+        for (int y=0; y<N; y++) {
+            for (int x=0; x<N; x++) {
+                cone[static_cast<size_t>(y*N+x)]=std::hypot(x-50.0, y-50.0);
+            }
+        }
+        // a circle inside the grid gives a single closed line
+        const QVector<QPolygonF> circle=JKQTPMarchingSquaresContour(cone.data(), N, N, 20.0);
+        QCOMPARE_EQ(circle.size(), 1);
+        QVERIFY(circle[0].size()>100);
+        QCOMPARE_EQ(circle[0].first(), circle[0].last());
+        for (const QPointF& p: circle[0]) {
+            QVERIFY(fabs(std::hypot(p.x()-50.0, p.y()-50.0)-20.0)<0.01);
+        }
+        // a circle that is cut by the border of the grid gives one open line per corner
+        const QVector<QPolygonF> cut=JKQTPMarchingSquaresContour(cone.data(), N, N, 60.0);
+        QCOMPARE_EQ(cut.size(), 4);
+        for (const QPolygonF& l: cut) {
+            QVERIFY(l.first()!=l.last());
+        }
+        // non-finite values open the line
+        cone[static_cast<size_t>(50*N+70)]=std::numeric_limits<double>::quiet_NaN();
+        const QVector<QPolygonF> nan=JKQTPMarchingSquaresContour(cone.data(), N, N, 20.0);
+        QCOMPARE_EQ(nan.size(), 1);
+        QVERIFY(nan[0].first()!=nan[0].last());
+        // a saddle point gives two separate lines
+        const double saddle[4]={1,0,0,1};
+        QCOMPARE_EQ(JKQTPMarchingSquaresContour(saddle, 2, 2, 0.5).size(), 2);
+        // levels outside the range and degenerate grids give no lines
+        QVERIFY(JKQTPMarchingSquaresContour(saddle, 2, 2, 5).isEmpty());
+        QVERIFY(JKQTPMarchingSquaresContour(saddle, 4, 1, 0.5).isEmpty());
+    }
+
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPGeometryToolsTest)
+
+#include "JKQTPGeometryTools_test.moc"
@@ -0,0 +1,146 @@
+#include <QObject>
+#include <QtTest>
+#include <cmath>
+#include <vector>
+#include "jkqtcommon/jkqtpbasicimagetools.h"
+
+#ifndef QCOMPARE_EQ
+#define QCOMPARE_EQ(A,B) if (!static_cast<bool>((A)==(B))) {qDebug()<<QTest::toString(A)<< "!=" << QTest::toString(B); } QVERIFY((A)==(B))
+#endif
+
+
+class JKQTPImageTilePyramidTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPImageTilePyramidTest() {
+    }
+
+    inline ~JKQTPImageTilePyramidTest() {
+    }
+
+private:
+    /** \brief brute-force value of pixel \a x / \a y of level \a level : recursively average the finite values of the 2x2 pixels below */
+    static double referenceValue(const std::vector<uint16_t>& img, int Nx, int Ny, int level, int x, int y) {
+        if (level==0) {
+            if (x>=Nx || y>=Ny) return JKQTP_NAN;
+            return img[static_cast<size_t>(y)*static_cast<size_t>(Nx)+static_cast<size_t>(x)];
+        }
+        double sum=0;
+        int cnt=0;
+        for (int yy=2*y; yy<2*y+2; yy++) {
+            for (int xx=2*x; xx<2*x+2; xx++) {
+                const double v=referenceValue(img, Nx, Ny, level-1, xx, yy);
+                if (std::isfinite(v)) {
+                    sum+=v;
+                    cnt++;
+                }
+            }
+        }
+        return (cnt>0)?(sum/cnt):JKQTP_NAN;
+    }
+
+private slots:
+
+    inline void test_levels() {
+        const std::vector<uint16_t> img(1000*300, 1);
+        JKQTPImageTilePyramid pyr;
+        QCOMPARE_EQ(pyr.getLevelCount(), 0);
+        pyr.setSource(img.data(), JKQTPMathImageDataType::UInt16Array, 1000, 300, 1);
+        QCOMPARE_EQ(pyr.getLevelCount(), 11);
+        QCOMPARE_EQ(pyr.getLevelWidth(1), 500);
+        QCOMPARE_EQ(pyr.getLevelHeight(3), 38);
+        QCOMPARE_EQ(pyr.getLevelWidth(10), 1);
+        QCOMPARE_EQ(pyr.levelForDownsampling(1.5), 0);
+        QCOMPARE_EQ(pyr.levelForDownsampling(3.9), 1);
+        QCOMPARE_EQ(pyr.levelForDownsampling(4.0), 2);
+        QCOMPARE_EQ(pyr.levelForDownsampling(1e6), 10);
+    }
+
+    inline void test_getRegion() {
+        const int Nx=1300, Ny=700;
+        std::vector<uint16_t> img(static_cast<size_t>(Nx)*static_cast<size_t>(Ny));
+        for (size_t i=0; i<img.size(); i++) img[i]=static_cast<uint16_t>((i*7919)%1000);
+        for (bool parallel: {false, true}) {
+            JKQTPImageTilePyramid pyr;
+            pyr.setParallelBuilding(parallel);
+            pyr.setSource(img.data(), JKQTPMathImageDataType::UInt16Array, Nx, Ny, 1);
+            for (int level: {1, 2, 3}) {
+                const int x0=37>>(level-1), y0=250>>level;
+                const int x1=pyr.getLevelWidth(level), y1=pyr.getLevelHeight(level);
+                std::vector<double> out;
+                QVERIFY(pyr.getRegion(level, x0, y0, x1, y1, out));
+                QCOMPARE_EQ(out.size(), static_cast<size_t>((x1-x0)*(y1-y0)));
+                for (int y=y0; y<y1; y+=3) {
+                    for (int x=x0; x<x1; x+=5) {
+                        QVERIFY(fabs(out[static_cast<size_t>((y-y0)*(x1-x0)+(x-x0))]-referenceValue(img, Nx, Ny, level, x, y))<1e-9);
+                    }
+                }
+            }
+            std::vector<double> out;
+            QVERIFY(!pyr.getRegion(0, 0, 0, 10, 10, out));
+            QVERIFY(!pyr.getRegion(1, 0, 0, pyr.getLevelWidth(1)+1, 10, out));
+        }
+    }
+
+    inline void test_cache() {
+        const int Nx=2048, Ny=2048;
+        std::vector<uint16_t> img(static_cast<size_t>(Nx)*static_cast<size_t>(Ny), 5);
+        JKQTPImageTilePyramid pyr;
+        pyr.setSource(img.data(), JKQTPMathImageDataType::UInt16Array, Nx, Ny, 1);
+        std::vector<double> out;
+        // level 2 is 512x512 = 2x2 tiles, built from 4x4 tiles of level 1
+        QVERIFY(pyr.getRegion(2, 0, 0, 512, 512, out));
+        JKQTPImageTilePyramid::Statistics stat=pyr.getStatistics();
+        QCOMPARE_EQ(stat.requestedTiles, quint64(4));
+        QCOMPARE_EQ(stat.hitTiles, quint64(0));
+        QCOMPARE_EQ(stat.builtTiles, quint64(4+16));
+        QCOMPARE_EQ(stat.cachedTiles, size_t(20));
+        QCOMPARE_EQ(out[1000], 5.0);
+
+        QVERIFY(pyr.getRegion(2, 10, 10, 300, 20, out));
+        stat=pyr.getStatistics();
+        QCOMPARE_EQ(stat.requestedTiles, quint64(6));
+        QCOMPARE_EQ(stat.hitTiles, quint64(2));
+        QCOMPARE_EQ(stat.builtTiles, quint64(20));
+
+        // same key: cache is kept, new key: cache is dropped
+        pyr.setSource(img.data(), JKQTPMathImageDataType::UInt16Array, Nx, Ny, 1);
+        QCOMPARE_EQ(pyr.getStatistics().cachedTiles, size_t(20));
+        pyr.setSource(img.data(), JKQTPMathImageDataType::UInt16Array, Nx, Ny, 2);
+        stat=pyr.getStatistics();
+        QCOMPARE_EQ(stat.cachedTiles, size_t(0));
+        QCOMPARE_EQ(stat.invalidations, quint64(1));
+
+        // memory limit: the least-recently used tiles are evicted after a request
+        const size_t tileBytes=JKQTPImageTilePyramid::TileSize*JKQTPImageTilePyramid::TileSize*sizeof(double);
+        pyr.resetStatistics();
+        pyr.setMaxMemory(tileBytes*6);
+        QVERIFY(pyr.getRegion(2, 0, 0, 256, 256, out));
+        QCOMPARE_EQ(pyr.getStatistics().cachedTiles, size_t(5));
+        QVERIFY(pyr.getRegion(2, 256, 256, 512, 512, out));
+        stat=pyr.getStatistics();
+        QCOMPARE_EQ(stat.cachedTiles, size_t(6));
+        QCOMPARE_EQ(stat.evictedTiles, quint64(4));
+        QVERIFY(stat.memoryBytes<=pyr.getMaxMemory());
+    }
+
+    inline void test_nonFinite() {
+        std::vector<double> img={1, JKQTP_NAN, 3, JKQTP_NAN,
+                                 JKQTP_NAN, JKQTP_NAN, INFINITY, JKQTP_NAN};
+        JKQTPImageTilePyramid pyr;
+        pyr.setSource(img.data(), JKQTPMathImageDataType::DoubleArray, 4, 2, 1);
+        std::vector<double> out;
+        QVERIFY(pyr.getRegion(1, 0, 0, 2, 1, out));
+        QCOMPARE_EQ(out[0], 1.0);
+        QCOMPARE_EQ(out[1], 3.0);
+        QVERIFY(pyr.getRegion(2, 0, 0, 1, 1, out));
+        QCOMPARE_EQ(out[0], 2.0);
+    }
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPImageTilePyramidTest)
+
+#include "JKQTPImageTilePyramid_test.moc"
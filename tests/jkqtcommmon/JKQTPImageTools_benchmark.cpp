@@ -0,0 +1,75 @@
+#include <QObject>
+#include <QtTest>
+#include <vector>
+#include "jkqtcommon/jkqtpbasicimagetools.h"
+
+
+class JKQTPImageToolsBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPImageToolsBenchmark() {
+    }
+
+    inline ~JKQTPImageToolsBenchmark() {
+    }
+
+private:
+    /** \brief width of the benchmark frame (4K UHD) */
+    static constexpr int W=3840;
+    /** \brief height of the benchmark frame (4K UHD) */
+    static constexpr int H=2160;
+
+    /** \brief colorizes a 4K frame of type \a T with a gradient test pattern, using \a threads threads (see JKQTPImageTools::setParallelColorizationThreads() ) */
+    template <class T>
+    static void benchmarkArray2image(int threads) {
+        std::vector<T> data(static_cast<size_t>(W)*static_cast<size_t>(H));
+        for (int y=0; y<H; y++) {
+            for (int x=0; x<W; x++) {
+                data[static_cast<size_t>(y)*W+x]=static_cast<T>((x+y)%251);
+            }
+        }
+        JKQTPImageTools::setParallelColorizationThreads(threads);
+        QImage img;
+        QBENCHMARK {
+            JKQTPImageTools::array2image<T>(data.data(), W, H, img, JKQTPMathImageMATLAB, 10, 240);
+        }
+        JKQTPImageTools::setParallelColorizationThreads(0);
+    }
+
+    /** \brief data rows for the benchmarks: serial and parallel colorization */
+    static void addThreadRows() {
+        QTest::addColumn<int>("threads");
+        QTest::newRow("serial") << 1;
+        QTest::newRow("parallel") << 0;
+    }
+
+private slots:
+
+    inline void benchmark_array2image_double() { QFETCH(int, threads); benchmarkArray2image<double>(threads); }
+    inline void benchmark_array2image_double_data() { addThreadRows(); }
+    inline void benchmark_array2image_float() { QFETCH(int, threads); benchmarkArray2image<float>(threads); }
+    inline void benchmark_array2image_float_data() { addThreadRows(); }
+    inline void benchmark_array2image_uint8() { QFETCH(int, threads); benchmarkArray2image<uint8_t>(threads); }
+    inline void benchmark_array2image_uint8_data() { addThreadRows(); }
+    inline void benchmark_array2image_int8() { QFETCH(int, threads); benchmarkArray2image<int8_t>(threads); }
+    inline void benchmark_array2image_int8_data() { addThreadRows(); }
+    inline void benchmark_array2image_uint16() { QFETCH(int, threads); benchmarkArray2image<uint16_t>(threads); }
+    inline void benchmark_array2image_uint16_data() { addThreadRows(); }
+    inline void benchmark_array2image_int16() { QFETCH(int, threads); benchmarkArray2image<int16_t>(threads); }
+    inline void benchmark_array2image_int16_data() { addThreadRows(); }
+    inline void benchmark_array2image_uint32() { QFETCH(int, threads); benchmarkArray2image<uint32_t>(threads); }
+    inline void benchmark_array2image_uint32_data() { addThreadRows(); }
+    inline void benchmark_array2image_int32() { QFETCH(int, threads); benchmarkArray2image<int32_t>(threads); }
+    inline void benchmark_array2image_int32_data() { addThreadRows(); }
+    inline void benchmark_array2image_uint64() { QFETCH(int, threads); benchmarkArray2image<uint64_t>(threads); }
+    inline void benchmark_array2image_uint64_data() { addThreadRows(); }
+    inline void benchmark_array2image_int64() { QFETCH(int, threads); benchmarkArray2image<int64_t>(threads); }
+    inline void benchmark_array2image_int64_data() { addThreadRows(); }
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPImageToolsBenchmark)
+
+#include "JKQTPImageTools_benchmark.moc"
@@ -0,0 +1,211 @@
+#include <QObject>
+#include <QtTest>
+#include <random>
+#include <vector>
+#include <typeinfo>
+#include "jkqtcommon/jkqtpbasicimagetools.h"
+
+#ifndef QCOMPARE_EQ
+#define QCOMPARE_EQ(A,B) if (!static_cast<bool>((A)==(B))) {qDebug()<<QTest::toString(A)<< "!=" << QTest::toString(B); } QVERIFY((A)==(B))
+#endif
+
+
+class JKQTPImageToolsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPImageToolsTest() {
+    }
+
+    inline ~JKQTPImageToolsTest() {
+    }
+
+private:
+    /** \brief straightforward per-pixel implementation of JKQTPImageTools::array2image(), used as reference */
+    template <class T>
+    static QImage referenceArray2image(const T* dbl_in, int width, int height, JKQTPMathImageColorPalette palette, double minColor, double maxColor, JKQTPMathImageColorRangeFailAction paletteMinFail, JKQTPMathImageColorRangeFailAction paletteMaxFail, QColor minFailColor, QColor maxFailColor, QColor nanColor, QColor infColor, bool logScale, double logBase) {
+        const int NPixels=width*height;
+        double min = *dbl_in;
+        double max = *dbl_in;
+        if (jkqtp_approximatelyEqual(minColor, maxColor, JKQTP_DOUBLE_EPSILON)) {
+            bool first=true;
+            for (int i=1; i<NPixels; ++i) {
+                T v=dbl_in[i];
+                if (!(std::isnan(static_cast<long double>(v)) || std::isinf(static_cast<long double>(v)))) {
+                    if (first) {
+                        min=max=v;
+                        first=false;
+                    } else {
+                        if (v < min) min = v;
+                        else if (v > max) max = v;
+                    }
+                }
+            }
+        } else {
+            min = minColor;
+            max = maxColor;
+        }
+        const T* dbl=dbl_in;
+        QVector<T> dbl1;
+        if (logScale) {
+            double logB=log10(logBase);
+            dbl1=QVector<T>(NPixels, 0);
+            for (int i=0; i<NPixels; i++) {
+                dbl1[i]=log10(dbl_in[i])/logB;
+            }
+            dbl=dbl1.data();
+            min=log10(min)/logB;
+            max=log10(max)/logB;
+        }
+        const double delta=max-min;
+        const JKQTPImageTools::LUTType& lut_used=JKQTPImageTools::getLUTforPalette(palette);
+        QImage img(width, height, QImage::Format_ARGB32);
+        if (jkqtp_approximatelyEqual(min, max, JKQTP_DOUBLE_EPSILON)) {
+            img.fill(lut_used[0]);
+            return img;
+        }
+        const int lutSize=lut_used.size();
+        for (int j=0; j<height; ++j) {
+            QRgb* line=reinterpret_cast<QRgb*>(img.scanLine(height-1-j));
+            for (int i=0; i<width; ++i) {
+                double val=dbl[j*width+i];
+                if (std::isnan(val)) {
+                    line[i]=nanColor.rgba();
+                } else if (std::isinf(val)) {
+                    line[i]=infColor.rgba();
+                } else {
+                    const int v = static_cast<int>((val-min)/delta*static_cast<double>(lutSize));
+                    const int vv = qBound<int>(0, v, lutSize-1);
+                    line[i]=lut_used[vv];
+                    if ((v<0)&&(paletteMinFail==JKQTPMathImageGivenColor)) {
+                        line[i]=minFailColor.rgba();
+                    } else if ((v>=lutSize)&&(paletteMaxFail==JKQTPMathImageGivenColor)) {
+                        line[i]=maxFailColor.rgba();
+                    } else if ((v<0)&&(paletteMinFail==JKQTPMathImageTransparent)) {
+                        line[i]=QColor(Qt::transparent).rgba();
+                    } else if ((v>=lutSize)&&(paletteMaxFail==JKQTPMathImageTransparent)) {
+                        line[i]=QColor(Qt::transparent).rgba();
+                    }
+                }
+            }
+        }
+        return img;
+    }
+
+    /** \brief compares JKQTPImageTools::array2image() with referenceArray2image() for random images of type \a T
+     *         (small and large, i.e. serial/parallel and with/without lookup table), with different ranges and range-fail actions */
+    template <class T>
+    static void compareArray2image(double lo, double hi) {
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<double> dist(lo, hi);
+        for (const QSize size: {QSize(13,7), QSize(700,500)}) {
+            std::vector<T> data(static_cast<size_t>(size.width()*size.height()));
+            for (auto& d: data) d=static_cast<T>(dist(rng));
+            if constexpr (std::is_floating_point<T>::value) {
+                data[3]=std::numeric_limits<T>::quiet_NaN();
+                data[5]=std::numeric_limits<T>::infinity();
+                data[8]=-std::numeric_limits<T>::infinity();
+            }
+            const double range=hi-lo;
+            const std::vector<std::pair<double,double>> ranges={{0,0}, {lo+range*0.2, hi-range*0.3}, {lo-range, hi+range}};
+            const std::vector<JKQTPMathImageColorRangeFailAction> failActions={JKQTPMathImageLastPaletteColor, JKQTPMathImageGivenColor, JKQTPMathImageTransparent};
+            for (const auto& r: ranges) {
+                for (const auto fail: failActions) {
+                    QImage img;
+                    JKQTPImageTools::array2image<T>(data.data(), size.width(), size.height(), img, JKQTPMathImageMATLAB, r.first, r.second, fail, fail, QColor("red"), QColor("blue"), QColor("green"), QColor("yellow"));
+                    const QImage ref=referenceArray2image<T>(data.data(), size.width(), size.height(), JKQTPMathImageMATLAB, r.first, r.second, fail, fail, QColor("red"), QColor("blue"), QColor("green"), QColor("yellow"), false, 10.0);
+                    QVERIFY2(img==ref, QString("type=%1, size=%2x%3, range=%4..%5, fail=%6").arg(typeid(T).name()).arg(size.width()).arg(size.height()).arg(r.first).arg(r.second).arg(static_cast<int>(fail)).toLatin1().data());
+                }
+            }
+            if (lo>0) {
+                QImage img;
+                JKQTPImageTools::array2image<T>(data.data(), size.width(), size.height(), img, JKQTPMathImageMATLAB, 0, 0, JKQTPMathImageLastPaletteColor, JKQTPMathImageLastPaletteColor, QColor("red"), QColor("blue"), QColor("green"), QColor("yellow"), true, 2.0);
+                const QImage ref=referenceArray2image<T>(data.data(), size.width(), size.height(), JKQTPMathImageMATLAB, 0, 0, JKQTPMathImageLastPaletteColor, JKQTPMathImageLastPaletteColor, QColor("red"), QColor("blue"), QColor("green"), QColor("yellow"), true, 2.0);
+                QVERIFY(img==ref);
+            }
+        }
+    }
+
+    /** \brief compares JKQTPImagePlot_getImageMinMax() with JKQTPImagePlot_getImageMin() and JKQTPImagePlot_getImageMax() for random images of type \a T */
+    template <class T>
+    static void compareImageMinMax(double lo, double hi) {
+        std::mt19937 rng(4711);
+        std::uniform_real_distribution<double> dist(lo, hi);
+        for (const QSize size: {QSize(1,1), QSize(13,7), QSize(700,500)}) {
+            std::vector<T> data(static_cast<size_t>(size.width()*size.height()));
+            for (auto& d: data) d=static_cast<T>(dist(rng));
+            if constexpr (std::is_floating_point<T>::value) {
+                if (data.size()>8) {
+                    data[3]=std::numeric_limits<T>::quiet_NaN();
+                    data[5]=std::numeric_limits<T>::infinity();
+                    data[8]=-std::numeric_limits<T>::infinity();
+                }
+            }
+            double imin=-1, imax=-1;
+            const bool found=JKQTPImagePlot_getImageMinMax<T>(data.data(), size.width(), size.height(), imin, imax);
+            QCOMPARE_EQ(found, data.size()>1);
+            QCOMPARE_EQ(imin, JKQTPImagePlot_getImageMin<T>(data.data(), size.width(), size.height()));
+            QCOMPARE_EQ(imax, JKQTPImagePlot_getImageMax<T>(data.data(), size.width(), size.height()));
+        }
+    }
+
+private slots:
+
+    inline void test_getImageMinMax() {
+        for (int threads: {0, 1, 3}) {
+            JKQTPImageTools::setParallelColorizationThreads(threads);
+            compareImageMinMax<double>(-100, 200);
+            compareImageMinMax<float>(-100, 200);
+            compareImageMinMax<uint8_t>(0, 255);
+            compareImageMinMax<int8_t>(-128, 127);
+            compareImageMinMax<uint16_t>(0, 65535);
+            compareImageMinMax<int16_t>(-32768, 32767);
+            compareImageMinMax<uint32_t>(0, 1e9);
+            compareImageMinMax<int32_t>(-1e9, 1e9);
+            compareImageMinMax<uint64_t>(0, 1e12);
+            compareImageMinMax<int64_t>(-1e12, 1e12);
+        }
+        JKQTPImageTools::setParallelColorizationThreads(0);
+        const std::vector<double> nans(100, std::numeric_limits<double>::quiet_NaN());
+        double imin=-1, imax=-1;
+        QVERIFY(!JKQTPImagePlot_getImageMinMax<double>(nans.data(), 10, 10, imin, imax));
+        QCOMPARE_EQ(imin, 0.0);
+        QCOMPARE_EQ(imax, 0.0);
+    }
+
+    inline void test_array2image() {
+        for (int threads: {0, 1, 3}) {
+            JKQTPImageTools::setParallelColorizationThreads(threads);
+            compareArray2image<double>(-100, 200);
+            compareArray2image<double>(1, 1000);
+            compareArray2image<float>(-100, 200);
+            compareArray2image<uint8_t>(0, 255);
+            compareArray2image<uint8_t>(1, 255);
+            compareArray2image<int8_t>(-128, 127);
+            compareArray2image<uint16_t>(0, 65535);
+            compareArray2image<uint16_t>(100, 4095);
+            compareArray2image<int16_t>(-32768, 32767);
+            compareArray2image<uint32_t>(0, 1e9);
+            compareArray2image<int32_t>(-1e9, 1e9);
+            compareArray2image<uint64_t>(0, 1e12);
+            compareArray2image<int64_t>(-1e12, 1e12);
+        }
+        JKQTPImageTools::setParallelColorizationThreads(0);
+    }
+
+    inline void test_array2imageReusesImage() {
+        const std::vector<uint16_t> data(64*32, 7);
+        QImage img(64, 32, QImage::Format_ARGB32);
+        const uchar* bits=img.constBits();
+        JKQTPImageTools::array2image<uint16_t>(data.data(), 64, 32, img, JKQTPMathImageMATLAB, 0, 10);
+        QCOMPARE_EQ(img.constBits(), bits);
+        JKQTPImageTools::array2image<uint16_t>(data.data(), 32, 64, img, JKQTPMathImageMATLAB, 0, 10);
+        QCOMPARE_EQ(img.size(), QSize(32, 64));
+    }
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPImageToolsTest)
+
+#include "JKQTPImageTools_test.moc"
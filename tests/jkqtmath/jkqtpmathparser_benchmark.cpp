@@ -0,0 +1,158 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
+#include <cmath>
+#include "jkqtmath/jkqtpmathparser.h"
+
+#ifndef QCOMPARE_EQ
+#define QCOMPARE_EQ(A,B) if (!static_cast<bool>((A)==(B))) {qDebug()<<QTest::toString(A)<< "!=" << QTest::toString(B); } QVERIFY((A)==(B))
+#endif
+
+
+
+class JKQTPMathParserBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPMathParserBenchmark() {
+    }
+
+    inline ~JKQTPMathParserBenchmark() {
+    }
+
+private:
+    static bool sameValue(double a, double b) {
+        return (std::isnan(a) && std::isnan(b)) || (a==b);
+    }
+
+    static void addExpressionRows() {
+        QTest::addColumn<QString>("expression");
+        QTest::newRow("polynomial") << QString("x^3-2*x^2+p1*x-1");
+        QTest::newRow("damped_oscillation") << QString("p1*exp(-x/p2)*sin(2*pi*x)");
+        QTest::newRow("gaussian") << QString("p1*exp(-0.5*sqr((x-p2)/p3))/(p3*sqrt(2*pi))");
+        QTest::newRow("mixed") << QString("atan2(x,p2)+abs(cos(x))^0.5+sinc(x)");
+    }
+
+    static void addParameters(JKQTPMathParser& mp) {
+        mp.addVariableDouble("p1", 2.5);
+        mp.addVariableDouble("p2", 5.0);
+        mp.addVariableDouble("p3", 0.75);
+    }
+
+private slots:
+
+    inline void test_compileByteCode_data() {
+        addExpressionRows();
+        QTest::newRow("constant") << QString("1+2*3-pi");
+        QTest::newRow("argument") << QString("x");
+        QTest::newRow("external") << QString("ext*x+ext");
+        QTest::newRow("minmax") << QString("-x+min(x,3)-max(2,x)");
+    }
+
+    inline void test_compileByteCode() {
+        QFETCH(QString, expression);
+        JKQTPMathParser mp;
+        addParameters(mp);
+        double x=0, ext=3.25;
+        mp.addVariableDouble("x", &x);
+        mp.addVariableDouble("ext", &ext);
+        std::unique_ptr<JKQTPMathParser::jkmpNode> node(mp.parse(expression.toStdString()));
+        JKQTPMathParser::jkmpByteCode bc;
+        QVERIFY(mp.compileByteCode(node.get(), "x", bc));
+        QVERIFY(bc.isValid());
+
+        const size_t N=3*JKQTPMathParser::jkmpByteCode::BlockSize+17;
+        std::vector<double> xs(N), ys(N);
+        for (size_t i=0; i<N; i++) xs[i]=-10.0+20.0*static_cast<double>(i)/static_cast<double>(N);
+        bc.evaluate(xs.data(), ys.data(), N);
+        for (size_t i=0; i<N; i++) {
+            x=xs[i];
+            const JKQTPMathParser::jkmpResult r=node->evaluate();
+            QCOMPARE_EQ(r.type, JKQTPMathParser::jkmpDouble);
+            QVERIFY(sameValue(ys[i], r.num));
+            QVERIFY(sameValue(bc.evaluate(xs[i]), r.num));
+        }
+    }
+
+    inline void test_compileByteCodeConstantFolding() {
+        JKQTPMathParser mp;
+        addParameters(mp);
+        std::unique_ptr<JKQTPMathParser::jkmpNode> node(mp.parse("2*pi*p1+sqrt(p2)"));
+        JKQTPMathParser::jkmpByteCode bc;
+        QVERIFY(mp.compileByteCode(node.get(), "x", bc));
+        QCOMPARE_EQ(bc.getInstructionCount(), static_cast<size_t>(0));
+        QCOMPARE_EQ(bc.evaluate(1.0), node->evaluate().num);
+
+        node.reset(mp.parse("2*pi*x"));
+        QVERIFY(mp.compileByteCode(node.get(), "x", bc));
+        QCOMPARE_EQ(bc.getInstructionCount(), static_cast<size_t>(1));
+    }
+
+    inline void test_compileByteCodeFallback() {
+        JKQTPMathParser mp;
+        mp.addVariableDouble("x", 0.0);
+        JKQTPMathParser::jkmpByteCode bc;
+        for (const std::string expr: {"x>2", "'a'+'b'", "y=x; y*2", "x%2", "if(x>1, x, 1)", "unknownvariable*x"}) {
+            std::unique_ptr<JKQTPMathParser::jkmpNode> node(mp.parse(expr));
+            QVERIFY(!mp.compileByteCode(node.get(), "x", bc));
+            QVERIFY(!bc.isValid());
+            QVERIFY(std::isnan(bc.evaluate(1.0)));
+        }
+    }
+
+    inline void benchmark_evaluate_data() {
+        addExpressionRows();
+    }
+
+    inline void benchmark_evaluate() {
+        QFETCH(QString, expression);
+        JKQTPMathParser mp;
+        addParameters(mp);
+        double x=0;
+        mp.addVariableDouble("x", &x);
+        std::unique_ptr<JKQTPMathParser::jkmpNode> node(mp.parse(expression.toStdString()));
+        JKQTPMathParser::jkmpByteCode bc;
+        QVERIFY(mp.compileByteCode(node.get(), "x", bc));
+
+        const size_t N=200000;
+        std::vector<double> xs(N), ys(N);
+        for (size_t i=0; i<N; i++) xs[i]=static_cast<double>(i)*1e-4;
+
+        QElapsedTimer timer;
+        double sum=0;
+        timer.start();
+        for (size_t i=0; i<N; i++) {
+            x=xs[i];
+            sum+=node->evaluate().num;
+        }
+        const double treeNS=timer.nsecsElapsed();
+
+        timer.start();
+        for (size_t i=0; i<N; i++) {
+            sum+=bc.evaluate(xs[i]);
+        }
+        const double singleNS=timer.nsecsElapsed();
+
+        int runs=0;
+        timer.start();
+        QBENCHMARK {
+            bc.evaluate(xs.data(), ys.data(), N);
+            runs++;
+        }
+        const double batchNS=timer.nsecsElapsed()/static_cast<double>(runs);
+
+        qDebug()<<expression<<": "<<bc.getInstructionCount()<<" instructions, "<<bc.getRegisterCount()<<" registers";
+        qDebug()<<"  tree:     "<<treeNS/static_cast<double>(N)<<"ns/sample";
+        qDebug()<<"  bytecode: "<<singleNS/static_cast<double>(N)<<"ns/sample (speedup "<<treeNS/singleNS<<"x)";
+        qDebug()<<"  batch:    "<<batchNS/static_cast<double>(N)<<"ns/sample (speedup "<<treeNS/batchNS<<"x)";
+        qDebug()<<"  (sum="<<sum+ys[N/2]<<")";
+    }
+};
+
+
+QTEST_APPLESS_MAIN(JKQTPMathParserBenchmark)
+
+#include "jkqtpmathparser_benchmark.moc"
@@ -0,0 +1,75 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+
+
+class JKQTBasePlotterBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTBasePlotterBenchmark() {
+    }
+
+    inline ~JKQTBasePlotterBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_parallelGraphDraw_data() {
+        QTest::addColumn<int>("graphs");
+        QTest::addColumn<int>("N");
+        QTest::addColumn<bool>("parallel");
+        for (int graphs: {8, 64}) {
+            for (int N: {10000, 100000}) {
+                for (bool parallel: {false, true}) {
+                    QTest::newRow(QString("%1 graphs x N=%2, %3").arg(graphs).arg(N).arg(parallel?"parallel":"serial").toLatin1().constData())<<graphs<<N<<parallel;
+                }
+            }
+        }
+    }
+
+    /** \brief draws many JKQTPXYLineGraph (e.g. a multi-channel recording) into a QImage, serially or in parallel (see JKQTBasePlotter::setParallelGraphRendering() ) */
+    inline void benchmark_parallelGraphDraw() {
+        QFETCH(int, graphs);
+        QFETCH(int, N);
+        QFETCH(bool, parallel);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 100, "x");
+        for (int g=0; g<graphs; g++) {
+            const size_t cy=ds->addCalculatedColumnFromColumn(cx, [g](double x) { return sin(x*double(g+1)*0.1)+double(g)*2.0; }, "y");
+            JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+            graph->setXYColumns(cx, cy);
+            graph->setSymbolType(JKQTPNoSymbol);
+            plot.addGraph(graph);
+        }
+        plot.zoomToFit();
+        plot.setParallelGraphRendering(parallel);
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond(parallel?"JKQTBasePlotter::drawNonGrid() [parallel graphs]":"JKQTBasePlotter::drawNonGrid() [serial graphs]", size_t(graphs)*size_t(N)*runs, timer.nsecsElapsed());
+        if (runs>0) qDebug()<<"  "<<double(timer.nsecsElapsed())/double(runs)/1.0e6<<"ms/frame, "<<QThread::idealThreadCount()<<" threads available";
+    }
+};
+
+
+QTEST_MAIN(JKQTBasePlotterBenchmark)
+
+#include "JKQTBasePlotter_benchmark.moc"
@@ -0,0 +1,216 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "jkqtplotter/jkqtpdatastorage.h"
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+
+
+class JKQTPDatastoreBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPDatastoreBenchmark() {
+    }
+
+    inline ~JKQTPDatastoreBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_columnAccess_data() {
+        QTest::addColumn<int>("N");
+        QTest::newRow("N=100k")<<100000;
+        QTest::newRow("N=5M")<<5000000;
+    }
+
+    /** \brief sum over two columns, reading every point through JKQTPDatastore::get() (i.e. QMap lookup per point) */
+    inline void benchmark_columnAccess() {
+        QFETCH(int, N);
+        JKQTPDatastore ds;
+        const size_t cx=ds.addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds.addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+
+        double sum=0;
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            for (int i=0; i<N; i++) {
+                sum+=ds.get(cx, static_cast<size_t>(i))+ds.get(cy, static_cast<size_t>(i));
+            }
+        }
+        reportPointsPerSecond("JKQTPDatastore::get()", N*runs, timer.nsecsElapsed());
+        qDebug()<<"sum="<<sum;
+    }
+
+    inline void benchmark_streamingAppend_data() {
+        QTest::addColumn<bool>("ringBuffer");
+        QTest::newRow("appendToColumn() [vector column]")<<false;
+        QTest::newRow("appendFramesToColumns() [ring-buffer column]")<<true;
+    }
+
+    /** \brief streams 1M (time, value) frames in blocks of 1000 into two columns, keeping the last 100k rows */
+    inline void benchmark_streamingAppend() {
+        QFETCH(bool, ringBuffer);
+        const size_t capacity=100000;
+        const size_t blockSize=1000;
+        const size_t blocks=1000;
+        std::vector<double> frames(2*blockSize);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPDatastore ds;
+            const size_t ct=ringBuffer?ds.addRingBufferColumn(capacity, "t"):ds.addColumn("t");
+            const size_t cy=ringBuffer?ds.addRingBufferColumn(capacity, "y"):ds.addColumn("y");
+            for (size_t b=0; b<blocks; b++) {
+                for (size_t i=0; i<blockSize; i++) {
+                    frames[2*i]=double(b*blockSize+i)*1e-6;
+                    frames[2*i+1]=sin(frames[2*i]);
+                }
+                if (ringBuffer) {
+                    ds.appendFramesToColumns({ct, cy}, frames.data(), blockSize);
+                } else {
+                    for (size_t i=0; i<blockSize; i++) {
+                        ds.appendToColumns(ct, cy, frames[2*i], frames[2*i+1]);
+                    }
+                    // keep only the last capacity rows, as a strip chart would
+                    if (ds.getRows(ct)>capacity) {
+                        const int excess=static_cast<int>(ds.getRows(ct)-capacity);
+                        for (size_t c: {ct, cy}) {
+                            auto first=ds.begin(static_cast<int>(c));
+                            auto last=first;
+                            last+=excess-1;
+                            ds.eraseFromColumn(first, last);
+                        }
+                    }
+                }
+            }
+        }
+        reportPointsPerSecond(ringBuffer?"JKQTPDatastore::appendFramesToColumns() [ring-buffer]":"JKQTPDatastore::appendToColumns() [vector+erase]", blocks*blockSize*runs, timer.nsecsElapsed());
+    }
+
+    inline void benchmark_columnViewAccess_data() {
+        benchmark_columnAccess_data();
+    }
+
+    /** \brief sum over two columns, reading every point through a JKQTPColumnView (one lookup per column) */
+    inline void benchmark_columnViewAccess() {
+        QFETCH(int, N);
+        JKQTPDatastore ds;
+        const size_t cx=ds.addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds.addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+
+        double sum=0;
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            const JKQTPColumnView xData=ds.getColumnView(cx);
+            const JKQTPColumnView yData=ds.getColumnView(cy);
+            for (int i=0; i<N; i++) {
+                sum+=xData.getValue(i)+yData.getValue(i);
+            }
+        }
+        reportPointsPerSecond("JKQTPColumnView::getValue()", N*runs, timer.nsecsElapsed());
+        qDebug()<<"sum="<<sum;
+    }
+
+    inline void benchmark_typedColumnViewAccess_data() {
+        benchmark_columnAccess_data();
+    }
+
+    /** \brief sum over an \c int16_t column (4x less memory than \c double ), reading every point through a JKQTPColumnView */
+    inline void benchmark_typedColumnViewAccess() {
+        QFETCH(int, N);
+        JKQTPDatastore ds;
+        std::vector<int16_t> adc(static_cast<size_t>(N));
+        for (int i=0; i<N; i++) adc[static_cast<size_t>(i)]=static_cast<int16_t>(30000.0*sin(double(i)/1000.0));
+        const size_t cy=ds.addTypedColumn(adc.data(), adc.size(), "adc");
+
+        double sum=0;
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            const JKQTPColumnView yData=ds.getColumnView(cy);
+            for (int i=0; i<N; i++) {
+                sum+=yData.getValue(i);
+            }
+        }
+        reportPointsPerSecond("JKQTPColumnView::getValue() [int16]", N*runs, timer.nsecsElapsed());
+        qDebug()<<"sum="<<sum;
+    }
+
+    inline void benchmark_lineGraphGetXMinMax_data() {
+        benchmark_columnAccess_data();
+    }
+
+    /** \brief autoscaling a JKQTPXYLineGraph (the first run calculates the statistics of the column, later runs use the cached values) */
+    inline void benchmark_lineGraphGetXMinMax() {
+        QFETCH(int, N);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        plot.addGraph(graph);
+
+        double minx=0, maxx=0, sgz=0;
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            graph->getXMinMax(minx, maxx, sgz);
+        }
+        reportPointsPerSecond("JKQTPXYLineGraph::getXMinMax()", N*runs, timer.nsecsElapsed());
+        QCOMPARE(minx, 0.0);
+        QCOMPARE(maxx, 10.0);
+    }
+
+    inline void benchmark_zoomToFitSharedColumns_data() {
+        benchmark_columnAccess_data();
+    }
+
+    /** \brief zoomToFit() of a plot with 20 graphs that share the same two columns (e.g. a dashboard) */
+    inline void benchmark_zoomToFitSharedColumns() {
+        QFETCH(int, N);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+        for (int g=0; g<20; g++) {
+            JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+            graph->setXYColumns(cx, cy);
+            plot.addGraph(graph);
+        }
+
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            plot.zoomToFit();
+        }
+        reportPointsPerSecond("JKQTBasePlotter::zoomToFit() [20 graphs]", 20*N*runs, timer.nsecsElapsed());
+    }
+};
+
+
+QTEST_MAIN(JKQTPDatastoreBenchmark)
+
+#include "JKQTPDatastore_benchmark.moc"
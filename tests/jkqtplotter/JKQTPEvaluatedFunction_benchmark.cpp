@@ -0,0 +1,66 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include <atomic>
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtpevaluatedfunction.h"
+
+
+class JKQTPEvaluatedFunctionBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPEvaluatedFunctionBenchmark() {
+    }
+
+    inline ~JKQTPEvaluatedFunctionBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_functionGraphEvaluation_data() {
+        QTest::addColumn<bool>("parallel");
+        QTest::newRow("serial")<<false;
+        QTest::newRow("parallel")<<true;
+    }
+
+    /** \brief evaluates a JKQTPXFunctionLineGraph with an expensive plot function (some 10 microseconds per call), serially or in parallel (see JKQTPEvaluatedFunctionGraphBase::setParallelEvaluation() ) */
+    inline void benchmark_functionGraphEvaluation() {
+        QFETCH(bool, parallel);
+        JKQTBasePlotter plot(true);
+        std::atomic<size_t> calls{0};
+        JKQTPXFunctionLineGraph* graph=new JKQTPXFunctionLineGraph([&calls](double x) {
+            calls++;
+            double sum=0;
+            for (int i=1; i<=1000; i++) sum+=sin(x*double(i))/double(i);
+            return sum;
+        }, "expensive", &plot);
+        graph->setParallelEvaluation(parallel);
+        plot.addGraph(graph);
+        plot.setXY(0, 10, -2, 2);
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond(parallel?"JKQTPXFunctionLineGraph [parallel evaluation]":"JKQTPXFunctionLineGraph [serial evaluation]", calls, timer.nsecsElapsed());
+        if (runs>0) qDebug()<<"  "<<double(timer.nsecsElapsed())/double(runs)/1.0e6<<"ms/frame, "<<double(calls)/double(runs)<<" function calls/frame, "<<QThread::idealThreadCount()<<" threads available";
+    }
+};
+
+
+QTEST_MAIN(JKQTPEvaluatedFunctionBenchmark)
+
+#include "JKQTPEvaluatedFunction_benchmark.moc"
@@ -0,0 +1,117 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+
+
+class JKQTPGraphsBaseBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPGraphsBaseBenchmark() {
+    }
+
+    inline ~JKQTPGraphsBaseBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_hitTest_data() {
+        QTest::addColumn<int>("N");
+        QTest::newRow("N=10k")<<10000;
+        QTest::newRow("N=100k")<<100000;
+        QTest::newRow("N=2M")<<2000000;
+    }
+
+    /** \brief latency of JKQTPXYGraph::hitTest() (as used by the tooltip tool on every mouse move) for a scatter graph */
+    inline void benchmark_hitTest() {
+        QFETCH(int, N);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addColumn(static_cast<size_t>(N), "x");
+        const size_t cy=ds->addColumn(static_cast<size_t>(N), "y");
+        for (int i=0; i<N; i++) {
+            ds->set(cx, static_cast<size_t>(i), sin(double(i)*0.7)*10.0+double(i%1000)/100.0);
+            ds->set(cy, static_cast<size_t>(i), cos(double(i)*1.3)*5.0+double(i%777)/100.0);
+        }
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        plot.grabPixelImage(QSize(800,600), false);
+
+        QElapsedTimer firstTimer;
+        firstTimer.start();
+        QPointF closest;
+        graph->hitTest(QPointF(0,0), &closest);
+        qDebug()<<"JKQTPXYGraph::hitTest() [first call, N="<<N<<"]: "<<double(firstTimer.nsecsElapsed())/1.0e6<<"ms";
+
+        size_t runs=0;
+        double sum=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            const double x=double(runs%200)/10.0-10.0;
+            const double y=double((runs*7)%100)/10.0-5.0;
+            runs++;
+            sum+=graph->hitTest(QPointF(x, y), &closest);
+        }
+        if (runs>0) qDebug()<<"JKQTPXYGraph::hitTest() [N="<<N<<"]: "<<double(timer.nsecsElapsed())/double(runs)/1.0e3<<"us/call";
+        qDebug()<<"sum="<<sum;
+    }
+
+    inline void benchmark_errorIndicatorDraw_data() {
+        QTest::addColumn<int>("N");
+        QTest::addColumn<int>("style");
+        for (int N: {100000, 1000000}) {
+            QTest::newRow(QString("N=%1, bars").arg(N).toLatin1().constData())<<N<<static_cast<int>(JKQTPErrorBars);
+            QTest::newRow(QString("N=%1, bars+lines").arg(N).toLatin1().constData())<<N<<static_cast<int>(JKQTPErrorBarsLines);
+            QTest::newRow(QString("N=%1, simple bars+polygons").arg(N).toLatin1().constData())<<N<<static_cast<int>(JKQTPErrorSimpleBarsPolygons);
+        }
+    }
+
+    /** \brief draws a JKQTPXYLineErrorGraph with symmetric y-errors (without line and symbols, so only the error indicators are measured) */
+    inline void benchmark_errorIndicatorDraw() {
+        QFETCH(int, N);
+        QFETCH(int, style);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 100, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x*0.37)*10.0; }, "y");
+        const size_t ce=ds->addCalculatedColumnFromColumn(cx, [](double x) { return 1.0+0.5*sin(x*123.4); }, "yerr");
+        JKQTPXYLineErrorGraph* graph=new JKQTPXYLineErrorGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setYErrorColumn(static_cast<int>(ce));
+        graph->setYErrorSymmetric(true);
+        graph->setYErrorStyle(static_cast<JKQTPErrorPlotstyleElements>(style));
+        graph->setDrawLine(false);
+        graph->setSymbolType(JKQTPNoSymbol);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond("JKQTPGraphErrorStyleMixin::intPlotXYErrorIndicators()", size_t(N)*runs, timer.nsecsElapsed());
+        if (runs>0) qDebug()<<"  "<<double(timer.nsecsElapsed())/double(runs)/1.0e6<<"ms/frame";
+    }
+};
+
+
+QTEST_MAIN(JKQTPGraphsBaseBenchmark)
+
+#include "JKQTPGraphsBase_benchmark.moc"
@@ -0,0 +1,99 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+
+
+class JKQTPLinesBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPLinesBenchmark() {
+    }
+
+    inline ~JKQTPLinesBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_lineGraphDraw_data() {
+        QTest::addColumn<int>("N");
+        QTest::addColumn<bool>("minMaxDecimation");
+        QTest::newRow("N=100k")<<100000<<false;
+        QTest::newRow("N=5M")<<5000000<<false;
+        QTest::newRow("N=100k, min/max-decimation")<<100000<<true;
+        QTest::newRow("N=5M, min/max-decimation")<<5000000<<true;
+    }
+
+    /** \brief draws a JKQTPXYLineGraph into a QImage */
+    inline void benchmark_lineGraphDraw() {
+        QFETCH(int, N);
+        QFETCH(bool, minMaxDecimation);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setSymbolType(JKQTPNoSymbol);
+        graph->setUseMinMaxDecimation(minMaxDecimation);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond("JKQTPXYLineGraph::draw()", N*runs, timer.nsecsElapsed());
+    }
+
+    inline void benchmark_lineGraphPanDraw_data() {
+        benchmark_lineGraphDraw_data();
+    }
+
+    /** \brief draws a JKQTPXYLineGraph into a QImage, while panning over the data (each run shows a different 1% of the data) */
+    inline void benchmark_lineGraphPanDraw() {
+        QFETCH(int, N);
+        QFETCH(bool, minMaxDecimation);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 100, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setSymbolType(JKQTPNoSymbol);
+        graph->setUseMinMaxDecimation(minMaxDecimation);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            plot.setX(double(runs%99), double(runs%99)+1.0);
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond("JKQTPXYLineGraph::draw() [panning]", N*runs, timer.nsecsElapsed());
+    }
+};
+
+
+QTEST_MAIN(JKQTPLinesBenchmark)
+
+#include "JKQTPLines_benchmark.moc"
@@ -0,0 +1,122 @@
+#include <QObject>
+#include <QtTest>
+#include <QElapsedTimer>
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+#include "jkqtplotter/graphs/jkqtpscatter.h"
+
+
+class JKQTPScatterBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    inline JKQTPScatterBenchmark() {
+    }
+
+    inline ~JKQTPScatterBenchmark() {
+    }
+
+private:
+    /** \brief prints the throughput of the last benchmark run */
+    inline void reportPointsPerSecond(const char* name, size_t N, qint64 nsecs) {
+        if (nsecs>0) qDebug()<<name<<": N="<<N<<" points in "<<double(nsecs)/1.0e6<<"ms ==> "<<double(N)/(double(nsecs)*1.0e-9)/1.0e6<<"MPoints/s";
+    }
+
+private slots:
+
+    inline void benchmark_scatterGraphDraw_data() {
+        QTest::addColumn<int>("N");
+        QTest::addColumn<bool>("sprites");
+        for (int N: {100000, 1000000}) {
+            for (bool sprites: {false, true}) {
+                QTest::newRow(QString("N=%1, %2").arg(N).arg(sprites?"symbol sprites":"vector symbols").toLatin1().constData())<<N<<sprites;
+            }
+        }
+    }
+
+    /** \brief draws a scatter graph (symbols only) into a QImage, with or without the symbol sprite cache (see JKQTPPlotSymbolSprite() ) */
+    inline void benchmark_scatterGraphDraw() {
+        QFETCH(int, N);
+        QFETCH(bool, sprites);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 100, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x*13.7)*cos(x*0.31)+0.3*sin(x*1234.5); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setDrawLine(false);
+        graph->setSymbolType(JKQTPFilledCircle);
+        graph->setSymbolSize(6);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        const bool oldSprites=JKQTPIsSymbolSpriteCacheEnabled();
+        JKQTPSetSymbolSpriteCacheEnabled(sprites);
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond(sprites?"JKQTPXYLineGraph::draw() [symbol sprites]":"JKQTPXYLineGraph::draw() [vector symbols]", size_t(N)*runs, timer.nsecsElapsed());
+        if (runs>0) qDebug()<<"  "<<double(timer.nsecsElapsed())/double(runs)/1.0e6<<"ms/frame";
+        JKQTPSetSymbolSpriteCacheEnabled(oldSprites);
+    }
+
+    inline void benchmark_parametrizedScatterGraphDraw_data() {
+        QTest::addColumn<int>("N");
+        QTest::addColumn<bool>("sizeColumn");
+        QTest::addColumn<bool>("group");
+        for (int N: {100000, 500000}) {
+            for (bool sizeColumn: {false, true}) {
+                for (bool group: {false, true}) {
+                    QTest::newRow(QString("N=%1, color%2%3").arg(N).arg(sizeColumn?"+size":"").arg(group?", grouped":"").toLatin1().constData())<<N<<sizeColumn<<group;
+                }
+            }
+        }
+    }
+
+    /** \brief draws a JKQTPXYParametrizedScatterGraph, where the symbols are colored (and optionally sized) by value */
+    inline void benchmark_parametrizedScatterGraphDraw() {
+        QFETCH(int, N);
+        QFETCH(bool, sizeColumn);
+        QFETCH(bool, group);
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 100, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x*13.7)*cos(x*0.31)+0.3*sin(x*1234.5); }, "y");
+        const size_t cc=ds->addCalculatedColumnFromColumn(cx, [](double x) { return cos(x*1234.5)*x; }, "color");
+        const size_t cs=ds->addCalculatedColumnFromColumn(cx, [](double x) { return 3.0+2.0*sin(x*321.1); }, "size");
+        JKQTPXYParametrizedScatterGraph* graph=new JKQTPXYParametrizedScatterGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setColorColumn(static_cast<int>(cc));
+        if (sizeColumn) graph->setSizeColumn(static_cast<int>(cs));
+        graph->setGroupSymbolsForDrawing(group);
+        graph->setDrawLine(false);
+        graph->setSymbolType(JKQTPFilledCircle);
+        graph->setSymbolSize(5);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+
+        QImage img(1500, 1000, QImage::Format_ARGB32_Premultiplied);
+        size_t runs=0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            runs++;
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+        }
+        reportPointsPerSecond("JKQTPXYParametrizedScatterGraph::draw()", size_t(N)*runs, timer.nsecsElapsed());
+        if (runs>0) qDebug()<<"  "<<double(timer.nsecsElapsed())/double(runs)/1.0e6<<"ms/frame";
+    }
+};
+
+
+QTEST_MAIN(JKQTPScatterBenchmark)
+
+#include "JKQTPScatter_benchmark.moc"
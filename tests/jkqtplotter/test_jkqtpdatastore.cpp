@@ -10,6 +10,7 @@
 #include <QTemporaryFile>
 #include <QPoint>
 #include <QPointF>
+#include <thread>
 #include <cmath>
 #include <vector>
 #include <list>
@@ -906,6 +907,510 @@ private slots:
         QCOMPARE(ds.get(col, 1), 200.0);
         QCOMPARE(ds.get(col, 2), 300.0);
     }
+
+    void test_columnView() {
+        JKQTPDatastore ds;
+        QVector<double> d;
+        for (int i = 0; i < 10; ++i) d << double(i) * 1.5;
+        size_t col = ds.addCopiedColumn(d, QString("view"));
+
+        const JKQTPColumnView v = ds.getColumnView(col);
+        QVERIFY(v.isValid());
+        QCOMPARE(v.size(), static_cast<size_t>(10));
+        for (size_t i = 0; i < v.size(); ++i) {
+            QCOMPARE(v[i], ds.get(col, i));
+            QCOMPARE(v.getValue(i), ds.get(col, i));
+        }
+        // out-of-range access behaves like JKQTPDatastore::get()
+        QVERIFY(std::isnan(v.getValue(static_cast<size_t>(10))));
+        QVERIFY(std::isnan(v.getValue(-1)));
+
+        // invalid columns yield invalid views
+        QVERIFY(!ds.getColumnView(-1).isValid());
+        QVERIFY(!ds.getColumnView(static_cast<size_t>(1234)).isValid());
+        QCOMPARE(ds.getColumnView(-1).size(), static_cast<size_t>(0));
+
+        // the view pins the column, even if it is deleted from the datastore
+        ds.deleteColumn(col);
+        QVERIFY(v.isValid());
+        QCOMPARE(v[3], 4.5);
+    }
+
+    void test_typedColumns() {
+        JKQTPDatastore ds;
+        std::vector<int16_t> adc{-3, 0, 7, 32767, -32768};
+        const size_t ext = ds.addTypedColumn(adc.data(), adc.size(), QString("adc"));
+        QVERIFY(ds.getColumnDataType(ext) == JKQTPMathImageDataType::Int16Array);
+        QCOMPARE(ds.getRows(ext), adc.size());
+        QVERIFY(ds.isColumnDataExternal(ext));
+        // zero-copy: the column references the external memory
+        QCOMPARE(ds.getColumnRawPointer(ext), static_cast<const void*>(adc.data()));
+        QCOMPARE(static_cast<const JKQTPDatastore&>(ds).getColumnPointer(ext), static_cast<const double*>(nullptr));
+        for (size_t i = 0; i < adc.size(); ++i) QCOMPARE(ds.get(ext, i), double(adc[i]));
+        QVERIFY(std::isnan(ds.get(ext, adc.size())));
+
+        // views and const iterators convert to double
+        const JKQTPColumnView v = ds.getColumnView(ext);
+        QCOMPARE(v.getPointer(), static_cast<const double*>(nullptr));
+        QVERIFY(v.getDataType() == JKQTPMathImageDataType::Int16Array);
+        QCOMPARE(v[2], 7.0);
+        double sum = 0.0;
+        for (auto it = ds.cbegin(ext); it != ds.cend(ext); ++it) sum += *it;
+        QCOMPARE(sum, double(-3 + 0 + 7 + 32767 - 32768));
+        QVERIFY(!ds.isVectorColumn(ext));
+
+        // writes go into the typed memory (rounded and clipped)
+        ds.set(ext, 1, 2.6);
+        QCOMPARE(adc[1], int16_t(3));
+        ds.set(ext, 1, 1e6);
+        QCOMPARE(adc[1], int16_t(32767));
+        ds.set(ext, 1, JKQTP_NAN);
+        QCOMPARE(adc[1], int16_t(0));
+        ds.inc(ext, 0, 1.0);
+        QCOMPARE(adc[0], int16_t(-2));
+
+        // copied typed columns own their memory
+        std::vector<uint16_t> frame(12);
+        for (size_t i = 0; i < frame.size(); ++i) frame[i] = static_cast<uint16_t>(i * 1000);
+        const size_t img = ds.addCopiedTypedImageColumn(frame.data(), JKQTPMathImageDataType::UInt16Array, 4, 3, QString("frame"));
+        frame[5] = 0;
+        QVERIFY(ds.getColumnRawPointer(img) != static_cast<const void*>(frame.data()));
+        QCOMPARE(ds.getColumnImageWidth(static_cast<int>(img)), static_cast<size_t>(4));
+        QCOMPARE(ds.getPixel(img, 1, 1), 5000.0);
+        QVERIFY(ds.getColumnChecksum(static_cast<int>(img)) != 0);
+
+        // append converts to a double vector column
+        ds.appendToColumn(img, 1.5);
+        QVERIFY(ds.isVectorColumn(img));
+        QVERIFY(ds.getColumnDataType(img) == JKQTPMathImageDataType::DoubleArray);
+        QCOMPARE(ds.getRows(img), static_cast<size_t>(13));
+        QCOMPARE(ds.get(img, 11), 11000.0);
+        QCOMPARE(ds.get(img, 12), 1.5);
+
+        // float columns
+        const float fdata[3] = {0.5f, -1.25f, 3.0f};
+        const size_t fcol = ds.addCopiedTypedColumn(fdata, 3, QString("float"));
+        QVERIFY(ds.getColumnDataType(fcol) == JKQTPMathImageDataType::FloatArray);
+        QCOMPARE(ds.get(fcol, 1), -1.25);
+
+        // visit() passes a view with the original element type
+        size_t visitedSize = 0;
+        ds.getColumnView(ext).visit([&](const auto& tv) {
+            QVERIFY((std::is_same<decltype(tv.getPointer()), const int16_t*>::value));
+            QCOMPARE(tv.getPointer(), static_cast<const int16_t*>(adc.data()));
+            QCOMPARE(tv[2], 7.0);
+            QVERIFY(std::isnan(tv.getValue(static_cast<int>(adc.size()))));
+            visitedSize = tv.size();
+        });
+        QCOMPARE(visitedSize, adc.size());
+
+        // JKQTPVisitColumnViews() uses typed views for columns of the same type and falls back to JKQTPColumnView otherwise
+        std::vector<int16_t> adc2{1, 2, 3, 4, 5};
+        const size_t ext2 = ds.addTypedColumn(adc2.data(), adc2.size(), QString("adc2"));
+        const size_t dcol = ds.addCopiedColumn(QVector<double>{1.0, 2.0, 3.0}, QString("double"));
+        bool sameTypeTyped = false;
+        JKQTPVisitColumnViews(ds.getColumnView(ext), ds.getColumnView(ext2), [&](const auto& a, const auto& b) {
+            sameTypeTyped = std::is_same<typename std::decay<decltype(a)>::type, JKQTPTypedColumnView<int16_t> >::value
+                            && std::is_same<typename std::decay<decltype(b)>::type, JKQTPTypedColumnView<int16_t> >::value;
+            QCOMPARE(b[4], 5.0);
+        });
+        QVERIFY(sameTypeTyped);
+        bool mixedGeneric = false;
+        JKQTPVisitColumnViews(ds.getColumnView(ext), ds.getColumnView(dcol), [&](const auto& a, const auto& b) {
+            mixedGeneric = std::is_same<typename std::decay<decltype(a)>::type, JKQTPColumnView>::value;
+            QCOMPARE(a[2], 7.0);
+            QCOMPARE(b[2], 3.0);
+        });
+        QVERIFY(mixedGeneric);
+    }
+
+    void test_minMaxPyramid() {
+        JKQTPDatastore ds;
+        const size_t N = 10000;
+        std::vector<double> data(N);
+        for (size_t i = 0; i < N; ++i) data[i] = sin(double(i) * 0.37) * 100.0 + double(i % 17) - 20.0;
+        data[1234] = JKQTP_NAN;
+        const size_t c = ds.addCopiedColumn(data, QString("data"));
+        const JKQTPColumnView v = ds.getColumnView(c);
+
+        // compare against a brute-force scan for ranges of different lengths and alignment
+        const auto check = [&](size_t start, size_t end) {
+            double bmin = 0, bmax = 0, bsgz = 0;
+            bool any = false;
+            for (size_t i = start; i < end; ++i) {
+                const double x = data[i];
+                if (!std::isfinite(x)) continue;
+                if (!any || x < bmin) bmin = x;
+                if (!any || x > bmax) bmax = x;
+                if (x > 0 && (bsgz <= 0 || x < bsgz)) bsgz = x;
+                any = true;
+            }
+            double pmin = 0, pmax = 0, psgz = 0;
+            QCOMPARE(v.getMinMax(start, end, pmin, pmax, &psgz), any);
+            QCOMPARE(pmin, bmin);
+            QCOMPARE(pmax, bmax);
+            QCOMPARE(psgz, bsgz);
+        };
+        check(0, N);
+        check(0, 1);
+        check(1234, 1235);
+        check(63, 65);
+        check(64, 128);
+        check(100, 9000);
+        check(511, 4097);
+        for (size_t s = 0; s < N; s += 997) {
+            for (size_t len = 1; s + len <= N; len = len * 3 + 1) check(s, s + len);
+        }
+
+        const auto pyramid = v.getMinMaxPyramid();
+        QVERIFY(pyramid != nullptr);
+        QCOMPARE(pyramid->getRows(), N);
+        QVERIFY(pyramid->hasNonFiniteValues());
+        QVERIFY(!pyramid->isSortedAscending());
+        QCOMPARE(pyramid->getLevel(pyramid->getLevelCount() - 1).size(), static_cast<size_t>(1));
+        // the pyramid is cached ...
+        QCOMPARE(v.getMinMaxPyramid(), pyramid);
+
+        // ... and discarded on write
+        ds.set(c, 5000, 1000.0);
+        data[5000] = 1000.0;
+        QVERIFY(v.getMinMaxPyramid() != pyramid);
+        check(0, N);
+        check(4990, 5010);
+        ds.appendToColumn(c, -1000.0);
+        data.push_back(-1000.0);
+        const JKQTPColumnView v2 = ds.getColumnView(c);
+        double pmin = 0, pmax = 0;
+        QVERIFY(v2.getMinMax(0, N + 1, pmin, pmax));
+        QCOMPARE(pmin, -1000.0);
+        QCOMPARE(pmax, 1000.0);
+        ds.scaleColumnValues(c, 2.0);
+        QVERIFY(v2.getMinMax(0, N + 1, pmin, pmax));
+        QCOMPARE(pmin, -2000.0);
+        QCOMPARE(pmax, 2000.0);
+
+        // sortedness and typed columns
+        const size_t lin = ds.addLinearColumn(1000, 0, 10, QString("lin"));
+        QVERIFY(ds.getColumnView(lin).getMinMaxPyramid()->isSortedAscending());
+        QVERIFY(!ds.getColumnView(lin).getMinMaxPyramid()->isSortedDescending());
+        QVERIFY(!ds.getColumnView(lin).getMinMaxPyramid()->hasNonFiniteValues());
+        std::vector<int16_t> adc(300);
+        for (size_t i = 0; i < adc.size(); ++i) adc[i] = static_cast<int16_t>(1000 - int(i) * 5);
+        const size_t typed = ds.addTypedColumn(adc.data(), adc.size(), QString("adc"));
+        QVERIFY(ds.getColumnView(typed).getMinMaxPyramid()->isSortedDescending());
+        QVERIFY(ds.getColumnView(typed).getMinMax(10, 200, pmin, pmax));
+        QCOMPARE(pmin, double(adc[199]));
+        QCOMPARE(pmax, double(adc[10]));
+
+        // empty ranges / invalid views
+        QVERIFY(!v2.getMinMax(10, 10, pmin, pmax));
+        QVERIFY(!JKQTPColumnView().getMinMax(0, 10, pmin, pmax));
+    }
+
+    void test_columnStatisticsAndGeneration() {
+        JKQTPDatastore ds;
+        const size_t c = ds.addCopiedColumn(std::vector<double>{3.0, -1.0, 0.5, JKQTP_NAN, 7.0}, QString("c"));
+        JKQTPColumnStatistics st = ds.getColumnStatistics(c);
+        QCOMPARE(st.rows, static_cast<size_t>(5));
+        QVERIFY(st.hasFiniteValues);
+        QVERIFY(st.hasNonFiniteValues);
+        QCOMPARE(st.minValue, -1.0);
+        QCOMPARE(st.maxValue, 7.0);
+        QCOMPARE(st.smallestGreaterZero, 0.5);
+        QVERIFY(!st.sortedAscending);
+        QVERIFY(!st.sortedDescending);
+        // the statistics are cached, as long as the data is not modified
+        const quint64 gen0 = st.generation;
+        QCOMPARE(ds.getColumnStatistics(c).generation, gen0);
+
+        // every modifying access increments the generation
+        quint64 lastGen = gen0;
+        const auto checkModified = [&](const char* what, double expectedMin, double expectedMax) {
+            const JKQTPColumnStatistics s = ds.getColumnStatistics(c);
+            if (s.generation <= lastGen) qDebug() << "generation not incremented by" << what;
+            QVERIFY(s.generation > lastGen);
+            QCOMPARE(s.minValue, expectedMin);
+            QCOMPARE(s.maxValue, expectedMax);
+            lastGen = s.generation;
+        };
+        ds.set(c, 3, 10.0);
+        checkModified("set()", -1.0, 10.0);
+        ds.appendToColumn(c, -5.0);
+        checkModified("appendToColumn()", -5.0, 10.0);
+        ds.scaleColumnValues(c, 2.0);
+        checkModified("scaleColumnValues()", -10.0, 20.0);
+        ds.inc(c, 0, 100.0);
+        checkModified("inc()", -10.0, 106.0);
+        ds.resizeColumn(c, 3);
+        checkModified("resizeColumn()", -2.0, 106.0);
+        for (auto it = ds.begin(c); it != ds.end(c); ++it) *it = 1.0;
+        checkModified("iterator", 1.0, 1.0);
+        ds.setAll(c, 4.0);
+        checkModified("setAll()", 4.0, 4.0);
+        QVERIFY(ds.getColumnStatistics(c).sortedAscending);
+        QVERIFY(ds.getColumnStatistics(c).sortedDescending);
+
+        // changes to external memory have to be marked as modified ...
+        std::vector<double> ext(100);
+        for (size_t i = 0; i < ext.size(); i++) ext[i] = static_cast<double>(i);
+        const size_t e = ds.addColumn(ext.data(), ext.size(), QString("ext"));
+        const JKQTPColumnView ev = ds.getColumnView(e);
+        double rmin = 0, rmax = 0;
+        QCOMPARE(ds.getColumnStatistics(e).maxValue, 99.0);
+        QVERIFY(ds.getColumnStatistics(e).sortedAscending);
+        QVERIFY(ev.getMinMax(10, 90, rmin, rmax));
+        QCOMPARE(rmax, 89.0);
+        ext[0] = 500.0;
+        ext[50] = -500.0;
+        QCOMPARE(ds.getColumnStatistics(e).maxValue, 99.0);
+        ds.markColumnModified(e);
+        QCOMPARE(ds.getColumnStatistics(e).maxValue, 500.0);
+        QVERIFY(!ds.getColumnStatistics(e).sortedAscending);
+        QVERIFY(ev.getMinMax(10, 90, rmin, rmax));
+        QCOMPARE(rmin, -500.0);
+        QCOMPARE(rmax, 89.0);
+        // ... unless the column detects them with a hash over the data
+        QVERIFY(!ds.getColumnDetectExternalChanges(e));
+        ds.setColumnDetectExternalChanges(e, true);
+        QVERIFY(ds.getColumnDetectExternalChanges(e));
+        ext[50] = 50.0;
+        QCOMPARE(ds.getColumnStatistics(e).minValue, 1.0);
+        QVERIFY(ev.getMinMax(10, 90, rmin, rmax));
+        QCOMPARE(rmin, 10.0);
+
+        // non-existing columns
+        QVERIFY(!ds.getColumnStatistics(-1).hasFiniteValues);
+        QCOMPARE(ds.getColumnStatistics(static_cast<size_t>(1000)).rows, static_cast<size_t>(0));
+    }
+
+    void test_columnGenerationAndHash64() {
+        // jkqtp_hash64() follows xxHash64
+        QCOMPARE(jkqtp_hash64("", 0), Q_UINT64_C(0xEF46DB3751D8E999));
+        const char* txt = "Nobody inspects the spammish repetition";
+        QCOMPARE(jkqtp_hash64(txt, strlen(txt)), Q_UINT64_C(0xFBCEA83C8A378BF1));
+
+        JKQTPDatastore ds;
+        const size_t c1 = ds.addCopiedColumn(std::vector<double>{1.0, 2.0, 3.0}, QString("c1"));
+        const size_t c2 = ds.addCopiedColumn(std::vector<double>{1.0, 2.0, 3.0}, QString("c2"));
+        // the generation is O(1) and distinct for different columns, the hash depends only on the data
+        const quint64 g1 = ds.getColumnGeneration(c1);
+        QVERIFY(g1 != ds.getColumnGeneration(c2));
+        QCOMPARE(ds.getColumnHash64(c1), ds.getColumnHash64(c2));
+        QCOMPARE(ds.getColumnGeneration(c1), g1);
+        ds.set(c1, 1, 5.0);
+        QVERIFY(ds.getColumnGeneration(c1) > g1);
+        QVERIFY(ds.getColumnHash64(c1) != ds.getColumnHash64(c2));
+
+        // a column that replaces a deleted column has a new generation
+        const quint64 g2 = ds.getColumnGeneration(c2);
+        ds.deleteColumn(c2);
+        QCOMPARE(ds.getColumnGeneration(c2), Q_UINT64_C(0));
+        const size_t c3 = ds.addCopiedColumn(std::vector<double>{1.0, 2.0, 3.0}, QString("c3"));
+        QVERIFY(ds.getColumnGeneration(c3) != g2);
+
+        // changes in external memory are not visible in the generation, but in the hash
+        std::vector<int16_t> ext{1, 2, 3, 4};
+        const size_t e = ds.addTypedColumn(ext.data(), ext.size(), QString("ext"));
+        const quint64 ge = ds.getColumnGeneration(e);
+        const quint64 he = ds.getColumnHash64(e);
+        QCOMPARE(he, jkqtp_hash64(ext.data(), ext.size()*sizeof(int16_t)));
+        ext[2] = 10;
+        QCOMPARE(ds.getColumnGeneration(e), ge);
+        QVERIFY(ds.getColumnHash64(e) != he);
+        ds.markColumnModified(e);
+        QVERIFY(ds.getColumnGeneration(e) != ge);
+
+        // the data key is the generation, only external columns that detect external changes also hash the data
+        QCOMPARE(ds.getColumnDataKey(c1), ds.getColumnGeneration(c1));
+        QCOMPARE(ds.getColumnDataKey(e), ds.getColumnGeneration(e));
+        ext[0] = 7;
+        QCOMPARE(ds.getColumnDataKey(e), ds.getColumnGeneration(e));
+        ds.setColumnDetectExternalChanges(e, true);
+        const quint64 ke = ds.getColumnDataKey(e);
+        QVERIFY(ke != ds.getColumnGeneration(e));
+        QCOMPARE(ds.getColumnDataKey(e), ke);
+        ext[0] = 1;
+        QVERIFY(ds.getColumnDataKey(e) != ke);
+        ext[0] = 7;
+        QCOMPARE(ds.getColumnDataKey(e), ke);
+        ds.setColumnDetectExternalChanges(c1, true);
+        QCOMPARE(ds.getColumnDataKey(c1), ds.getColumnGeneration(c1));
+        QCOMPARE(ds.getColumnDataKey(-1), Q_UINT64_C(0));
+
+        QCOMPARE(ds.getColumnGeneration(-1), Q_UINT64_C(0));
+        QCOMPARE(ds.getColumnHash64(1000), Q_UINT64_C(0));
+    }
+
+    void test_modificationGuard() {
+        JKQTPDatastore ds;
+        const size_t c = ds.addCopiedColumn(std::vector<double>{1.0, 2.0, 3.0}, QString("c"));
+        int calls1 = 0, calls2 = 0;
+        ds.setModificationGuard(&calls1, [&calls1]() { calls1++; });
+        ds.setModificationGuard(&calls2, [&calls2]() { calls2++; });
+        // reading does not call the guards
+        QCOMPARE(ds.get(c, 1), 2.0);
+        QCOMPARE(ds.getColumnStatistics(c).maxValue, 3.0);
+        QCOMPARE(calls1, 0);
+        // all modifications call every guard before the data is changed
+        ds.set(c, 1, 5.0);
+        QCOMPARE(calls1, 1);
+        QCOMPARE(calls2, 1);
+        ds.appendToColumn(c, 4.0);
+        QVERIFY(calls1 >= 2);
+        int calls = calls1;
+        const size_t c2 = ds.addColumn(5, QString("c2"));
+        QVERIFY(calls1 > calls);
+        calls = calls1;
+        ds.deleteColumn(c2);
+        QVERIFY(calls1 > calls);
+        calls = calls1;
+        ds.markColumnModified(c);
+        QVERIFY(calls1 > calls);
+        // a guard is replaced by registering the same owner again and can be removed
+        calls = calls1;
+        ds.setModificationGuard(&calls2, [&calls2]() { calls2 += 100; });
+        ds.removeModificationGuard(&calls1);
+        ds.set(c, 0, 1.0);
+        QCOMPARE(calls1, calls);
+        QVERIFY(calls2 >= 100);
+        ds.removeModificationGuard(&calls2);
+        calls = calls2;
+        ds.clear();
+        QCOMPARE(calls2, calls);
+    }
+
+    void test_ringBufferColumn() {
+        JKQTPDatastore ds;
+        const size_t c = ds.addRingBufferColumn(5, QString("ring"));
+        QVERIFY(ds.isRingBufferColumn(c));
+        QCOMPARE(ds.getRows(c), static_cast<size_t>(0));
+        for (int i=0; i<3; i++) ds.appendToColumn(c, double(i));
+        QCOMPARE(ds.getRows(c), static_cast<size_t>(3));
+        QCOMPARE(ds.get(c, 0), 0.0);
+        QCOMPARE(ds.get(c, 2), 2.0);
+        QVERIFY(std::isnan(ds.get(c, 3)));
+
+        // when the buffer is full, the oldest values are dropped, row 0 is the oldest value, the rows are contiguous
+        const quint64 g = ds.getColumnGeneration(c);
+        for (int i=3; i<23; i++) {
+            ds.appendToColumn(c, double(i));
+            QCOMPARE(ds.getRows(c), static_cast<size_t>(std::min(i+1, 5)));
+            const JKQTPColumnView view = ds.getColumnView(c);
+            QVERIFY(view.getPointer()!=nullptr);
+            for (size_t r=0; r<view.size(); r++) {
+                QCOMPARE(view[r], double(i+1-int(view.size())+int(r)));
+                QCOMPARE(view.getPointer()[r], view[r]);
+            }
+        }
+        QVERIFY(ds.getColumnGeneration(c) > g);
+        QVERIFY(ds.isRingBufferColumn(c));
+        const JKQTPColumnStatistics stat = ds.getColumnStatistics(c);
+        QCOMPARE(stat.minValue, 18.0);
+        QCOMPARE(stat.maxValue, 22.0);
+        QVERIFY(stat.sortedAscending);
+
+        // setValue() keeps the ring-buffer
+        ds.set(c, 1, 100.0);
+        QVERIFY(ds.isRingBufferColumn(c));
+        QCOMPARE(ds.get(c, 1), 100.0);
+        ds.appendToColumn(c, 23.0);
+        QCOMPARE(ds.get(c, 0), 100.0);
+        QCOMPARE(ds.get(c, 4), 23.0);
+
+        // converting keeps the newest rows
+        const size_t v = ds.addCopiedColumn(std::vector<double>{1, 2, 3, 4, 5, 6, 7}, QString("vec"));
+        ds.convertToRingBufferColumn(v, 4);
+        QVERIFY(ds.isRingBufferColumn(v));
+        QCOMPARE(ds.getRows(v), static_cast<size_t>(4));
+        QCOMPARE(ds.get(v, 0), 4.0);
+        QCOMPARE(ds.get(v, 3), 7.0);
+        ds.convertToVectorColumn(v);
+        QVERIFY(!ds.isRingBufferColumn(v));
+        QCOMPARE(ds.getRows(v), static_cast<size_t>(4));
+        ds.appendToColumn(v, 8.0);
+        QCOMPARE(ds.getRows(v), static_cast<size_t>(5));
+        QCOMPARE(ds.get(v, 4), 8.0);
+    }
+
+    void test_appendFramesToColumns() {
+        JKQTPDatastore ds;
+        const size_t r1 = ds.addRingBufferColumn(4, QString("r1"));
+        const size_t r2 = ds.addRingBufferColumn(4, QString("r2"));
+        const size_t v = ds.addColumn(QString("vec"));
+        const std::vector<double> frames{0, 10, 100, 1, 11, 101, 2, 12, 102};
+        QVERIFY(ds.appendFramesToColumns({r1, r2, v}, frames.data(), 3));
+        QVERIFY(ds.appendFramesToColumns({r1, r2, v}, frames.data(), 3));
+        QCOMPARE(ds.getRows(r1), static_cast<size_t>(4));
+        QCOMPARE(ds.getRows(r2), static_cast<size_t>(4));
+        QCOMPARE(ds.getRows(v), static_cast<size_t>(6));
+        const std::vector<double> expected1{2, 0, 1, 2};
+        for (size_t i=0; i<4; i++) {
+            QCOMPARE(ds.get(r1, i), expected1[i]);
+            QCOMPARE(ds.get(r2, i), expected1[i]+10.0);
+        }
+        for (size_t i=0; i<6; i++) {
+            QCOMPARE(ds.get(v, i), double(i%3)+100.0);
+        }
+        // nothing is appended, if a column does not exist
+        QVERIFY(!ds.appendFramesToColumns({r1, 1000}, frames.data(), 1));
+        QCOMPARE(ds.get(r1, 3), 2.0);
+        QCOMPARE(ds.getRows(v), static_cast<size_t>(6));
+    }
+
+    void test_ingestionQueue() {
+        JKQTPDatastore ds;
+        const size_t cX = ds.addColumn(QString("x"));
+        const size_t cY = ds.addRingBufferColumn(1000, QString("y"));
+        QVERIFY(ds.addIngestionQueue({cX, 1000}, 10)==nullptr);
+        std::shared_ptr<JKQTPDatastoreIngestionQueue> queue = ds.addIngestionQueue({cX, cY}, 3);
+        QVERIFY(queue!=nullptr);
+        QCOMPARE(ds.getIngestionQueueCount(), static_cast<size_t>(1));
+        QCOMPARE(queue->getCapacityFrames(), static_cast<size_t>(3));
+        QVERIFY(!ds.hasPendingIngestion());
+        // the 4th and 5th frame do not fit into the queue
+        const std::vector<double> frames{0, 10, 1, 11, 2, 12, 3, 13, 4, 14};
+        QCOMPARE(queue->pushFrames(frames.data(), 5), static_cast<size_t>(3));
+        QVERIFY(!queue->pushFrame({5, 15}));
+        QVERIFY(ds.hasPendingIngestion());
+        QCOMPARE(ds.getRows(cX), static_cast<size_t>(0));
+        QCOMPARE(ds.drainIngestionQueues(), static_cast<size_t>(3));
+        QVERIFY(!ds.hasPendingIngestion());
+        QCOMPARE(ds.getRows(cX), static_cast<size_t>(3));
+        QCOMPARE(ds.getRows(cY), static_cast<size_t>(3));
+        // the frames wrap around the end of the queue
+        QVERIFY(queue->pushFrame({6, 16}));
+        QCOMPARE(ds.drainIngestionQueues(), static_cast<size_t>(1));
+        QCOMPARE(queue->pushFrames(frames.data(), 3), static_cast<size_t>(3));
+        QCOMPARE(ds.drainIngestionQueues(), static_cast<size_t>(3));
+        const std::vector<double> expectedX{0, 1, 2, 6, 0, 1, 2};
+        QCOMPARE(ds.getRows(cX), expectedX.size());
+        for (size_t i=0; i<expectedX.size(); i++) {
+            QCOMPARE(ds.get(cX, i), expectedX[i]);
+            QCOMPARE(ds.get(cY, i), expectedX[i]+10.0);
+        }
+        JKQTPDatastoreIngestionQueue::Statistics stat=queue->getStatistics();
+        QCOMPARE(stat.pushedFrames, static_cast<uint64_t>(7));
+        QCOMPARE(stat.droppedFrames, static_cast<uint64_t>(3));
+        QCOMPARE(stat.drainedFrames, static_cast<uint64_t>(7));
+        QCOMPARE(stat.drainCount, static_cast<uint64_t>(3));
+        QCOMPARE(stat.maxPendingFrames, static_cast<size_t>(3));
+        // frames from a producer thread
+        const size_t N=100000;
+        std::thread producer([queue, N]() {
+            for (size_t i=0; i<N; ) {
+                if (queue->pushFrame({double(i), double(i)+10.0})) i++;
+                else std::this_thread::yield();
+            }
+        });
+        size_t drained=0;
+        while (drained<N) drained+=ds.drainIngestionQueues();
+        producer.join();
+        QCOMPARE(ds.getRows(cX), N+expectedX.size());
+        QCOMPARE(ds.get(cX, N+expectedX.size()-1), double(N-1));
+        QCOMPARE(ds.get(cY, 999), double(N-1)+10.0);
+        ds.removeIngestionQueue(queue);
+        QCOMPARE(ds.getIngestionQueueCount(), static_cast<size_t>(0));
+    }
 };
 
 QTEST_MAIN(TestJKQTPDatastoreCombined)
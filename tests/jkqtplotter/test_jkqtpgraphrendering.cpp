@@ -0,0 +1,1003 @@
+// Rendering regression tests for JKQTPlotter graphs
+// Uses Qt Test framework
+//
+// These tests render graphs into QImages and compare optimized drawing paths
+// against the reference (full) drawing path.
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QPicture>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "jkqtplotter/jkqtpbaseplotter.h"
+#include "jkqtplotter/jkqtplotter.h"
+#include "jkqtplotter/graphs/jkqtplines.h"
+#include "jkqtplotter/graphs/jkqtpscatter.h"
+#include "jkqtplotter/graphs/jkqtpevaluatedfunction.h"
+#include "jkqtplotter/graphs/jkqtpimage.h"
+#include "jkqtplotter/graphs/jkqtpimagergb.h"
+#include "jkqtplotter/graphs/jkqtpcontour.h"
+#include "jkqtcommon/jkqtpdrawingtools.h"
+
+/** \brief verifies that \a image looks like \a reference , i.e. at most the fraction \a maxFraction of the pixels differ by more than
+ *         \a tolerance in any color channel (see TestJKQTPGraphRendering::compareImages() ). The difference is reported only on failure,
+ *         \a what describes the compared renderings in the message. */
+#define VERIFY_IMAGES_SIMILAR(reference, image, maxFraction, tolerance, what) \
+    do { \
+        const QByteArray imageMismatch=compareImages((reference), (image), (maxFraction), (tolerance), (what)); \
+        QVERIFY2(imageMismatch.isEmpty(), imageMismatch.constData()); \
+    } while (false)
+
+class TestJKQTPGraphRendering : public QObject
+{
+    Q_OBJECT
+
+private:
+    /** \brief returns the fraction of pixels in \a a and \a b that differ by more than \a tolerance in any color channel */
+    static double differingPixelFraction(const QImage& a, const QImage& b, int tolerance=64) {
+        if (a.size()!=b.size()) return 1.0;
+        const QImage ia=a.convertToFormat(QImage::Format_ARGB32);
+        const QImage ib=b.convertToFormat(QImage::Format_ARGB32);
+        size_t differing=0;
+        for (int y=0; y<ia.height(); y++) {
+            const QRgb* la=reinterpret_cast<const QRgb*>(ia.constScanLine(y));
+            const QRgb* lb=reinterpret_cast<const QRgb*>(ib.constScanLine(y));
+            for (int x=0; x<ia.width(); x++) {
+                if (abs(qRed(la[x])-qRed(lb[x]))>tolerance || abs(qGreen(la[x])-qGreen(lb[x]))>tolerance || abs(qBlue(la[x])-qBlue(lb[x]))>tolerance || abs(qAlpha(la[x])-qAlpha(lb[x]))>tolerance) {
+                    differing++;
+                }
+            }
+        }
+        return double(differing)/double(ia.width()*ia.height());
+    }
+
+    /** \brief returns an empty string, if less than the fraction \a maxFraction of the pixels in \a image differ from \a reference by more
+     *         than \a tolerance (for \a maxFraction \c ==0 : if no pixel differs), otherwise a description of the difference for
+     *         QVERIFY2(), starting with \a what \see VERIFY_IMAGES_SIMILAR() */
+    static QByteArray compareImages(const QImage& reference, const QImage& image, double maxFraction, int tolerance, const QString& what) {
+        const double diff=differingPixelFraction(reference, image, tolerance);
+        if ((maxFraction>0.0)?(diff<maxFraction):(diff==0.0)) return QByteArray();
+        return QString("%1: %2% of the pixels differ by more than %3 (allowed: %4%)").arg(what).arg(diff*100.0).arg(tolerance).arg(maxFraction*100.0).toLocal8Bit();
+    }
+
+    /** \brief renders a JKQTPXYLineGraph of the data \a X / \a Y into an image, if \a xmin / \a xmax are given, the x-axis is set to this range,
+     *         for \a devicePixelRatio \c !=1 the image has this device pixel ratio (i.e. simulates a HiDPI screen) */
+    static QImage renderLineGraph(const std::vector<double>& X, const std::vector<double>& Y, bool useMinMaxDecimation, JKQTPGraphSymbols symbol=JKQTPNoSymbol, double xmin=JKQTP_NAN, double xmax=JKQTP_NAN, bool invertX=false, double devicePixelRatio=1.0) {
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addCopiedColumn(X, "x");
+        const size_t cy=ds->addCopiedColumn(Y, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setSymbolType(symbol);
+        graph->setUseMinMaxDecimation(useMinMaxDecimation);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        if (std::isfinite(xmin) && std::isfinite(xmax)) plot.setX(xmin, xmax);
+        plot.getXAxis()->setInverted(invertX);
+        if (devicePixelRatio!=1.0) {
+            QImage img(QSize(800,600)*devicePixelRatio, QImage::Format_ARGB32);
+            img.setDevicePixelRatio(devicePixelRatio);
+            img.fill(Qt::transparent);
+            JKQTPEnhancedPainter painter;
+            painter.begin(&img);
+            painter.setRenderHint(JKQTPEnhancedPainter::Antialiasing);
+            plot.draw(painter, QRect(0,0,800,600));
+            painter.end();
+            return img;
+        }
+        return plot.grabPixelImage(QSize(800,600), false);
+    }
+
+    /** \brief renders a JKQTPMathImage of the smooth test image \a img ( \a Nx * \a Ny ) into an image, optionally zoomed to \a xmin .. \a xmax / \a ymin .. \a ymax */
+    static QImage renderMathImage(const std::vector<double>& img, int Nx, int Ny, bool viewportRendering, JKQTPMathImage::ViewportDownsamplingMode mode=JKQTPMathImage::NearestNeighbourDownsampling, double xmin=JKQTP_NAN, double xmax=JKQTP_NAN, double ymin=JKQTP_NAN, double ymax=JKQTP_NAN, bool invertX=false) {
+        JKQTBasePlotter plot(true);
+        JKQTPMathImage* graph=new JKQTPMathImage(0, 0, Nx, Ny, JKQTPMathImageDataType::DoubleArray, img.data(), Nx, Ny, JKQTPMathImageMATLAB, &plot);
+        graph->setViewportRendering(viewportRendering);
+        graph->setViewportDownsampling(mode);
+        graph->setShowColorBar(false);
+        plot.addGraph(graph);
+        plot.setXY(0, Nx, 0, Ny);
+        if (std::isfinite(xmin) && std::isfinite(xmax)) plot.setX(xmin, xmax);
+        if (std::isfinite(ymin) && std::isfinite(ymax)) plot.setY(ymin, ymax);
+        plot.getXAxis()->setInverted(invertX);
+        return plot.grabPixelImage(QSize(800,600), false);
+    }
+
+private slots:
+
+    void test_minMaxDecimator() {
+        QPolygonF out;
+        JKQTPMinMaxPolyLineDecimator decimator(&out, 1.0);
+        // bin 0: first, max, min, last
+        QVERIFY(decimator.add(QPointF(0.1, 5)));
+        QVERIFY(decimator.add(QPointF(0.2, 9)));
+        QVERIFY(decimator.add(QPointF(0.3, 7)));
+        QVERIFY(decimator.add(QPointF(0.4, 1)));
+        QVERIFY(decimator.add(QPointF(0.5, 3)));
+        QVERIFY(decimator.add(QPointF(0.6, 4)));
+        // bin 1: single point
+        QVERIFY(decimator.add(QPointF(1.5, 2)));
+        decimator.flush();
+        QCOMPARE(out.size(), 5);
+        QCOMPARE(out[0], QPointF(0.1, 5));
+        QCOMPARE(out[1], QPointF(0.2, 9));
+        QCOMPARE(out[2], QPointF(0.4, 1));
+        QCOMPARE(out[3], QPointF(0.6, 4));
+        QCOMPARE(out[4], QPointF(1.5, 2));
+        // non-monotonic x is detected
+        QVERIFY(!decimator.add(QPointF(0.5, 2)));
+
+        // decreasing x (e.g. inverted axis) is fine
+        QPolygonF outDec;
+        JKQTPMinMaxPolyLineDecimator decimatorDec(&outDec, 1.0);
+        for (int i=100; i>0; i--) QVERIFY(decimatorDec.add(QPointF(double(i)/10.0, double(i%3))));
+        decimatorDec.flush();
+        QVERIFY(outDec.size()<=4*11);
+        QVERIFY(!decimatorDec.add(QPointF(50, 0)));
+
+        // bins of width 0.5, starting at 0.25 (e.g. device pixel columns for a device pixel ratio of 2 and an offset)
+        QPolygonF outHalf;
+        JKQTPMinMaxPolyLineDecimator decimatorHalf(&outHalf, 0.5, 0.25);
+        for (double x: {0.3, 0.4, 0.5, 0.6, 0.7}) QVERIFY(decimatorHalf.add(QPointF(x, x*10.0)));
+        QVERIFY(decimatorHalf.add(QPointF(0.8, 1.0)));
+        decimatorHalf.flush();
+        QCOMPARE(outHalf.size(), 3);
+        QCOMPARE(outHalf[1], QPointF(0.7, 7.0));
+        QCOMPARE(outHalf[2], QPointF(0.8, 1.0));
+    }
+
+    void test_lineGraphMinMaxDecimation_sortedData() {
+        const size_t N=200000;
+        std::vector<double> X(N), Y(N);
+        for (size_t i=0; i<N; i++) {
+            X[i]=double(i)/double(N)*10.0;
+            Y[i]=sin(X[i])+0.3*sin(double(i)*0.7)+((i%1000==0)?2.0:0.0);
+        }
+        for (double dpr: {1.0, 2.0}) {
+            const QImage full=renderLineGraph(X, Y, false, JKQTPNoSymbol, JKQTP_NAN, JKQTP_NAN, false, dpr);
+            const QImage decimated=renderLineGraph(X, Y, true, JKQTPNoSymbol, JKQTP_NAN, JKQTP_NAN, false, dpr);
+            QVERIFY(!full.isNull());
+            QCOMPARE(decimated.size(), full.size());
+            VERIFY_IMAGES_SIMILAR(full, decimated, 0.002, 32, QString("sorted data, devicePixelRatio=%1, decimated vs. full").arg(dpr));
+        }
+    }
+
+    void test_lineGraphMinMaxDecimation_zoomed() {
+        // large dataset, so the min/max pyramid of the column is used
+        const size_t N=400000;
+        std::vector<double> X(N), Y(N);
+        for (size_t i=0; i<N; i++) {
+            X[i]=double(i)/double(N)*100.0;
+            Y[i]=sin(X[i])+0.5*sin(double(i)*0.13)+((i%5000==0)?3.0:0.0);
+        }
+        const double ranges[3][2]={{0.0, 100.0}, {31.4, 47.3}, {99.0, 99.9}};
+        for (const auto& r: ranges) {
+            for (bool inverted: {false, true}) {
+                for (double dpr: {1.0, 2.0}) {
+                    const QImage full=renderLineGraph(X, Y, false, JKQTPNoSymbol, r[0], r[1], inverted, dpr);
+                    const QImage decimated=renderLineGraph(X, Y, true, JKQTPNoSymbol, r[0], r[1], inverted, dpr);
+                    VERIFY_IMAGES_SIMILAR(full, decimated, 0.002, 32, QString("x=%1..%2, inverted=%3, devicePixelRatio=%4, decimated vs. full").arg(r[0]).arg(r[1]).arg(inverted).arg(dpr));
+                }
+            }
+        }
+    }
+
+    void test_lineGraphMinMaxDecimation_fallbacks() {
+        const size_t N=5000;
+        std::vector<double> X(N), Y(N);
+        for (size_t i=0; i<N; i++) {
+            const double t=double(i)/double(N)*2.0*3.141592653589793;
+            // not monotonic in x: decimation has to fall back to drawing all points
+            X[i]=cos(3.0*t);
+            Y[i]=sin(2.0*t);
+        }
+        QCOMPARE(renderLineGraph(X, Y, true), renderLineGraph(X, Y, false));
+        // with symbols, all points are drawn
+        for (size_t i=0; i<N; i++) X[i]=double(i);
+        QCOMPARE(renderLineGraph(X, Y, true, JKQTPCross), renderLineGraph(X, Y, false, JKQTPCross));
+    }
+
+    void test_hitTestSpatialIndex() {
+        const size_t N=30000;
+        std::mt19937 rng(42);
+        std::normal_distribution<double> dist(0.0, 1.0);
+        std::vector<double> X(N), Y(N);
+        for (size_t i=0; i<N; i++) {
+            X[i]=dist(rng)*((i%3==0)?10.0:1.0);
+            Y[i]=(i%101==0)?JKQTP_NAN:dist(rng);
+        }
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addCopiedColumn(X, "x");
+        const size_t cy=ds->addCopiedColumn(Y, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        plot.setX(-5, 5);
+        plot.grabPixelImage(QSize(800,600), false);
+        QVERIFY(static_cast<int>(N)>=JKQTPXYGraph::HitTestIndexMinPoints);
+
+        // reference: search through all points
+        const auto bruteForce=[&](const QPointF& pos, JKQTPPlotElement::HitTestMode mode) {
+            const QPointF posF(graph->transformX(pos.x()), graph->transformY(pos.y()));
+            double best=JKQTP_NAN;
+            for (size_t i=0; i<N; i++) {
+                const double dx=graph->transformX(X[i])-posF.x();
+                const double dy=graph->transformY(Y[i])-posF.y();
+                if (!JKQTPIsOKFloat(dx) || !JKQTPIsOKFloat(dy)) continue;
+                const double d=(mode==JKQTPPlotElement::HitTestXY)?sqrt(dx*dx+dy*dy):((mode==JKQTPPlotElement::HitTestXOnly)?fabs(dx):fabs(dy));
+                if (!JKQTPIsOKFloat(best) || d<best) best=d;
+            }
+            return best;
+        };
+        for (int q=0; q<200; q++) {
+            const QPointF pos(dist(rng)*8.0, dist(rng)*2.0);
+            for (auto mode: {JKQTPPlotElement::HitTestXY, JKQTPPlotElement::HitTestXOnly, JKQTPPlotElement::HitTestYOnly}) {
+                QPointF closest;
+                const double d=graph->hitTest(pos, &closest, nullptr, mode);
+                QVERIFY(JKQTPIsOKFloat(d));
+                QVERIFY(fabs(d-bruteForce(pos, mode))<1e-9);
+            }
+        }
+
+        // the index is rebuilt, when the data changes
+        ds->set(cx, 17, 3.5);
+        ds->set(cy, 17, 0.25);
+        QPointF closest;
+        QCOMPARE(graph->hitTest(QPointF(3.5, 0.25), &closest), 0.0);
+        QCOMPARE(closest, QPointF(3.5, 0.25));
+
+        // ... and when external memory is changed in place and marked as modified
+        const size_t ex=ds->addColumn(X.data(), N, "ex");
+        const size_t ey=ds->addColumn(Y.data(), N, "ey");
+        graph->setXYColumns(ex, ey);
+        QVERIFY(graph->hitTest(QPointF(-2.5, 0.75), &closest)>0.0);
+        X[23]=-2.5;
+        Y[23]=0.75;
+        ds->markColumnModified(ex);
+        ds->markColumnModified(ey);
+        QCOMPARE(graph->hitTest(QPointF(-2.5, 0.75), &closest), 0.0);
+        QCOMPARE(closest, QPointF(-2.5, 0.75));
+    }
+
+    void test_parallelGraphRendering() {
+        const size_t N=2000;
+        const auto render=[&](bool parallel, int threads) {
+            JKQTBasePlotter plot(true);
+            JKQTPDatastore* ds=plot.getDatastore();
+            const size_t cx=ds->addLinearColumn(N, 0, 10, "x");
+            for (int g=0; g<13; g++) {
+                const size_t cy=ds->addCalculatedColumnFromColumn(cx, [g](double x) { return sin(x+double(g)*0.3)+double(g)*0.2; }, "y");
+                if (g%4==1) {
+                    JKQTPXYScatterGraph* graph=new JKQTPXYScatterGraph(&plot);
+                    graph->setXYColumns(cx, cy);
+                    graph->setSymbolType(JKQTPFilledTriangle);
+                    plot.addGraph(graph);
+                    continue;
+                }
+                JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+                graph->setXYColumns(cx, cy);
+                graph->setSymbolType((g%3==0)?JKQTPFilledCircle:JKQTPNoSymbol);
+                graph->setLineWidth(1.0+double(g%4));
+                if (g==5) graph->setVisible(false);
+                plot.addGraph(graph);
+            }
+            plot.addGraph(new JKQTPXFunctionLineGraph([](double x) { return cos(x*2.0)+1.0; }, "f(x)", &plot));
+            plot.zoomToFit();
+            plot.setParallelGraphRendering(parallel);
+            plot.setParallelGraphRenderingThreads(threads);
+            return plot.grabPixelImage(QSize(800,600), false);
+        };
+        {
+            JKQTBasePlotter plot(true);
+            QVERIFY(JKQTPXYScatterGraph(&plot).canDrawInParallel());
+            QVERIFY(JKQTPXYParametrizedScatterGraph(&plot).canDrawInParallel());
+            QVERIFY(JKQTPXFunctionLineGraph(&plot).canDrawInParallel());
+            QVERIFY(JKQTPColumnMathImage(&plot).canDrawInParallel());
+        }
+        const QImage serial=render(false, 0);
+        // the worker threads are reused for the following frames
+        for (int threads: {2, 3, 4, 16, 4}) {
+            const QImage parallel=render(true, threads);
+            QCOMPARE(parallel.size(), serial.size());
+            VERIFY_IMAGES_SIMILAR(serial, parallel, 0.0005, 2, QString("parallel with %1 threads vs. serial").arg(threads));
+        }
+    }
+
+    void test_layerCaching() {
+        const size_t N=1000;
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 10, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setTitle("graph");
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        const auto render=[&]() {
+            QImage img(800, 600, QImage::Format_ARGB32_Premultiplied);
+            img.fill(Qt::transparent);
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+            return img;
+        };
+        const QImage reference=render();
+        plot.setLayerCaching(true);
+        plot.resetLayerRenderCounts();
+
+        // the first frame draws all layers, the second none
+        const QImage cached1=render();
+        const QImage cached2=render();
+        VERIFY_IMAGES_SIMILAR(reference, cached1, 0.0005, 2, "layer cache vs. direct drawing");
+        QCOMPARE(cached2, cached1);
+        for (auto layer: {JKQTBasePlotter::BackgroundLayer, JKQTBasePlotter::GraphsLayer, JKQTBasePlotter::AxesLayer, JKQTBasePlotter::KeyLayer}) {
+            QCOMPARE(plot.getLayerRenderCount(layer), quint64(1));
+        }
+
+        // highlighting a graph only invalidates the graphs
+        QVector<JKQTBasePlotter::DrawingLayers> layersUpdated;
+        connect(&plot, &JKQTBasePlotter::plotLayersUpdated, [&layersUpdated](JKQTBasePlotter::DrawingLayers layers) { layersUpdated.push_back(layers); });
+        graph->setHighlighted(true);
+        QCOMPARE(layersUpdated.size(), 1);
+        QCOMPARE(layersUpdated.first(), JKQTBasePlotter::DrawingLayers(JKQTBasePlotter::GraphsLayer));
+        const QImage highlighted=render();
+        QVERIFY(highlighted!=cached1);
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::BackgroundLayer), quint64(1));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(2));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::AxesLayer), quint64(1));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::KeyLayer), quint64(1));
+        // ... setting the same value again does nothing
+        graph->setHighlighted(true);
+        QCOMPARE(layersUpdated.size(), 1);
+
+        // the style of the key only invalidates the key, the plot frame only the background
+        plot.getMainKey()->setTextColor(QColor("blue"));
+        render();
+        plot.setPlotFrameColor(QColor("green"));
+        render();
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::BackgroundLayer), quint64(2));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(2));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::AxesLayer), quint64(1));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::KeyLayer), quint64(2));
+
+        // zooming invalidates all layers automatically
+        plot.setX(2, 5);
+        render();
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::BackgroundLayer), quint64(3));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(3));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::AxesLayer), quint64(2));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::KeyLayer), quint64(3));
+    }
+
+    void test_stripChartMode() {
+        const size_t N=20000;
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cx=ds->addLinearColumn(N, 0, 20, "x");
+        const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(3.0*x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cx, cy);
+        graph->setSymbolType(JKQTPNoSymbol);
+        plot.addGraph(graph);
+        plot.setXY(0, 10, -1.5, 1.5);
+        const auto render=[&]() {
+            QImage img(800, 600, QImage::Format_ARGB32_Premultiplied);
+            img.fill(Qt::transparent);
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+            return img;
+        };
+        plot.setLayerCaching(true);
+        plot.setStripChartMode(true);
+        plot.resetLayerRenderCounts();
+        render();
+        QCOMPARE(plot.getStripChartRenderCount(), quint64(0));
+
+        // advance the x-range by 3 pixels per frame: only a strip of the graphs is drawn
+        const double pixelWidth=1.0/fabs(plot.getXAxis()->x2p(1)-plot.getXAxis()->x2p(0));
+        double xmin=0;
+        QImage strip;
+        for (int i=0; i<20; i++) {
+            xmin+=3.0*pixelWidth;
+            plot.setX(xmin, xmin+10);
+            strip=render();
+        }
+        QCOMPARE(plot.getStripChartRenderCount(), quint64(20));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::BackgroundLayer), quint64(21));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::KeyLayer), quint64(1));
+
+        // ... and looks like the completely drawn plot
+        plot.setStripChartMode(false);
+        plot.invalidateLayers();
+        const QImage full=render();
+        VERIFY_IMAGES_SIMILAR(full, strip, 0.002, 64, "strip-chart vs. full");
+
+        // non-integer shifts are rounded, changes of the y-range and invalidateStripChart() draw completely
+        plot.setStripChartMode(true);
+        plot.resetLayerRenderCounts();
+        render();
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(1));
+        plot.setX(xmin+0.4*pixelWidth, xmin+10+0.4*pixelWidth);
+        render();
+        QCOMPARE(plot.getStripChartRenderCount(), quint64(1));
+        plot.setY(-2, 2);
+        render();
+        QCOMPARE(plot.getStripChartRenderCount(), quint64(1));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(3));
+        plot.invalidateStripChart();
+        plot.setX(xmin+pixelWidth, xmin+10+pixelWidth);
+        render();
+        QCOMPARE(plot.getStripChartRenderCount(), quint64(1));
+        QCOMPARE(plot.getLayerRenderCount(JKQTBasePlotter::GraphsLayer), quint64(4));
+    }
+
+    void test_symbolSprites() {
+        const auto render=[](bool sprites) {
+            const bool old=JKQTPIsSymbolSpriteCacheEnabled();
+            JKQTPSetSymbolSpriteCacheEnabled(sprites);
+            QImage img(800, 600, QImage::Format_ARGB32_Premultiplied);
+            img.fill(Qt::white);
+            {
+                QPainter painter(&img);
+                painter.setRenderHint(QPainter::Antialiasing);
+                for (int i=1; i<static_cast<int>(JKQTPSymbolCount); i++) {
+                    const double x=25.0+double(i%15)*50.0+double(i)*0.13;
+                    const double y=30.0+double(i/15)*60.0+double(i)*0.29;
+                    JKQTPPlotSymbol(painter, x, y, static_cast<JKQTPGraphSymbols>(i), 18.0+double(i%3)*5.0, 1.0+double(i%2), QColor("red"), QColor("darkblue").lighter(), QFont());
+                }
+            }
+            JKQTPSetSymbolSpriteCacheEnabled(old);
+            return img;
+        };
+        const QImage vector=render(false);
+        const QImage sprites=render(true);
+        const QImage sprites2=render(true);
+        VERIFY_IMAGES_SIMILAR(vector, sprites, 0.002, 64, "symbol sprites vs. vector symbols");
+        QCOMPARE(sprites2, sprites);
+
+        // sprites are only used for pixel output
+        QPicture picture;
+        QPainter picturePainter(&picture);
+        QVERIFY(!JKQTPPlotSymbolSprite(picturePainter, 10, 10, JKQTPFilledCircle, 10, 1, QColor("red"), QColor("blue")));
+        picturePainter.end();
+        QImage img(100, 100, QImage::Format_ARGB32_Premultiplied);
+        QPainter imgPainter(&img);
+        QVERIFY(JKQTPPlotSymbolSprite(imgPainter, 10, 10, JKQTPFilledCircle, 10, 1, QColor("red"), QColor("blue")));
+        QVERIFY(!JKQTPPlotSymbolSprite(imgPainter, 10, 10, JKQTPCharacterSymbol+QChar('@').unicode(), 10, 1, QColor("red"), QColor("blue")));
+        imgPainter.rotate(30);
+        QVERIFY(!JKQTPPlotSymbolSprite(imgPainter, 10, 10, JKQTPFilledCircle, 10, 1, QColor("red"), QColor("blue")));
+    }
+
+    void test_batchedSymbolGraphs() {
+        // scatter and line graphs draw all their symbols with one call to JKQTPPlotSymbols(), which has to look the same as vector symbols
+        const auto render=[](bool sprites, bool lineGraph) {
+            const bool old=JKQTPIsSymbolSpriteCacheEnabled();
+            JKQTPSetSymbolSpriteCacheEnabled(sprites);
+            JKQTBasePlotter plot(true);
+            JKQTPDatastore* ds=plot.getDatastore();
+            const size_t cx=ds->addLinearColumn(200, 0, 10, "x");
+            const size_t cy=ds->addCalculatedColumnFromColumn(cx, [](double x) { return sin(x*3.1); }, "y");
+            JKQTPXYGraph* graph=nullptr;
+            if (lineGraph) {
+                JKQTPXYLineGraph* g=new JKQTPXYLineGraph(&plot);
+                g->setSymbolType(JKQTPFilledTriangle);
+                g->setSymbolSize(8);
+                graph=g;
+            } else {
+                JKQTPXYScatterGraph* g=new JKQTPXYScatterGraph(&plot);
+                g->setSymbolType(JKQTPFilledTriangle);
+                g->setSymbolSize(8);
+                graph=g;
+            }
+            graph->setXYColumns(cx, cy);
+            plot.addGraph(graph);
+            plot.zoomToFit();
+            const QImage img=plot.grabPixelImage(QSize(800,600), false);
+            JKQTPSetSymbolSpriteCacheEnabled(old);
+            return img;
+        };
+        for (bool lineGraph: {false, true}) {
+            VERIFY_IMAGES_SIMILAR(render(false, lineGraph), render(true, lineGraph), 0.002, 64, lineGraph?QString("line graph: sprites vs. vector symbols"):QString("scatter graph: sprites vs. vector symbols"));
+        }
+    }
+
+    void test_parametrizedScatterDrawingOrder() {
+        // three equally sized symbols at the same position (red, blue, red): in data order the last red symbol is on top,
+        // with grouping all red symbols are drawn together, before the blue one
+        const auto render=[](bool group) {
+            JKQTBasePlotter plot(true);
+            JKQTPDatastore* ds=plot.getDatastore();
+            const size_t cx=ds->addCopiedColumn(std::vector<double>{0.0, 1.0, 1.0, 1.0}, "x");
+            const size_t cy=ds->addCopiedColumn(std::vector<double>{0.0, 1.0, 1.0, 1.0}, "y");
+            const size_t cc=ds->addCopiedColumn(std::vector<double>{double(QColor("green").rgba()), double(QColor("red").rgba()), double(QColor("blue").rgba()), double(QColor("red").rgba())}, "color");
+            JKQTPXYParametrizedScatterGraph* graph=new JKQTPXYParametrizedScatterGraph(&plot);
+            graph->setXYColumns(cx, cy);
+            graph->setColorColumn(static_cast<int>(cc));
+            graph->setColorColumnContainsRGB(true);
+            graph->setSymbolFillDerivationMode(JKQTPColorDerivationMode::JKQTPFFCMSameColor);
+            graph->setSymbolType(JKQTPFilledCircle);
+            graph->setSymbolSize(30);
+            graph->setGroupSymbolsForDrawing(group);
+            QCOMPARE(graph->getGroupSymbolsForDrawing(), group);
+            plot.addGraph(graph);
+            plot.setXY(-1, 3, -1, 3);
+            const QImage img=plot.grabPixelImage(QSize(400,400), false);
+            int red=0, blue=0;
+            for (int y=0; y<img.height(); y++) {
+                for (int x=0; x<img.width(); x++) {
+                    const QColor c=img.pixelColor(x,y);
+                    if (c.red()>200 && c.green()<60 && c.blue()<60) red++;
+                    if (c.blue()>200 && c.green()<60 && c.red()<60) blue++;
+                }
+            }
+            return std::make_pair(red, blue);
+        };
+        QVERIFY(!JKQTPXYParametrizedScatterGraph(static_cast<JKQTBasePlotter*>(nullptr)).getGroupSymbolsForDrawing());
+        const auto ordered=render(false);
+        QVERIFY2(ordered.first>100 && ordered.second<ordered.first/10, QString("data order: red=%1, blue=%2").arg(ordered.first).arg(ordered.second).toLatin1().constData());
+        const auto grouped=render(true);
+        QVERIFY2(grouped.second>100 && grouped.first<grouped.second/10, QString("grouped: red=%1, blue=%2").arg(grouped.first).arg(grouped.second).toLatin1().constData());
+    }
+
+    void test_functionSampleCache() {
+        JKQTBasePlotter plot(true);
+        size_t calls=0;
+        JKQTPXFunctionLineGraph* graph=new JKQTPXFunctionLineGraph(&plot);
+        graph->setPlotFunctionFunctor(jkqtpPlotFunctionType([&calls](double x, const QVector<double>& p) {
+            calls++;
+            return p.value(0, 1.0)*sin(x)*exp(-x/20.0);
+        }));
+        graph->setSampleCaching(true);
+        plot.addGraph(graph);
+        const auto render=[&]() {
+            QImage img(800, 600, QImage::Format_ARGB32_Premultiplied);
+            img.fill(Qt::white);
+            JKQTPEnhancedPainter painter(&img);
+            plot.drawNonGrid(painter, QRect(0,0,img.width(), img.height()));
+            return img;
+        };
+        plot.setXY(0, 20, -1.5, 1.5);
+        const QImage first=render();
+        const size_t firstCalls=calls;
+        QVERIFY(firstCalls>0);
+        QVERIFY(graph->getSampleCacheSize()>0);
+
+        // redrawing the same range does not evaluate the function
+        calls=0;
+        QCOMPARE(render(), first);
+        QCOMPARE(calls, size_t(0));
+
+        // panning by 5% only evaluates the function (mainly) in the newly exposed range
+        calls=0;
+        plot.setXY(1, 21, -1.5, 1.5);
+        render();
+        QVERIFY2(calls<firstCalls/4, qPrintable(QString("function calls after panning: %1 (initial: %2)").arg(calls).arg(firstCalls)));
+
+        // changing the parameters invalidates the cache
+        calls=0;
+        graph->setParamsV(0.5);
+        render();
+        QVERIFY(calls>=firstCalls/2);
+
+        // the cached plot matches the uncached one
+        plot.setXY(0, 20, -1.5, 1.5);
+        graph->setParamsV(1.0);
+        const QImage cached=render();
+        graph->setSampleCaching(false);
+        QCOMPARE(graph->getSampleCacheSize(), 0);
+        const QImage uncached=render();
+        VERIFY_IMAGES_SIMILAR(uncached, cached, 0.005, 64, "sample cache vs. uncached evaluation");
+    }
+
+    void test_redrawCoalescing() {
+        JKQTPlotter plot;
+        plot.resize(200, 150);
+        const size_t cX=plot.getDatastore()->addCopiedColumn(std::vector<double>{0, 1, 2, 3}, "x");
+        const size_t cY=plot.getDatastore()->addCopiedColumn(std::vector<double>{0, 1, 0, 1}, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cX, cY);
+        plot.addGraph(graph);
+        QTRY_VERIFY(!plot.isRedrawPending());
+
+        // without a frame rate limit, every request is rendered immediately
+        plot.resetRenderStatistics();
+        for (int i=0; i<5; i++) plot.redrawPlot();
+        QCOMPARE(plot.getRenderStatistics().requestedFrames, static_cast<quint64>(5));
+        QCOMPARE(plot.getRenderStatistics().renderedFrames, static_cast<quint64>(5));
+
+        // with a frame rate limit, all requests until the next frame are coalesced
+        plot.setMaxFrameRate(20);
+        plot.resetRenderStatistics();
+        for (int i=0; i<100; i++) plot.requestRedraw(JKQTPlotter::RedrawDataChanged, JKQTBasePlotter::GraphsLayer);
+        // the changed layers are collected until the frame is started
+        QVERIFY(plot.getPendingRedrawLayers()==JKQTBasePlotter::DrawingLayers(JKQTBasePlotter::GraphsLayer));
+        plot.getPlotter()->setX(0, 4);
+        QVERIFY(plot.isRedrawPending());
+        QCOMPARE(plot.getRenderStatistics().renderedFrames, static_cast<quint64>(0));
+        QVERIFY(plot.getPendingRedrawReasons().testFlag(JKQTPlotter::RedrawDataChanged));
+        QVERIFY(plot.getPendingRedrawReasons().testFlag(JKQTPlotter::RedrawZoomChanged));
+        QTRY_VERIFY(!plot.isRedrawPending());
+        QVERIFY(plot.getPendingRedrawLayers()==JKQTBasePlotter::DrawingLayers());
+        const JKQTPlotter::RenderStatistics& stat=plot.getRenderStatistics();
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(1));
+        QCOMPARE(stat.requestsPerReason[1], static_cast<quint64>(100));
+        QVERIFY(stat.requestedFrames>=100);
+        QCOMPARE(stat.coalescedRequests(), stat.requestedFrames-1);
+        QVERIFY(stat.lastFrameReasons.testFlag(JKQTPlotter::RedrawDataChanged));
+        QVERIFY(stat.lastFrameReasons.testFlag(JKQTPlotter::RedrawZoomChanged));
+        quint64 histogramSum=0;
+        for (int i=0; i<JKQTPlotter::RenderTimeHistogramBins; i++) histogramSum+=stat.renderTimeHistogram[i];
+        QCOMPARE(histogramSum, static_cast<quint64>(1));
+
+        // the frames are always rendered from the event loop
+        plot.redrawPlot();
+        QVERIFY(plot.isRedrawPending());
+        QTRY_VERIFY(!plot.isRedrawPending());
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(2));
+        QVERIFY(stat.lastFrameReasons==JKQTPlotter::RedrawReasons(JKQTPlotter::RedrawRequested));
+
+        // removing the limit renders a pending frame immediately
+        plot.redrawPlot();
+        plot.setMaxFrameRate(0);
+        QVERIFY(!plot.isRedrawPending());
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(3));
+    }
+
+    void test_backgroundRenderingContract() {
+        JKQTPlotter plot;
+        plot.resize(400, 300);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t N=200000;
+        const size_t cX=ds->addLinearColumn(N, 0, 10, "x");
+        const size_t cY=ds->addCalculatedColumnFromColumn(cX, [](double x) { return sin(x*100.0); }, "y");
+        const size_t cUnused=ds->addColumn(10, "unused");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cX, cY);
+        graph->setSymbolType(JKQTPFilledCircle);
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        plot.setBackgroundRendering(true);
+        QTRY_VERIFY(!plot.isRedrawPending() && !plot.isBackgroundRenderingRunning());
+        plot.resetRenderStatistics();
+        const JKQTPlotter::RenderStatistics& stat=plot.getRenderStatistics();
+
+        // a redraw request never waits for the worker: the outdated frame is aborted and the new one is started, when the worker returns
+        plot.redrawPlot();
+        QVERIFY(plot.isBackgroundRenderingRunning());
+        plot.redrawPlot();
+        QVERIFY(plot.isBackgroundRenderingRunning());
+        QVERIFY(plot.getPlotter()->isDrawingAborted());
+        QTRY_VERIFY(!plot.isRedrawPending() && !plot.isBackgroundRenderingRunning());
+        QCOMPARE(stat.abortedFrames, static_cast<quint64>(1));
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(1));
+
+        // modifications of the datastore from other threads are rejected with a warning and do not abort the frame
+        plot.redrawPlot();
+        QVERIFY(plot.isBackgroundRenderingRunning());
+        QTest::ignoreMessage(QtWarningMsg, "JKQTPlotter: the datastore was modified from another thread, while the plot was drawn in the background. Use JKQTPDatastore::addIngestionQueue() to pass data from other threads!");
+        std::thread producer([ds, cUnused]() {
+            ds->set(cUnused, 0, 1.0);
+            ds->set(cUnused, 1, 2.0);
+        });
+        producer.join();
+        QVERIFY(!plot.getPlotter()->isDrawingAborted());
+        // ... in the GUI thread, they abort the frame without waiting for it
+        ds->set(cUnused, 0, 3.0);
+        QVERIFY(plot.isBackgroundRenderingRunning());
+        QVERIFY(plot.getPlotter()->isDrawingAborted());
+        QTRY_VERIFY(!plot.isRedrawPending() && !plot.isBackgroundRenderingRunning());
+        QCOMPARE(stat.abortedFrames, static_cast<quint64>(2));
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(2));
+
+        // the plot is modified inside a JKQTPlotterUpdateGuard, which aborts the running frame first
+        plot.redrawPlot();
+        QVERIFY(plot.isBackgroundRenderingRunning());
+        {
+            JKQTPlotterUpdateGuard guard(&plot);
+            QVERIFY(!plot.isBackgroundRenderingRunning());
+            plot.getPlotter()->setX(1, 9);
+            plot.getXAxis()->setInverted(true);
+        }
+        QCOMPARE(stat.abortedFrames, static_cast<quint64>(3));
+        QTRY_VERIFY(!plot.isRedrawPending() && !plot.isBackgroundRenderingRunning());
+        QCOMPARE(stat.renderedFrames, static_cast<quint64>(3));
+        QCOMPARE(plot.getXMin(), 1.0);
+        QCOMPARE(plot.getXMax(), 9.0);
+    }
+
+    void test_preparedDrawNonGrid() {
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t cX=ds->addLinearColumn(100, 0, 10, "x");
+        const size_t cY=ds->addCalculatedColumnFromColumn(cX, [](double x) { return sin(x); }, "y");
+        JKQTPXYLineGraph* graph=new JKQTPXYLineGraph(&plot);
+        graph->setXYColumns(cX, cY);
+        graph->setTitle("sin(x)");
+        plot.addGraph(graph);
+        plot.zoomToFit();
+        plot.setWidgetSize(400, 300);
+        int scalingSignals=0;
+        connect(&plot, &JKQTBasePlotter::plotScalingRecalculated, [&scalingSignals]() { scalingSignals++; });
+        const auto render=[&plot](bool prepared) {
+            QImage img(400, 300, QImage::Format_ARGB32);
+            img.fill(Qt::transparent);
+            JKQTPEnhancedPainter painter(&img);
+            if (prepared) plot.prepareDrawNonGrid(painter);
+            plot.drawNonGrid(painter, QPoint(0,0), !prepared);
+            painter.end();
+            return img;
+        };
+        const QImage reference=render(false);
+        QCOMPARE(scalingSignals, 1);
+        // the layout is calculated by prepareDrawNonGrid(), drawing without recalculation does not emit signals
+        const double borderLeft=plot.getInternalPlotBorderLeft();
+        const QImage prepared=render(true);
+        QCOMPARE(scalingSignals, 2);
+        QCOMPARE(plot.getInternalPlotBorderLeft(), borderLeft);
+        VERIFY_IMAGES_SIMILAR(reference, prepared, 0.0, 0, "prepared vs. direct drawNonGrid()");
+    }
+
+    void test_imageViewportRendering() {
+        auto makeImage=[](int Nx, int Ny) {
+            std::vector<double> img(static_cast<size_t>(Nx)*static_cast<size_t>(Ny));
+            for (int y=0; y<Ny; y++) {
+                for (int x=0; x<Nx; x++) {
+                    img[static_cast<size_t>(y)*static_cast<size_t>(Nx)+static_cast<size_t>(x)]=sin(double(x)/double(Nx)*6.0)*cos(double(y)/double(Ny)*4.0)+double(y)/double(Ny);
+                }
+            }
+            return img;
+        };
+        // image smaller than the plot: same pixels, only scaled differently
+        {
+            const std::vector<double> img=makeImage(200, 150);
+            VERIFY_IMAGES_SIMILAR(renderMathImage(img, 200, 150, false), renderMathImage(img, 200, 150, true), 0.01, 64, "small image, viewport vs. full");
+        }
+        // image larger than the plot: downsampled to the device resolution
+        const int Nx=3000, Ny=2400;
+        const std::vector<double> img=makeImage(Nx, Ny);
+        {
+            const QImage full=renderMathImage(img, Nx, Ny, false);
+            VERIFY_IMAGES_SIMILAR(full, renderMathImage(img, Nx, Ny, true), 0.01, 64, "large image, viewport vs. full");
+            VERIFY_IMAGES_SIMILAR(full, renderMathImage(img, Nx, Ny, true, JKQTPMathImage::BoxFilterDownsampling), 0.01, 64, "large image, box-filter viewport vs. full");
+        }
+        // zoomed into a region of the image, with mirrored x-axis
+        {
+            VERIFY_IMAGES_SIMILAR(renderMathImage(img, Nx, Ny, false, JKQTPMathImage::NearestNeighbourDownsampling, 1000, 1400.5, 300.3, 600, true),
+                                  renderMathImage(img, Nx, Ny, true, JKQTPMathImage::NearestNeighbourDownsampling, 1000, 1400.5, 300.3, 600, true),
+                                  0.01, 64, "zoomed, mirrored image, viewport vs. full");
+        }
+    }
+
+    void test_imageTileCache() {
+        const int Nx=4000, Ny=3000;
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t col=ds->addImageColumn(Nx, Ny, "image");
+        for (int y=0; y<Ny; y++) {
+            for (int x=0; x<Nx; x++) {
+                ds->set(col, static_cast<size_t>(y)*static_cast<size_t>(Nx)+static_cast<size_t>(x), sin(double(x)/double(Nx)*6.0)*cos(double(y)/double(Ny)*4.0)+double(y)/double(Ny));
+            }
+        }
+        JKQTPColumnMathImage* graph=new JKQTPColumnMathImage(0, 0, Nx, Ny, static_cast<int>(col), JKQTPMathImageMATLAB, &plot);
+        graph->setShowColorBar(false);
+        graph->setViewportDownsampling(JKQTPMathImage::BoxFilterDownsampling);
+        plot.addGraph(graph);
+        plot.setXY(0, Nx, 0, Ny);
+
+        const QImage direct=plot.grabPixelImage(QSize(800,600), false);
+        graph->setUseTileCache(true);
+        const QImage cached=plot.grabPixelImage(QSize(800,600), false);
+        VERIFY_IMAGES_SIMILAR(direct, cached, 0.01, 64, "tile cache vs. direct box-filter sampling");
+        JKQTPImageTilePyramid::Statistics stat=graph->getTileCacheStatistics();
+        QVERIFY(stat.builtTiles>0);
+        QCOMPARE(stat.hitTiles, quint64(0));
+
+        // the second frame is drawn from the cache
+        graph->resetTileCacheStatistics();
+        const QImage cached2=plot.grabPixelImage(QSize(800,600), false);
+        stat=graph->getTileCacheStatistics();
+        QVERIFY(stat.requestedTiles>0);
+        QCOMPARE(stat.hitTiles, stat.requestedTiles);
+        QCOMPARE(stat.builtTiles, quint64(0));
+        VERIFY_IMAGES_SIMILAR(cached, cached2, 0.0, 0, "second frame from the tile cache vs. first frame");
+
+        // changing the column invalidates the cache
+        ds->set(col, 0, 100.0);
+        graph->resetTileCacheStatistics();
+        plot.grabPixelImage(QSize(800,600), false);
+        stat=graph->getTileCacheStatistics();
+        QCOMPARE(stat.invalidations, quint64(1));
+        QVERIFY(stat.builtTiles>0);
+
+        // the memory limit is respected between frames
+        graph->setTileCacheMaxMemory(JKQTPImageTilePyramid::TileSize*JKQTPImageTilePyramid::TileSize*sizeof(double)*2);
+        stat=graph->getTileCacheStatistics();
+        QVERIFY(stat.memoryBytes<=graph->getTileCacheMaxMemory());
+        QVERIFY(stat.evictedTiles>0);
+    }
+
+    void test_imageDataRange() {
+        const int Nx=300, Ny=200;
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t col=ds->addImageColumn(Nx, Ny, "image");
+        std::vector<double> raw(static_cast<size_t>(Nx)*static_cast<size_t>(Ny));
+        for (size_t i=0; i<raw.size(); i++) {
+            raw[i]=sin(double(i)/1000.0)*double(i%17);
+            ds->set(col, i, raw[i]);
+        }
+        raw[10]=JKQTP_NAN;
+        ds->set(col, 10, JKQTP_NAN);
+        const double expectedMin=JKQTPImagePlot_getImageMin<double>(raw.data(), Nx, Ny);
+        const double expectedMax=JKQTPImagePlot_getImageMax<double>(raw.data(), Nx, Ny);
+        double imin=0, imax=0;
+        QVERIFY(JKQTPImagePlot_getImageMinMax<double>(raw.data(), Nx, Ny, imin, imax));
+        QCOMPARE(imin, expectedMin);
+        QCOMPARE(imax, expectedMax);
+
+        // column images use the range cached in the datastore, until the column is modified
+        JKQTPColumnMathImage* graph=new JKQTPColumnMathImage(0, 0, Nx, Ny, static_cast<int>(col), JKQTPMathImageMATLAB, &plot);
+        plot.addGraph(graph);
+        graph->getDataMinMax(imin, imax);
+        QCOMPARE(imin, expectedMin);
+        QCOMPARE(imax, expectedMax);
+        QCOMPARE(ds->getColumnStatistics(col).generation, ds->getColumnGeneration(col));
+        ds->set(col, 5, 1000.0);
+        graph->getDataMinMax(imin, imax);
+        QCOMPARE(imin, expectedMin);
+        QCOMPARE(imax, 1000.0);
+
+        // raw pointers are not cached, as they may be changed in place
+        JKQTPMathImage* rawGraph=new JKQTPMathImage(0, 0, Nx, Ny, JKQTPMathImageDataType::DoubleArray, raw.data(), Nx, Ny, JKQTPMathImageMATLAB, &plot);
+        plot.addGraph(rawGraph);
+        rawGraph->getDataMinMax(imin, imax);
+        QCOMPARE(imax, expectedMax);
+        raw[7]=-1000.0;
+        rawGraph->getDataMinMax(imin, imax);
+        QCOMPARE(imin, -1000.0);
+    }
+
+    void test_contourPlot() {
+        const int Nx=300, Ny=200;
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t col=ds->addImageColumn(Nx, Ny, "image");
+        for (int y=0; y<Ny; y++) {
+            for (int x=0; x<Nx; x++) {
+                ds->set(col, static_cast<size_t>(y*Nx+x), sin(double(x)/double(Nx)*9.0)*cos(double(y)/double(Ny)*7.0));
+            }
+        }
+        JKQTPColumnContourPlot* graph=new JKQTPColumnContourPlot(&plot);
+        graph->setImageColumn(col);
+        graph->setWidth(Nx);
+        graph->setHeight(Ny);
+        graph->setShowColorBar(false);
+        graph->setContourColoringMode(JKQTPContourPlot::SingleColorContours);
+        graph->setContourLevels(QVector<double>{-0.5, 0.0, 0.5});
+        plot.addGraph(graph);
+        plot.setXY(0, Nx, 0, Ny);
+        QVERIFY(graph->getContourAlgorithm()==JKQTPContourPlot::MarchingSquaresContours);
+        plot.grabPixelImage(QSize(600,400), false);
+
+        // adding or changing a level only calculates that level, the result is the same as a full recalculation
+        graph->addContourLevel(0.25);
+        const QImage incremental=plot.grabPixelImage(QSize(600,400), false);
+        graph->clearCachedContours();
+        const QImage full=plot.grabPixelImage(QSize(600,400), false);
+        VERIFY_IMAGES_SIMILAR(full, incremental, 0.0, 0, "contours after adding a level vs. full recalculation");
+        graph->setContourLevels(QVector<double>{-0.5, 0.1, 0.25, 0.5});
+        const QImage changed=plot.grabPixelImage(QSize(600,400), false);
+        graph->clearCachedContours();
+        VERIFY_IMAGES_SIMILAR(plot.grabPixelImage(QSize(600,400), false), changed, 0.0, 0, "contours after changing the levels vs. full recalculation");
+        QVERIFY(differingPixelFraction(changed, full, 0)>0.0);
+
+        // marching squares and CONREC yield (nearly) the same lines
+        graph->setContourAlgorithm(JKQTPContourPlot::CONRECContours);
+        const QImage conrec=plot.grabPixelImage(QSize(600,400), false);
+        const double diff=differingPixelFraction(changed, conrec);
+        graph->setVisible(false);
+        const double linePixels=differingPixelFraction(changed, plot.grabPixelImage(QSize(600,400), false));
+        QVERIFY(linePixels>0.0);
+        QVERIFY2(diff<linePixels*0.5, qPrintable(QString("marching squares vs. CONREC: %1% of the pixels differ, but only %2% are covered by contour lines").arg(diff*100.0).arg(linePixels*100.0)));
+    }
+
+    void test_externalImageColumnEditedInPlace() {
+        const int Nx=200, Ny=150;
+        std::vector<double> img(static_cast<size_t>(Nx)*static_cast<size_t>(Ny));
+        for (int y=0; y<Ny; y++) {
+            for (int x=0; x<Nx; x++) {
+                img[static_cast<size_t>(y*Nx+x)]=sin(double(x)/double(Nx)*9.0)*cos(double(y)/double(Ny)*7.0);
+            }
+        }
+        JKQTBasePlotter plot(true);
+        JKQTPDatastore* ds=plot.getDatastore();
+        const size_t col=ds->addImageColumn(img.data(), Nx, Ny, "external image");
+        JKQTPColumnContourPlot* graph=new JKQTPColumnContourPlot(&plot);
+        graph->setImageColumn(col);
+        graph->setWidth(Nx);
+        graph->setHeight(Ny);
+        graph->setShowColorBar(false);
+        graph->setContourColoringMode(JKQTPContourPlot::SingleColorContours);
+        graph->setContourLevels(QVector<double>{-0.5, 0.0, 0.5});
+        plot.addGraph(graph);
+        plot.setXY(0, Nx, 0, Ny);
+        const QImage before=plot.grabPixelImage(QSize(600,400), false);
+        double imin=0, imax=0;
+        graph->getDataMinMax(imin, imax);
+        QCOMPARE(imax, JKQTPImagePlot_getImageMax<double>(img.data(), Nx, Ny));
+
+        // the application changes the referenced array in place: the data keys are O(1), so without
+        // markColumnModified() the cached contour lines are kept ...
+        const std::vector<double> original=img;
+        for (double& v: img) v=-v;
+        img[static_cast<size_t>(Nx+1)]=10.0;
+        const quint64 keyBefore=graph->getImageDataKey();
+        VERIFY_IMAGES_SIMILAR(plot.grabPixelImage(QSize(600,400), false), before, 0.0, 0, "contours are cached until the external column is marked as modified");
+        QCOMPARE(graph->getImageDataKey(), keyBefore);
+        // ... and contour lines and data range follow, once the change is signalled
+        ds->markColumnModified(col);
+        QVERIFY(graph->getImageDataKey()!=keyBefore);
+        const QImage after=plot.grabPixelImage(QSize(600,400), false);
+        QVERIFY2(differingPixelFraction(before, after, 0)>0.0, "contour lines were not recalculated after the external column was marked as modified");
+        graph->clearCachedContours();
+        VERIFY_IMAGES_SIMILAR(plot.grabPixelImage(QSize(600,400), false), after, 0.0, 0, "contours after an in-place change of the external column vs. full recalculation");
+        graph->getDataMinMax(imin, imax);
+        QCOMPARE(imax, 10.0);
+
+        // with setDetectImageDataChanges() the graph hashes the image and detects changes in place by itself
+        graph->setDetectImageDataChanges(true);
+        const quint64 keyDetect=graph->getImageDataKey();
+        QCOMPARE(graph->getImageDataKey(), keyDetect);
+        std::copy(original.begin(), original.end(), img.begin());
+        QVERIFY(graph->getImageDataKey()!=keyDetect);
+        VERIFY_IMAGES_SIMILAR(plot.grabPixelImage(QSize(600,400), false), before, 0.0, 0, "contours after an in-place change, detected by a hash over the image");
+        graph->getDataMinMax(imin, imax);
+        QCOMPARE(imax, JKQTPImagePlot_getImageMax<double>(img.data(), Nx, Ny));
+
+        // images from raw pointers are invalidated by markImageDataModified()
+        JKQTPContourPlot* rawGraph=new JKQTPContourPlot(&plot);
+        rawGraph->setData(img.data(), Nx, Ny, JKQTPMathImageDataType::DoubleArray);
+        const quint64 rawKey=rawGraph->getImageDataKey();
+        img[0]=20.0;
+        QCOMPARE(rawGraph->getImageDataKey(), rawKey);
+        rawGraph->markImageDataModified();
+        QVERIFY(rawGraph->getImageDataKey()!=rawKey);
+        delete rawGraph;
+    }
+
+    void test_rgbImageViewportRendering() {
+        const int Nx=1500, Ny=1200;
+        std::vector<double> r(static_cast<size_t>(Nx)*static_cast<size_t>(Ny)), g(r.size()), b(r.size());
+        for (int y=0; y<Ny; y++) {
+            for (int x=0; x<Nx; x++) {
+                const size_t i=static_cast<size_t>(y)*static_cast<size_t>(Nx)+static_cast<size_t>(x);
+                r[i]=double(x)/double(Nx);
+                g[i]=double(y)/double(Ny);
+                b[i]=sin(double(x+y)/double(Nx)*3.0);
+            }
+        }
+        auto render=[&](bool viewportRendering) {
+            JKQTBasePlotter plot(true);
+            JKQTPRGBMathImage* graph=new JKQTPRGBMathImage(0, 0, Nx, Ny, JKQTPMathImageDataType::DoubleArray, r.data(), Nx, Ny, &plot);
+            graph->setDataG(g.data());
+            graph->setDatatypeG(JKQTPMathImageDataType::DoubleArray);
+            graph->setDataB(b.data());
+            graph->setDatatypeB(JKQTPMathImageDataType::DoubleArray);
+            graph->setViewportRendering(viewportRendering);
+            graph->setShowColorBar(false);
+            plot.addGraph(graph);
+            plot.setXY(100, 1300.5, 50, 1000);
+            return plot.grabPixelImage(QSize(800,600), false);
+        };
+        VERIFY_IMAGES_SIMILAR(render(false), render(true), 0.01, 64, "RGB image, viewport vs. full");
+    }
+};
+
+QTEST_MAIN(TestJKQTPGraphRendering)
+#include "test_jkqtpgraphrendering.moc"